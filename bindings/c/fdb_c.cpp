@@ -64,6 +64,9 @@ static_assert(static_cast<int>(FDB_BG_MUTATION_TYPE_SET_VALUE) == static_cast<in
               "FDB_BG_MUTATION_TYPE_SET_VALUE enum value mismatch");
 static_assert(static_cast<int>(FDB_BG_MUTATION_TYPE_CLEAR_RANGE) == static_cast<int>(MutationRef::Type::ClearRange),
               "FDB_BG_MUTATION_TYPE_CLEAR_RANGE enum value mismatch");
+static_assert(sizeof(FDBOptionalValue) == sizeof(OptionalValueRef), "FDBOptionalValue / OptionalValueRef size mismatch");
+static_assert(sizeof(FDBChangeFeedMutation) == sizeof(ChangeFeedMutationRef),
+              "FDBChangeFeedMutation / ChangeFeedMutationRef size mismatch");
 
 #define TSAV_ERROR(type, error) ((FDBFuture*)(ThreadFuture<type>(error())).extractPtr())
 
@@ -326,6 +329,25 @@ extern "C" DLLEXPORT fdb_error_t fdb_future_get_keyrange_array(FDBFuture* f,
 	                 *out_count = na.size(););
 }
 
+extern "C" DLLEXPORT fdb_error_t fdb_future_get_optional_value_array(FDBFuture* f,
+                                                                     FDBOptionalValue const** out_values,
+                                                                     int* out_count) {
+	CATCH_AND_RETURN(Standalone<VectorRef<OptionalValueRef>> values =
+	                     TSAV(Standalone<VectorRef<OptionalValueRef>>, f)->get();
+	                 *out_values = (FDBOptionalValue*)values.begin();
+	                 *out_count = values.size(););
+}
+
+extern "C" DLLEXPORT fdb_error_t fdb_future_get_change_feed_mutations(FDBFuture* f,
+                                                                      FDBChangeFeedMutation const** out_mutations,
+                                                                      int* out_count,
+                                                                      int64_t* out_end_version) {
+	CATCH_AND_RETURN(ChangeFeedReadResult const& result = TSAV(ChangeFeedReadResult, f)->get();
+	                 *out_mutations = (FDBChangeFeedMutation*)result.mutations.begin();
+	                 *out_count = result.mutations.size();
+	                 *out_end_version = result.endVersion;);
+}
+
 extern "C" DLLEXPORT fdb_error_t fdb_future_get_key_array(FDBFuture* f, FDBKey const** out_key_array, int* out_count) {
 	CATCH_AND_RETURN(Standalone<VectorRef<KeyRef>> na = TSAV(Standalone<VectorRef<KeyRef>>, f)->get();
 	                 *out_key_array = (FDBKey*)na.begin();
@@ -508,6 +530,58 @@ extern "C" DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_get_client_statu
 	return (FDBFuture*)(DB(db)->getClientStatus().extractPtr());
 }
 
+extern "C" DLLEXPORT FDBFuture* fdb_database_create_change_feed(FDBDatabase* db,
+                                                                uint8_t const* feed_id,
+                                                                int feed_id_length,
+                                                                uint8_t const* begin_key,
+                                                                int begin_key_length,
+                                                                uint8_t const* end_key,
+                                                                int end_key_length) {
+	KeyRef begin(begin_key, begin_key_length);
+	KeyRef end(end_key, end_key_length);
+	if (begin > end) {
+		return TSAV_ERROR(Void, inverted_range);
+	}
+	return (FDBFuture*)(DB(db)->createChangeFeed(StringRef(feed_id, feed_id_length), KeyRangeRef(begin, end)).extractPtr());
+}
+
+extern "C" DLLEXPORT FDBFuture* fdb_database_destroy_change_feed(FDBDatabase* db,
+                                                                 uint8_t const* feed_id,
+                                                                 int feed_id_length) {
+	return (FDBFuture*)(DB(db)->destroyChangeFeed(StringRef(feed_id, feed_id_length)).extractPtr());
+}
+
+extern "C" DLLEXPORT FDBFuture* fdb_database_pop_change_feed(FDBDatabase* db,
+                                                             uint8_t const* feed_id,
+                                                             int feed_id_length,
+                                                             int64_t version) {
+	return (FDBFuture*)(DB(db)->popChangeFeed(StringRef(feed_id, feed_id_length), version).extractPtr());
+}
+
+extern "C" DLLEXPORT FDBFuture* fdb_database_read_change_feed(FDBDatabase* db,
+                                                              uint8_t const* feed_id,
+                                                              int feed_id_length,
+                                                              int64_t begin_version,
+                                                              int64_t end_version,
+                                                              uint8_t const* begin_key,
+                                                              int begin_key_length,
+                                                              uint8_t const* end_key,
+                                                              int end_key_length,
+                                                              int target_bytes) {
+	KeyRef begin(begin_key, begin_key_length);
+	KeyRef end(end_key, end_key_length);
+	if (begin > end) {
+		return TSAV_ERROR(ChangeFeedReadResult, inverted_range);
+	}
+	return (FDBFuture*)(DB(db)
+	                        ->readChangeFeed(StringRef(feed_id, feed_id_length),
+	                                         begin_version,
+	                                         end_version,
+	                                         KeyRangeRef(begin, end),
+	                                         target_bytes)
+	                        .extractPtr());
+}
+
 extern "C" DLLEXPORT void fdb_transaction_destroy(FDBTransaction* tr) {
 	try {
 		TXN(tr)->delref();
@@ -538,6 +612,16 @@ FDBFuture* fdb_transaction_get_v13(FDBTransaction* tr, uint8_t const* key_name,
 	return fdb_transaction_get_impl(tr, key_name, key_name_length, 0);
 }
 
+extern "C" DLLEXPORT FDBFuture* fdb_transaction_get_values(FDBTransaction* tr,
+                                                           FDBKey const* keys,
+                                                           int count,
+                                                           fdb_bool_t snapshot) {
+	if (count < 0) {
+		return TSAV_ERROR(Standalone<VectorRef<OptionalValueRef>>, invalid_option_value);
+	}
+	return (FDBFuture*)(TXN(tr)->getValues(VectorRef<KeyRef>((KeyRef*)keys, count), snapshot).extractPtr());
+}
+
 FDBFuture* fdb_transaction_get_key_impl(FDBTransaction* tr,
                                         uint8_t const* key_name,
                                         int key_name_length,
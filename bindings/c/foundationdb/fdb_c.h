@@ -230,6 +230,26 @@ typedef struct readgranulecontext {
 
 typedef enum { FDB_BG_MUTATION_TYPE_SET_VALUE = 0, FDB_BG_MUTATION_TYPE_CLEAR_RANGE = 1 } FDBBGMutationType;
 
+#pragma pack(push, 4)
+/* One value read by fdb_transaction_get_values. value is only meaningful when present is true. */
+typedef struct optionalvalue {
+	fdb_bool_t present;
+	const uint8_t* value;
+	int value_length;
+} FDBOptionalValue;
+#pragma pack(pop)
+
+#pragma pack(push, 4)
+/* A mutation read from a change feed. type is FDB_BG_MUTATION_TYPE_SET_VALUE for a set of param1 to param2, or
+ * FDB_BG_MUTATION_TYPE_CLEAR_RANGE for a clear of [param1, param2). */
+typedef struct changefeedmutation {
+	int64_t version;
+	int type;
+	FDBKey param1;
+	FDBKey param2;
+} FDBChangeFeedMutation;
+#pragma pack(pop)
+
 #pragma pack(push, 4)
 
 typedef struct bgtenantprefix {
@@ -351,6 +371,18 @@ DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_future_get_keyrange_array(FDBFuture
                                                                        FDBKeyRange const** out_ranges,
                                                                        int* out_count);
 
+/* Returns the values read by fdb_transaction_get_values, one for each requested key in the order requested. */
+DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_future_get_optional_value_array(FDBFuture* f,
+                                                                             FDBOptionalValue const** out_values,
+                                                                             int* out_count);
+
+/* Returns the mutations read by fdb_database_read_change_feed in version order. Every version up to and including
+ * out_end_version has been read, so the next read should begin at out_end_version + 1. */
+DLLEXPORT WARN_UNUSED_RESULT fdb_error_t fdb_future_get_change_feed_mutations(FDBFuture* f,
+                                                                              FDBChangeFeedMutation const** out_mutations,
+                                                                              int* out_count,
+                                                                              int64_t* out_end_version);
+
 /* FDBResult is a synchronous computation result, as opposed to a future that is asynchronous. */
 DLLEXPORT void fdb_result_destroy(FDBResult* r);
 
@@ -417,6 +449,41 @@ DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_get_server_protocol(FDBData
 
 DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_get_client_status(FDBDatabase* db);
 
+/* Change feeds capture every mutation to [begin_key, end_key) from the version at which they are created. Creating a
+ * feed which already exists with the same range does nothing. */
+DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_create_change_feed(FDBDatabase* db,
+                                                                        uint8_t const* feed_id,
+                                                                        int feed_id_length,
+                                                                        uint8_t const* begin_key,
+                                                                        int begin_key_length,
+                                                                        uint8_t const* end_key,
+                                                                        int end_key_length);
+
+DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_destroy_change_feed(FDBDatabase* db,
+                                                                         uint8_t const* feed_id,
+                                                                         int feed_id_length);
+
+/* Discards the mutations of the feed below version */
+DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_pop_change_feed(FDBDatabase* db,
+                                                                     uint8_t const* feed_id,
+                                                                     int feed_id_length,
+                                                                     int64_t version);
+
+/* Reads the mutations of the feed between begin_version (inclusive) and end_version (exclusive) which touch
+ * [begin_key, end_key). Returns once roughly target_bytes have been read or no newer committed version is available.
+ * Fails with change_feed_popped if begin_version is before the version the feed was popped to, or, for part of the
+ * range which moved to a different storage server, before the version at which that server took it over. */
+DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_read_change_feed(FDBDatabase* db,
+                                                                      uint8_t const* feed_id,
+                                                                      int feed_id_length,
+                                                                      int64_t begin_version,
+                                                                      int64_t end_version,
+                                                                      uint8_t const* begin_key,
+                                                                      int begin_key_length,
+                                                                      uint8_t const* end_key,
+                                                                      int end_key_length,
+                                                                      int target_bytes);
+
 DLLEXPORT void fdb_transaction_destroy(FDBTransaction* tr);
 
 DLLEXPORT void fdb_transaction_cancel(FDBTransaction* tr);
@@ -439,6 +506,13 @@ DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get(FDBTransaction* tr,
                                                             fdb_bool_t snapshot);
 #endif
 
+/* Reads keys, which need not be sorted or distinct, at the transaction's read version. Keys stored on the same storage
+ * server shard are read with one request. */
+DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get_values(FDBTransaction* tr,
+                                                                   FDBKey const* keys,
+                                                                   int count,
+                                                                   fdb_bool_t snapshot);
+
 #if FDB_API_VERSION >= 14
 DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get_key(FDBTransaction* tr,
                                                                 uint8_t const* key_name,
@@ -104,6 +104,20 @@ void Future::cancel() {
 	return fdb_future_get_mappedkeyvalue_array(future_, out_kv, out_count, out_more);
 }
 
+// OptionalValueArrayFuture
+
+[[nodiscard]] fdb_error_t OptionalValueArrayFuture::get(const FDBOptionalValue** out_values, int* out_count) {
+	return fdb_future_get_optional_value_array(future_, out_values, out_count);
+}
+
+// ChangeFeedMutationsFuture
+
+[[nodiscard]] fdb_error_t ChangeFeedMutationsFuture::get(const FDBChangeFeedMutation** out_mutations,
+                                                         int* out_count,
+                                                         int64_t* out_end_version) {
+	return fdb_future_get_change_feed_mutations(future_, out_mutations, out_count, out_end_version);
+}
+
 // Result
 
 Result::~Result() {
@@ -136,6 +150,46 @@ EmptyFuture Database::create_snapshot(FDBDatabase* db,
 	return EmptyFuture(fdb_database_create_snapshot(db, uid, uid_length, snap_command, snap_command_length));
 }
 
+EmptyFuture Database::create_change_feed(FDBDatabase* db,
+                                         std::string_view feed_id,
+                                         std::string_view begin_key,
+                                         std::string_view end_key) {
+	return EmptyFuture(fdb_database_create_change_feed(db,
+	                                                   (const uint8_t*)feed_id.data(),
+	                                                   feed_id.size(),
+	                                                   (const uint8_t*)begin_key.data(),
+	                                                   begin_key.size(),
+	                                                   (const uint8_t*)end_key.data(),
+	                                                   end_key.size()));
+}
+
+EmptyFuture Database::destroy_change_feed(FDBDatabase* db, std::string_view feed_id) {
+	return EmptyFuture(fdb_database_destroy_change_feed(db, (const uint8_t*)feed_id.data(), feed_id.size()));
+}
+
+EmptyFuture Database::pop_change_feed(FDBDatabase* db, std::string_view feed_id, int64_t version) {
+	return EmptyFuture(fdb_database_pop_change_feed(db, (const uint8_t*)feed_id.data(), feed_id.size(), version));
+}
+
+ChangeFeedMutationsFuture Database::read_change_feed(FDBDatabase* db,
+                                                     std::string_view feed_id,
+                                                     int64_t begin_version,
+                                                     int64_t end_version,
+                                                     std::string_view begin_key,
+                                                     std::string_view end_key,
+                                                     int target_bytes) {
+	return ChangeFeedMutationsFuture(fdb_database_read_change_feed(db,
+	                                                               (const uint8_t*)feed_id.data(),
+	                                                               feed_id.size(),
+	                                                               begin_version,
+	                                                               end_version,
+	                                                               (const uint8_t*)begin_key.data(),
+	                                                               begin_key.size(),
+	                                                               (const uint8_t*)end_key.data(),
+	                                                               end_key.size(),
+	                                                               target_bytes));
+}
+
 // Transaction
 Transaction::Transaction(FDBDatabase* db) {
 	if (fdb_error_t err = fdb_database_create_transaction(db, &tr_)) {
@@ -188,6 +242,15 @@ ValueFuture Transaction::get(std::string_view key, fdb_bool_t snapshot) {
 	return ValueFuture(fdb_transaction_get(tr_, (const uint8_t*)key.data(), key.size(), snapshot));
 }
 
+OptionalValueArrayFuture Transaction::get_values(const std::vector<std::string_view>& keys, fdb_bool_t snapshot) {
+	std::vector<FDBKey> fdbKeys;
+	fdbKeys.reserve(keys.size());
+	for (const auto& key : keys) {
+		fdbKeys.push_back(FDBKey{ (const uint8_t*)key.data(), (int)key.size() });
+	}
+	return OptionalValueArrayFuture(fdb_transaction_get_values(tr_, fdbKeys.data(), fdbKeys.size(), snapshot));
+}
+
 KeyFuture Transaction::get_key(const uint8_t* key_name,
                                int key_name_length,
                                fdb_bool_t or_equal,
@@ -44,6 +44,7 @@
 
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace fdb {
 
@@ -172,6 +173,30 @@ private:
 	KeyRangeArrayFuture(FDBFuture* f) : Future(f) {}
 };
 
+class OptionalValueArrayFuture : public Future {
+public:
+	// Call this function instead of fdb_future_get_optional_value_array when
+	// using the OptionalValueArrayFuture type. Its behavior is identical to
+	// fdb_future_get_optional_value_array.
+	fdb_error_t get(const FDBOptionalValue** out_values, int* out_count);
+
+private:
+	friend class Transaction;
+	OptionalValueArrayFuture(FDBFuture* f) : Future(f) {}
+};
+
+class ChangeFeedMutationsFuture : public Future {
+public:
+	// Call this function instead of fdb_future_get_change_feed_mutations when
+	// using the ChangeFeedMutationsFuture type. Its behavior is identical to
+	// fdb_future_get_change_feed_mutations.
+	fdb_error_t get(const FDBChangeFeedMutation** out_mutations, int* out_count, int64_t* out_end_version);
+
+private:
+	friend class Database;
+	ChangeFeedMutationsFuture(FDBFuture* f) : Future(f) {}
+};
+
 class EmptyFuture : public Future {
 private:
 	friend class Transaction;
@@ -214,6 +239,19 @@ public:
 	                                   int uid_length,
 	                                   const uint8_t* snap_command,
 	                                   int snap_command_length);
+	static EmptyFuture create_change_feed(FDBDatabase* db,
+	                                      std::string_view feed_id,
+	                                      std::string_view begin_key,
+	                                      std::string_view end_key);
+	static EmptyFuture destroy_change_feed(FDBDatabase* db, std::string_view feed_id);
+	static EmptyFuture pop_change_feed(FDBDatabase* db, std::string_view feed_id, int64_t version);
+	static ChangeFeedMutationsFuture read_change_feed(FDBDatabase* db,
+	                                                  std::string_view feed_id,
+	                                                  int64_t begin_version,
+	                                                  int64_t end_version,
+	                                                  std::string_view begin_key,
+	                                                  std::string_view end_key,
+	                                                  int target_bytes);
 };
 
 // Wrapper around FDBTransaction, providing the same set of calls as the C API.
@@ -256,6 +294,10 @@ public:
 	// Returns a future which will be set to the value of `key` in the database.
 	ValueFuture get(std::string_view key, fdb_bool_t snapshot);
 
+	// Returns a future which will be set to the values of `keys` in the
+	// database, in the order of `keys`.
+	OptionalValueArrayFuture get_values(const std::vector<std::string_view>& keys, fdb_bool_t snapshot);
+
 	// Returns a future which will be set to the key in the database matching the
 	// passed key selector.
 	KeyFuture get_key(const uint8_t* key_name,
@@ -520,6 +520,39 @@ TEST_CASE("fdb_future_get_value") {
 	}
 }
 
+TEST_CASE("fdb_transaction_get_values") {
+	insert_data(db, create_data({ { "a", "1" }, { "b", "2" }, { "c", "3" } }));
+
+	fdb::Transaction tr(db);
+	// Unsorted, repeated and missing keys all come back in request order
+	std::vector<std::string> keys = { key("c"), key("missing"), key("a"), key("c") };
+	std::vector<std::string_view> keyViews(keys.begin(), keys.end());
+	while (1) {
+		fdb::OptionalValueArrayFuture f1 = tr.get_values(keyViews, /* snapshot */ false);
+
+		fdb_error_t err = wait_future(f1);
+		if (err) {
+			fdb::EmptyFuture f2 = tr.on_error(err);
+			fdb_check(wait_future(f2));
+			continue;
+		}
+
+		const FDBOptionalValue* values;
+		int count;
+		fdb_check(f1.get(&values, &count));
+
+		CHECK(count == 4);
+		CHECK(values[0].present);
+		CHECK(std::string((const char*)values[0].value, values[0].value_length) == "3");
+		CHECK(!values[1].present);
+		CHECK(values[2].present);
+		CHECK(std::string((const char*)values[2].value, values[2].value_length) == "1");
+		CHECK(values[3].present);
+		CHECK(std::string((const char*)values[3].value, values[3].value_length) == "3");
+		break;
+	}
+}
+
 TEST_CASE("fdb_future_get_string_array") {
 	insert_data(db, create_data({ { "foo", "bar" } }));
 
@@ -2429,6 +2462,71 @@ TEST_CASE("fdb_database_create_snapshot") {
 	}
 }
 
+TEST_CASE("fdb_database_change_feed") {
+	std::string feed_id = key("change_feed");
+	std::string begin_key = key("cf/");
+	std::string end_key = key("cf0");
+	fdb::EmptyFuture create = fdb::Database::create_change_feed(db, feed_id, begin_key, end_key);
+	fdb_check(wait_future(create));
+
+	int64_t set_version;
+	int64_t clear_version;
+	fdb::Transaction tr(db);
+	while (1) {
+		tr.set(key("cf/a"), "1");
+		tr.set(key("cf1"), "outside");
+		fdb::EmptyFuture f1 = tr.commit();
+		fdb_error_t err = wait_future(f1);
+		if (err) {
+			fdb::EmptyFuture f2 = tr.on_error(err);
+			fdb_check(wait_future(f2));
+			continue;
+		}
+		fdb_check(tr.get_committed_version(&set_version));
+		break;
+	}
+	tr.reset();
+	while (1) {
+		tr.clear(key("cf/a"));
+		fdb::EmptyFuture f1 = tr.commit();
+		fdb_error_t err = wait_future(f1);
+		if (err) {
+			fdb::EmptyFuture f2 = tr.on_error(err);
+			fdb_check(wait_future(f2));
+			continue;
+		}
+		fdb_check(tr.get_committed_version(&clear_version));
+		break;
+	}
+
+	std::vector<std::pair<int64_t, int>> mutations;
+	int64_t begin_version = 0;
+	while (begin_version <= clear_version) {
+		fdb::ChangeFeedMutationsFuture f =
+		    fdb::Database::read_change_feed(db, feed_id, begin_version, clear_version + 1, begin_key, end_key, 1e6);
+		fdb_check(wait_future(f));
+		const FDBChangeFeedMutation* out_mutations;
+		int out_count;
+		int64_t out_end_version;
+		fdb_check(f.get(&out_mutations, &out_count, &out_end_version));
+		for (int i = 0; i < out_count; i++) {
+			CHECK(std::string((const char*)out_mutations[i].param1.key, out_mutations[i].param1.key_length) ==
+			      key("cf/a"));
+			mutations.emplace_back(out_mutations[i].version, out_mutations[i].type);
+		}
+		CHECK(out_end_version >= begin_version);
+		begin_version = out_end_version + 1;
+	}
+	CHECK(mutations.size() == 2);
+	CHECK(mutations[0] == std::make_pair(set_version, (int)FDB_BG_MUTATION_TYPE_SET_VALUE));
+	CHECK(mutations[1] == std::make_pair(clear_version, (int)FDB_BG_MUTATION_TYPE_CLEAR_RANGE));
+
+	fdb::EmptyFuture pop = fdb::Database::pop_change_feed(db, feed_id, clear_version + 1);
+	fdb_check(wait_future(pop));
+	fdb::EmptyFuture destroy = fdb::Database::destroy_change_feed(db, feed_id);
+	fdb_check(wait_future(destroy));
+}
+
 TEST_CASE("fdb_error_predicate") {
 	CHECK(fdb_error_predicate(FDB_ERROR_PREDICATE_RETRYABLE, 1007)); // transaction_too_old
 	CHECK(fdb_error_predicate(FDB_ERROR_PREDICATE_RETRYABLE, 1020)); // not_committed
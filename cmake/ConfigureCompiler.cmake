@@ -110,6 +110,15 @@ if(NOT WIN32)
   if (NOT HAS_C11_ATOMICS)
     message(FATAL_ERROR "C compiler does not support c11 atomics")
   endif()
+  # AsyncFileIOUring is only built against kernel headers which have the io_uring operations it uses
+  include(CheckCSourceCompiles)
+  check_c_source_compiles("
+#include <linux/io_uring.h>
+int main() { return IORING_OP_READ + IORING_OP_WRITE + IORING_REGISTER_FILES_UPDATE + IOSQE_IO_DRAIN; }"
+    HAS_IO_URING)
+  if (HAS_IO_URING)
+    add_compile_definitions(HAVE_IO_URING)
+  endif()
 endif()
 
 if(WIN32)
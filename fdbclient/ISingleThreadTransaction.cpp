@@ -56,3 +56,13 @@ Reference<ISingleThreadTransaction> ISingleThreadTransaction::create(Type type,
 	result->construct(cx);
 	return result;
 }
+
+Future<std::vector<Optional<Value>>> ISingleThreadTransaction::getValues(const Standalone<VectorRef<KeyRef>>& keys,
+                                                                        Snapshot snapshot) {
+	std::vector<Future<Optional<Value>>> reads;
+	reads.reserve(keys.size());
+	for (const KeyRef& key : keys) {
+		reads.push_back(get(Key(key, keys.arena()), snapshot));
+	}
+	return getAll(reads);
+}
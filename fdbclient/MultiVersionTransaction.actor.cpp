@@ -102,6 +102,26 @@ ThreadFuture<Optional<Value>> DLTransaction::get(const KeyRef& key, bool snapsho
 	});
 }
 
+ThreadFuture<Standalone<VectorRef<OptionalValueRef>>> DLTransaction::getValues(const VectorRef<KeyRef>& keys,
+                                                                             bool snapshot) {
+	if (!api->transactionGetValues) {
+		return unsupported_operation();
+	}
+	FdbCApi::FDBFuture* f =
+	    api->transactionGetValues(tr, (const FdbCApi::FDBKey*)keys.begin(), keys.size(), snapshot);
+
+	return toThreadFuture<Standalone<VectorRef<OptionalValueRef>>>(api, f, [](FdbCApi::FDBFuture* f, FdbCApi* api) {
+		const FdbCApi::FDBOptionalValue* values;
+		int count;
+		FdbCApi::fdb_error_t error = api->futureGetOptionalValueArray(f, &values, &count);
+		ASSERT(!error);
+
+		// The memory for this is stored in the FDBFuture and is released when the future gets destroyed
+		return Standalone<VectorRef<OptionalValueRef>>(VectorRef<OptionalValueRef>((OptionalValueRef*)values, count),
+		                                               Arena());
+	});
+}
+
 ThreadFuture<Key> DLTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	FdbCApi::FDBFuture* f =
 	    api->transactionGetKey(tr, key.getKey().begin(), key.getKey().size(), key.orEqual, key.offset, snapshot);
@@ -455,6 +475,74 @@ ThreadFuture<Void> DLDatabase::createSnapshot(const StringRef& uid, const String
 	return toThreadFuture<Void>(api, f, [](FdbCApi::FDBFuture* f, FdbCApi* api) { return Void(); });
 }
 
+ThreadFuture<Void> DLDatabase::createChangeFeed(const KeyRef& feedID, const KeyRangeRef& range) {
+	if (!api->databaseCreateChangeFeed) {
+		return unsupported_operation();
+	}
+
+	FdbCApi::FDBFuture* f = api->databaseCreateChangeFeed(db,
+	                                                      feedID.begin(),
+	                                                      feedID.size(),
+	                                                      range.begin.begin(),
+	                                                      range.begin.size(),
+	                                                      range.end.begin(),
+	                                                      range.end.size());
+	return toThreadFuture<Void>(api, f, [](FdbCApi::FDBFuture* f, FdbCApi* api) { return Void(); });
+}
+
+ThreadFuture<Void> DLDatabase::destroyChangeFeed(const KeyRef& feedID) {
+	if (!api->databaseDestroyChangeFeed) {
+		return unsupported_operation();
+	}
+
+	FdbCApi::FDBFuture* f = api->databaseDestroyChangeFeed(db, feedID.begin(), feedID.size());
+	return toThreadFuture<Void>(api, f, [](FdbCApi::FDBFuture* f, FdbCApi* api) { return Void(); });
+}
+
+ThreadFuture<Void> DLDatabase::popChangeFeed(const KeyRef& feedID, Version version) {
+	if (!api->databasePopChangeFeed) {
+		return unsupported_operation();
+	}
+
+	FdbCApi::FDBFuture* f = api->databasePopChangeFeed(db, feedID.begin(), feedID.size(), version);
+	return toThreadFuture<Void>(api, f, [](FdbCApi::FDBFuture* f, FdbCApi* api) { return Void(); });
+}
+
+ThreadFuture<ChangeFeedReadResult> DLDatabase::readChangeFeed(const KeyRef& feedID,
+                                                              Version begin,
+                                                              Version end,
+                                                              const KeyRangeRef& range,
+                                                              int targetBytes) {
+	if (!api->databaseReadChangeFeed) {
+		return unsupported_operation();
+	}
+
+	FdbCApi::FDBFuture* f = api->databaseReadChangeFeed(db,
+	                                                    feedID.begin(),
+	                                                    feedID.size(),
+	                                                    begin,
+	                                                    end,
+	                                                    range.begin.begin(),
+	                                                    range.begin.size(),
+	                                                    range.end.begin(),
+	                                                    range.end.size(),
+	                                                    targetBytes);
+	return toThreadFuture<ChangeFeedReadResult>(api, f, [](FdbCApi::FDBFuture* f, FdbCApi* api) {
+		const FdbCApi::FDBChangeFeedMutation* mutations;
+		int count;
+		int64_t endVersion;
+		FdbCApi::fdb_error_t error = api->futureGetChangeFeedMutations(f, &mutations, &count, &endVersion);
+		ASSERT(!error);
+
+		ChangeFeedReadResult result;
+		result.endVersion = endVersion;
+		// The memory for this is stored in the FDBFuture and is released when the future gets destroyed
+		result.mutations = Standalone<VectorRef<ChangeFeedMutationRef>>(
+		    VectorRef<ChangeFeedMutationRef>((ChangeFeedMutationRef*)mutations, count), Arena());
+		return result;
+	});
+}
+
 ThreadFuture<DatabaseSharedState*> DLDatabase::createSharedState() {
 	if (!api->databaseCreateSharedState) {
 		return unsupported_operation();
@@ -598,6 +686,26 @@ void DLApi::init() {
 	                   headerVersion >= 700);
 	loadClientFunction(
 	    &api->databaseCreateSnapshot, lib, fdbCPath, "fdb_database_create_snapshot", headerVersion >= 700);
+	loadClientFunction(&api->databaseCreateChangeFeed,
+	                   lib,
+	                   fdbCPath,
+	                   "fdb_database_create_change_feed",
+	                   headerVersion >= ApiVersion::withChangeFeedApi().version());
+	loadClientFunction(&api->databaseDestroyChangeFeed,
+	                   lib,
+	                   fdbCPath,
+	                   "fdb_database_destroy_change_feed",
+	                   headerVersion >= ApiVersion::withChangeFeedApi().version());
+	loadClientFunction(&api->databasePopChangeFeed,
+	                   lib,
+	                   fdbCPath,
+	                   "fdb_database_pop_change_feed",
+	                   headerVersion >= ApiVersion::withChangeFeedApi().version());
+	loadClientFunction(&api->databaseReadChangeFeed,
+	                   lib,
+	                   fdbCPath,
+	                   "fdb_database_read_change_feed",
+	                   headerVersion >= ApiVersion::withChangeFeedApi().version());
 	loadClientFunction(&api->databaseGetClientStatus,
 	                   lib,
 	                   fdbCPath,
@@ -611,6 +719,11 @@ void DLApi::init() {
 	loadClientFunction(
 	    &api->transactionGetReadVersion, lib, fdbCPath, "fdb_transaction_get_read_version", headerVersion >= 0);
 	loadClientFunction(&api->transactionGet, lib, fdbCPath, "fdb_transaction_get", headerVersion >= 0);
+	loadClientFunction(&api->transactionGetValues,
+	                   lib,
+	                   fdbCPath,
+	                   "fdb_transaction_get_values",
+	                   headerVersion >= ApiVersion::withMultiGet().version());
 	loadClientFunction(&api->transactionGetKey, lib, fdbCPath, "fdb_transaction_get_key", headerVersion >= 0);
 	loadClientFunction(&api->transactionGetAddressesForKey,
 	                   lib,
@@ -691,6 +804,16 @@ void DLApi::init() {
 	    &api->futureGetKeyValueArray, lib, fdbCPath, "fdb_future_get_keyvalue_array", headerVersion >= 0);
 	loadClientFunction(
 	    &api->futureGetMappedKeyValueArray, lib, fdbCPath, "fdb_future_get_mappedkeyvalue_array", headerVersion >= 710);
+	loadClientFunction(&api->futureGetOptionalValueArray,
+	                   lib,
+	                   fdbCPath,
+	                   "fdb_future_get_optional_value_array",
+	                   headerVersion >= ApiVersion::withMultiGet().version());
+	loadClientFunction(&api->futureGetChangeFeedMutations,
+	                   lib,
+	                   fdbCPath,
+	                   "fdb_future_get_change_feed_mutations",
+	                   headerVersion >= ApiVersion::withChangeFeedApi().version());
 	loadClientFunction(&api->futureGetSharedState, lib, fdbCPath, "fdb_future_get_shared_state", headerVersion >= 710);
 	loadClientFunction(&api->futureSetCallback, lib, fdbCPath, "fdb_future_set_callback", headerVersion >= 0);
 	loadClientFunction(&api->futureCancel, lib, fdbCPath, "fdb_future_cancel", headerVersion >= 0);
@@ -935,6 +1058,11 @@ ThreadFuture<Optional<Value>> MultiVersionTransaction::get(const KeyRef& key, bo
 	return executeOperation(&ITransaction::get, key, std::forward<bool>(snapshot));
 }
 
+ThreadFuture<Standalone<VectorRef<OptionalValueRef>>> MultiVersionTransaction::getValues(const VectorRef<KeyRef>& keys,
+                                                                                       bool snapshot) {
+	return executeOperation(&ITransaction::getValues, keys, std::forward<bool>(snapshot));
+}
+
 ThreadFuture<Key> MultiVersionTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	return executeOperation(&ITransaction::getKey, key, std::forward<bool>(snapshot));
 }
@@ -1444,6 +1572,31 @@ ThreadFuture<Void> MultiVersionDatabase::createSnapshot(const StringRef& uid, co
 	return executeOperation(&IDatabase::createSnapshot, uid, snapshot_command);
 }
 
+ThreadFuture<Void> MultiVersionDatabase::createChangeFeed(const KeyRef& feedID, const KeyRangeRef& range) {
+	return executeOperation(&IDatabase::createChangeFeed, feedID, range);
+}
+
+ThreadFuture<Void> MultiVersionDatabase::destroyChangeFeed(const KeyRef& feedID) {
+	return executeOperation(&IDatabase::destroyChangeFeed, feedID);
+}
+
+ThreadFuture<Void> MultiVersionDatabase::popChangeFeed(const KeyRef& feedID, Version version) {
+	return executeOperation(&IDatabase::popChangeFeed, feedID, std::forward<Version>(version));
+}
+
+ThreadFuture<ChangeFeedReadResult> MultiVersionDatabase::readChangeFeed(const KeyRef& feedID,
+                                                                        Version begin,
+                                                                        Version end,
+                                                                        const KeyRangeRef& range,
+                                                                        int targetBytes) {
+	return executeOperation(&IDatabase::readChangeFeed,
+	                        feedID,
+	                        std::forward<Version>(begin),
+	                        std::forward<Version>(end),
+	                        range,
+	                        std::forward<int>(targetBytes));
+}
+
 ThreadFuture<DatabaseSharedState*> MultiVersionDatabase::createSharedState() {
 	return executeOperation(&IDatabase::createSharedState);
 }
@@ -1835,6 +1988,82 @@ Standalone<StringRef> MultiVersionDatabase::DatabaseState::getClientStatus(
 	return StringRef(json_spirit::write_string(json_spirit::mValue(statusObj)));
 }
 
+// ShardedMultiVersionDatabase
+ShardedMultiVersionDatabase::ShardedMultiVersionDatabase(std::vector<Reference<IDatabase>> shards)
+  : shards(std::move(shards)), nextShard(0) {
+	ASSERT(!this->shards.empty());
+}
+
+Reference<ITransaction> ShardedMultiVersionDatabase::createTransaction() {
+	// Transactions are independent of each other, so they are assigned round-robin to keep the client threads evenly
+	// loaded regardless of which application thread creates them.
+	return shards[nextShard.fetch_add(1, std::memory_order_relaxed) % shards.size()]->createTransaction();
+}
+
+void ShardedMultiVersionDatabase::setOption(FDBDatabaseOptions::Option option, Optional<StringRef> value) {
+	for (auto& shard : shards) {
+		shard->setOption(option, value);
+	}
+}
+
+double ShardedMultiVersionDatabase::getMainThreadBusyness() {
+	double busyness = 0;
+	for (auto& shard : shards) {
+		busyness += shard->getMainThreadBusyness();
+	}
+	return busyness / shards.size();
+}
+
+ThreadFuture<ProtocolVersion> ShardedMultiVersionDatabase::getServerProtocol(
+    Optional<ProtocolVersion> expectedVersion) {
+	return shards[0]->getServerProtocol(expectedVersion);
+}
+
+ThreadFuture<int64_t> ShardedMultiVersionDatabase::rebootWorker(const StringRef& address, bool check, int duration) {
+	return shards[0]->rebootWorker(address, check, duration);
+}
+
+ThreadFuture<Void> ShardedMultiVersionDatabase::forceRecoveryWithDataLoss(const StringRef& dcid) {
+	return shards[0]->forceRecoveryWithDataLoss(dcid);
+}
+
+ThreadFuture<Void> ShardedMultiVersionDatabase::createSnapshot(const StringRef& uid,
+                                                               const StringRef& snapshot_command) {
+	return shards[0]->createSnapshot(uid, snapshot_command);
+}
+
+ThreadFuture<Void> ShardedMultiVersionDatabase::createChangeFeed(const KeyRef& feedID, const KeyRangeRef& range) {
+	return shards[0]->createChangeFeed(feedID, range);
+}
+
+ThreadFuture<Void> ShardedMultiVersionDatabase::destroyChangeFeed(const KeyRef& feedID) {
+	return shards[0]->destroyChangeFeed(feedID);
+}
+
+ThreadFuture<Void> ShardedMultiVersionDatabase::popChangeFeed(const KeyRef& feedID, Version version) {
+	return shards[0]->popChangeFeed(feedID, version);
+}
+
+ThreadFuture<ChangeFeedReadResult> ShardedMultiVersionDatabase::readChangeFeed(const KeyRef& feedID,
+                                                                               Version begin,
+                                                                               Version end,
+                                                                               const KeyRangeRef& range,
+                                                                               int targetBytes) {
+	return shards[0]->readChangeFeed(feedID, begin, end, range, targetBytes);
+}
+
+ThreadFuture<DatabaseSharedState*> ShardedMultiVersionDatabase::createSharedState() {
+	return shards[0]->createSharedState();
+}
+
+void ShardedMultiVersionDatabase::setSharedState(DatabaseSharedState* p) {
+	shards[0]->setSharedState(p);
+}
+
+ThreadFuture<Standalone<StringRef>> ShardedMultiVersionDatabase::getClientStatus() {
+	return shards[0]->getClientStatus();
+}
+
 // MultiVersionApi
 void MultiVersionApi::runOnExternalClientsAllThreads(std::function<void(Reference<ClientInfo>)> func,
                                                      bool runOnFailedClients,
@@ -2162,6 +2391,13 @@ void MultiVersionApi::setNetworkOptionInternal(FDBNetworkOptions::Option option,
 		// multiple client threads are not supported on windows.
 		threadCount = extractIntOption(value, 1, 1);
 #endif
+	} else if (option == FDBNetworkOptions::CLIENT_THREADS_SHARD_DATABASES) {
+		MutexHolder holder(lock);
+		validateOption(value, false, true);
+		if (networkStartSetup) {
+			throw invalid_option();
+		}
+		shardDatabasesAcrossThreads = true;
 	} else if (option == FDBNetworkOptions::CLIENT_TMP_DIR) {
 		validateOption(value, true, false, false);
 		tmpDir = abspath(value.get().toString());
@@ -2431,6 +2667,18 @@ Reference<IDatabase> MultiVersionApi::createDatabase(ClusterConnectionRecord con
 	if (localClientDisabled) {
 		ASSERT(!bypassMultiClientApi);
 
+		if (shardDatabasesAcrossThreads && threadCount > 1) {
+			lock.leave();
+
+			std::vector<Reference<IDatabase>> shards;
+			for (int threadIdx = 0; threadIdx < threadCount; threadIdx++) {
+				Reference<IDatabase> localDb = connectionRecord.createDatabase(localClient->api);
+				shards.push_back(Reference<IDatabase>(
+				    new MultiVersionDatabase(this, threadIdx, connectionRecord, Reference<IDatabase>(), localDb)));
+			}
+			return Reference<IDatabase>(new ShardedMultiVersionDatabase(std::move(shards)));
+		}
+
 		int threadIdx = nextThread;
 		nextThread = (nextThread + 1) % threadCount;
 		lock.leave();
@@ -2653,8 +2901,9 @@ void MultiVersionApi::loadEnvironmentVariableNetworkOptions() {
 MultiVersionApi::MultiVersionApi()
   : callbackOnMainThread(true), localClientDisabled(false), networkStartSetup(false), networkSetup(false),
     disableBypass(false), bypassMultiClientApi(false), externalClient(false), ignoreExternalClientFailures(false),
-    failIncompatibleClient(false), retainClientLibCopies(false), apiVersion(0), threadCount(0), tmpDir("/tmp"),
-    traceShareBaseNameAmongThreads(false), envOptionsLoaded(false) {}
+    failIncompatibleClient(false), retainClientLibCopies(false), apiVersion(0), threadCount(0),
+    shardDatabasesAcrossThreads(false), tmpDir("/tmp"), traceShareBaseNameAmongThreads(false),
+    envOptionsLoaded(false) {}
 
 MultiVersionApi* MultiVersionApi::api = new MultiVersionApi();
 
@@ -2733,6 +2982,116 @@ TEST_CASE("/fdbclient/multiversionclient/EnvironmentVariableParsing") {
 	return Void();
 }
 
+namespace {
+
+// An IDatabase that counts the calls a ShardedMultiVersionDatabase makes to it
+class CountingDatabase final : public IDatabase, ThreadSafeReferenceCounted<CountingDatabase> {
+public:
+	explicit CountingDatabase(double busyness) : busyness(busyness) {}
+
+	Reference<ITransaction> createTransaction() override {
+		++transactions;
+		return Reference<ITransaction>();
+	}
+	void setOption(FDBDatabaseOptions::Option option, Optional<StringRef> value) override { ++options; }
+	double getMainThreadBusyness() override { return busyness; }
+
+	ThreadFuture<ProtocolVersion> getServerProtocol(Optional<ProtocolVersion> expectedVersion) override {
+		++managementCalls;
+		return ThreadFuture<ProtocolVersion>();
+	}
+
+	void addref() override { ThreadSafeReferenceCounted<CountingDatabase>::addref(); }
+	void delref() override { ThreadSafeReferenceCounted<CountingDatabase>::delref(); }
+
+	ThreadFuture<int64_t> rebootWorker(const StringRef& address, bool check, int duration) override {
+		++managementCalls;
+		return ThreadFuture<int64_t>();
+	}
+	ThreadFuture<Void> forceRecoveryWithDataLoss(const StringRef& dcid) override {
+		++managementCalls;
+		return ThreadFuture<Void>();
+	}
+	ThreadFuture<Void> createSnapshot(const StringRef& uid, const StringRef& snapshot_command) override {
+		++managementCalls;
+		return ThreadFuture<Void>();
+	}
+	ThreadFuture<Void> createChangeFeed(const KeyRef& feedID, const KeyRangeRef& range) override {
+		++managementCalls;
+		return ThreadFuture<Void>();
+	}
+	ThreadFuture<Void> destroyChangeFeed(const KeyRef& feedID) override {
+		++managementCalls;
+		return ThreadFuture<Void>();
+	}
+	ThreadFuture<Void> popChangeFeed(const KeyRef& feedID, Version version) override {
+		++managementCalls;
+		return ThreadFuture<Void>();
+	}
+	ThreadFuture<ChangeFeedReadResult> readChangeFeed(const KeyRef& feedID,
+	                                                  Version begin,
+	                                                  Version end,
+	                                                  const KeyRangeRef& range,
+	                                                  int targetBytes) override {
+		++managementCalls;
+		return ThreadFuture<ChangeFeedReadResult>();
+	}
+
+	ThreadFuture<DatabaseSharedState*> createSharedState() override {
+		++managementCalls;
+		return ThreadFuture<DatabaseSharedState*>();
+	}
+	void setSharedState(DatabaseSharedState* p) override { ++managementCalls; }
+
+	ThreadFuture<Standalone<StringRef>> getClientStatus() override {
+		++managementCalls;
+		return ThreadFuture<Standalone<StringRef>>();
+	}
+
+	int transactions = 0;
+	int options = 0;
+	int managementCalls = 0;
+	double busyness;
+};
+
+} // namespace
+
+TEST_CASE("/fdbclient/multiversionclient/ShardedMultiVersionDatabase") {
+	std::vector<Reference<CountingDatabase>> counting;
+	std::vector<Reference<IDatabase>> shards;
+	for (int i = 0; i < 3; ++i) {
+		counting.push_back(makeReference<CountingDatabase>(i));
+		shards.push_back(counting.back());
+	}
+	Reference<IDatabase> db = makeReference<ShardedMultiVersionDatabase>(shards);
+
+	// Transactions are spread round-robin
+	for (int i = 0; i < 7; ++i) {
+		db->createTransaction();
+	}
+	ASSERT_EQ(counting[0]->transactions, 3);
+	ASSERT_EQ(counting[1]->transactions, 2);
+	ASSERT_EQ(counting[2]->transactions, 2);
+
+	// Options apply to every shard, busyness is the average of the shards
+	db->setOption(FDBDatabaseOptions::LOCATION_CACHE_SIZE, "1000"_sr);
+	for (auto& shard : counting) {
+		ASSERT_EQ(shard->options, 1);
+	}
+	ASSERT_EQ(db->getMainThreadBusyness(), 1.0);
+
+	// Everything else is served by the first shard
+	db->getServerProtocol();
+	db->rebootWorker("127.0.0.1:4500"_sr, false, 0);
+	db->createChangeFeed("feed"_sr, allKeys);
+	db->getClientStatus();
+	ASSERT_EQ(counting[0]->managementCalls, 4);
+	ASSERT_EQ(counting[1]->managementCalls, 0);
+	ASSERT_EQ(counting[2]->managementCalls, 0);
+
+	return Void();
+}
+
 class ValidateFuture final : public ThreadCallback {
 public:
 	ValidateFuture(ThreadFuture<int> f, ErrorOr<int> expectedValue, std::set<int> legalErrors)
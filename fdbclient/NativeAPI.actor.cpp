@@ -25,6 +25,7 @@
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <queue>
 #include <regex>
 #include <string>
 #include <unordered_set>
@@ -1740,6 +1741,163 @@ ACTOR Future<Optional<Value>> getValue(Reference<TransactionState> trState,
 	}
 }
 
+ACTOR Future<std::vector<Optional<Value>>> getValues(Reference<TransactionState> trState,
+                                                     Standalone<VectorRef<KeyRef>> keys,
+                                                     SpanContext spanContext);
+
+// Reads keys, which all belong to the shard served by locationInfo, with one request. If the shard has moved the keys
+// are grouped again by their new locations.
+ACTOR Future<std::vector<Optional<Value>>> getValuesBatch(Reference<TransactionState> trState,
+                                                          Standalone<VectorRef<KeyRef>> keys,
+                                                          KeyRangeLocationInfo locationInfo,
+                                                          SpanContext spanContext) {
+	state Optional<ReadOptions> readOptions = trState->readOptions;
+	state VersionVector ssLatestCommitVersions;
+	state double startTimeD = now();
+	trState->cx->getLatestCommitVersions(locationInfo.locations, trState, ssLatestCommitVersions);
+
+	try {
+		GetValuesRequest req;
+		req.spanContext = spanContext;
+		req.arena = keys.arena();
+		req.keys = keys;
+		req.version = trState->readVersion();
+		req.tags = trState->cx->sampleReadTags() ? trState->options.readTags : Optional<TagSet>();
+		req.options = readOptions;
+		req.ssLatestCommitVersions = ssLatestCommitVersions;
+
+		++trState->cx->transactionPhysicalReads;
+		state GetValuesReply reply;
+		try {
+			if (CLIENT_BUGGIFY_WITH_PROB(.01)) {
+				throw deterministicRandom()->randomChoice(
+				    std::vector<Error>{ transaction_too_old(), future_version(), wrong_shard_server() });
+			}
+			choose {
+				when(wait(trState->cx->connectionFileChanged())) {
+					throw transaction_too_old();
+				}
+				when(GetValuesReply _reply =
+				         wait(loadBalance(trState->cx.getPtr(),
+				                          locationInfo.locations,
+				                          &StorageServerInterface::getValues,
+				                          req,
+				                          TaskPriority::DefaultPromiseEndpoint,
+				                          AtMostOnce::False,
+				                          trState->cx->enableLocalityLoadBalance ? &trState->cx->queueModel : nullptr,
+				                          trState->options.enableReplicaConsistencyCheck,
+				                          trState->options.requiredReplicas))) {
+					reply = _reply;
+				}
+			}
+			++trState->cx->transactionPhysicalReadsCompleted;
+		} catch (Error&) {
+			++trState->cx->transactionPhysicalReadsCompleted;
+			throw;
+		}
+
+		trState->cx->readLatencies.addSample(now() - startTimeD);
+
+		// Both the keys and the reply are in key order, so one pass matches them up
+		std::vector<Optional<Value>> values(keys.size());
+		int64_t bytes = 0;
+		int k = 0;
+		for (const KeyValueRef& kv : reply.data) {
+			while (k < keys.size() && keys[k] < kv.key) {
+				bytes += keys[k++].size();
+			}
+			if (k == keys.size() || keys[k] != kv.key) {
+				// A reply with a key that wasn't requested, or out of order, is a storage server bug.  Reading the
+				// keys again, from fresh locations, lets the load balancer pick another replica.
+				TraceEvent(SevError, "GetValuesUnexpectedKey")
+				    .detail("Key", kv.key)
+				    .detail("Keys", keys.size())
+				    .detail("Replies", reply.data.size());
+				throw wrong_shard_server();
+			}
+			values[k++] = Value(kv.value, reply.arena);
+			bytes += kv.expectedSize();
+		}
+		for (; k < keys.size(); ++k) {
+			bytes += keys[k].size();
+		}
+		trState->totalCost += getReadOperationCost(bytes);
+		trState->cx->transactionBytesRead += reply.data.expectedSize();
+		trState->cx->transactionKeysRead += keys.size();
+		return values;
+	} catch (Error& e) {
+		if (e.code() != error_code_wrong_shard_server && e.code() != error_code_all_alternatives_failed) {
+			throw e;
+		}
+		trState->cx->invalidateCache(locationInfo.range);
+		wait(delay(CLIENT_KNOBS->WRONG_SHARD_SERVER_DELAY, trState->taskID));
+		std::vector<Optional<Value>> values = wait(getValues(trState, keys, spanContext));
+		return values;
+	}
+}
+
+// Reads sorted and distinct keys, sending each storage team one request per shard (of at most GET_VALUES_BATCH_KEYS
+// keys) instead of one request per key.
+ACTOR Future<std::vector<Optional<Value>>> getValues(Reference<TransactionState> trState,
+                                                     Standalone<VectorRef<KeyRef>> keys,
+                                                     SpanContext spanContext) {
+	state std::vector<Future<std::vector<Optional<Value>>>> batches;
+	state int begin = 0;
+	while (begin < keys.size()) {
+		state KeyRangeLocationInfo locationInfo =
+		    wait(getKeyLocation(trState, keys[begin], &StorageServerInterface::getValues, Reverse::False));
+		int end = std::lower_bound(keys.begin() + begin, keys.end(), locationInfo.range.end) - keys.begin();
+		end = std::min(end, begin + CLIENT_KNOBS->GET_VALUES_BATCH_KEYS);
+		ASSERT(end > begin);
+
+		Standalone<VectorRef<KeyRef>> batch(keys.slice(begin, end), keys.arena());
+		batches.push_back(getValuesBatch(trState, batch, locationInfo, spanContext));
+		begin = end;
+	}
+
+	wait(waitForAll(batches));
+
+	std::vector<Optional<Value>> values;
+	values.reserve(keys.size());
+	for (auto& batch : batches) {
+		for (auto& value : batch.get()) {
+			values.push_back(std::move(value));
+		}
+	}
+	return values;
+}
+
+// Reads keys in any order, returning their values in the same order
+ACTOR Future<std::vector<Optional<Value>>> getValuesUnordered(Reference<TransactionState> trState,
+                                                              Standalone<VectorRef<KeyRef>> keys,
+                                                              Standalone<VectorRef<KeyRef>> sortedKeys,
+                                                              std::vector<Future<Optional<Value>>> localReads) {
+	wait(trState->startTransaction());
+
+	state Span span("NAPI:getValues"_loc, trState->spanContext);
+
+	trState->cx->validateVersion(trState->readVersion());
+
+	state std::vector<Optional<Value>> sortedValues;
+	if (!sortedKeys.empty()) {
+		std::vector<Optional<Value>> _sortedValues = wait(getValues(trState, sortedKeys, span.context));
+		sortedValues = std::move(_sortedValues);
+	}
+	wait(waitForAll(localReads));
+
+	std::vector<Optional<Value>> values;
+	values.reserve(keys.size());
+	for (int i = 0; i < keys.size(); ++i) {
+		if (localReads[i].isValid()) {
+			values.push_back(localReads[i].get());
+		} else {
+			int index = std::lower_bound(sortedKeys.begin(), sortedKeys.end(), keys[i]) - sortedKeys.begin();
+			values.push_back(sortedValues[index]);
+		}
+	}
+	return values;
+}
+
 ACTOR Future<Key> getKey(Reference<TransactionState> trState, KeySelector k) {
 	wait(trState->startTransaction());
 
@@ -3532,6 +3690,35 @@ Future<Optional<Value>> Transaction::get(const Key& key, Snapshot snapshot) {
 	return getValue(trState, key);
 }
 
+Future<std::vector<Optional<Value>>> Transaction::getValues(const Standalone<VectorRef<KeyRef>>& keys,
+                                                            Snapshot snapshot) {
+	++trState->cx->transactionGetValuesRequests;
+
+	// Keys which get() answers without a storage server read are read through it, the rest are batched
+	std::vector<Future<Optional<Value>>> localReads(keys.size());
+	Standalone<VectorRef<KeyRef>> sortedKeys;
+	sortedKeys.arena().dependsOn(keys.arena());
+	sortedKeys.reserve(sortedKeys.arena(), keys.size());
+	for (int i = 0; i < keys.size(); ++i) {
+		const KeyRef& key = keys[i];
+		if (key == metadataVersionKey || key.size() > getMaxReadKeySize(key)) {
+			localReads[i] = get(key, snapshot);
+			continue;
+		}
+		++trState->cx->transactionLogicalReads;
+		++trState->cx->transactionGetValueRequests;
+		if (!snapshot) {
+			tr.transaction.read_conflict_ranges.push_back(tr.arena, singleKeyRange(key, tr.arena));
+		}
+		sortedKeys.push_back(sortedKeys.arena(), key);
+	}
+	std::sort(sortedKeys.begin(), sortedKeys.end());
+	sortedKeys.resize(sortedKeys.arena(), std::unique(sortedKeys.begin(), sortedKeys.end()) - sortedKeys.begin());
+
+	getReadVersion();
+	return getValuesUnordered(trState, keys, sortedKeys, localReads);
+}
+
 void Watch::setWatch(Future<Void> watchFuture) {
 	this->watchFuture = watchFuture;
 
@@ -6849,6 +7036,405 @@ Future<Standalone<VectorRef<ReadHotRangeWithMetrics>>> DatabaseContext::getHotRa
 	    Reference<DatabaseContext>::addRef(this), ssi, ReadHotSubRangeRequest(keys, type, splitCount));
 }
 
+ACTOR static Future<Void> createChangeFeedActor(Database cx, Key feedID, KeyRange range) {
+	state Transaction tr(cx);
+	state Key feedKey = changeFeedKeyFor(feedID);
+	if (!normalKeys.contains(range)) {
+		throw key_outside_legal_range();
+	}
+	if (range.empty()) {
+		throw inverted_range();
+	}
+	loop {
+		try {
+			tr.setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+			tr.setOption(FDBTransactionOptions::LOCK_AWARE);
+			Optional<Value> existing = wait(tr.get(feedKey));
+			if (existing.present()) {
+				auto [existingRange, popVersion, status] = decodeChangeFeedValue(existing.get());
+				// Feed IDs are never reused, so a destroyed feed cannot be created again
+				if (status == ChangeFeedStatus::CHANGE_FEED_DESTROY || existingRange != range) {
+					throw client_invalid_operation();
+				}
+				return Void();
+			}
+			tr.set(feedKey, changeFeedValue(range, 0, ChangeFeedStatus::CHANGE_FEED_CREATE));
+			wait(tr.commit());
+			return Void();
+		} catch (Error& e) {
+			wait(tr.onError(e));
+		}
+	}
+}
+
+ACTOR static Future<Void> destroyChangeFeedActor(Database cx, Key feedID) {
+	state Transaction tr(cx);
+	state Key feedKey = changeFeedKeyFor(feedID);
+	loop {
+		try {
+			tr.setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+			tr.setOption(FDBTransactionOptions::LOCK_AWARE);
+			Optional<Value> existing = wait(tr.get(feedKey));
+			if (!existing.present()) {
+				return Void();
+			}
+			auto [range, popVersion, status] = decodeChangeFeedValue(existing.get());
+			if (status == ChangeFeedStatus::CHANGE_FEED_DESTROY) {
+				return Void();
+			}
+			tr.set(feedKey, changeFeedValue(range, popVersion, ChangeFeedStatus::CHANGE_FEED_DESTROY));
+			wait(tr.commit());
+			return Void();
+		} catch (Error& e) {
+			wait(tr.onError(e));
+		}
+	}
+}
+
+ACTOR static Future<Void> popChangeFeedMutationsActor(Database cx, Key feedID, Version version) {
+	state Transaction tr(cx);
+	state Key feedKey = changeFeedKeyFor(feedID);
+	loop {
+		try {
+			tr.setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+			tr.setOption(FDBTransactionOptions::LOCK_AWARE);
+			Optional<Value> existing = wait(tr.get(feedKey));
+			if (!existing.present()) {
+				throw unknown_change_feed();
+			}
+			auto [range, popVersion, status] = decodeChangeFeedValue(existing.get());
+			if (status == ChangeFeedStatus::CHANGE_FEED_DESTROY) {
+				throw unknown_change_feed();
+			}
+			if (version <= popVersion) {
+				return Void();
+			}
+			tr.set(feedKey, changeFeedValue(range, version, status));
+			wait(tr.commit());
+			return Void();
+		} catch (Error& e) {
+			wait(tr.onError(e));
+		}
+	}
+}
+
+ACTOR static Future<bool> isChangeFeedRegistered(Database cx, Key feedID) {
+	state Transaction tr(cx);
+	loop {
+		try {
+			tr.setOption(FDBTransactionOptions::READ_SYSTEM_KEYS);
+			tr.setOption(FDBTransactionOptions::LOCK_AWARE);
+			Optional<Value> existing = wait(tr.get(changeFeedKeyFor(feedID)));
+			return existing.present() &&
+			       std::get<2>(decodeChangeFeedValue(existing.get())) != ChangeFeedStatus::CHANGE_FEED_DESTROY;
+		} catch (Error& e) {
+			wait(tr.onError(e));
+		}
+	}
+}
+
+// Picks a random replica of a shard which the failure monitor does not consider failed
+static Optional<StorageServerInterface> chooseChangeFeedReplica(Reference<LocationInfo> const& locations) {
+	Optional<StorageServerInterface> chosen;
+	int available = 0;
+	for (int i = 0; i < locations->size(); i++) {
+		if (IFailureMonitor::failureMonitor()
+		        .getState(locations->get(i, &StorageServerInterface::changeFeedStream).getEndpoint())
+		        .failed) {
+			continue;
+		}
+		if (deterministicRandom()->random01() * ++available < 1.0) {
+			chosen = locations->getInterface(i);
+		}
+	}
+	return chosen;
+}
+
+// Streams one shard's part of a change feed, one version at a time. Nothing more is requested from the storage server
+// until the merge has consumed everything already sent.
+ACTOR static Future<Void> singleChangeFeedStream(StorageServerInterface interf,
+                                                 PromiseStream<Standalone<MutationsAndVersionRef>> results,
+                                                 Key feedID,
+                                                 Version begin,
+                                                 Version end,
+                                                 KeyRange range) {
+	state ChangeFeedStreamRequest req;
+	req.rangeID = feedID;
+	req.begin = begin;
+	req.end = end;
+	req.range = range;
+	req.id = deterministicRandom()->randomUniqueID();
+	state ReplyPromiseStream<ChangeFeedStreamReply> replies = interf.changeFeedStream.getReplyStream(req);
+	try {
+		loop {
+			wait(results.onEmpty());
+			ChangeFeedStreamReply reply = waitNext(replies.getFuture());
+			for (auto& entry : reply.mutations) {
+				results.send(Standalone<MutationsAndVersionRef>(entry, reply.arena));
+			}
+		}
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+		results.sendError(e);
+	}
+	return Void();
+}
+
+ACTOR static Future<Void> getChangeFeedStreamActor(Reference<DatabaseContext> db,
+                                                   PromiseStream<Standalone<VectorRef<MutationsAndVersionRef>>> results,
+                                                   Key feedID,
+                                                   Version begin,
+                                                   Version end,
+                                                   KeyRange range) {
+	state Database cx(db);
+	state Span span("NAPI:GetChangeFeedStream"_loc);
+	state std::vector<Future<Void>> shardStreams;
+	state std::vector<MutationAndVersionStream> streams;
+	state std::priority_queue<MutationAndVersionStream> heap;
+	state std::vector<MutationAndVersionStream> advanced;
+	state Standalone<VectorRef<MutationsAndVersionRef>> batch;
+	state int i;
+	loop {
+		try {
+			if (begin >= end) {
+				results.sendError(end_of_stream());
+				return Void();
+			}
+			state std::vector<KeyRangeLocationInfo> locations =
+			    wait(getKeyRangeLocations(cx,
+			                              range,
+			                              CLIENT_KNOBS->CHANGE_FEED_LOCATION_LIMIT,
+			                              Reverse::False,
+			                              &StorageServerInterface::changeFeedStream,
+			                              span.context,
+			                              Optional<UID>(),
+			                              UseProvisionalProxies::False,
+			                              latestVersion));
+			if (locations.size() >= CLIENT_KNOBS->CHANGE_FEED_LOCATION_LIMIT) {
+				TraceEvent(SevError, "ChangeFeedStreamTooManyLocations")
+				    .detail("FeedID", feedID)
+				    .detail("Range", range)
+				    .detail("Locations", locations.size());
+				throw unsupported_operation();
+			}
+
+			streams.resize(locations.size());
+			for (i = 0; i < locations.size(); i++) {
+				Optional<StorageServerInterface> interf = chooseChangeFeedReplica(locations[i].locations);
+				if (!interf.present()) {
+					throw all_alternatives_failed();
+				}
+				shardStreams.push_back(singleChangeFeedStream(
+				    interf.get(), streams[i].results, feedID, begin, end, KeyRange(range & locations[i].range)));
+			}
+			for (i = 0; i < streams.size(); i++) {
+				advanced.push_back(streams[i]);
+			}
+
+			// Every shard reports each version it has read, so a version is complete once it is the lowest version
+			// at the head of every shard's stream
+			loop {
+				for (i = 0; i < advanced.size(); i++) {
+					if (!batch.empty() && !advanced[i].results.getFuture().isReady()) {
+						begin = batch.back().version + 1;
+						results.send(batch);
+						batch = Standalone<VectorRef<MutationsAndVersionRef>>();
+					}
+					try {
+						Standalone<MutationsAndVersionRef> next = waitNext(advanced[i].results.getFuture());
+						advanced[i].next = next;
+						heap.push(advanced[i]);
+					} catch (Error& e) {
+						if (e.code() != error_code_end_of_stream) {
+							throw;
+						}
+					}
+				}
+				advanced.clear();
+
+				if (heap.empty()) {
+					if (!batch.empty()) {
+						results.send(batch);
+					}
+					results.sendError(end_of_stream());
+					return Void();
+				}
+
+				MutationsAndVersionRef merged(heap.top().next.version, invalidVersion);
+				while (!heap.empty() && heap.top().next.version == merged.version) {
+					advanced.push_back(heap.top());
+					heap.pop();
+					MutationsAndVersionRef const& next = advanced.back().next;
+					merged.mutations.append(batch.arena(), next.mutations.begin(), next.mutations.size());
+					batch.arena().dependsOn(advanced.back().next.arena());
+					merged.knownCommittedVersion = std::max(merged.knownCommittedVersion, next.knownCommittedVersion);
+				}
+				batch.push_back(batch.arena(), merged);
+				if (batch.expectedSize() >= CLIENT_KNOBS->CHANGE_FEED_STREAM_MIN_BYTES) {
+					begin = batch.back().version + 1;
+					results.send(batch);
+					batch = Standalone<VectorRef<MutationsAndVersionRef>>();
+					wait(results.onEmpty());
+				}
+			}
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+			// Restart every shard's stream after the last version which was sent
+			shardStreams.clear();
+			streams.clear();
+			heap = std::priority_queue<MutationAndVersionStream>();
+			advanced.clear();
+			batch = Standalone<VectorRef<MutationsAndVersionRef>>();
+			if (e.code() == error_code_wrong_shard_server || e.code() == error_code_all_alternatives_failed ||
+			    e.code() == error_code_connection_failed || e.code() == error_code_broken_promise ||
+			    e.code() == error_code_future_version || e.code() == error_code_request_maybe_delivered) {
+				cx->invalidateCache(range);
+				wait(delay(CLIENT_KNOBS->WRONG_SHARD_SERVER_DELAY));
+			} else if (e.code() == error_code_unknown_change_feed) {
+				// The storage servers may not have applied the registration of a new feed yet
+				bool registered = wait(isChangeFeedRegistered(cx, feedID));
+				if (!registered) {
+					results.sendError(unknown_change_feed());
+					return Void();
+				}
+				wait(delay(CLIENT_KNOBS->WRONG_SHARD_SERVER_DELAY));
+			} else {
+				results.sendError(e);
+				return Void();
+			}
+		}
+	}
+}
+
+ACTOR static Future<ChangeFeedReadResult> readChangeFeedActor(Reference<DatabaseContext> db,
+                                                              Key feedID,
+                                                              Version begin,
+                                                              Version end,
+                                                              KeyRange range,
+                                                              int targetBytes) {
+	state PromiseStream<Standalone<VectorRef<MutationsAndVersionRef>>> results;
+	state Future<Void> stream = getChangeFeedStreamActor(db, results, feedID, begin, end, range);
+	state ChangeFeedReadResult result;
+	state int64_t bytes = 0;
+	try {
+		loop {
+			Standalone<VectorRef<MutationsAndVersionRef>> batch = waitNext(results.getFuture());
+			for (auto& entry : batch) {
+				for (auto& m : entry.mutations) {
+					result.mutations.push_back(result.mutations.arena(),
+					                           ChangeFeedMutationRef(result.mutations.arena(), entry.version, m));
+				}
+				result.endVersion = entry.version;
+				bytes += entry.expectedSize();
+			}
+			if (bytes >= targetBytes || !results.getFuture().isReady()) {
+				break;
+			}
+		}
+	} catch (Error& e) {
+		if (e.code() != error_code_end_of_stream) {
+			throw;
+		}
+		result.endVersion = end - 1;
+	}
+	return result;
+}
+
+ACTOR static Future<Standalone<VectorRef<OverlappingChangeFeedEntry>>>
+getOverlappingChangeFeedsActor(Reference<DatabaseContext> db, KeyRange range, Version minVersion) {
+	state Database cx(db);
+	state Span span("NAPI:GetOverlappingChangeFeeds"_loc);
+	loop {
+		try {
+			state std::vector<KeyRangeLocationInfo> locations =
+			    wait(getKeyRangeLocations(cx,
+			                              range,
+			                              CLIENT_KNOBS->CHANGE_FEED_LOCATION_LIMIT,
+			                              Reverse::False,
+			                              &StorageServerInterface::overlappingChangeFeeds,
+			                              span.context,
+			                              Optional<UID>(),
+			                              UseProvisionalProxies::False,
+			                              latestVersion));
+			if (locations.size() >= CLIENT_KNOBS->CHANGE_FEED_LOCATION_LIMIT) {
+				TraceEvent(SevError, "OverlappingChangeFeedsTooManyLocations")
+				    .detail("Range", range)
+				    .detail("Locations", locations.size());
+				throw unsupported_operation();
+			}
+
+			state std::vector<Future<OverlappingChangeFeedsReply>> replies;
+			for (auto& location : locations) {
+				OverlappingChangeFeedsRequest req(KeyRange(range & location.range));
+				req.minVersion = minVersion;
+				replies.push_back(loadBalance(location.locations->locations(),
+				                              &StorageServerInterface::overlappingChangeFeeds,
+				                              req,
+				                              TaskPriority::DefaultPromiseEndpoint));
+			}
+			wait(waitForAll(replies));
+
+			Standalone<VectorRef<OverlappingChangeFeedEntry>> feeds;
+			std::unordered_set<KeyRef> seen;
+			for (auto& reply : replies) {
+				for (auto& feed : reply.get().feeds) {
+					if (seen.insert(feed.feedId).second) {
+						feeds.push_back_deep(feeds.arena(), feed);
+					}
+				}
+			}
+			return feeds;
+		} catch (Error& e) {
+			if (e.code() == error_code_wrong_shard_server || e.code() == error_code_all_alternatives_failed ||
+			    e.code() == error_code_future_version) {
+				cx->invalidateCache(range);
+				wait(delay(CLIENT_KNOBS->WRONG_SHARD_SERVER_DELAY));
+			} else {
+				throw;
+			}
+		}
+	}
+}
+
+Future<Void> DatabaseContext::createChangeFeed(Key feedID, KeyRange range) {
+	return createChangeFeedActor(Database(Reference<DatabaseContext>::addRef(this)), feedID, range);
+}
+
+Future<Void> DatabaseContext::destroyChangeFeed(Key feedID) {
+	return destroyChangeFeedActor(Database(Reference<DatabaseContext>::addRef(this)), feedID);
+}
+
+Future<Void> DatabaseContext::popChangeFeedMutations(Key feedID, Version version) {
+	return popChangeFeedMutationsActor(Database(Reference<DatabaseContext>::addRef(this)), feedID, version);
+}
+
+Future<Void> DatabaseContext::getChangeFeedStream(
+    PromiseStream<Standalone<VectorRef<MutationsAndVersionRef>>> const& results,
+    Key feedID,
+    Version begin,
+    Version end,
+    KeyRange range) {
+	return getChangeFeedStreamActor(Reference<DatabaseContext>::addRef(this), results, feedID, begin, end, range);
+}
+
+Future<ChangeFeedReadResult> DatabaseContext::readChangeFeed(Key feedID,
+                                                             Version begin,
+                                                             Version end,
+                                                             KeyRange range,
+                                                             int targetBytes) {
+	return readChangeFeedActor(Reference<DatabaseContext>::addRef(this), feedID, begin, end, range, targetBytes);
+}
+
+Future<Standalone<VectorRef<OverlappingChangeFeedEntry>>> DatabaseContext::getOverlappingChangeFeeds(
+    KeyRange range,
+    Version minVersion) {
+	return getOverlappingChangeFeedsActor(Reference<DatabaseContext>::addRef(this), range, minVersion);
+}
+
 int64_t getMaxKeySize(KeyRef const& key) {
 	return getMaxWriteKeySize(key, true);
 }
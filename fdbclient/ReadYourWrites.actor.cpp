@@ -405,6 +405,76 @@ public:
 		return readWithConflictRangeRYW(ryw, req, snapshot);
 	}
 
+	// Whether a read of key must go to the database, rather than being answered by the writes and read cache which the
+	// iterator sees
+	template <class Iter>
+	static bool needsDatabaseRead(Iter& it, KeyRef key) {
+		it.skip(key);
+		return !it.is_kv() && !it.is_empty_range();
+	}
+
+	// Reads the keys which this transaction cannot answer itself with a single batched read into the read cache, then
+	// reads every key through the usual path so writes and conflict ranges are handled as for get().
+	ACTOR static Future<std::vector<Optional<Value>>> getValues(ReadYourWritesTransaction* ryw,
+	                                                            Standalone<VectorRef<KeyRef>> keys,
+	                                                            Snapshot snapshot) {
+		state Standalone<VectorRef<KeyRef>> fetchKeys;
+		fetchKeys.arena().dependsOn(keys.arena());
+		{
+			const bool rywIterator = !snapshot || ryw->options.snapshotRywEnabled > 0;
+			RYWIterator rywIt(&ryw->cache, &ryw->writes);
+			SnapshotCache::iterator cacheIt(&ryw->cache, &ryw->writes);
+			for (const KeyRef& key : keys) {
+				if (key == metadataVersionKey || key >= ryw->getMaxReadKey() || key.size() > getMaxReadKeySize(key)) {
+					continue;
+				}
+				if (rywIterator ? needsDatabaseRead(rywIt, key) : needsDatabaseRead(cacheIt, key)) {
+					fetchKeys.push_back(fetchKeys.arena(), key);
+				}
+			}
+		}
+
+		if (!fetchKeys.empty()) {
+			choose {
+				when(std::vector<Optional<Value>> fetched = wait(ryw->tr.getValues(fetchKeys, Snapshot::True))) {
+					for (int i = 0; i < fetchKeys.size(); ++i) {
+						KeyRef k(ryw->arena, fetchKeys[i]);
+						if (fetched[i].present()) {
+							if (ryw->cache.insert(k, fetched[i].get()))
+								ryw->arena.dependsOn(fetched[i].get().arena());
+						} else {
+							ryw->cache.insert(k, Optional<ValueRef>());
+						}
+					}
+				}
+				when(wait(ryw->resetPromise.getFuture())) {
+					throw internal_error();
+				}
+			}
+		}
+
+		state std::vector<Future<Optional<Value>>> reads;
+		reads.reserve(keys.size());
+		for (const KeyRef& key : keys) {
+			reads.push_back(ryw->get(Key(key, keys.arena()), snapshot));
+		}
+		std::vector<Optional<Value>> values = wait(getAll(reads));
+		return values;
+	}
+
+	ACTOR static Future<std::vector<Optional<Value>>> getValuesThrough(ReadYourWritesTransaction* ryw,
+	                                                                   Standalone<VectorRef<KeyRef>> keys,
+	                                                                   Snapshot snapshot) {
+		choose {
+			when(std::vector<Optional<Value>> values = wait(ryw->tr.getValues(keys, snapshot))) {
+				return values;
+			}
+			when(wait(ryw->resetPromise.getFuture())) {
+				throw internal_error();
+			}
+		}
+	}
+
 	template <class Iter>
 	static void resolveKeySelectorFromCache(KeySelector& key,
 	                                        Iter& it,
@@ -1688,6 +1758,39 @@ Future<Optional<Value>> ReadYourWritesTransaction::get(const Key& key, Snapshot
 	return result;
 }
 
+Future<std::vector<Optional<Value>>> ReadYourWritesTransaction::getValues(const Standalone<VectorRef<KeyRef>>& keys,
+                                                                          Snapshot snapshot) {
+	CODE_PROBE(true, "ReadYourWritesTransaction::getValues");
+
+	if (checkUsedDuringCommit()) {
+		return used_during_commit();
+	}
+
+	if (resetPromise.isSet())
+		return resetPromise.getFuture().getError();
+
+	bool special = false;
+	for (const KeyRef& key : keys) {
+		if (specialKeys.contains(key)) {
+			special = true;
+		} else if (key >= getMaxReadKey() && key != metadataVersionKey) {
+			return key_outside_legal_range();
+		}
+	}
+
+	// Special keys are served by their own modules, so a batch containing any is read key by key
+	Future<std::vector<Optional<Value>>> result;
+	if (special) {
+		result = ISingleThreadTransaction::getValues(keys, snapshot);
+	} else if (options.readYourWritesDisabled) {
+		result = RYWImpl::getValuesThrough(this, keys, snapshot);
+	} else {
+		result = RYWImpl::getValues(this, keys, snapshot);
+	}
+	reading.add(success(result));
+	return result;
+}
+
 Future<Key> ReadYourWritesTransaction::getKey(const KeySelector& key, Snapshot snapshot) {
 	if (checkUsedDuringCommit()) {
 		return used_during_commit();
@@ -238,7 +238,13 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
                         "p90":0.0,
                         "p95":0.0,
                         "p99":0.0,
-                        "p99.9":0.0
+                        "p99.9":0.0,
+                        "log_linear_histogram":{
+                           "p50":0.0,
+                           "p90":0.0,
+                           "p99":0.0,
+                           "p999":0.0
+                        }
                      },
                      "batch":{
                         "count":0,
@@ -250,7 +256,13 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
                         "p90":0.0,
                         "p95":0.0,
                         "p99":0.0,
-                        "p99.9":0.0
+                        "p99.9":0.0,
+                        "log_linear_histogram":{
+                           "p50":0.0,
+                           "p90":0.0,
+                           "p99":0.0,
+                           "p999":0.0
+                        }
                      }
                   },
                   "read_latency_statistics":{
@@ -263,7 +275,13 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
                      "p90":0.0,
                      "p95":0.0,
                      "p99":0.0,
-                     "p99.9":0.0
+                     "p99.9":0.0,
+                     "log_linear_histogram":{
+                        "p50":0.0,
+                        "p90":0.0,
+                        "p99":0.0,
+                        "p999":0.0
+                     }
                   },
                   "commit_latency_statistics":{
                      "count":0,
@@ -275,7 +293,13 @@ const KeyRef JSONSchemas::statusSchema = R"statusSchema(
                      "p90":0.0,
                      "p95":0.0,
                      "p99":0.0,
-                     "p99.9":0.0
+                     "p99.9":0.0,
+                     "log_linear_histogram":{
+                        "p50":0.0,
+                        "p90":0.0,
+                        "p99":0.0,
+                        "p999":0.0
+                     }
                   },
                   "commit_batching_window_size":{
                      "count":0,
@@ -474,6 +474,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 
 	// KeyValueStoreMemory
 	init( REPLACE_CONTENTS_BYTES,                                1e5 );
+	init( KVS_MEMORY_IMAGE_INTERVAL,                               0 ); if( randomize && BUGGIFY ) KVS_MEMORY_IMAGE_INTERVAL = 1 + deterministicRandom()->random01() * 30;
+	init( KVS_MEMORY_IMAGE_RUN_BYTES,                            1e6 ); if( randomize && BUGGIFY ) KVS_MEMORY_IMAGE_RUN_BYTES = deterministicRandom()->randomInt(100, 1e5);
+	init( KVS_MEMORY_IMAGE_LOAD_THREADS,                           4 ); if( randomize && BUGGIFY ) KVS_MEMORY_IMAGE_LOAD_THREADS = deterministicRandom()->randomInt(1, 5);
 
 	// KeyValueStoreRocksDB
 	init( ROCKSDB_SET_READ_TIMEOUT,         		    !isSimulated );
@@ -739,6 +742,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 
 	bool buggfyUseResolverPrivateMutations = randomize && BUGGIFY && !ENABLE_VERSION_VECTOR_TLOG_UNICAST;
 	init( PROXY_USE_RESOLVER_PRIVATE_MUTATIONS,                 false ); if( buggfyUseResolverPrivateMutations ) PROXY_USE_RESOLVER_PRIVATE_MUTATIONS = deterministicRandom()->coinflip();
+	init( PROXY_PIPELINE_MESSAGE_COPIES,                        false ); if( randomize && BUGGIFY ) PROXY_PIPELINE_MESSAGE_COPIES = true;
 
 	init( BURSTINESS_METRICS_ENABLED  ,                         false );
 	init( BURSTINESS_METRICS_LOG_INTERVAL,                        0.1 );
@@ -775,6 +779,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( SAMPLE_EXPIRATION_TIME,                                1.0 );
 	init( SAMPLE_POLL_TIME,                                      0.1 );
 	init( RESOLVER_STATE_MEMORY_LIMIT,                           1e6 );
+	init( RESOLVER_CONFLICT_SET_THREADS,                           1 ); if( randomize && BUGGIFY ) RESOLVER_CONFLICT_SET_THREADS = deterministicRandom()->randomInt(2, 5);
+	init( RESOLVER_PARALLEL_MIN_CONFLICT_RANGES,                1000 ); if( randomize && BUGGIFY ) RESOLVER_PARALLEL_MIN_CONFLICT_RANGES = deterministicRandom()->randomInt(0, 10);
 	init( LAST_LIMITED_RATIO,                                    2.0 );
 
 	// Backup Worker
@@ -1063,6 +1069,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( STORAGE_DURABILITY_LAG_REJECT_THRESHOLD,              0.25 );
 	init( STORAGE_DURABILITY_LAG_MIN_RATE,                       0.1 );
 	init( STORAGE_COMMIT_INTERVAL,                               0.5 ); if( randomize && BUGGIFY ) STORAGE_COMMIT_INTERVAL = 2.0;
+	init( STORAGE_ROW_CACHE_BYTES,                                 0 ); if( randomize && BUGGIFY ) STORAGE_ROW_CACHE_BYTES = deterministicRandom()->randomInt(1, 1e6);
 
 	// Constants which affect the fraction of data which is sampled
 	// by storage severs to estimate key-range sizes and splits.
@@ -1102,7 +1109,11 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( MAX_STORAGE_COMMIT_TIME,                             200.0 ); //The max fsync stall time on the storage server and tlog before marking a disk as failed
 	init( RANGESTREAM_LIMIT_BYTES,                               2e6 ); if( randomize && BUGGIFY ) RANGESTREAM_LIMIT_BYTES = 1;
 	init( BLOBWORKERSTATUSSTREAM_LIMIT_BYTES,                    1e4 ); if( randomize && BUGGIFY ) BLOBWORKERSTATUSSTREAM_LIMIT_BYTES = 1;
+	init( CHANGEFEEDSTREAM_LIMIT_BYTES,                          1e6 ); if( randomize && BUGGIFY ) CHANGEFEEDSTREAM_LIMIT_BYTES = 1;
+	init( CHANGEFEED_REPLY_BYTES,                                1e5 ); if( randomize && BUGGIFY ) CHANGEFEED_REPLY_BYTES = 1;
 	init( ENABLE_CLEAR_RANGE_EAGER_READS,                       true ); if( randomize && BUGGIFY ) ENABLE_CLEAR_RANGE_EAGER_READS = deterministicRandom()->coinflip();
+	init( SKIP_KNOWN_ATOMIC_OP_EAGER_READS,                     true ); if( randomize && BUGGIFY ) SKIP_KNOWN_ATOMIC_OP_EAGER_READS = deterministicRandom()->coinflip();
+	init( STORAGE_VERSIONED_DATA_ART,                          false ); if( randomize && BUGGIFY ) STORAGE_VERSIONED_DATA_ART = deterministicRandom()->coinflip();
 	init( CHECKPOINT_TRANSFER_BLOCK_BYTES,                      40e6 );
 	init( QUICK_GET_VALUE_FALLBACK,                             true );
 	init( QUICK_GET_KEY_VALUES_FALLBACK,                        true );
@@ -1259,7 +1270,11 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( REDWOOD_EVICT_UPDATED_PAGES,                          true ); if( randomize && BUGGIFY ) { REDWOOD_EVICT_UPDATED_PAGES = false; }
 	init( REDWOOD_DECODECACHE_REUSE_MIN_HEIGHT,                    2 ); if( randomize && BUGGIFY ) { REDWOOD_DECODECACHE_REUSE_MIN_HEIGHT = deterministicRandom()->randomInt(1, 7); }
 	init( REDWOOD_NODE_MAX_UNBALANCE,                              2 );
+	init( REDWOOD_PAGE_CACHE_EVICTION_POLICY,                  "lru" ); if( randomize && BUGGIFY ) { REDWOOD_PAGE_CACHE_EVICTION_POLICY = "slru"; }
+	init( REDWOOD_PAGE_CACHE_PROTECTED_FRACTION,                0.80 ); if( randomize && BUGGIFY ) { REDWOOD_PAGE_CACHE_PROTECTED_FRACTION = deterministicRandom()->random01(); }
 	init( REDWOOD_IO_PRIORITIES,                       "32,32,32,32" );
+	init( REDWOOD_PAGE_COMPRESSION,                            false ); if( randomize && BUGGIFY ) { REDWOOD_PAGE_COMPRESSION = true; }
+	init( REDWOOD_COMPRESSED_NODE_PAGES,                           4 ); if( randomize && BUGGIFY ) { REDWOOD_COMPRESSED_NODE_PAGES = deterministicRandom()->randomInt(1, 9); }
 
 	// Server request latency measurement
 	init( LATENCY_SKETCH_ACCURACY,                              0.01 );
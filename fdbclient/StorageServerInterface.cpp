@@ -60,6 +60,39 @@ void TSS_traceMismatch(TraceEvent& event,
 	            tss.value.present() ? traceChecksumValue(tss.value.get()) : "missing");
 }
 
+// batched point reads
+template <>
+bool TSS_doCompare(const GetValuesReply& src, const GetValuesReply& tss) {
+	return src.data == tss.data;
+}
+
+template <>
+const char* LB_mismatchTraceName(const GetValuesRequest& req, const ComparisonType& type) {
+	return type == TSS_COMPARISON ? "TSSMismatchGetValues" : "ReplicaMismatchGetValues";
+}
+
+template <>
+void TSS_traceMismatch(TraceEvent& event,
+                       const GetValuesRequest& req,
+                       const GetValuesReply& src,
+                       const GetValuesReply& tss,
+                       const ComparisonType& type) {
+	event.detail("Begin", req.keys.empty() ? StringRef() : req.keys.front())
+	    .detail("End", req.keys.empty() ? StringRef() : req.keys.back())
+	    .detail("KeyCount", req.keys.size())
+	    .detail("Version", req.version)
+	    .detail(type == TSS_COMPARISON ? "SSReplyCount" : "SourceSSReplyCount", src.data.size())
+	    .detail(type == TSS_COMPARISON ? "TSSReplyCount" : "ReplicaSSReplyCount", tss.data.size());
+	for (int i = 0; i < std::min(src.data.size(), tss.data.size()); i++) {
+		if (src.data[i] != tss.data[i]) {
+			event.detail("MismatchKey", src.data[i].key)
+			    .detail(type == TSS_COMPARISON ? "SSReply" : "SourceSSReply", traceChecksumValue(src.data[i].value))
+			    .detail(type == TSS_COMPARISON ? "TSSReply" : "ReplicaSSReply", traceChecksumValue(tss.data[i].value));
+			break;
+		}
+	}
+}
+
 // key selector reads
 template <>
 bool TSS_doCompare(const GetKeyReply& src, const GetKeyReply& tss) {
@@ -423,6 +456,12 @@ void TSSMetrics::recordLatency(const GetValueRequest& req, double ssLatency, dou
 	TSSgetValueLatency.addSample(tssLatency);
 }
 
+template <>
+void TSSMetrics::recordLatency(const GetValuesRequest& req, double ssLatency, double tssLatency) {
+	SSgetValueLatency.addSample(ssLatency);
+	TSSgetValueLatency.addSample(tssLatency);
+}
+
 template <>
 void TSSMetrics::recordLatency(const GetKeyRequest& req, double ssLatency, double tssLatency) {
 	SSgetKeyLatency.addSample(ssLatency);
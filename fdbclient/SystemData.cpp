@@ -422,6 +422,36 @@ CheckpointMetaData decodeCheckpointValue(const ValueRef& value) {
 	return checkpoint;
 }
 
+const KeyRangeRef changeFeedKeys("\xff/changeFeed/"_sr, "\xff/changeFeed0"_sr);
+const KeyRef changeFeedPrefix = changeFeedKeys.begin;
+
+const Key changeFeedKeyFor(KeyRef feedID) {
+	return feedID.withPrefix(changeFeedPrefix);
+}
+
+Key decodeChangeFeedKey(KeyRef key) {
+	return key.removePrefix(changeFeedPrefix);
+}
+
+const Value changeFeedValue(KeyRangeRef const& range, Version popVersion, ChangeFeedStatus status) {
+	BinaryWriter wr(IncludeVersion());
+	wr << range;
+	wr << popVersion;
+	wr << static_cast<uint8_t>(status);
+	return wr.toValue();
+}
+
+std::tuple<KeyRange, Version, ChangeFeedStatus> decodeChangeFeedValue(ValueRef const& value) {
+	KeyRange range;
+	Version popVersion;
+	uint8_t status;
+	BinaryReader reader(value, IncludeVersion());
+	reader >> range;
+	reader >> popVersion;
+	reader >> status;
+	return std::make_tuple(range, popVersion, static_cast<ChangeFeedStatus>(status));
+}
+
 // "\xff/dataMoves/[[UID]] := [[DataMoveMetaData]]"
 const KeyRangeRef dataMoveKeys("\xff/dataMoves/"_sr, "\xff/dataMoves0"_sr);
 const Key dataMoveKeyFor(UID dataMoveId) {
@@ -108,6 +108,48 @@ ThreadFuture<Void> ThreadSafeDatabase::createSnapshot(const StringRef& uid, cons
 	});
 }
 
+ThreadFuture<Void> ThreadSafeDatabase::createChangeFeed(const KeyRef& feedID, const KeyRangeRef& range) {
+	DatabaseContext* db = this->db;
+	Key id = feedID;
+	KeyRange r = range;
+	return onMainThread([db, id, r]() -> Future<Void> {
+		db->checkDeferredError();
+		return db->createChangeFeed(id, r);
+	});
+}
+
+ThreadFuture<Void> ThreadSafeDatabase::destroyChangeFeed(const KeyRef& feedID) {
+	DatabaseContext* db = this->db;
+	Key id = feedID;
+	return onMainThread([db, id]() -> Future<Void> {
+		db->checkDeferredError();
+		return db->destroyChangeFeed(id);
+	});
+}
+
+ThreadFuture<Void> ThreadSafeDatabase::popChangeFeed(const KeyRef& feedID, Version version) {
+	DatabaseContext* db = this->db;
+	Key id = feedID;
+	return onMainThread([db, id, version]() -> Future<Void> {
+		db->checkDeferredError();
+		return db->popChangeFeedMutations(id, version);
+	});
+}
+
+ThreadFuture<ChangeFeedReadResult> ThreadSafeDatabase::readChangeFeed(const KeyRef& feedID,
+                                                                      Version begin,
+                                                                      Version end,
+                                                                      const KeyRangeRef& range,
+                                                                      int targetBytes) {
+	DatabaseContext* db = this->db;
+	Key id = feedID;
+	KeyRange r = range;
+	return onMainThread([db, id, begin, end, r, targetBytes]() -> Future<ChangeFeedReadResult> {
+		db->checkDeferredError();
+		return db->readChangeFeed(id, begin, end, r, targetBytes);
+	});
+}
+
 ThreadFuture<DatabaseSharedState*> ThreadSafeDatabase::createSharedState() {
 	DatabaseContext* db = this->db;
 	return onMainThread([db]() -> Future<DatabaseSharedState*> { return db->initSharedState(); });
@@ -234,6 +276,28 @@ ThreadFuture<Optional<Value>> ThreadSafeTransaction::get(const KeyRef& key, bool
 	});
 }
 
+ThreadFuture<Standalone<VectorRef<OptionalValueRef>>> ThreadSafeTransaction::getValues(const VectorRef<KeyRef>& keys,
+                                                                                     bool snapshot) {
+	Standalone<VectorRef<KeyRef>> k;
+	k.append_deep(k.arena(), keys.begin(), keys.size());
+
+	ISingleThreadTransaction* tr = this->tr;
+	return onMainThread([tr, k, snapshot]() -> Future<Standalone<VectorRef<OptionalValueRef>>> {
+		tr->checkDeferredError();
+		return map(tr->getValues(k, Snapshot{ snapshot }), [](const std::vector<Optional<Value>>& values) {
+			Standalone<VectorRef<OptionalValueRef>> result;
+			result.reserve(result.arena(), values.size());
+			for (const Optional<Value>& v : values) {
+				if (v.present()) {
+					result.arena().dependsOn(v.get().arena());
+				}
+				result.push_back(result.arena(), OptionalValueRef(v.castTo<ValueRef>()));
+			}
+			return result;
+		});
+	});
+}
+
 ThreadFuture<Key> ThreadSafeTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	KeySelector k = key;
 
@@ -18,13 +18,14 @@
  * limitations under the License.
  */
 
+#include "fdbclient/VersionedArtMap.h"
 #include "fdbclient/VersionedMap.h"
 #include "flow/TreeBenchmark.h"
 #include "flow/UnitTest.h"
 
-template <typename K>
+template <typename K, typename Map = VersionedMap<K, int>>
 struct VersionedMapHarness {
-	using map = VersionedMap<K, int>;
+	using map = Map;
 	using key_type = K;
 
 	struct result {
@@ -74,4 +75,119 @@ TEST_CASE("performance/map/StringRef/VersionedMap") {
 	return Void();
 }
 
+TEST_CASE("performance/map/StringRef/VersionedArtMap") {
+	Arena arena;
+	VersionedMapHarness<StringRef, VersionedArtMap<int>> tree;
+
+	treeBenchmark(tree, [&arena]() { return randomStr(arena); });
+
+	return Void();
+}
+
+// Keys over a small alphabet share long prefixes and end at inner nodes, and keys of arbitrary bytes fill the larger
+// node types
+static KeyRef randomArtKey(Arena& arena) {
+	std::string key;
+	if (deterministicRandom()->random01() < 0.2) {
+		key = "a long prefix shared by many keys/";
+	}
+	int length = deterministicRandom()->randomInt(0, 6);
+	bool anyByte = deterministicRandom()->random01() < 0.3;
+	for (int i = 0; i < length; i++) {
+		key += anyByte ? (char)deterministicRandom()->randomInt(0, 256)
+		               : (char)('a' + deterministicRandom()->randomInt(0, 3));
+	}
+	return KeyRef(arena, key);
+}
+
+template <class I, class J>
+static void checkSameItem(I i, J j) {
+	ASSERT_EQ((bool)i, (bool)j);
+	if (i) {
+		ASSERT(i.key() == j.key());
+		ASSERT_EQ(*i, *j);
+		ASSERT_EQ(i.insertVersion(), j.insertVersion());
+	}
+}
+
+TEST_CASE("/fdbclient/VersionedArtMap/randomized") {
+	Arena arena;
+	VersionedMap<KeyRef, int> expected;
+	AnyVersionedMap<int> art(true);
+	ASSERT(art.isArt());
+
+	for (Version v = 1; v <= 2000; v++) {
+		expected.createNewVersion(v);
+		art.createNewVersion(v);
+
+		int ops = deterministicRandom()->randomInt(0, 20);
+		for (int op = 0; op < ops; op++) {
+			double r = deterministicRandom()->random01();
+			KeyRef key = randomArtKey(arena);
+			if (r < 0.6) {
+				int value = deterministicRandom()->randomInt(0, 1000);
+				expected.insert(key, value);
+				art.insert(key, value);
+			} else if (r < 0.7) {
+				// An insert version older than the latest version
+				int value = deterministicRandom()->randomInt(0, 1000);
+				Version insertAt = deterministicRandom()->randomInt64(expected.getOldestVersion(), v + 1);
+				expected.insert(key, value, insertAt);
+				art.insert(key, value, insertAt);
+			} else if (r < 0.9) {
+				auto i = expected.atLatest().lower_bound(key);
+				if (i) {
+					KeyRef present = i.key();
+					expected.erase(present);
+					art.erase(art.atLatest().find(present));
+				}
+			} else {
+				KeyRef end = randomArtKey(arena);
+				if (end < key) {
+					std::swap(key, end);
+				}
+				expected.erase(key, end);
+				art.erase(key, end);
+			}
+		}
+
+		if (v % 10 == 0) {
+			Version at = deterministicRandom()->randomInt64(expected.getOldestVersion(), v + 1);
+			auto expectedView = expected.at(at);
+			auto artView = art.at(at);
+			artView.validate();
+
+			auto i = expectedView.begin();
+			auto j = artView.begin();
+			for (; i; ++i, ++j) {
+				checkSameItem(i, j);
+			}
+			ASSERT(!j);
+			i = expectedView.end();
+			j = artView.end();
+			for (--i, --j; i; --i, --j) {
+				checkSameItem(i, j);
+			}
+			ASSERT(!j);
+
+			for (int probe = 0; probe < 20; probe++) {
+				KeyRef key = randomArtKey(arena);
+				checkSameItem(expectedView.find(key), artView.find(key));
+				checkSameItem(expectedView.lower_bound(key), artView.lower_bound(key));
+				checkSameItem(expectedView.upper_bound(key), artView.upper_bound(key));
+				checkSameItem(expectedView.lastLess(key), artView.lastLess(key));
+				checkSameItem(expectedView.lastLessOrEqual(key), artView.lastLessOrEqual(key));
+			}
+		}
+
+		if (deterministicRandom()->random01() < 0.05) {
+			Version oldest = deterministicRandom()->randomInt64(expected.getOldestVersion(), v + 1);
+			expected.forgetVersionsBefore(oldest);
+			art.forgetVersionsBefore(oldest);
+		}
+	}
+
+	return Void();
+}
+
 void forceLinkVersionedMapTests() {}
@@ -65,6 +65,7 @@ public:
 	double FUTURE_VERSION_RETRY_DELAY;
 	double GRV_ERROR_RETRY_DELAY;
 	int REPLY_BYTE_LIMIT;
+	int GET_VALUES_BATCH_KEYS; // The most keys sent to one storage server in a single multi-key point read
 	double DEFAULT_BACKOFF;
 	double DEFAULT_MAX_BACKOFF;
 	double BACKOFF_GROWTH_RATE;
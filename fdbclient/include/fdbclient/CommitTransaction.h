@@ -548,4 +548,30 @@ struct MutationsAndVersionRef {
 	}
 };
 
+// A mutation read from a change feed, flattened for the client bindings. The layout matches FDBChangeFeedMutation.
+#pragma pack(push, 4)
+struct ChangeFeedMutationRef {
+	Version version;
+	int32_t type;
+	StringRef param1;
+	StringRef param2;
+
+	ChangeFeedMutationRef() : version(invalidVersion), type(MutationRef::MAX_ATOMIC_OP) {}
+	ChangeFeedMutationRef(Arena& to, Version version, MutationRef const& m)
+	  : version(version), type(m.type), param1(to, m.param1), param2(to, m.param2) {}
+	ChangeFeedMutationRef(Arena& to, const ChangeFeedMutationRef& from)
+	  : version(from.version), type(from.type), param1(to, from.param1), param2(to, from.param2) {}
+
+	int expectedSize() const { return param1.size() + param2.size(); }
+};
+#pragma pack(pop)
+
+// The result of reading a change feed: its mutations in version order, and the last version which was read.
+struct ChangeFeedReadResult {
+	Standalone<VectorRef<ChangeFeedMutationRef>> mutations;
+	Version endVersion = invalidVersion;
+
+	int expectedSize() const { return mutations.expectedSize(); }
+};
+
 #endif
@@ -267,6 +267,29 @@ public:
 	                                                                          ReadHotSubRangeRequest::SplitType type,
 	                                                                          int splitCount);
 
+	// Change feeds capture every mutation to a key range from the version they are created. Creating a feed which
+	// already exists with the same range is a no-op.
+	Future<Void> createChangeFeed(Key feedID, KeyRange range);
+	Future<Void> destroyChangeFeed(Key feedID);
+	// Discards the mutations of the feed below version
+	Future<Void> popChangeFeedMutations(Key feedID, Version version);
+	// Sends the mutations of the feed in [begin, end) which touch range, merged across shards and grouped by version.
+	// The stream ends with end_of_stream once every version before end has been read.
+	Future<Void> getChangeFeedStream(PromiseStream<Standalone<VectorRef<MutationsAndVersionRef>>> const& results,
+	                                 Key feedID,
+	                                 Version begin = 0,
+	                                 Version end = std::numeric_limits<Version>::max(),
+	                                 KeyRange range = allKeys);
+	// Reads the mutations of the feed starting at begin, returning once roughly targetBytes have been read or no more
+	// committed versions are available
+	Future<ChangeFeedReadResult> readChangeFeed(Key feedID,
+	                                            Version begin,
+	                                            Version end,
+	                                            KeyRange range,
+	                                            int targetBytes);
+	Future<Standalone<VectorRef<OverlappingChangeFeedEntry>>> getOverlappingChangeFeeds(KeyRange range,
+	                                                                                   Version minVersion);
+
 	// Returns the protocol version reported by the coordinator this client is connected to
 	// If an expected version is given, the future won't return until the protocol version is different than expected
 	// Note: this will never return if the server is running a protocol from FDB 5.0 or older
@@ -449,6 +472,7 @@ public:
 	Counter transactionPhysicalReadsCompleted;
 	Counter transactionGetKeyRequests;
 	Counter transactionGetValueRequests;
+	Counter transactionGetValuesRequests;
 	Counter transactionGetRangeRequests;
 	Counter transactionGetMappedRangeRequests;
 	Counter transactionGetRangeStreamRequests;
@@ -535,6 +535,24 @@ struct Traceable<KeyValueRef> : std::true_type {
 	}
 };
 
+// One value returned by a multi-key point read, flattened for the client bindings. The layout matches
+// FDBOptionalValue.
+#pragma pack(push, 4)
+struct OptionalValueRef {
+	int32_t present;
+	ValueRef value;
+
+	OptionalValueRef() : present(0) {}
+	explicit OptionalValueRef(const Optional<ValueRef>& v) : present(v.present()), value(v.orDefault(ValueRef())) {}
+	OptionalValueRef(Arena& a, const OptionalValueRef& copyFrom)
+	  : present(copyFrom.present), value(a, copyFrom.value) {}
+
+	Optional<ValueRef> get() const { return present ? Optional<ValueRef>(value) : Optional<ValueRef>(); }
+
+	int expectedSize() const { return value.expectedSize(); }
+};
+#pragma pack(pop)
+
 using Key = Standalone<KeyRef>;
 using Value = Standalone<ValueRef>;
 using KeyRange = Standalone<KeyRangeRef>;
@@ -22,6 +22,7 @@
 #define FDBCLIENT_ICLIENTAPI_H
 #pragma once
 
+#include "fdbclient/CommitTransaction.h"
 #include "fdbclient/FDBOptions.g.h"
 #include "fdbclient/FDBTypes.h"
 #include "fdbclient/Tracing.h"
@@ -43,6 +44,9 @@ public:
 	// own memory. It is guaranteed, however, that the ThreadFuture will hold a reference to the memory. It will persist
 	// until the ThreadFuture's ThreadSingleAssignmentVar has its memory released or it is destroyed.
 	virtual ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) = 0;
+	// Reads several keys at once, returning their values in the order of keys
+	virtual ThreadFuture<Standalone<VectorRef<OptionalValueRef>>> getValues(const VectorRef<KeyRef>& keys,
+	                                                                        bool snapshot = false) = 0;
 	virtual ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) = 0;
 	virtual ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                           const KeySelectorRef& end,
@@ -152,6 +156,18 @@ public:
 	// Management API, create snapshot
 	virtual ThreadFuture<Void> createSnapshot(const StringRef& uid, const StringRef& snapshot_command) = 0;
 
+	// Change feeds capture the mutations to a key range from the version they are created
+	virtual ThreadFuture<Void> createChangeFeed(const KeyRef& feedID, const KeyRangeRef& range) = 0;
+	virtual ThreadFuture<Void> destroyChangeFeed(const KeyRef& feedID) = 0;
+	// Discards the mutations of the feed below version
+	virtual ThreadFuture<Void> popChangeFeed(const KeyRef& feedID, Version version) = 0;
+	// Reads the mutations of the feed in [begin, end) which touch range, stopping after roughly targetBytes
+	virtual ThreadFuture<ChangeFeedReadResult> readChangeFeed(const KeyRef& feedID,
+	                                                          Version begin,
+	                                                          Version end,
+	                                                          const KeyRangeRef& range,
+	                                                          int targetBytes) = 0;
+
 	// Interface to manage shared state across multiple connections to the same Database
 	virtual ThreadFuture<DatabaseSharedState*> createSharedState() = 0;
 	virtual void setSharedState(DatabaseSharedState* p) = 0;
@@ -54,6 +54,10 @@ ACTOR static Future<Void> replaceRange_impl(class IKeyValueStore* self,
                                             KeyRange range,
                                             Standalone<VectorRef<KeyValueRef>> data);
 
+ACTOR static Future<std::vector<Optional<Value>>> readValues_impl(class IKeyValueStore* self,
+                                                                  Standalone<VectorRef<KeyRef>> keys,
+                                                                  Optional<ReadOptions> options);
+
 class IKeyValueStore : public IClosable {
 public:
 	virtual KeyValueStoreType getType() const = 0;
@@ -76,6 +80,14 @@ public:
 	                                                int maxLength,
 	                                                Optional<ReadOptions> options = Optional<ReadOptions>()) = 0;
 
+	// Reads the values of keys, which must be sorted ascending and distinct, returning them in the same order. The
+	// default implementation issues one readValue() per key; engines which can share work between neighbouring keys
+	// (one cursor, one batched lookup) should override it.
+	virtual Future<std::vector<Optional<Value>>> readValues(Standalone<VectorRef<KeyRef>> keys,
+	                                                        Optional<ReadOptions> options = Optional<ReadOptions>()) {
+		return readValues_impl(this, keys, options);
+	}
+
 	// If rowLimit>=0, reads first rows sorted ascending, otherwise reads last rows sorted descending
 	// The total size of the returned value (less the last entry) will be less than byteLimit
 	virtual Future<RangeResult> readRange(KeyRangeRef keys,
@@ -189,5 +201,17 @@ ACTOR static Future<Void> replaceRange_impl(IKeyValueStore* self,
 	return Void();
 }
 
+ACTOR static Future<std::vector<Optional<Value>>> readValues_impl(IKeyValueStore* self,
+                                                                  Standalone<VectorRef<KeyRef>> keys,
+                                                                  Optional<ReadOptions> options) {
+	state std::vector<Future<Optional<Value>>> reads;
+	reads.reserve(keys.size());
+	for (const KeyRef& key : keys) {
+		reads.push_back(self->readValue(key, options));
+	}
+	std::vector<Optional<Value>> values = wait(getAll(reads));
+	return values;
+}
+
 #include "flow/unactorcompiler.h"
 #endif
@@ -54,6 +54,9 @@ public:
 	virtual Future<Version> getReadVersion() = 0;
 	virtual Optional<Version> getCachedReadVersion() const = 0;
 	virtual Future<Optional<Value>> get(const Key& key, Snapshot = Snapshot::False) = 0;
+	// Reads several keys, returning their values in the order of keys. The default reads each key with get().
+	virtual Future<std::vector<Optional<Value>>> getValues(const Standalone<VectorRef<KeyRef>>& keys,
+	                                                       Snapshot = Snapshot::False);
 	virtual Future<Key> getKey(const KeySelector& key, Snapshot = Snapshot::False) = 0;
 	virtual Future<RangeResult> getRange(const KeySelector& begin,
 	                                     const KeySelector& end,
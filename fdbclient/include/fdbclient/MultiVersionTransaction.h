@@ -90,6 +90,17 @@ struct FdbCApi : public ThreadSafeReferenceCounted<FdbCApi> {
 		const void* endKey;
 		int endKeyLength;
 	} FDBKeyRange;
+	typedef struct optionalvalue {
+		fdb_bool_t present;
+		const uint8_t* value;
+		int valueLength;
+	} FDBOptionalValue;
+	typedef struct changefeedmutation {
+		int64_t version;
+		int type;
+		FDBKey param1;
+		FDBKey param2;
+	} FDBChangeFeedMutation;
 
 #pragma pack(pop)
 
@@ -125,6 +136,25 @@ struct FdbCApi : public ThreadSafeReferenceCounted<FdbCApi> {
 	                                     int uidLength,
 	                                     uint8_t const* snapshotCommmand,
 	                                     int snapshotCommandLength);
+	FDBFuture* (*databaseCreateChangeFeed)(FDBDatabase* database,
+	                                       uint8_t const* feedID,
+	                                       int feedIDLength,
+	                                       uint8_t const* beginKey,
+	                                       int beginKeyLength,
+	                                       uint8_t const* endKey,
+	                                       int endKeyLength);
+	FDBFuture* (*databaseDestroyChangeFeed)(FDBDatabase* database, uint8_t const* feedID, int feedIDLength);
+	FDBFuture* (*databasePopChangeFeed)(FDBDatabase* database, uint8_t const* feedID, int feedIDLength, int64_t version);
+	FDBFuture* (*databaseReadChangeFeed)(FDBDatabase* database,
+	                                     uint8_t const* feedID,
+	                                     int feedIDLength,
+	                                     int64_t beginVersion,
+	                                     int64_t endVersion,
+	                                     uint8_t const* beginKey,
+	                                     int beginKeyLength,
+	                                     uint8_t const* endKey,
+	                                     int endKeyLength,
+	                                     int targetBytes);
 	FDBFuture* (*databaseCreateSharedState)(FDBDatabase* database);
 	void (*databaseSetSharedState)(FDBDatabase* database, DatabaseSharedState* p);
 
@@ -144,6 +174,7 @@ struct FdbCApi : public ThreadSafeReferenceCounted<FdbCApi> {
 	FDBFuture* (*transactionGetReadVersion)(FDBTransaction* tr);
 
 	FDBFuture* (*transactionGet)(FDBTransaction* tr, uint8_t const* keyName, int keyNameLength, fdb_bool_t snapshot);
+	FDBFuture* (*transactionGetValues)(FDBTransaction* tr, FDBKey const* keys, int count, fdb_bool_t snapshot);
 	FDBFuture* (*transactionGetKey)(FDBTransaction* tr,
 	                                uint8_t const* keyName,
 	                                int keyNameLength,
@@ -251,6 +282,11 @@ struct FdbCApi : public ThreadSafeReferenceCounted<FdbCApi> {
 	                                            int* outCount,
 	                                            fdb_bool_t* outMore);
 
+	fdb_error_t (*futureGetOptionalValueArray)(FDBFuture* f, FDBOptionalValue const** outValues, int* outCount);
+	fdb_error_t (*futureGetChangeFeedMutations)(FDBFuture* f,
+	                                            FDBChangeFeedMutation const** outMutations,
+	                                            int* outCount,
+	                                            int64_t* outEndVersion);
 	fdb_error_t (*futureGetSharedState)(FDBFuture* f, DatabaseSharedState** outPtr);
 	fdb_error_t (*futureSetCallback)(FDBFuture* f, FDBCallback callback, void* callback_parameter);
 	void (*futureCancel)(FDBFuture* f);
@@ -278,6 +314,8 @@ public:
 	ThreadFuture<Version> getReadVersion() override;
 
 	ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) override;
+	ThreadFuture<Standalone<VectorRef<OptionalValueRef>>> getValues(const VectorRef<KeyRef>& keys,
+	                                                                bool snapshot = false) override;
 	ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) override;
 	ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                   const KeySelectorRef& end,
@@ -375,6 +413,14 @@ public:
 	ThreadFuture<int64_t> rebootWorker(const StringRef& address, bool check, int duration) override;
 	ThreadFuture<Void> forceRecoveryWithDataLoss(const StringRef& dcid) override;
 	ThreadFuture<Void> createSnapshot(const StringRef& uid, const StringRef& snapshot_command) override;
+	ThreadFuture<Void> createChangeFeed(const KeyRef& feedID, const KeyRangeRef& range) override;
+	ThreadFuture<Void> destroyChangeFeed(const KeyRef& feedID) override;
+	ThreadFuture<Void> popChangeFeed(const KeyRef& feedID, Version version) override;
+	ThreadFuture<ChangeFeedReadResult> readChangeFeed(const KeyRef& feedID,
+	                                                  Version begin,
+	                                                  Version end,
+	                                                  const KeyRangeRef& range,
+	                                                  int targetBytes) override;
 
 	ThreadFuture<DatabaseSharedState*> createSharedState() override;
 	void setSharedState(DatabaseSharedState* p) override;
@@ -441,6 +487,8 @@ public:
 	ThreadFuture<Version> getReadVersion() override;
 
 	ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) override;
+	ThreadFuture<Standalone<VectorRef<OptionalValueRef>>> getValues(const VectorRef<KeyRef>& keys,
+	                                                                bool snapshot = false) override;
 	ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) override;
 	ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                   const KeySelectorRef& end,
@@ -687,6 +735,14 @@ public:
 	ThreadFuture<int64_t> rebootWorker(const StringRef& address, bool check, int duration) override;
 	ThreadFuture<Void> forceRecoveryWithDataLoss(const StringRef& dcid) override;
 	ThreadFuture<Void> createSnapshot(const StringRef& uid, const StringRef& snapshot_command) override;
+	ThreadFuture<Void> createChangeFeed(const KeyRef& feedID, const KeyRangeRef& range) override;
+	ThreadFuture<Void> destroyChangeFeed(const KeyRef& feedID) override;
+	ThreadFuture<Void> popChangeFeed(const KeyRef& feedID, Version version) override;
+	ThreadFuture<ChangeFeedReadResult> readChangeFeed(const KeyRef& feedID,
+	                                                  Version begin,
+	                                                  Version end,
+	                                                  const KeyRangeRef& range,
+	                                                  int targetBytes) override;
 
 	ThreadFuture<DatabaseSharedState*> createSharedState() override;
 	void setSharedState(DatabaseSharedState* p) override;
@@ -769,6 +825,49 @@ public:
 	friend class MultiVersionTransaction;
 };
 
+// An implementation of IDatabase that spreads the transactions of a single database across one MultiVersionDatabase
+// per client thread, so that one database object can use all of the threads started by CLIENT_THREADS_PER_VERSION.
+// Each shard has its own location cache and connections, because the network state of every client thread lives in a
+// separate copy of the client library. With N client threads a database object therefore costs N DatabaseContexts:
+// N location caches to fill, N connections to the coordinators, proxies and each storage server it reads from, and
+// read version requests batched N ways instead of one. Management and change feed operations are always served by
+// the first shard.
+class ShardedMultiVersionDatabase final : public IDatabase, ThreadSafeReferenceCounted<ShardedMultiVersionDatabase> {
+public:
+	explicit ShardedMultiVersionDatabase(std::vector<Reference<IDatabase>> shards);
+
+	Reference<ITransaction> createTransaction() override;
+	void setOption(FDBDatabaseOptions::Option option, Optional<StringRef> value = Optional<StringRef>()) override;
+	double getMainThreadBusyness() override;
+
+	ThreadFuture<ProtocolVersion> getServerProtocol(
+	    Optional<ProtocolVersion> expectedVersion = Optional<ProtocolVersion>()) override;
+
+	void addref() override { ThreadSafeReferenceCounted<ShardedMultiVersionDatabase>::addref(); }
+	void delref() override { ThreadSafeReferenceCounted<ShardedMultiVersionDatabase>::delref(); }
+
+	ThreadFuture<int64_t> rebootWorker(const StringRef& address, bool check, int duration) override;
+	ThreadFuture<Void> forceRecoveryWithDataLoss(const StringRef& dcid) override;
+	ThreadFuture<Void> createSnapshot(const StringRef& uid, const StringRef& snapshot_command) override;
+	ThreadFuture<Void> createChangeFeed(const KeyRef& feedID, const KeyRangeRef& range) override;
+	ThreadFuture<Void> destroyChangeFeed(const KeyRef& feedID) override;
+	ThreadFuture<Void> popChangeFeed(const KeyRef& feedID, Version version) override;
+	ThreadFuture<ChangeFeedReadResult> readChangeFeed(const KeyRef& feedID,
+	                                                  Version begin,
+	                                                  Version end,
+	                                                  const KeyRangeRef& range,
+	                                                  int targetBytes) override;
+
+	ThreadFuture<DatabaseSharedState*> createSharedState() override;
+	void setSharedState(DatabaseSharedState* p) override;
+
+	ThreadFuture<Standalone<StringRef>> getClientStatus() override;
+
+private:
+	const std::vector<Reference<IDatabase>> shards;
+	std::atomic<uint32_t> nextShard;
+};
+
 // An implementation of IClientApi that can choose between multiple different client implementations either provided
 // locally within the primary loaded fdb_c client or through any number of dynamically loaded clients.
 //
@@ -854,6 +953,7 @@ private:
 
 	int nextThread = 0;
 	int threadCount;
+	bool shardDatabasesAcrossThreads;
 	std::string tmpDir;
 	bool traceShareBaseNameAmongThreads;
 	std::string traceFileIdentifier;
@@ -323,6 +323,10 @@ public:
 	Optional<Version> getCachedReadVersion() const;
 
 	[[nodiscard]] Future<Optional<Value>> get(const Key& key, Snapshot = Snapshot::False);
+	// Reads several keys at once, returning their values in the order of keys. Keys are grouped by the shard which
+	// holds them so each storage server answers one request per shard rather than one per key.
+	[[nodiscard]] Future<std::vector<Optional<Value>>> getValues(const Standalone<VectorRef<KeyRef>>& keys,
+	                                                             Snapshot = Snapshot::False);
 	[[nodiscard]] Future<Void> watch(Reference<Watch> watch);
 	[[nodiscard]] Future<Key> getKey(const KeySelector& key, Snapshot = Snapshot::False);
 	// Future< Optional<KeyValue> > get( const KeySelectorRef& key );
@@ -78,6 +78,8 @@ public:
 	Future<Version> getReadVersion() override;
 	Optional<Version> getCachedReadVersion() const override { return tr.getCachedReadVersion(); }
 	Future<Optional<Value>> get(const Key& key, Snapshot = Snapshot::False) override;
+	Future<std::vector<Optional<Value>>> getValues(const Standalone<VectorRef<KeyRef>>& keys,
+	                                               Snapshot = Snapshot::False) override;
 	Future<Key> getKey(const KeySelector& key, Snapshot = Snapshot::False) override;
 	Future<RangeResult> getRange(const KeySelector& begin,
 	                             const KeySelector& end,
@@ -483,6 +483,10 @@ public:
 
 	// KeyValueStoreMemory
 	int64_t REPLACE_CONTENTS_BYTES;
+	double KVS_MEMORY_IMAGE_INTERVAL; // Seconds between on-disk images of the memory engine's data, 0 disables them.
+	                                  // The log is not popped past the start of the latest image.
+	int KVS_MEMORY_IMAGE_RUN_BYTES; // Target size of each checksummed run of an image
+	int KVS_MEMORY_IMAGE_LOAD_THREADS; // Threads which verify and decode image runs during recovery
 
 	// KeyValueStoreRocksDB
 	bool ROCKSDB_SET_READ_TIMEOUT;
@@ -721,6 +725,9 @@ public:
 	double REPORT_TRANSACTION_COST_ESTIMATION_DELAY;
 	bool PROXY_REJECT_BATCH_QUEUED_TOO_LONG;
 	bool PROXY_USE_RESOLVER_PRIVATE_MUTATIONS;
+	// If true, a commit batch's messages are copied into the buffers of the TLogs they go to on a helper thread,
+	// overlapping with the next batch's tag assignment on the proxy's main thread.
+	bool PROXY_PIPELINE_MESSAGE_COPIES;
 	bool BURSTINESS_METRICS_ENABLED;
 	// Interval on which to emit burstiness metrics on the commit proxy (in
 	// seconds).
@@ -755,6 +762,8 @@ public:
 	double SAMPLE_EXPIRATION_TIME;
 	double SAMPLE_POLL_TIME;
 	int64_t RESOLVER_STATE_MEMORY_LIMIT;
+	int RESOLVER_CONFLICT_SET_THREADS; // Threads used to detect conflicts within one resolver; 1 disables partitioning
+	int RESOLVER_PARALLEL_MIN_CONFLICT_RANGES; // Batches with fewer conflict ranges are always resolved on one thread
 
 	// Backup Worker
 	double BACKUP_TIMEOUT; // master's reaction time for backup failure
@@ -1138,6 +1147,7 @@ public:
 	int STORAGE_FETCH_BYTES;
 	int STORAGE_ROCKSDB_FETCH_BYTES;
 	double STORAGE_COMMIT_INTERVAL;
+	int64_t STORAGE_ROW_CACHE_BYTES; // Memory for caching values read from the storage engine by point reads, 0 disables
 	int BYTE_SAMPLING_FACTOR;
 	int BYTE_SAMPLING_OVERHEAD;
 	double MIN_BYTE_SAMPLING_PROBABILITY; // Adjustable only for test of PhysicalShardMove. Should always be 0 for other
@@ -1168,7 +1178,11 @@ public:
 	double MAX_STORAGE_COMMIT_TIME;
 	int64_t RANGESTREAM_LIMIT_BYTES;
 	int64_t BLOBWORKERSTATUSSTREAM_LIMIT_BYTES;
+	int64_t CHANGEFEEDSTREAM_LIMIT_BYTES;
+	int64_t CHANGEFEED_REPLY_BYTES; // Target size of one reply to a change feed stream
 	bool ENABLE_CLEAR_RANGE_EAGER_READS;
+	bool SKIP_KNOWN_ATOMIC_OP_EAGER_READS; // Don't read the old value of an atomic op's key if it is in versioned data
+	bool STORAGE_VERSIONED_DATA_ART; // Keep the storage server's versioned data in a VersionedArtMap instead of a PTree
 	bool QUICK_GET_VALUE_FALLBACK;
 	bool QUICK_GET_KEY_VALUES_FALLBACK;
 	bool STRICTLY_ENFORCE_BYTE_LIMIT;
@@ -1359,8 +1373,15 @@ public:
 	bool REDWOOD_EVICT_UPDATED_PAGES; // Whether to prioritize eviction of updated pages from cache.
 	int REDWOOD_DECODECACHE_REUSE_MIN_HEIGHT; // Minimum height for which to keep and reuse page decode caches
 	int REDWOOD_NODE_MAX_UNBALANCE; // Maximum imbalance in a node before it should be rebuilt instead of updated
+	std::string REDWOOD_PAGE_CACHE_EVICTION_POLICY; // "lru" or "slru". With "slru" pages reused by point reads are
+	                                                // protected from being flushed out by range scans and fetches.
+	double REDWOOD_PAGE_CACHE_PROTECTED_FRACTION; // Fraction of the page cache that "slru" may use for its protected
+	                                              // segment
 
 	std::string REDWOOD_IO_PRIORITIES;
+	bool REDWOOD_PAGE_COMPRESSION; // Whether new Redwood files are written with zstd compressed BTree pages
+	int REDWOOD_COMPRESSED_NODE_PAGES; // Number of pages that BTree nodes of compressed Redwood files are sized in
+	                                   // multiples of, so that they compress into fewer pages
 
 	// Server request latency measurement
 	double LATENCY_SKETCH_ACCURACY;
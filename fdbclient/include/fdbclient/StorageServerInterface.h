@@ -90,6 +90,7 @@ struct StorageServerInterface {
 
 	enum { LocationAwareLoadBalance = 1 };
 	enum { AlwaysFresh = 0 };
+	enum { CancelsLostLoadBalancedRequests = 1 };
 
 	LocalityData locality;
 	UID uniqueID;
@@ -97,6 +98,8 @@ struct StorageServerInterface {
 
 	PublicRequestStream<struct GetValueRequest> getValue;
 	PublicRequestStream<struct GetKeyRequest> getKey;
+	// Point reads of several sorted keys at one version, answered with a single storage engine batch read
+	PublicRequestStream<struct GetValuesRequest> getValues;
 
 	// Throws a wrong_shard_server if the keys in the request or result depend on data outside this server OR if a large
 	// selector offset prevents all data from being read in one range read
@@ -127,6 +130,8 @@ struct StorageServerInterface {
 	RequestStream<struct GetHotShardsRequest> getHotShards;
 	RequestStream<struct GetStorageCheckSumRequest> getCheckSum;
 	RequestStream<struct BulkDumpRequest> bulkdump;
+	// Abandons a getValue or getKeyValues request which lost a load balancing race to another replica
+	PublicRequestStream<struct CancelReadRequest> cancelRead;
 
 private:
 	bool acceptingRequests;
@@ -197,8 +202,11 @@ public:
 			getCheckSum =
 			    RequestStream<struct GetStorageCheckSumRequest>(getValue.getEndpoint().getAdjustedEndpoint(25));
 			bulkdump = RequestStream<struct BulkDumpRequest>(getValue.getEndpoint().getAdjustedEndpoint(26));
+			getValues = PublicRequestStream<struct GetValuesRequest>(getValue.getEndpoint().getAdjustedEndpoint(27));
+			cancelRead = PublicRequestStream<struct CancelReadRequest>(getValue.getEndpoint().getAdjustedEndpoint(28));
 		}
 	}
+	void cancelLostRequest(UID replyToken) const;
 	bool operator==(StorageServerInterface const& s) const { return uniqueID == s.uniqueID; }
 	bool operator<(StorageServerInterface const& s) const { return uniqueID < s.uniqueID; }
 	void initEndpoints() {
@@ -230,6 +238,8 @@ public:
 		streams.push_back(getHotShards.getReceiver());
 		streams.push_back(getCheckSum.getReceiver());
 		streams.push_back(bulkdump.getReceiver());
+		streams.push_back(getValues.getReceiver(TaskPriority::LoadBalancedEndpoint));
+		streams.push_back(cancelRead.getReceiver(TaskPriority::LoadBalancedEndpoint));
 		FlowTransport::transport().addEndpoints(streams);
 	}
 };
@@ -283,6 +293,7 @@ struct GetValueReply : public LoadBalancedReply {
 
 struct GetValueRequest : TimedRequest {
 	constexpr static FileIdentifier file_identifier = 8454530;
+	enum { CancellableIfLost = 1 }; // See CancelReadRequest
 	SpanContext spanContext;
 	Key key;
 	Version version;
@@ -311,6 +322,64 @@ struct GetValueRequest : TimedRequest {
 	}
 };
 
+// Sent without a reply to a storage server which was asked for a read that the client has since been answered by
+// another replica. The read is identified by the token of its reply endpoint.
+struct CancelReadRequest {
+	constexpr static FileIdentifier file_identifier = 7302117;
+	UID replyToken;
+
+	CancelReadRequest() {}
+	explicit CancelReadRequest(UID replyToken) : replyToken(replyToken) {}
+
+	bool verify() const { return true; }
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, replyToken);
+	}
+};
+
+inline void StorageServerInterface::cancelLostRequest(UID replyToken) const {
+	cancelRead.send(CancelReadRequest(replyToken));
+}
+
+// Values of the keys in a GetValuesRequest which are present, in key order
+struct GetValuesReply : public LoadBalancedReply {
+	constexpr static FileIdentifier file_identifier = 4096827;
+	Arena arena;
+	VectorRef<KeyValueRef, VecSerStrategy::String> data;
+	bool cached = false;
+
+	GetValuesReply() {}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, LoadBalancedReply::penalty, LoadBalancedReply::error, data, cached, arena);
+	}
+};
+
+struct GetValuesRequest : TimedRequest {
+	constexpr static FileIdentifier file_identifier = 11632201;
+	SpanContext spanContext;
+	Arena arena;
+	VectorRef<KeyRef> keys; // Sorted and distinct, all within one shard of the receiving server
+	Version version;
+	Optional<TagSet> tags;
+	ReplyPromise<GetValuesReply> reply;
+	Optional<ReadOptions> options;
+	VersionVector ssLatestCommitVersions; // includes the latest commit versions, as known
+	                                      // to this client, of all storage replicas that
+	                                      // serve the given keys
+	GetValuesRequest() {}
+
+	bool verify() const { return true; }
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, keys, version, tags, reply, spanContext, options, ssLatestCommitVersions, arena);
+	}
+};
+
 struct WatchValueReply {
 	constexpr static FileIdentifier file_identifier = 3;
 
@@ -371,6 +440,7 @@ struct GetKeyValuesReply : public LoadBalancedReply {
 
 struct GetKeyValuesRequest : TimedRequest {
 	constexpr static FileIdentifier file_identifier = 6795746;
+	enum { CancellableIfLost = 1 }; // See CancelReadRequest
 	SpanContext spanContext;
 	Arena arena;
 	KeySelectorRef begin, end;
@@ -884,8 +954,8 @@ struct ChangeFeedStreamReply : public ReplyPromiseStreamReply {
 	}
 };
 
-// NOTE: This is obsolete and not used, but a RequestStream interface dependent on this
-// type is persisted in the database via StorageServerInterface, so just keep this around.
+// Streams the mutations captured by change feed rangeID in [begin, end) which touch range. Each reply ends with an
+// entry for the last version read, which has no mutations if nothing in range changed at that version.
 struct ChangeFeedStreamRequest {
 	constexpr static FileIdentifier file_identifier = 6795746;
 	SpanContext spanContext;
@@ -895,7 +965,7 @@ struct ChangeFeedStreamRequest {
 	Version end = 0;
 	KeyRange range;
 	int replyBufferSize = -1;
-	bool canReadPopped = true;
+	bool canReadPopped = false; // Skip to the popped version instead of failing with change_feed_popped
 	UID id; // This must be globally unique among ChangeFeedStreamRequest instances
 	Optional<ReadOptions> options;
 	bool encrypted = false;
@@ -921,8 +991,7 @@ struct ChangeFeedStreamRequest {
 	}
 };
 
-// NOTE: This is obsolete and not used, but a RequestStream interface dependent on this
-// type is persisted in the database via StorageServerInterface, so just keep this around.
+// Discards the mutations captured by change feed rangeID before version.
 struct ChangeFeedPopRequest {
 	constexpr static FileIdentifier file_identifier = 10726174;
 	Key rangeID;
@@ -1028,8 +1097,6 @@ struct FetchCheckpointKeyValuesRequest {
 	}
 };
 
-// NOTE: This is obsolete and not used, but a RequestStream interface dependent on this
-// type is persisted in the database via StorageServerInterface, so just keep this around.
 struct OverlappingChangeFeedEntry {
 	KeyRef feedId;
 	KeyRangeRef range;
@@ -1061,8 +1128,6 @@ struct OverlappingChangeFeedEntry {
 	}
 };
 
-// NOTE: This is obsolete and not used, but a RequestStream interface dependent on this
-// type is persisted in the database via StorageServerInterface, so just keep this around.
 struct OverlappingChangeFeedsReply {
 	constexpr static FileIdentifier file_identifier = 11815134;
 	VectorRef<OverlappingChangeFeedEntry> feeds;
@@ -1081,8 +1146,7 @@ struct OverlappingChangeFeedsReply {
 	}
 };
 
-// NOTE: This is obsolete and not used, but a RequestStream interface dependent on this
-// type is persisted in the database via StorageServerInterface, so just keep this around.
+// Returns the change feeds registered on the storage server which overlap range, once it has reached minVersion.
 struct OverlappingChangeFeedsRequest {
 	constexpr static FileIdentifier file_identifier = 7228462;
 	KeyRange range;
@@ -1098,8 +1162,6 @@ struct OverlappingChangeFeedsRequest {
 	}
 };
 
-// NOTE: This is obsolete and not used, but a RequestStream interface dependent on this
-// type is persisted in the database via StorageServerInterface, so just keep this around.
 struct ChangeFeedVersionUpdateReply {
 	constexpr static FileIdentifier file_identifier = 4246160;
 	Version version = 0;
@@ -1113,8 +1175,7 @@ struct ChangeFeedVersionUpdateReply {
 	}
 };
 
-// NOTE: This is obsolete and not used, but a RequestStream interface dependent on this
-// type is persisted in the database via StorageServerInterface, so just keep this around.
+// Returns the latest version at which change feeds can be read, once it is at least minVersion.
 struct ChangeFeedVersionUpdateRequest {
 	constexpr static FileIdentifier file_identifier = 6795746;
 	Version minVersion;
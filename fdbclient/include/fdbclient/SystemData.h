@@ -172,6 +172,18 @@ const Value checkpointValue(const CheckpointMetaData& checkpoint);
 UID decodeCheckpointKey(const KeyRef& key);
 CheckpointMetaData decodeCheckpointValue(const ValueRef& value);
 
+// "\xff/changeFeed/[[feedID]]" := "[[range, popVersion, ChangeFeedStatus]]"
+// The registration of a change feed. Setting it is routed by the commit proxies to the storage servers which own the
+// feed's range, which then capture the mutations to that range. Feeds are destroyed by setting the status to
+// CHANGE_FEED_DESTROY rather than by clearing the key, since a clear does not carry the range.
+enum class ChangeFeedStatus : uint8_t { CHANGE_FEED_CREATE = 0, CHANGE_FEED_STOP = 1, CHANGE_FEED_DESTROY = 2 };
+extern const KeyRangeRef changeFeedKeys;
+extern const KeyRef changeFeedPrefix;
+const Key changeFeedKeyFor(KeyRef feedID);
+Key decodeChangeFeedKey(KeyRef key);
+const Value changeFeedValue(KeyRangeRef const& range, Version popVersion, ChangeFeedStatus status);
+std::tuple<KeyRange, Version, ChangeFeedStatus> decodeChangeFeedValue(ValueRef const& value);
+
 // "\xff/dataMoves/[[UID]] := [[DataMoveMetaData]]"
 extern const KeyRangeRef dataMoveKeys;
 const Key dataMoveKeyFor(UID dataMoveId);
@@ -58,6 +58,14 @@ public:
 	ThreadFuture<int64_t> rebootWorker(const StringRef& address, bool check, int duration) override;
 	ThreadFuture<Void> forceRecoveryWithDataLoss(const StringRef& dcid) override;
 	ThreadFuture<Void> createSnapshot(const StringRef& uid, const StringRef& snapshot_command) override;
+	ThreadFuture<Void> createChangeFeed(const KeyRef& feedID, const KeyRangeRef& range) override;
+	ThreadFuture<Void> destroyChangeFeed(const KeyRef& feedID) override;
+	ThreadFuture<Void> popChangeFeed(const KeyRef& feedID, Version version) override;
+	ThreadFuture<ChangeFeedReadResult> readChangeFeed(const KeyRef& feedID,
+	                                                  Version begin,
+	                                                  Version end,
+	                                                  const KeyRangeRef& range,
+	                                                  int targetBytes) override;
 
 	ThreadFuture<DatabaseSharedState*> createSharedState() override;
 	void setSharedState(DatabaseSharedState* p) override;
@@ -92,6 +100,8 @@ public:
 	ThreadFuture<Version> getReadVersion() override;
 
 	ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) override;
+	ThreadFuture<Standalone<VectorRef<OptionalValueRef>>> getValues(const VectorRef<KeyRef>& keys,
+	                                                                bool snapshot = false) override;
 	ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) override;
 	ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                   const KeySelectorRef& end,
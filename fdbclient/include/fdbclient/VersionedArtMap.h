@@ -0,0 +1,1226 @@
+/*
+ * VersionedArtMap.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBCLIENT_VERSIONEDARTMAP_H
+#define FDBCLIENT_VERSIONEDARTMAP_H
+#pragma once
+
+#include <variant>
+
+#include "fdbclient/VersionedMap.h"
+
+// VersionedArtImpl is a partially persistent adaptive radix tree (ART) over KeyRef keys.
+//
+// Inner nodes are one of four sizes (4, 16, 48 or 256 children, indexed by the next key byte) with a compressed path
+// prefix, and a key which ends at an inner node is held in that node's terminal leaf.  Leaves hold the key, the value
+// and the version the value was inserted at, and are never modified once created.
+//
+// Persistence is by path copying: each inner node records the version it was created at, and is modified in place by
+// changes at that version but copied by changes at any later version.  Nodes are reference counted and shared between
+// the trees of all versions, so a version with few changes costs a few node copies along the changed paths.
+//
+// Path prefixes longer than MAX_PREFIX bytes are only partially stored in the node; the rest is read from any leaf
+// below it, which has the same key bytes at that depth.
+namespace VersionedArtImpl {
+
+enum NodeType : uint8_t { LEAF, NODE4, NODE16, NODE48, NODE256 };
+
+constexpr int MAX_PREFIX = 12;
+constexpr int NO_SLOT = -1;
+
+template <class T>
+struct Tree {
+	// Nodes implement the reference counting interface of Reference<> themselves, so that a single
+	// Reference<Node> can be freed according to its type
+	struct Node {
+		uint32_t referenceCount;
+		NodeType type;
+
+		explicit Node(NodeType type) : referenceCount(1), type(type) {}
+		Node(Node const& n) : referenceCount(1), type(n.type) {}
+
+		void addref() { ++referenceCount; }
+		void delref() {
+			if (--referenceCount == 0) {
+				destroy(this);
+			}
+		}
+		bool isSoleOwner() const { return referenceCount == 1; }
+		bool isLeaf() const { return type == LEAF; }
+
+		// Lets deferredCleanupActor() free a tree a few nodes at a time
+		friend void releaseSoleOwnedChildren(Reference<Node>& node, std::vector<Reference<Node>>& toFree) {
+			if (!node->isLeaf()) {
+				Tree::releaseSoleOwnedChildren(static_cast<Inner*>(node.getPtr()), toFree);
+			}
+		}
+	};
+
+	struct Leaf : Node, FastAllocated<Leaf> {
+		KeyRef key;
+		T value;
+		Version insertVersion;
+
+		Leaf(KeyRef key, T const& value, Version insertVersion)
+		  : Node(LEAF), key(key), value(value), insertVersion(insertVersion) {}
+	};
+
+	struct Inner : Node {
+		uint16_t numChildren;
+		uint32_t prefixLen;
+		uint8_t prefix[MAX_PREFIX];
+		Version version; // The version this node was created at, and so may be modified in place at
+		Reference<Leaf> terminal; // The key which ends at this node, if any
+
+		Inner(NodeType type, Version version) : Node(type), numChildren(0), prefixLen(0), version(version) {}
+		Inner(NodeType type, Inner const& from, Version version)
+		  : Node(type), numChildren(from.numChildren), prefixLen(from.prefixLen), version(version),
+		    terminal(from.terminal) {
+			memcpy(prefix, from.prefix, MAX_PREFIX);
+		}
+
+		int slots() const { return numChildren + (terminal ? 1 : 0); }
+	};
+
+	// Node4 and Node16 keep their children sorted by key byte
+	struct Node4 : Inner, FastAllocated<Node4> {
+		uint8_t keys[4];
+		Reference<Node> children[4];
+		explicit Node4(Version v) : Inner(NODE4, v) {}
+		Node4(Inner const& from, Version v) : Inner(NODE4, from, v) {}
+	};
+
+	struct Node16 : Inner, FastAllocated<Node16> {
+		uint8_t keys[16];
+		Reference<Node> children[16];
+		explicit Node16(Version v) : Inner(NODE16, v) {}
+		Node16(Inner const& from, Version v) : Inner(NODE16, from, v) {}
+	};
+
+	struct Node48 : Inner, FastAllocated<Node48> {
+		uint8_t index[256]; // 1 + the position in children of the child for each key byte, or 0
+		Reference<Node> children[48];
+		explicit Node48(Version v) : Inner(NODE48, v) { memset(index, 0, sizeof(index)); }
+		Node48(Inner const& from, Version v) : Inner(NODE48, from, v) { memset(index, 0, sizeof(index)); }
+	};
+
+	struct Node256 : Inner, FastAllocated<Node256> {
+		Reference<Node> children[256];
+		explicit Node256(Version v) : Inner(NODE256, v) {}
+		Node256(Inner const& from, Version v) : Inner(NODE256, from, v) {}
+	};
+
+	template <class Children>
+	static void releaseSoleOwned(Children& children, std::vector<Reference<Node>>& toFree) {
+		for (auto& child : children) {
+			if (child && child->isSoleOwner()) {
+				toFree.push_back(std::move(child));
+			}
+		}
+	}
+
+	static void releaseSoleOwnedChildren(Inner* n, std::vector<Reference<Node>>& toFree) {
+		switch (n->type) {
+		case NODE4:
+			releaseSoleOwned(static_cast<Node4*>(n)->children, toFree);
+			break;
+		case NODE16:
+			releaseSoleOwned(static_cast<Node16*>(n)->children, toFree);
+			break;
+		case NODE48:
+			releaseSoleOwned(static_cast<Node48*>(n)->children, toFree);
+			break;
+		default:
+			releaseSoleOwned(static_cast<Node256*>(n)->children, toFree);
+			break;
+		}
+	}
+
+	static void destroy(Node* n) {
+		switch (n->type) {
+		case LEAF:
+			delete static_cast<Leaf*>(n);
+			break;
+		case NODE4:
+			delete static_cast<Node4*>(n);
+			break;
+		case NODE16:
+			delete static_cast<Node16*>(n);
+			break;
+		case NODE48:
+			delete static_cast<Node48*>(n);
+			break;
+		case NODE256:
+			delete static_cast<Node256*>(n);
+			break;
+		}
+	}
+
+	// Returns a copy of n which may be modified at version at
+	static Reference<Node> clone(Inner const* n, Version at) {
+		Inner* c;
+		switch (n->type) {
+		case NODE4:
+			c = new Node4(*static_cast<Node4 const*>(n));
+			break;
+		case NODE16:
+			c = new Node16(*static_cast<Node16 const*>(n));
+			break;
+		case NODE48:
+			c = new Node48(*static_cast<Node48 const*>(n));
+			break;
+		default:
+			ASSERT(n->type == NODE256);
+			c = new Node256(*static_cast<Node256 const*>(n));
+			break;
+		}
+		c->version = at;
+		return Reference<Node>(c);
+	}
+
+	// Returns the node at ref, copying it into ref first unless it was created at version at
+	static Inner* writable(Reference<Node>& ref, Version at) {
+		Inner* n = static_cast<Inner*>(ref.getPtr());
+		if (n->version != at) {
+			ref = clone(n, at);
+			n = static_cast<Inner*>(ref.getPtr());
+		}
+		return n;
+	}
+
+	// Returns a pointer to the child of n for key byte c, or nullptr
+	static Reference<Node>* findChild(Inner* n, uint8_t c) {
+		switch (n->type) {
+		case NODE4: {
+			Node4* n4 = static_cast<Node4*>(n);
+			for (int i = 0; i < n->numChildren; ++i) {
+				if (n4->keys[i] == c) {
+					return &n4->children[i];
+				}
+			}
+			return nullptr;
+		}
+		case NODE16: {
+			Node16* n16 = static_cast<Node16*>(n);
+			for (int i = 0; i < n->numChildren; ++i) {
+				if (n16->keys[i] == c) {
+					return &n16->children[i];
+				}
+			}
+			return nullptr;
+		}
+		case NODE48: {
+			Node48* n48 = static_cast<Node48*>(n);
+			return n48->index[c] ? &n48->children[n48->index[c] - 1] : nullptr;
+		}
+		default: {
+			Node256* n256 = static_cast<Node256*>(n);
+			return n256->children[c] ? &n256->children[c] : nullptr;
+		}
+		}
+	}
+
+	static Node* findChild(Inner const* n, uint8_t c) {
+		Reference<Node>* r = findChild(const_cast<Inner*>(n), c);
+		return r ? r->getPtr() : nullptr;
+	}
+
+	// The entries of an inner node are numbered by slot: slot 0 is the terminal leaf, and slot 1 + b is the child for
+	// key byte b, so that slot order is key order.
+
+	static Node* slotNode(Inner const* n, int slot) {
+		return slot == 0 ? n->terminal.getPtr() : findChild(n, (uint8_t)(slot - 1));
+	}
+
+	// Returns the first occupied slot after slot, which may be NO_SLOT to start from the beginning, or NO_SLOT
+	static int nextSlot(Inner const* n, int slot) {
+		if (slot < 0 && n->terminal) {
+			return 0;
+		}
+		int minByte = std::max(slot, 0);
+		switch (n->type) {
+		case NODE4:
+		case NODE16: {
+			uint8_t const* keys =
+			    n->type == NODE4 ? static_cast<Node4 const*>(n)->keys : static_cast<Node16 const*>(n)->keys;
+			for (int i = 0; i < n->numChildren; ++i) {
+				if (keys[i] >= minByte) {
+					return 1 + keys[i];
+				}
+			}
+			return NO_SLOT;
+		}
+		case NODE48: {
+			Node48 const* n48 = static_cast<Node48 const*>(n);
+			for (int b = minByte; b < 256; ++b) {
+				if (n48->index[b]) {
+					return 1 + b;
+				}
+			}
+			return NO_SLOT;
+		}
+		default: {
+			Node256 const* n256 = static_cast<Node256 const*>(n);
+			for (int b = minByte; b < 256; ++b) {
+				if (n256->children[b]) {
+					return 1 + b;
+				}
+			}
+			return NO_SLOT;
+		}
+		}
+	}
+
+	// Returns the last occupied slot before slot, which may be 257 to start from the end, or NO_SLOT
+	static int prevSlot(Inner const* n, int slot) {
+		int maxByte = std::min(slot - 2, 255);
+		switch (n->type) {
+		case NODE4:
+		case NODE16: {
+			uint8_t const* keys =
+			    n->type == NODE4 ? static_cast<Node4 const*>(n)->keys : static_cast<Node16 const*>(n)->keys;
+			for (int i = n->numChildren - 1; i >= 0; --i) {
+				if (keys[i] <= maxByte) {
+					return 1 + keys[i];
+				}
+			}
+			break;
+		}
+		case NODE48: {
+			Node48 const* n48 = static_cast<Node48 const*>(n);
+			for (int b = maxByte; b >= 0; --b) {
+				if (n48->index[b]) {
+					return 1 + b;
+				}
+			}
+			break;
+		}
+		default: {
+			Node256 const* n256 = static_cast<Node256 const*>(n);
+			for (int b = maxByte; b >= 0; --b) {
+				if (n256->children[b]) {
+					return 1 + b;
+				}
+			}
+			break;
+		}
+		}
+		return slot > 0 && n->terminal ? 0 : NO_SLOT;
+	}
+
+	static Leaf const* minimumLeaf(Node const* n) {
+		while (!n->isLeaf()) {
+			Inner const* in = static_cast<Inner const*>(n);
+			n = slotNode(in, nextSlot(in, NO_SLOT));
+		}
+		return static_cast<Leaf const*>(n);
+	}
+
+	// Returns the full prefix of n, which is at the given depth
+	static uint8_t const* prefixBytes(Inner const* n, int depth) {
+		return n->prefixLen <= MAX_PREFIX ? n->prefix : minimumLeaf(n)->key.begin() + depth;
+	}
+
+	static void setPrefix(Inner* n, uint8_t const* bytes, int len) {
+		n->prefixLen = len;
+		memmove(n->prefix, bytes, std::min(len, MAX_PREFIX));
+	}
+
+	// Adds a child for key byte c, which n must not have.  n must be writable and at ref; if n is full, it is replaced
+	// at ref by a larger node.
+	static void addChild(Reference<Node>& ref, Inner* n, uint8_t c, Reference<Node>&& child, Version at) {
+		switch (n->type) {
+		case NODE4:
+		case NODE16: {
+			bool small = n->type == NODE4;
+			int capacity = small ? 4 : 16;
+			uint8_t* keys = small ? static_cast<Node4*>(n)->keys : static_cast<Node16*>(n)->keys;
+			Reference<Node>* children = small ? static_cast<Node4*>(n)->children : static_cast<Node16*>(n)->children;
+			if (n->numChildren < capacity) {
+				int i = n->numChildren;
+				while (i > 0 && keys[i - 1] > c) {
+					keys[i] = keys[i - 1];
+					children[i] = std::move(children[i - 1]);
+					--i;
+				}
+				keys[i] = c;
+				children[i] = std::move(child);
+				++n->numChildren;
+				return;
+			}
+			Inner* grown;
+			if (small) {
+				Node16* n16 = new Node16(*n, at);
+				for (int i = 0; i < 4; ++i) {
+					n16->keys[i] = keys[i];
+					n16->children[i] = std::move(children[i]);
+				}
+				grown = n16;
+			} else {
+				Node48* n48 = new Node48(*n, at);
+				for (int i = 0; i < 16; ++i) {
+					n48->index[keys[i]] = i + 1;
+					n48->children[i] = std::move(children[i]);
+				}
+				grown = n48;
+			}
+			ref = Reference<Node>(grown);
+			addChild(ref, grown, c, std::move(child), at);
+			return;
+		}
+		case NODE48: {
+			Node48* n48 = static_cast<Node48*>(n);
+			if (n->numChildren < 48) {
+				int i = 0;
+				while (n48->children[i]) {
+					++i;
+				}
+				n48->children[i] = std::move(child);
+				n48->index[c] = i + 1;
+				++n->numChildren;
+				return;
+			}
+			Node256* n256 = new Node256(*n, at);
+			for (int b = 0; b < 256; ++b) {
+				if (n48->index[b]) {
+					n256->children[b] = std::move(n48->children[n48->index[b] - 1]);
+				}
+			}
+			ref = Reference<Node>(n256);
+			addChild(ref, n256, c, std::move(child), at);
+			return;
+		}
+		default: {
+			Node256* n256 = static_cast<Node256*>(n);
+			n256->children[c] = std::move(child);
+			++n->numChildren;
+			return;
+		}
+		}
+	}
+
+	// Removes the child for key byte c, which n must have.  n must be writable and at ref; if n is sparse enough, it
+	// is replaced at ref by a smaller node.
+	static void removeChild(Reference<Node>& ref, Inner* n, uint8_t c, Version at) {
+		switch (n->type) {
+		case NODE4:
+		case NODE16: {
+			bool small = n->type == NODE4;
+			uint8_t* keys = small ? static_cast<Node4*>(n)->keys : static_cast<Node16*>(n)->keys;
+			Reference<Node>* children = small ? static_cast<Node4*>(n)->children : static_cast<Node16*>(n)->children;
+			int i = 0;
+			while (keys[i] != c) {
+				++i;
+			}
+			for (; i + 1 < n->numChildren; ++i) {
+				keys[i] = keys[i + 1];
+				children[i] = std::move(children[i + 1]);
+			}
+			children[i].clear();
+			--n->numChildren;
+			if (!small && n->numChildren <= 3) {
+				Node4* n4 = new Node4(*n, at);
+				for (int j = 0; j < n->numChildren; ++j) {
+					n4->keys[j] = keys[j];
+					n4->children[j] = std::move(children[j]);
+				}
+				ref = Reference<Node>(n4);
+			}
+			return;
+		}
+		case NODE48: {
+			Node48* n48 = static_cast<Node48*>(n);
+			n48->children[n48->index[c] - 1].clear();
+			n48->index[c] = 0;
+			--n->numChildren;
+			if (n->numChildren <= 12) {
+				Node16* n16 = new Node16(*n, at);
+				int j = 0;
+				for (int b = 0; b < 256; ++b) {
+					if (n48->index[b]) {
+						n16->keys[j] = b;
+						n16->children[j++] = std::move(n48->children[n48->index[b] - 1]);
+					}
+				}
+				ref = Reference<Node>(n16);
+			}
+			return;
+		}
+		default: {
+			Node256* n256 = static_cast<Node256*>(n);
+			n256->children[c].clear();
+			--n->numChildren;
+			if (n->numChildren <= 37) {
+				Node48* n48 = new Node48(*n, at);
+				int j = 0;
+				for (int b = 0; b < 256; ++b) {
+					if (n256->children[b]) {
+						n48->index[b] = j + 1;
+						n48->children[j++] = std::move(n256->children[b]);
+					}
+				}
+				ref = Reference<Node>(n48);
+			}
+			return;
+		}
+		}
+	}
+
+	// Places leaf as the terminal of n or as its child, depending on whether its key ends at depth
+	static void placeLeaf(Reference<Node>& ref, Inner* n, Reference<Leaf>&& leaf, int depth, Version at) {
+		if (leaf->key.size() == depth) {
+			n->terminal = std::move(leaf);
+		} else {
+			uint8_t c = leaf->key[depth];
+			addChild(ref, n, c, std::move(leaf), at);
+		}
+	}
+
+	// Inserts leaf into the tree at root, which must be writable at version at
+	static void insert(Reference<Node>& root, Reference<Leaf>&& leaf, Version at) {
+		KeyRef key = leaf->key;
+		Reference<Node>* ref = &root;
+		int depth = 0;
+		loop {
+			Inner* n = writable(*ref, at);
+			if (n->prefixLen) {
+				int p = n->prefixLen;
+				uint8_t const* prefix = prefixBytes(n, depth);
+				int m = std::min<int>(p, key.size() - depth);
+				int i = 0;
+				while (i < m && key[depth + i] == prefix[i]) {
+					++i;
+				}
+				if (i < p) {
+					// The key leaves the prefix after i bytes, so split the prefix there with a new node above n
+					Reference<Node> split(new Node4(at));
+					Inner* s = static_cast<Inner*>(split.getPtr());
+					setPrefix(s, prefix, i);
+					uint8_t c = prefix[i];
+					setPrefix(n, prefix + i + 1, p - i - 1);
+					addChild(split, s, c, std::move(*ref), at);
+					placeLeaf(split, s, std::move(leaf), depth + i, at);
+					*ref = std::move(split);
+					return;
+				}
+				depth += p;
+			}
+			if (depth == key.size()) {
+				n->terminal = std::move(leaf);
+				return;
+			}
+
+			uint8_t c = key[depth];
+			Reference<Node>* child = findChild(n, c);
+			if (!child) {
+				addChild(*ref, n, c, std::move(leaf), at);
+				return;
+			}
+			if ((*child)->isLeaf()) {
+				Leaf* existing = static_cast<Leaf*>(child->getPtr());
+				if (existing->key == key) {
+					*child = std::move(leaf);
+					return;
+				}
+				// Both keys continue below here, so put them under a new node with their common prefix
+				int d = depth + 1;
+				int m = std::min(existing->key.size(), key.size()) - d;
+				int common = 0;
+				while (common < m && existing->key[d + common] == key[d + common]) {
+					++common;
+				}
+				Reference<Node> split(new Node4(at));
+				Inner* s = static_cast<Inner*>(split.getPtr());
+				setPrefix(s, key.begin() + d, common);
+				Reference<Leaf> existingRef = Reference<Leaf>::addRef(existing);
+				placeLeaf(split, s, std::move(existingRef), d + common, at);
+				placeLeaf(split, s, std::move(leaf), d + common, at);
+				*child = std::move(split);
+				return;
+			}
+			ref = child;
+			depth += 1;
+		}
+	}
+
+	// Replaces the node at ref, which must be writable, by its only entry if it has one.  Nodes other than the root
+	// always have at least two entries.
+	static void collapse(Reference<Node>& ref, Version at) {
+		Inner* n = static_cast<Inner*>(ref.getPtr());
+		if (n->slots() != 1) {
+			return;
+		}
+		if (n->terminal) {
+			ref = std::move(n->terminal);
+			return;
+		}
+		int slot = nextSlot(n, NO_SLOT);
+		uint8_t c = slot - 1;
+		Reference<Node>* only = findChild(n, c);
+		if (!(*only)->isLeaf()) {
+			// The child's prefix becomes n's prefix, c, and then its own prefix
+			uint8_t merged[MAX_PREFIX];
+			int len = std::min<int>(n->prefixLen, MAX_PREFIX);
+			memcpy(merged, n->prefix, len);
+			if (len < MAX_PREFIX) {
+				merged[len++] = c;
+			}
+			Inner* child = writable(*only, at);
+			int rest = std::min<int>(child->prefixLen, MAX_PREFIX - len);
+			memcpy(merged + len, child->prefix, rest);
+			child->prefixLen += n->prefixLen + 1;
+			memcpy(child->prefix, merged, std::min<int>(child->prefixLen, MAX_PREFIX));
+		}
+		Reference<Node> replacement = std::move(*only);
+		ref = std::move(replacement);
+	}
+
+	// Removes key, which must be present, from the tree at root, which must be writable at version at
+	static void erase(Reference<Node>& root, KeyRef key, Version at) {
+		ASSERT(root);
+		Reference<Node>* ref = &root;
+		bool isRoot = true;
+		int depth = 0;
+		loop {
+			Inner* n = writable(*ref, at);
+			// The key is present, so it matches the prefix
+			depth += n->prefixLen;
+			if (depth == (int)key.size()) {
+				ASSERT(n->terminal && n->terminal->key == key);
+				n->terminal.clear();
+				break;
+			}
+			uint8_t c = key[depth];
+			Reference<Node>* child = findChild(n, c);
+			ASSERT(child != nullptr);
+			if ((*child)->isLeaf()) {
+				ASSERT(static_cast<Leaf*>(child->getPtr())->key == key);
+				removeChild(*ref, n, c, at);
+				break;
+			}
+			ref = child;
+			isRoot = false;
+			depth += 1;
+		}
+		if (!isRoot) {
+			collapse(*ref, at);
+		}
+	}
+
+	// Checks the structure of the subtree at n, whose keys all start with the given prefix, and counts its leaves
+	static void validate(Node const* n, KeyRef prefix, bool isRoot, int& count, Optional<KeyRef>& lastKey) {
+		if (n->isLeaf()) {
+			Leaf const* l = static_cast<Leaf const*>(n);
+			ASSERT(l->key.startsWith(prefix));
+			ASSERT(!lastKey.present() || lastKey.get() < l->key);
+			lastKey = l->key;
+			++count;
+			return;
+		}
+		Inner const* in = static_cast<Inner const*>(n);
+		ASSERT(isRoot || in->slots() >= 2);
+		Standalone<StringRef> full = prefix.withSuffix(
+		    in->prefixLen ? StringRef(prefixBytes(in, prefix.size()), in->prefixLen) : StringRef());
+		int children = 0;
+		for (int s = nextSlot(in, NO_SLOT); s != NO_SLOT; s = nextSlot(in, s)) {
+			if (s == 0) {
+				ASSERT(in->terminal->key == full);
+				validate(in->terminal.getPtr(), full, false, count, lastKey);
+			} else {
+				++children;
+				uint8_t c = s - 1;
+				validate(slotNode(in, s), full.withSuffix(StringRef(&c, 1)), false, count, lastKey);
+			}
+		}
+		ASSERT(children == in->numChildren);
+	}
+
+	// A position in a tree: the path of (inner node, slot) pairs from the root to a leaf.  Paths up to INLINE_DEPTH
+	// deep need no allocation.
+	struct Frame {
+		Inner const* node;
+		int slot;
+	};
+
+	class Path {
+		static constexpr int INLINE_DEPTH = 24;
+		Frame inlineFrames[INLINE_DEPTH];
+		std::vector<Frame> overflow;
+		int size_ = 0;
+
+	public:
+		Path() {}
+		Path(Path const& p) { *this = p; }
+		Path& operator=(Path const& p) {
+			size_ = p.size_;
+			std::copy(p.inlineFrames, p.inlineFrames + std::min(size_, INLINE_DEPTH), inlineFrames);
+			overflow = p.overflow;
+			return *this;
+		}
+
+		int size() const { return size_; }
+		void clear() {
+			size_ = 0;
+			overflow.clear();
+		}
+		Frame& back() { return size_ > INLINE_DEPTH ? overflow.back() : inlineFrames[size_ - 1]; }
+		void push_back(Frame f) {
+			if (size_ >= INLINE_DEPTH) {
+				overflow.push_back(f);
+			} else {
+				inlineFrames[size_] = f;
+			}
+			++size_;
+		}
+		void pop_back() {
+			if (size_ > INLINE_DEPTH) {
+				overflow.pop_back();
+			}
+			--size_;
+		}
+	};
+
+	struct Cursor {
+		Path path;
+		Leaf const* leaf = nullptr; // nullptr at the end
+
+		// Moves to the first leaf under n, which is below the current path
+		void descendFirst(Node const* n) {
+			while (!n->isLeaf()) {
+				Inner const* in = static_cast<Inner const*>(n);
+				int s = nextSlot(in, NO_SLOT);
+				if (s == NO_SLOT) { // Only an empty root has no entries
+					clear();
+					return;
+				}
+				path.push_back(Frame{ in, s });
+				n = slotNode(in, s);
+			}
+			leaf = static_cast<Leaf const*>(n);
+		}
+
+		void descendLast(Node const* n) {
+			while (!n->isLeaf()) {
+				Inner const* in = static_cast<Inner const*>(n);
+				int s = prevSlot(in, 257);
+				if (s == NO_SLOT) {
+					clear();
+					return;
+				}
+				path.push_back(Frame{ in, s });
+				n = slotNode(in, s);
+			}
+			leaf = static_cast<Leaf const*>(n);
+		}
+
+		void clear() {
+			path.clear();
+			leaf = nullptr;
+		}
+
+		// Moves to the first leaf after the subtree at the end of the path
+		void ascendNext() {
+			while (path.size()) {
+				Frame& f = path.back();
+				int s = nextSlot(f.node, f.slot);
+				if (s != NO_SLOT) {
+					f.slot = s;
+					descendFirst(slotNode(f.node, s));
+					return;
+				}
+				path.pop_back();
+			}
+			leaf = nullptr;
+		}
+
+		void ascendPrevious() {
+			while (path.size()) {
+				Frame& f = path.back();
+				int s = prevSlot(f.node, f.slot);
+				if (s != NO_SLOT) {
+					f.slot = s;
+					descendLast(slotNode(f.node, s));
+					return;
+				}
+				path.pop_back();
+			}
+			leaf = nullptr;
+		}
+
+		// Moves to the first leaf with a key >= key, or > key if strict
+		void seek(Node const* root, KeyRef key, bool strict) {
+			clear();
+			if (!root) {
+				return;
+			}
+			Inner const* n = static_cast<Inner const*>(root);
+			int depth = 0;
+			loop {
+				if (n->prefixLen) {
+					int p = n->prefixLen;
+					int m = std::min<int>(p, key.size() - depth);
+					int cmp = memcmp(key.begin() + depth, prefixBytes(n, depth), m);
+					if (cmp < 0 || (cmp == 0 && m < p)) {
+						// Everything under n is greater than key
+						descendFirst(n);
+						return;
+					}
+					if (cmp > 0) {
+						ascendNext();
+						return;
+					}
+					depth += p;
+				}
+				if (depth == key.size()) {
+					if (n->terminal && !strict) {
+						path.push_back(Frame{ n, 0 });
+						leaf = n->terminal.getPtr();
+						return;
+					}
+					path.push_back(Frame{ n, 0 });
+					ascendNext();
+					return;
+				}
+				uint8_t c = key[depth];
+				Node const* child = findChild(n, c);
+				path.push_back(Frame{ n, 1 + c });
+				if (!child) {
+					ascendNext();
+					return;
+				}
+				if (child->isLeaf()) {
+					Leaf const* l = static_cast<Leaf const*>(child);
+					int cmp = l->key.compare(key);
+					if (cmp < 0 || (cmp == 0 && strict)) {
+						ascendNext();
+					} else {
+						leaf = l;
+					}
+					return;
+				}
+				n = static_cast<Inner const*>(child);
+				depth += 1;
+			}
+		}
+	};
+};
+
+} // namespace VersionedArtImpl
+
+// VersionedArtMap has the interface of VersionedMap<KeyRef, T>, but is implemented by a partially persistent adaptive
+// radix tree (see VersionedArtImpl) instead of a PTree.  It needs less memory per item, since items do not need their
+// own search tree node, and point reads visit one node per distinguishing key byte instead of one per tree level.
+template <class T>
+class VersionedArtMap : NonCopyable {
+public:
+	typedef VersionedArtImpl::Tree<T> ArtTree;
+	typedef typename ArtTree::Node Node;
+	typedef typename ArtTree::Leaf Leaf;
+	typedef Reference<Node> Tree;
+
+	Version oldestVersion, latestVersion;
+
+	// The root of the tree at each version, sorted by version
+	std::deque<std::pair<Version, Tree>> roots;
+
+	struct rootsComparator {
+		bool operator()(const std::pair<Version, Tree>& value, const Version& key) { return (value.first < key); }
+		bool operator()(const Version& key, const std::pair<Version, Tree>& value) { return (key < value.first); }
+	};
+
+	Tree const& getRoot(Version v) const {
+		auto r = upper_bound(roots.begin(), roots.end(), v, rootsComparator());
+		--r;
+		return r->second;
+	}
+
+	struct iterator;
+
+	VersionedArtMap() : oldestVersion(0), latestVersion(0) { roots.emplace_back(0, Tree()); }
+	VersionedArtMap(VersionedArtMap&& v) noexcept
+	  : oldestVersion(v.oldestVersion), latestVersion(v.latestVersion), roots(std::move(v.roots)) {}
+	void operator=(VersionedArtMap&& v) noexcept {
+		oldestVersion = v.oldestVersion;
+		latestVersion = v.latestVersion;
+		roots = std::move(v.roots);
+	}
+
+	Version getLatestVersion() const { return latestVersion; }
+	Version getOldestVersion() const { return oldestVersion; }
+
+	void forgetVersionsBefore(Version newOldestVersion) {
+		ASSERT(newOldestVersion <= latestVersion);
+		auto r = upper_bound(roots.begin(), roots.end(), newOldestVersion, rootsComparator());
+		auto upper = r;
+		--r;
+		if (r->first != newOldestVersion) {
+			r = roots.emplace(upper, newOldestVersion, getRoot(newOldestVersion));
+		}
+
+		UNSTOPPABLE_ASSERT(r->first == newOldestVersion);
+		roots.erase(roots.begin(), r);
+		oldestVersion = newOldestVersion;
+	}
+
+	Future<Void> forgetVersionsBeforeAsync(Version newOldestVersion, TaskPriority taskID = TaskPriority::DefaultYield) {
+		ASSERT_LE(newOldestVersion, latestVersion);
+		auto r = upper_bound(roots.begin(), roots.end(), newOldestVersion, rootsComparator());
+		auto upper = r;
+		--r;
+		if (r->first != newOldestVersion) {
+			r = roots.emplace(upper, newOldestVersion, getRoot(newOldestVersion));
+		}
+
+		UNSTOPPABLE_ASSERT(r->first == newOldestVersion);
+
+		std::vector<Tree> toFree;
+		auto newBegin = r;
+		for (auto root = roots.begin(); root != newBegin; ++root) {
+			if (root->second && root->second->isSoleOwner()) {
+				toFree.push_back(std::move(root->second));
+			}
+		}
+
+		roots.erase(roots.begin(), newBegin);
+		oldestVersion = newOldestVersion;
+		return deferredCleanupActor(toFree, taskID);
+	}
+
+	// following sets and erases are into the given version, which may now be passed to at().  Must be called in
+	// monotonically increasing order.
+	void createNewVersion(Version version) {
+		if (version > latestVersion) {
+			latestVersion = version;
+			Tree r = getRoot(version);
+			roots.emplace_back(version, r);
+		} else
+			ASSERT(version == latestVersion);
+	}
+
+	// insert() and erase() invalidate atLatest() and all iterators into it
+	void insert(const KeyRef& k, const T& t) { insert(k, t, latestVersion); }
+	void insert(const KeyRef& k, const T& t, Version insertAt) {
+		Tree& root = roots.back().second;
+		if (!root) {
+			root = Tree(new typename ArtTree::Node4(latestVersion));
+		}
+		ArtTree::insert(root, makeReference<Leaf>(k, t, insertAt), latestVersion);
+	}
+	void erase(const KeyRef& begin, const KeyRef& end) {
+		loop {
+			auto i = atLatest().lower_bound(begin);
+			if (!i || !(i.key() < end)) {
+				break;
+			}
+			KeyRef key = i.key(); // Not a reference into the leaf being erased
+			erase(key);
+		}
+	}
+	void erase(const KeyRef& key) { // key must be present
+		ArtTree::erase(roots.back().second, key, latestVersion);
+	}
+	void erase(iterator const& item) { // iterator must be in latest version!
+		ASSERT_EQ(item.at, latestVersion);
+		KeyRef key = item.key();
+		erase(key);
+	}
+
+	struct iterator {
+		explicit iterator(Tree const& root, Version at) : root(root), at(at) {}
+
+		KeyRef const& key() const { return cursor.leaf->key; }
+		// Returns the version at which the current item was inserted
+		Version insertVersion() const { return cursor.leaf->insertVersion; }
+		operator bool() const { return cursor.leaf != nullptr; }
+		bool operator<(const KeyRef& key) const { return this->key() < key; }
+
+		T const& operator*() { return cursor.leaf->value; }
+		T const* operator->() { return &cursor.leaf->value; }
+		void operator++() {
+			if (cursor.leaf)
+				cursor.ascendNext();
+			else if (root)
+				cursor.descendFirst(root.getPtr());
+		}
+		void operator--() {
+			if (cursor.leaf)
+				cursor.ascendPrevious();
+			else if (root)
+				cursor.descendLast(root.getPtr());
+		}
+		bool operator==(const iterator& r) const { return cursor.leaf == r.cursor.leaf; }
+		bool operator!=(const iterator& r) const { return cursor.leaf != r.cursor.leaf; }
+
+	private:
+		friend class VersionedArtMap<T>;
+		Tree root;
+		Version at;
+		typename ArtTree::Cursor cursor;
+	};
+
+	class ViewAtVersion {
+	public:
+		ViewAtVersion(Tree const& root, Version at) : root(root), at(at) {}
+
+		iterator begin() const {
+			iterator i(root, at);
+			if (root)
+				i.cursor.descendFirst(root.getPtr());
+			return i;
+		}
+		iterator end() const { return iterator(root, at); }
+
+		// Returns x such that key==*x, or end()
+		iterator find(const KeyRef& key) const {
+			iterator i = lower_bound(key);
+			if (i && i.key() == key)
+				return i;
+			else
+				return end();
+		}
+
+		// Returns the smallest x such that *x>=key, or end()
+		iterator lower_bound(const KeyRef& key) const {
+			iterator i(root, at);
+			i.cursor.seek(root.getPtr(), key, false);
+			return i;
+		}
+
+		// Returns the smallest x such that *x>key, or end()
+		iterator upper_bound(const KeyRef& key) const {
+			iterator i(root, at);
+			i.cursor.seek(root.getPtr(), key, true);
+			return i;
+		}
+
+		// Returns the largest x such that *x<=key, or end()
+		iterator lastLessOrEqual(const KeyRef& key) const {
+			iterator i = upper_bound(key);
+			--i;
+			return i;
+		}
+
+		// Returns the largest x such that *x<key, or end()
+		iterator lastLess(const KeyRef& key) const {
+			iterator i = lower_bound(key);
+			--i;
+			return i;
+		}
+
+		void validate() {
+			if (!root)
+				return;
+			int count = 0;
+			Optional<KeyRef> lastKey;
+			ArtTree::validate(root.getPtr(), KeyRef(), true, count, lastKey);
+		}
+
+	private:
+		Tree root;
+		Version at;
+	};
+
+	ViewAtVersion at(Version v) const {
+		if (v == ::latestVersion) {
+			return atLatest();
+		}
+
+		return ViewAtVersion(getRoot(v), v);
+	}
+	ViewAtVersion atLatest() const { return ViewAtVersion(roots.back().second, latestVersion); }
+
+	bool isClearContaining(ViewAtVersion const& view, KeyRef key) {
+		auto i = view.lastLessOrEqual(key);
+		return i && i->isClearTo() && i->getEndKey() > key;
+	}
+};
+
+// AnyVersionedMap is a VersionedMap<KeyRef, T> or a VersionedArtMap<T>, chosen when it is constructed, behind the
+// VersionedMap interface.
+template <class T>
+class AnyVersionedMap : NonCopyable {
+public:
+	typedef VersionedMap<KeyRef, T> PTreeMap;
+	typedef VersionedArtMap<T> ArtMap;
+	typedef typename PTreeMap::PTreeT PTreeT;
+
+	// An upper bound for both implementations
+	static const int overheadPerItem = PTreeMap::overheadPerItem;
+
+	explicit AnyVersionedMap(bool useArt = false) {
+		if (useArt) {
+			impl.template emplace<ArtMap>();
+		}
+	}
+
+	bool isArt() const { return impl.index() == 1; }
+
+	Version getLatestVersion() const {
+		return visit([](auto const& m) { return m.getLatestVersion(); });
+	}
+	Version getOldestVersion() const {
+		return visit([](auto const& m) { return m.getOldestVersion(); });
+	}
+
+	void forgetVersionsBefore(Version newOldestVersion) {
+		visit([&](auto& m) { m.forgetVersionsBefore(newOldestVersion); });
+	}
+	Future<Void> forgetVersionsBeforeAsync(Version newOldestVersion, TaskPriority taskID = TaskPriority::DefaultYield) {
+		return visit([&](auto& m) { return m.forgetVersionsBeforeAsync(newOldestVersion, taskID); });
+	}
+	void createNewVersion(Version version) {
+		visit([&](auto& m) { m.createNewVersion(version); });
+	}
+
+	void insert(const KeyRef& k, const T& t) {
+		visit([&](auto& m) { m.insert(k, t); });
+	}
+	void insert(const KeyRef& k, const T& t, Version insertAt) {
+		visit([&](auto& m) { m.insert(k, t, insertAt); });
+	}
+	void erase(const KeyRef& begin, const KeyRef& end) {
+		visit([&](auto& m) { m.erase(begin, end); });
+	}
+	void erase(const KeyRef& key) {
+		visit([&](auto& m) { m.erase(key); });
+	}
+
+	struct iterator {
+		explicit iterator(typename PTreeMap::iterator const& i) : impl(std::in_place_index<0>, i) {}
+		explicit iterator(typename ArtMap::iterator const& i) : impl(std::in_place_index<1>, i) {}
+
+		KeyRef const& key() const {
+			return visit([](auto const& i) -> KeyRef const& { return i.key(); });
+		}
+		Version insertVersion() const {
+			return visit([](auto const& i) { return i.insertVersion(); });
+		}
+		operator bool() const {
+			return visit([](auto const& i) { return (bool)i; });
+		}
+		bool operator<(const KeyRef& key) const { return this->key() < key; }
+
+		T const& operator*() {
+			return visit([](auto& i) -> T const& { return *i; });
+		}
+		T const* operator->() {
+			return visit([](auto& i) { return i.operator->(); });
+		}
+		void operator++() {
+			visit([](auto& i) { ++i; });
+		}
+		void operator--() {
+			visit([](auto& i) { --i; });
+		}
+		bool operator==(const iterator& r) const {
+			return impl.index() == 1 ? std::get<1>(impl) == std::get<1>(r.impl)
+			                         : std::get<0>(impl) == std::get<0>(r.impl);
+		}
+		bool operator!=(const iterator& r) const { return !(*this == r); }
+
+	private:
+		friend class AnyVersionedMap<T>;
+		std::variant<typename PTreeMap::iterator, typename ArtMap::iterator> impl;
+
+		template <class F>
+		decltype(auto) visit(F&& f) {
+			return impl.index() == 1 ? f(*std::get_if<1>(&impl)) : f(*std::get_if<0>(&impl));
+		}
+		template <class F>
+		decltype(auto) visit(F&& f) const {
+			return impl.index() == 1 ? f(*std::get_if<1>(&impl)) : f(*std::get_if<0>(&impl));
+		}
+	};
+
+	void erase(iterator const& item) {
+		if (isArt())
+			std::get<1>(impl).erase(std::get<1>(item.impl));
+		else
+			std::get<0>(impl).erase(std::get<0>(item.impl));
+	}
+
+	class ViewAtVersion {
+	public:
+		explicit ViewAtVersion(typename PTreeMap::ViewAtVersion const& v) : impl(std::in_place_index<0>, v) {}
+		explicit ViewAtVersion(typename ArtMap::ViewAtVersion const& v) : impl(std::in_place_index<1>, v) {}
+
+		iterator begin() const {
+			return visit([](auto const& v) { return iterator(v.begin()); });
+		}
+		iterator end() const {
+			return visit([](auto const& v) { return iterator(v.end()); });
+		}
+		iterator find(const KeyRef& key) const {
+			return visit([&](auto const& v) { return iterator(v.find(key)); });
+		}
+		iterator lower_bound(const KeyRef& key) const {
+			return visit([&](auto const& v) { return iterator(v.lower_bound(key)); });
+		}
+		iterator upper_bound(const KeyRef& key) const {
+			return visit([&](auto const& v) { return iterator(v.upper_bound(key)); });
+		}
+		iterator lastLessOrEqual(const KeyRef& key) const {
+			return visit([&](auto const& v) { return iterator(v.lastLessOrEqual(key)); });
+		}
+		iterator lastLess(const KeyRef& key) const {
+			return visit([&](auto const& v) { return iterator(v.lastLess(key)); });
+		}
+		void validate() {
+			if (impl.index() == 1)
+				std::get<1>(impl).validate();
+			else
+				std::get<0>(impl).validate();
+		}
+
+	private:
+		std::variant<typename PTreeMap::ViewAtVersion, typename ArtMap::ViewAtVersion> impl;
+
+		template <class F>
+		decltype(auto) visit(F&& f) const {
+			return impl.index() == 1 ? f(*std::get_if<1>(&impl)) : f(*std::get_if<0>(&impl));
+		}
+	};
+
+	ViewAtVersion at(Version v) const {
+		return visit([&](auto const& m) { return ViewAtVersion(m.at(v)); });
+	}
+	ViewAtVersion atLatest() const {
+		return visit([](auto const& m) { return ViewAtVersion(m.atLatest()); });
+	}
+
+	bool isClearContaining(ViewAtVersion const& view, KeyRef key) {
+		auto i = view.lastLessOrEqual(key);
+		return i && i->isClearTo() && i->getEndKey() > key;
+	}
+
+private:
+	std::variant<PTreeMap, ArtMap> impl;
+
+	template <class F>
+	decltype(auto) visit(F&& f) {
+		return impl.index() == 1 ? f(*std::get_if<1>(&impl)) : f(*std::get_if<0>(&impl));
+	}
+	template <class F>
+	decltype(auto) visit(F&& f) const {
+		return impl.index() == 1 ? f(*std::get_if<1>(&impl)) : f(*std::get_if<0>(&impl));
+	}
+};
+
+#endif
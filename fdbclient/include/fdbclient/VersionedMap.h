@@ -609,6 +609,15 @@ void check(const Reference<PTree<T>>& p) {
 	}
 }
 
+// Moves the children of p that are only referenced by p to toFree, so that they are not freed recursively with p
+template <class T>
+void releaseSoleOwnedChildren(Reference<PTree<T>>& p, std::vector<Reference<PTree<T>>>& toFree) {
+	for (int c = 0; c < 3; c++) {
+		if (p->pointer[c] && p->pointer[c]->isSoleOwner())
+			toFree.push_back(std::move(p->pointer[c]));
+	}
+}
+
 // Remove pointers to any child nodes that have been updated at or before the given version
 // This essentially gets rid of node versions that will never be read (beyond 5s worth of versions)
 // TODO look into making this per-version compaction. (We could keep track of updated nodes at each version for example)
@@ -19,6 +19,7 @@
  */
 
 #include "fdbrpc/AsyncFileCached.actor.h"
+#include "flow/UnitTest.h"
 
 // Page caches used in non-simulated environments
 Optional<Reference<EvictablePageCache>> pc4k, pc64k;
@@ -31,7 +32,7 @@ EvictablePage::~EvictablePage() {
 	if (data) {
 		freeFast4kAligned(pageCache->pageSize, data);
 	}
-	if (EvictablePageCache::RANDOM == pageCache->cacheEvictionType) {
+	if (pageCache->usesPageVector()) {
 		if (index > -1) {
 			pageCache->pages[index] = pageCache->pages.back();
 			pageCache->pages[index]->index = index;
@@ -289,3 +290,78 @@ AsyncFileCached::~AsyncFileCached() {
 	}
 	openFiles.erase(filename);
 }
+
+namespace {
+
+// A page that deletes itself when evicted, unless it is pinned
+struct TestEvictablePage : EvictablePage {
+	int id;
+	bool pinned = false;
+	std::vector<int>* evicted;
+
+	TestEvictablePage(Reference<EvictablePageCache> pageCache, int id, std::vector<int>* evicted)
+	  : EvictablePage(pageCache), id(id), evicted(evicted) {
+		pageCache->allocate(this);
+	}
+
+	bool evict() override {
+		if (pinned) {
+			return false;
+		}
+		evicted->push_back(id);
+		delete this;
+		return true;
+	}
+};
+
+} // namespace
+
+TEST_CASE("/fdbrpc/AsyncFileCached/clockEviction") {
+	Reference<EvictablePageCache> cache =
+	    makeReference<EvictablePageCache>(4096, 4 * 4096, EvictablePageCache::CLOCK);
+	std::vector<int> evicted;
+	std::vector<TestEvictablePage*> page;
+	for (int i = 0; i < 4; ++i) {
+		page.push_back(new TestEvictablePage(cache, i, &evicted));
+	}
+	ASSERT(cache->pages.size() == 4 && evicted.empty() && cache->clockHand == 0);
+
+	// The hand clears the reference bits of pages 0 and 1 and evicts page 2, whose slot is filled by page 3
+	cache->updateHit(page[0]);
+	cache->updateHit(page[1]);
+	ASSERT(page[0]->referenced && page[1]->referenced);
+	page.push_back(new TestEvictablePage(cache, 4, &evicted));
+	ASSERT(evicted == std::vector<int>({ 2 }));
+	ASSERT(!page[0]->referenced && !page[1]->referenced);
+	ASSERT(cache->clockHand == 2 && cache->pages[2] == page[3]);
+
+	// The hand resumes where it stopped, so pages 0 and 1 survive even though their bits are now clear
+	page.push_back(new TestEvictablePage(cache, 5, &evicted));
+	ASSERT(evicted == std::vector<int>({ 2, 3 }));
+	ASSERT(cache->clockHand == 2 && cache->pages.size() == 4);
+
+	// A page that can't be evicted is passed over, the referenced page 5 gets a second chance, and the hand wraps
+	// around to page 0
+	page[4]->pinned = true;
+	cache->updateHit(page[5]);
+	page.push_back(new TestEvictablePage(cache, 6, &evicted));
+	ASSERT(evicted == std::vector<int>({ 2, 3, 0 }));
+	ASSERT(!page[5]->referenced && cache->clockHand == 0 && cache->pages[0] == page[5]);
+
+	// With every bit set, one revolution clears them all and the next evicts the first evictable page
+	for (auto p : cache->pages) {
+		cache->updateHit(p);
+	}
+	page.push_back(new TestEvictablePage(cache, 7, &evicted));
+	ASSERT(evicted == std::vector<int>({ 2, 3, 0, 5 }));
+	for (auto p : cache->pages) {
+		ASSERT(!p->referenced);
+	}
+	ASSERT(cache->pages.size() == 4);
+
+	page[4]->pinned = false;
+	while (!cache->pages.empty()) {
+		ASSERT(cache->pages.back()->evict());
+	}
+	return Void();
+}
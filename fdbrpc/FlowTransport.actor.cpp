@@ -20,6 +20,7 @@
 
 #include "fdbrpc/FlowTransport.h"
 #include "flow/Arena.h"
+#include "flow/CompressionUtils.h"
 #include "flow/IThreadPool.h"
 #include "flow/Knobs.h"
 #include "flow/NetworkAddress.h"
@@ -42,6 +43,7 @@
 #include "fdbrpc/genericactors.actor.h"
 #include "fdbrpc/IPAllowList.h"
 #include "fdbrpc/simulator.h"
+#include "fdbrpc/SimulatorProcessInfo.h"
 #include "flow/ActorCollection.h"
 #include "flow/Error.h"
 #include "flow/flow.h"
@@ -80,6 +82,9 @@ Future<Void> g_currentDeliveryPeerDisconnect;
 // Certainly this applies to FDB messages.  So we should refer to FDB
 // messages as "messages".
 constexpr int PACKET_LEN_WIDTH = sizeof(uint32_t);
+// Set in the length of a packet which is compressed with zstd. These are only sent to peers whose ConnectPacket has
+// FLAG_ACCEPTS_ZSTD set, and PACKET_LIMIT keeps real lengths far below this bit.
+constexpr uint32_t COMPRESSED_PACKET_FLAG = 0x80000000;
 
 // FIXME: explain what this is for
 const uint64_t TOKEN_STREAM_FLAG = 1;
@@ -364,6 +369,7 @@ public:
 	double lastIncompatibleMessage;
 	uint64_t transportId;
 	IPAllowList allowList;
+	uint16_t localDcTag = 0; // See getLocalDcTag()
 
 	Future<Void> multiVersionCleanup;
 	Future<Void> pingLogger;
@@ -507,6 +513,11 @@ ACTOR Future<Void> pingLatencyLogger(TransportData* self) {
 				    .detail("Count", peer->pingLatencies.getPopulationSize())
 				    .detail("BytesReceived", peer->bytesReceived - peer->lastLoggedBytesReceived)
 				    .detail("BytesSent", peer->bytesSent - peer->lastLoggedBytesSent)
+				    .detail("CompressOutgoing", peer->compressOutgoing)
+				    .detail("UncompressedBytesSent", peer->uncompressedBytesSent)
+				    .detail("CompressedBytesSent", peer->compressedBytesSent)
+				    .detail("UncompressedBytesReceived", peer->uncompressedBytesReceived)
+				    .detail("CompressedBytesReceived", peer->compressedBytesReceived)
 				    .detail("TimeoutCount", peer->timeoutCount)
 				    .detail("ConnectOutgoingCount", peer->connectOutgoingCount)
 				    .detail("ConnectIncomingCount", peer->connectIncomingCount)
@@ -520,6 +531,10 @@ ACTOR Future<Void> pingLatencyLogger(TransportData* self) {
 				peer->connectOutgoingCount = 0;
 				peer->connectIncomingCount = 0;
 				peer->connectFailedCount = 0;
+				peer->uncompressedBytesSent = 0;
+				peer->compressedBytesSent = 0;
+				peer->uncompressedBytesReceived = 0;
+				peer->compressedBytesReceived = 0;
 				peer->pingLatencies.clear();
 				peer->connectLatencies.clear();
 				peer->lastLoggedBytesReceived = peer->bytesReceived;
@@ -564,7 +579,10 @@ struct ConnectPacket {
 	// IP Address to reconnect to the originating process. Only one of these must be populated.
 	uint32_t canonicalRemoteIp4 = 0;
 
-	enum ConnectPacketFlags { FLAG_IPV6 = 1 };
+	enum ConnectPacketFlags { FLAG_IPV6 = 1, FLAG_ACCEPTS_ZSTD = 2 };
+	// The bits of flags from DC_TAG_SHIFT up hold a hash of the sender's data center id, or 0 if it is not known.
+	// Versions which do not know about them ignore them.
+	static constexpr int DC_TAG_SHIFT = 4;
 	uint16_t flags = 0;
 	uint8_t canonicalRemoteIp6[16] = { 0 };
 
@@ -592,6 +610,9 @@ struct ConnectPacket {
 
 	bool isIPv6() const { return flags & FLAG_IPV6; }
 
+	uint16_t dcTag() const { return flags >> DC_TAG_SHIFT; }
+	void setDcTag(uint16_t tag) { flags = (flags & ((1 << DC_TAG_SHIFT) - 1)) | (tag << DC_TAG_SHIFT); }
+
 	uint32_t totalPacketSize() const { return connectPacketLength + sizeof(connectPacketLength); }
 
 	template <class Ar>
@@ -613,6 +634,41 @@ struct ConnectPacket {
 
 #pragma pack(pop)
 
+// Maps a data center id to the tag sent in ConnectPacket. Distinct data centers get the same tag with probability
+// 1/4095, in which case traffic between them is not compressed.
+static uint16_t dcTagFor(Optional<Standalone<StringRef>> const& dcId) {
+	if (!dcId.present()) {
+		return 0;
+	}
+	return 1 + XXH3_64bits(dcId.get().begin(), dcId.get().size()) % ((1 << (16 - ConnectPacket::DC_TAG_SHIFT)) - 1);
+}
+
+static uint16_t getLocalDcTag(TransportData* transport) {
+	// Simulated processes share one transport, but each knows its own locality
+	if (g_network->isSimulated() && g_simulator->getCurrentProcess()) {
+		return dcTagFor(g_simulator->getCurrentProcess()->locality.dcId());
+	}
+	return transport->localDcTag;
+}
+
+// Returns whether packets should be compressed on a connection whose peer sent pkt
+static bool shouldCompressFor(TransportData* transport, ConnectPacket const& pkt) {
+	if (!(pkt.flags & ConnectPacket::FLAG_ACCEPTS_ZSTD) ||
+	    !CompressionUtils::supportedFilters.count(CompressionFilter::ZSTD)) {
+		return false;
+	}
+	switch (FLOW_KNOBS->PEER_COMPRESSION_MODE) {
+	case 1: {
+		const uint16_t localTag = getLocalDcTag(transport);
+		return localTag != 0 && pkt.dcTag() != 0 && localTag != pkt.dcTag();
+	}
+	case 2:
+		return true;
+	default:
+		return false;
+	}
+}
+
 ACTOR static Future<Void> connectionReader(TransportData* transport,
                                            Reference<IConnection> conn,
                                            Reference<struct Peer> peer,
@@ -1056,8 +1112,9 @@ Peer::Peer(TransportData* transport, NetworkAddress const& destination)
     pingLatencies(destination.isPublic() ? FLOW_KNOBS->PING_SKETCH_ACCURACY : 0.1), lastLoggedTime(0.0),
     lastLoggedBytesReceived(0), lastLoggedBytesSent(0), timeoutCount(0),
     protocolVersion(Reference<AsyncVar<Optional<ProtocolVersion>>>(new AsyncVar<Optional<ProtocolVersion>>())),
-    connectOutgoingCount(0), connectIncomingCount(0), connectFailedCount(0),
-    connectLatencies(destination.isPublic() ? FLOW_KNOBS->PING_SKETCH_ACCURACY : 0.1) {
+    compressOutgoing(false), connectOutgoingCount(0), connectIncomingCount(0), connectFailedCount(0),
+    connectLatencies(destination.isPublic() ? FLOW_KNOBS->PING_SKETCH_ACCURACY : 0.1), uncompressedBytesSent(0),
+    compressedBytesSent(0), uncompressedBytesReceived(0), compressedBytesReceived(0) {
 	IFailureMonitor::failureMonitor().setStatus(destination, FailureStatus(false));
 }
 
@@ -1088,6 +1145,10 @@ void Peer::prependConnectPacket() {
 	pkt.protocolVersion = g_network->protocolVersion();
 	pkt.protocolVersion.addObjectSerializerFlag();
 	pkt.connectionId = transport->transportId;
+	if (CompressionUtils::supportedFilters.count(CompressionFilter::ZSTD)) {
+		pkt.flags |= ConnectPacket::FLAG_ACCEPTS_ZSTD;
+	}
+	pkt.setDcTag(getLocalDcTag(transport));
 
 	PacketBuffer *pb_first = PacketBuffer::create(), *pb_end = nullptr;
 	PacketWriter wr(pb_first, nullptr, Unversioned());
@@ -1109,6 +1170,8 @@ void Peer::discardUnreliablePackets() {
 	// Throw away the current unsent list, dropping the reference count on each PacketBuffer that accounts for presence
 	// in the unsent list
 	unsent.discardAll();
+	// Packets queued from now on may go out on a connection to a peer which does not accept compressed packets
+	compressOutgoing = false;
 
 	// If there are reliable packets, compact reliable packets into a new unsent range
 	if (!reliable.empty()) {
@@ -1261,10 +1324,32 @@ ACTOR static void deliver(TransportData* self,
 	}
 }
 
+// Returns a compressed packet decompressed into arena
+static StringRef decompressPacket(StringRef packet, Arena& arena, NetworkAddress const& peerAddress, Peer* peer) {
+	StringRef result;
+	try {
+		result = CompressionUtils::decompress(CompressionFilter::ZSTD, packet, FLOW_KNOBS->PACKET_LIMIT, arena);
+	} catch (Error& e) {
+		TraceEvent(SevWarnAlways, "PacketDecompressionFailed")
+		    .error(e)
+		    .detail("FromPeer", peerAddress.toString())
+		    .detail("Length", packet.size());
+		throw platform_error();
+	}
+	if (result.size() < sizeof(UID)) {
+		TraceEvent(SevError, "PacketTooSmall").detail("FromPeer", peerAddress.toString()).detail("Length", result.size());
+		throw platform_error();
+	}
+	peer->compressedBytesReceived += packet.size();
+	peer->uncompressedBytesReceived += result.size();
+	return result;
+}
+
 static void scanPackets(TransportData* transport,
                         uint8_t*& unprocessed_begin, // FIXME: why isn't this called `start`?
                         const uint8_t* e, // FIXME: why isn't this called `end`?
                         Arena& arena,
+                        Peer* peer,
                         NetworkAddress const& peerAddress,
                         bool isTrustedPeer,
                         ProtocolVersion peerProtocolVersion,
@@ -1290,6 +1375,8 @@ static void scanPackets(TransportData* transport,
 			break;
 		packetLen = *(uint32_t*)p;
 		p += PACKET_LEN_WIDTH;
+		const bool compressed = packetLen & COMPRESSED_PACKET_FLAG;
+		packetLen &= ~COMPRESSED_PACKET_FLAG;
 
 		// Read checksum if present
 		if (checksumEnabled) {
@@ -1372,19 +1459,24 @@ static void scanPackets(TransportData* transport,
 #if VALGRIND
 		VALGRIND_CHECK_MEM_IS_DEFINED(p, packetLen);
 #endif
+		StringRef packet(p, packetLen);
+		if (compressed) {
+			packet = decompressPacket(packet, arena, peerAddress, peer);
+		}
+
 		// remove object serializer flag to account for flat buffer
 		peerProtocolVersion.removeObjectSerializerFlag();
-		ArenaReader reader(arena, StringRef(p, packetLen), AssumeVersion(peerProtocolVersion));
+		ArenaReader reader(arena, packet, AssumeVersion(peerProtocolVersion));
 		UID token;
 		reader >> token;
 
 		++transport->countPacketsReceived;
 
-		if (packetLen > FLOW_KNOBS->PACKET_WARNING) {
+		if (packet.size() > FLOW_KNOBS->PACKET_WARNING) {
 			TraceEvent(SevWarn, "LargePacketReceived")
 			    .suppressFor(1.0)
 			    .detail("FromPeer", peerAddress.toString())
-			    .detail("Length", (int)packetLen)
+			    .detail("Length", packet.size())
 			    .detail("Token", token);
 		}
 
@@ -1422,7 +1514,7 @@ static int getNewBufferSize(const uint8_t* begin,
 	if (len < PACKET_LEN_WIDTH) {
 		return FLOW_KNOBS->MIN_PACKET_BUFFER_BYTES;
 	}
-	const uint32_t packetLen = *(uint32_t*)begin;
+	const uint32_t packetLen = *(uint32_t*)begin & ~COMPRESSED_PACKET_FLAG;
 	if (packetLen > FLOW_KNOBS->PACKET_LIMIT) {
 		TraceEvent(SevError, "PacketLimitExceeded")
 		    .detail("FromPeer", peerAddress.toString())
@@ -1446,6 +1538,7 @@ ACTOR static Future<Void> connectionReader(TransportData* transport,
 	state uint8_t* buffer_end = nullptr;
 	state bool expectConnectPacket = true;
 	state bool compatible = false;
+	state bool compressOutgoing = false;
 	state bool incompatiblePeerCounted = false;
 	state NetworkAddress peerAddress;
 	state ProtocolVersion peerProtocolVersion;
@@ -1571,6 +1664,7 @@ ACTOR static Future<Void> connectionReader(TransportData* transport,
 						}
 						unprocessed_begin += connectPacketSize;
 						expectConnectPacket = false;
+						compressOutgoing = compatible && shouldCompressFor(transport, pkt);
 
 						if (peer) {
 							peerProtocolVersion = protocolVersion;
@@ -1606,6 +1700,7 @@ ACTOR static Future<Void> connectionReader(TransportData* transport,
 							wait(delay(0)); // Check for cancellation
 						}
 						peer->protocolVersion->set(peerProtocolVersion);
+						peer->compressOutgoing = compressOutgoing;
 					}
 				}
 
@@ -1615,6 +1710,7 @@ ACTOR static Future<Void> connectionReader(TransportData* transport,
 						            unprocessed_begin,
 						            unprocessed_end,
 						            arena,
+						            peer.getPtr(),
 						            peerAddress,
 						            trusted,
 						            peerProtocolVersion,
@@ -1832,6 +1928,10 @@ void FlowTransport::initMetrics() {
 	self->initMetrics();
 }
 
+void FlowTransport::setLocalDcId(Optional<Standalone<StringRef>> dcId) {
+	self->localDcTag = dcTagFor(dcId);
+}
+
 NetworkAddressList FlowTransport::getLocalAddresses() const {
 	return self->localAddresses.getAddressList();
 }
@@ -1972,6 +2072,40 @@ static void sendLocal(TransportData* self, ISerializeSource const& what, const E
 	}
 }
 
+// Serializes a packet into one buffer, which is returned compressed if it is large enough and compression shrinks it.
+// Sets uncompressedSize to the size of the packet before compression.
+static Standalone<StringRef> serializeCompressiblePacket(ISerializeSource const& what,
+                                                         const Endpoint::Token& token,
+                                                         int& uncompressedSize) {
+	// The object is written after room left for the token, so that the packet needs no further copies
+	struct Allocation {
+		Arena arena;
+		uint8_t* packet = nullptr;
+		static uint8_t* allocate(const size_t size, void* self) {
+			Allocation* allocation = static_cast<Allocation*>(self);
+			allocation->packet = new (allocation->arena) uint8_t[sizeof(UID) + size];
+			return allocation->packet + sizeof(UID);
+		}
+	} allocation;
+	ObjectWriter writer(&Allocation::allocate, &allocation, AssumeVersion(g_network->protocolVersion()));
+	what.serializeObjectWriter(writer);
+	const uint64_t tokenParts[2] = { token.first(), token.second() };
+	memcpy(allocation.packet, tokenParts, sizeof(tokenParts));
+	Standalone<StringRef> packet(StringRef(allocation.packet, sizeof(UID) + writer.toStringRef().size()),
+	                             allocation.arena);
+
+	uncompressedSize = packet.size();
+	if (packet.size() < FLOW_KNOBS->PEER_COMPRESSION_MIN_PACKET_BYTES) {
+		return packet;
+	}
+	Arena arena;
+	StringRef result = CompressionUtils::compress(CompressionFilter::ZSTD, packet, arena);
+	if (result.size() >= packet.size()) {
+		return packet;
+	}
+	return Standalone<StringRef>(result, arena);
+}
+
 static ReliablePacket* sendPacket(TransportData* self,
                                   Reference<Peer> peer,
                                   ISerializeSource const& what,
@@ -2015,9 +2149,22 @@ static ReliablePacket* sendPacket(TransportData* self,
 		packetInfoSize += sizeof(checksum);
 	}
 
+	// Reliable packets are not compressed since they are resent on later connections, which may be to a peer that does
+	// not accept compressed packets. Neither are packets which would have sensitive data wiped from their buffers.
+	Standalone<StringRef> serialized;
+	int uncompressedLen = 0;
+	if (peer->compressOutgoing && !reliable && !FLOW_KNOBS->WIPE_SENSITIVE_DATA_FROM_PACKET_BUFFER) {
+		serialized = serializeCompressiblePacket(what, destination.token, uncompressedLen);
+	}
+	const bool compressed = serialized.size() < uncompressedLen;
+
 	wr.writeAhead(packetInfoSize, &packetInfoBuffer);
-	wr << destination.token;
-	what.serializePacketWriter(wr);
+	if (serialized.size()) {
+		wr.serializeBytes(serialized);
+	} else {
+		wr << destination.token;
+		what.serializePacketWriter(wr);
+	}
 	pb = wr.finish();
 	len = wr.size() - packetInfoSize;
 
@@ -2069,7 +2216,12 @@ static ReliablePacket* sendPacket(TransportData* self,
 	}
 
 	// Write packet length and checksum into packet buffer
-	packetInfoBuffer.write(&len, sizeof(len));
+	const uint32_t lenAndFlags = compressed ? len | COMPRESSED_PACKET_FLAG : len;
+	packetInfoBuffer.write(&lenAndFlags, sizeof(lenAndFlags));
+	if (compressed) {
+		peer->uncompressedBytesSent += uncompressedLen;
+		peer->compressedBytesSent += len;
+	}
 	if (checksumEnabled) {
 		packetInfoBuffer.write(&checksum, sizeof(checksum), sizeof(len));
 	}
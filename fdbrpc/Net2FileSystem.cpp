@@ -41,6 +41,7 @@
 #include "fdbrpc/AsyncFileEncrypted.h"
 #include "fdbrpc/AsyncFileWinASIO.actor.h"
 #include "fdbrpc/AsyncFileKAIO.actor.h"
+#include "fdbrpc/AsyncFileIOUring.actor.h"
 #include "flow/AsioReactor.h"
 #include "flow/Platform.h"
 #include "fdbrpc/AsyncFileWriteChecker.actor.h"
@@ -70,9 +71,18 @@ Future<Reference<class IAsyncFile>> Net2FileSystem::open(const std::string& file
 	// don’t properly support kernel async I/O without O_DIRECT or AIO at all. In such
 	// cases, DISABLE_POSIX_KERNEL_AIO knob can be enabled to fallback to EIO instead
 	// of Kernel AIO. And EIO_USE_ODIRECT can be used to turn on or off O_DIRECT within
-	// EIO.
+	// EIO. If USE_IO_URING is set and the kernel supports it, io_uring takes the place
+	// of Kernel AIO.
+#ifdef HAVE_IO_URING
+	if ((flags & IAsyncFile::OPEN_UNBUFFERED) && !(flags & IAsyncFile::OPEN_NO_AIO) &&
+	    AsyncFileIOUring::isInitialized())
+		f = AsyncFileIOUring::open(filename, flags, mode, nullptr);
+	else if ((flags & IAsyncFile::OPEN_UNBUFFERED) && !(flags & IAsyncFile::OPEN_NO_AIO) &&
+	         !FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO)
+#else
 	if ((flags & IAsyncFile::OPEN_UNBUFFERED) && !(flags & IAsyncFile::OPEN_NO_AIO) &&
 	    !FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO)
+#endif
 		f = AsyncFileKAIO::open(filename, flags, mode, nullptr);
 	else
 #endif
@@ -117,8 +127,13 @@ void Net2FileSystem::newFileSystem(double ioTimeout, const std::string& fileSyst
 Net2FileSystem::Net2FileSystem(double ioTimeout, const std::string& fileSystemPath) {
 	Net2AsyncFile::init();
 #ifdef __linux__
-	if (!FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO)
-		AsyncFileKAIO::init(Reference<IEventFD>(N2::ASIOReactor::getEventFD()), ioTimeout);
+	if (!FLOW_KNOBS->DISABLE_POSIX_KERNEL_AIO) {
+#ifdef HAVE_IO_URING
+		if (!FLOW_KNOBS->USE_IO_URING ||
+		    !AsyncFileIOUring::init(Reference<IEventFD>(N2::ASIOReactor::getEventFD()), ioTimeout))
+#endif
+			AsyncFileKAIO::init(Reference<IEventFD>(N2::ASIOReactor::getEventFD()), ioTimeout);
+	}
 
 	if (fileSystemPath.empty()) {
 		checkFileSystem = false;
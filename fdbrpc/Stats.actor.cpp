@@ -221,10 +221,15 @@ LatencySample::LatencySample(std::string name,
                              UID id,
                              double loggingInterval,
                              double accuracy,
-                             bool skipTraceOnSilentInterval)
+                             bool skipTraceOnSilentInterval,
+                             bool logLinearHistogram)
   : name(name), IMetric(knobToMetricModel(FLOW_KNOBS->METRICS_DATA_MODEL)), id(id), sampleEmit(now()), sketch(accuracy),
     latencySampleEventHolder(makeReference<EventCacheHolder>(id.toString() + "/" + name)),
     skipTraceOnSilentInterval(skipTraceOnSilentInterval) {
+	if (logLinearHistogram) {
+		// Logged with this sample rather than by the HistogramRegistry, so it is not registered
+		histogram = makeReference<LogLinearHistogram>(Reference<HistogramRegistry>());
+	}
 	logger = recurring([this]() { logSample(); }, loggingInterval);
 	p50id = deterministicRandom()->randomUniqueID();
 	p90id = deterministicRandom()->randomUniqueID();
@@ -235,6 +240,9 @@ LatencySample::LatencySample(std::string name,
 
 void LatencySample::addMeasurement(double measurement) {
 	sketch.addSample(measurement);
+	if (histogram) {
+		histogram->sampleSeconds(measurement);
+	}
 }
 
 void LatencySample::logSample() {
@@ -242,13 +250,13 @@ void LatencySample::logSample() {
 		return;
 	}
 	double p25 = sketch.percentile(0.25);
-	double p50 = sketch.mean();
+	double p50 = sketch.median();
 	double p90 = sketch.percentile(0.9);
 	double p95 = sketch.percentile(0.95);
 	double p99 = sketch.percentile(0.99);
 	double p99_9 = sketch.percentile(0.999);
-	TraceEvent(name.c_str(), id)
-	    .detail("Count", sketch.getPopulationSize())
+	TraceEvent ev(name.c_str(), id);
+	ev.detail("Count", sketch.getPopulationSize())
 	    .detail("Elapsed", now() - sampleEmit)
 	    .detail("Min", sketch.min())
 	    .detail("Max", sketch.max())
@@ -258,8 +266,15 @@ void LatencySample::logSample() {
 	    .detail("P90", p90)
 	    .detail("P95", p95)
 	    .detail("P99", p99)
-	    .detail("P99.9", p99_9)
-	    .trackLatest(latencySampleEventHolder->trackingKey);
+	    .detail("P99.9", p99_9);
+	if (histogram) {
+		// The histogram records microseconds
+		ev.detail("HistogramP50", histogram->percentile(0.5) * 1e-6)
+		    .detail("HistogramP90", histogram->percentile(0.9) * 1e-6)
+		    .detail("HistogramP99", histogram->percentile(0.99) * 1e-6)
+		    .detail("HistogramP99.9", histogram->percentile(0.999) * 1e-6);
+	}
+	ev.trackLatest(latencySampleEventHolder->trackingKey);
 	MetricCollection* metrics = MetricCollection::getMetricCollection();
 	if (metrics != nullptr) {
 		NetworkAddress addr = g_network->getLocalAddress();
@@ -310,5 +325,8 @@ void LatencySample::logSample() {
 		}
 	}
 	sketch.clear();
+	if (histogram) {
+		histogram->clear();
+	}
 	sampleEmit = now();
 }
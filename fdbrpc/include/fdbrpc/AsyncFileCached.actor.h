@@ -42,47 +42,64 @@ namespace bi = boost::intrusive;
 struct EvictablePage {
 	void* data;
 	int index;
+	bool referenced; // CLOCK reference bit, set on a hit and cleared as the clock hand passes
 	class Reference<struct EvictablePageCache> pageCache;
 	bi::list_member_hook<> member_hook;
 
 	virtual bool evict() = 0; // true if page was evicted, false if it isn't immediately evictable (but will be evicted
 	                          // regardless if possible)
 
-	EvictablePage(Reference<EvictablePageCache> pageCache) : data(0), index(-1), pageCache(pageCache) {}
+	EvictablePage(Reference<EvictablePageCache> pageCache)
+	  : data(0), index(-1), referenced(false), pageCache(pageCache) {}
 	virtual ~EvictablePage();
 };
 
 struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 	using List =
 	    bi::list<EvictablePage, bi::member_hook<EvictablePage, bi::list_member_hook<>, &EvictablePage::member_hook>>;
-	enum CacheEvictionType { RANDOM = 0, LRU = 1 };
+	enum CacheEvictionType { RANDOM = 0, LRU = 1, CLOCK = 2 };
 
 	static CacheEvictionType evictionPolicyStringToEnum(const std::string& policy) {
 		std::string cep = policy;
 		std::transform(cep.begin(), cep.end(), cep.begin(), ::tolower);
-		if (cep != "random" && cep != "lru")
+		if (cep != "random" && cep != "lru" && cep != "clock")
 			throw invalid_cache_eviction_policy();
 
 		if (cep == "random")
 			return RANDOM;
+		if (cep == "clock")
+			return CLOCK;
 		return LRU;
 	}
 
-	EvictablePageCache() : pageSize(0), maxPages(0), cacheEvictionType(RANDOM) {}
+	EvictablePageCache() : pageSize(0), maxPages(0), clockHand(0), cacheEvictionType(RANDOM) {}
 
 	explicit EvictablePageCache(int pageSize, int64_t maxSize)
-	  : pageSize(pageSize), maxPages(maxSize / pageSize),
-	    cacheEvictionType(evictionPolicyStringToEnum(FLOW_KNOBS->CACHE_EVICTION_POLICY)) {
+	  : EvictablePageCache(pageSize, maxSize, evictionPolicyStringToEnum(FLOW_KNOBS->CACHE_EVICTION_POLICY)) {}
+
+	EvictablePageCache(int pageSize, int64_t maxSize, CacheEvictionType cacheEvictionType)
+	  : pageSize(pageSize), maxPages(maxSize / pageSize), clockHand(0), cacheEvictionType(cacheEvictionType) {
 		cacheEvictions.init("EvictablePageCache.CacheEvictions"_sr);
+
+		// Per page size metrics, so the 4k (SQLite) and 64k (log) caches can be told apart
+		std::string id = std::to_string(pageSize);
+		cacheHits.init("EvictablePageCache.CacheHits"_sr, id);
+		cacheMisses.init("EvictablePageCache.CacheMisses"_sr, id);
+		cacheEvictionAttempts.init("EvictablePageCache.CacheEvictionAttempts"_sr, id);
+		cacheSizeEvictions.init("EvictablePageCache.CacheEvictions"_sr, id);
 	}
 
+	// Pages are kept in the pages vector for the RANDOM and CLOCK policies and in lruPages for LRU
+	bool usesPageVector() const { return LRU != cacheEvictionType; }
+
 	void allocate(EvictablePage* page) {
+		++cacheMisses;
 		try_evict();
 		try_evict();
 
 		page->data = allocateFast4kAligned(pageSize);
 
-		if (RANDOM == cacheEvictionType) {
+		if (usesPageVector()) {
 			page->index = pages.size();
 			pages.push_back(page);
 		} else {
@@ -91,10 +108,14 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 	}
 
 	void updateHit(EvictablePage* page) {
-		if (RANDOM != cacheEvictionType) {
+		++cacheHits;
+		if (LRU == cacheEvictionType) {
 			// on a hit, update page's location in the LRU so that it's most recent (tail)
 			lruPages.erase(List::s_iterator_to(*page));
 			lruPages.push_back(*page);
+		} else if (CLOCK == cacheEvictionType) {
+			// CLOCK approximates LRU with only a store on a hit
+			page->referenced = true;
 		}
 	}
 
@@ -104,21 +125,49 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 				for (int i = 0; i < FLOW_KNOBS->MAX_EVICT_ATTEMPTS;
 				     i++) { // If we don't manage to evict anything, just go ahead and exceed the cache limit
 					int toEvict = deterministicRandom()->randomInt(0, pages.size());
+					++cacheEvictionAttempts;
 					if (pages[toEvict]->evict()) {
-						++cacheEvictions;
+						onEvicted();
 						break;
 					}
 				}
 			}
+		} else if (CLOCK == cacheEvictionType) {
+			if (pages.size() >= (uint64_t)maxPages && !pages.empty()) {
+				// Sweep the hand over the pages, giving each referenced page a second chance by clearing its bit.
+				// Two full revolutions is enough to reach every page with its bit clear.
+				int attempts = 0;
+				for (size_t step = 0, steps = 2 * pages.size();
+				     step < steps && attempts < FLOW_KNOBS->MAX_EVICT_ATTEMPTS;
+				     ++step) { // If we don't manage to evict anything, just go ahead and exceed the cache limit
+					if (clockHand >= pages.size()) {
+						clockHand = 0;
+					}
+					EvictablePage* page = pages[clockHand];
+					if (page->referenced) {
+						page->referenced = false;
+						++clockHand;
+						continue;
+					}
+					++attempts;
+					++cacheEvictionAttempts;
+					if (page->evict()) {
+						// The evicted page's slot now holds the former last page, which the hand visits next
+						onEvicted();
+						break;
+					}
+					++clockHand;
+				}
+			}
 		} else {
-			// For now, LRU is the only other CACHE_EVICTION option
 			if (lruPages.size() >= (uint64_t)maxPages) {
 				int i = 0;
 				// try the least recently used pages first (starting at head of the LRU list)
 				for (List::iterator it = lruPages.begin(); it != lruPages.end() && i < FLOW_KNOBS->MAX_EVICT_ATTEMPTS;
 				     ++it, ++i) { // If we don't manage to evict anything, just go ahead and exceed the cache limit
+					++cacheEvictionAttempts;
 					if (it->evict()) {
-						++cacheEvictions;
+						onEvicted();
 						break;
 					}
 				}
@@ -126,11 +175,21 @@ struct EvictablePageCache : ReferenceCounted<EvictablePageCache> {
 		}
 	}
 
+	void onEvicted() {
+		++cacheEvictions;
+		++cacheSizeEvictions;
+	}
+
 	std::vector<EvictablePage*> pages;
 	List lruPages;
 	int pageSize;
 	int64_t maxPages;
+	size_t clockHand; // Next index in pages the CLOCK policy will examine
 	Int64MetricHandle cacheEvictions;
+	Int64MetricHandle cacheHits;
+	Int64MetricHandle cacheMisses;
+	Int64MetricHandle cacheEvictionAttempts;
+	Int64MetricHandle cacheSizeEvictions;
 	const CacheEvictionType cacheEvictionType;
 };
 
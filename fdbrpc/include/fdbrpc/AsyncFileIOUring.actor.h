@@ -0,0 +1,741 @@
+/*
+ * AsyncFileIOUring.actor.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#if defined(__linux__) && defined(HAVE_IO_URING)
+
+// When actually compiled (NO_INTELLISENSE), include the generated version of this file.  In intellisense use the source
+// version.
+#if defined(NO_INTELLISENSE) && !defined(FLOW_ASYNCFILEIOURING_ACTOR_G_H)
+#define FLOW_ASYNCFILEIOURING_ACTOR_G_H
+#include "fdbrpc/AsyncFileIOUring.actor.g.h"
+#elif !defined(FLOW_ASYNCFILEIOURING_ACTOR_H)
+#define FLOW_ASYNCFILEIOURING_ACTOR_H
+
+#include "flow/IAsyncFile.h"
+
+#include <stdio.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include "fdbrpc/linux_io_uring.h"
+#include "fdbrpc/AsyncFileEIO.actor.h"
+#include "flow/Knobs.h"
+#include "fdbrpc/Stats.h"
+#include "flow/UnitTest.h"
+#include "flow/genericactors.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// An IAsyncFile for unbuffered files which issues reads, writes and fdatasyncs through one io_uring per process.
+// Operations are queued by priority and submitted in a single batch per run loop iteration from launch(), which also
+// reaps the completion queue directly from shared memory. The ring's eventfd is only used to wake the network thread
+// when it is idle. Files are registered with the ring as fixed files while free slots remain, and a sync() is held back
+// until the writes to the same file which were issued before it have completed.
+class AsyncFileIOUring final : public IAsyncFile, public ReferenceCounted<AsyncFileIOUring> {
+public:
+	virtual StringRef getClassName() override { return "AsyncFileIOUring"_sr; }
+
+	struct AsyncFileIOUringMetrics {
+		LatencySample readLatencySample = { "AsyncFileIOUringReadLatency",
+			                                UID(),
+			                                FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+		LatencySample writeLatencySample = { "AsyncFileIOUringWriteLatency",
+			                                 UID(),
+			                                 FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                 FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+		LatencySample syncLatencySample = { "AsyncFileIOUringSyncLatency",
+			                                UID(),
+			                                FLOW_KNOBS->KAIO_LATENCY_LOGGING_INTERVAL,
+			                                FLOW_KNOBS->KAIO_LATENCY_SKETCH_ACCURACY };
+	};
+
+	static AsyncFileIOUringMetrics& getMetrics() {
+		static AsyncFileIOUringMetrics metrics;
+		return metrics;
+	}
+
+	static Future<Reference<IAsyncFile>> open(std::string filename, int flags, int mode, void* ignore) {
+		ASSERT(isInitialized());
+		ASSERT(flags & OPEN_UNBUFFERED);
+
+		if (flags & OPEN_LOCK)
+			mode |= 02000; // Enable mandatory locking for this file if it is supported by the filesystem
+
+		std::string open_filename = filename;
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE) {
+			ASSERT((flags & OPEN_CREATE) && (flags & OPEN_READWRITE) && !(flags & OPEN_EXCLUSIVE));
+			open_filename = filename + ".part";
+		}
+
+		int fd = ::open(open_filename.c_str(), openFlags(flags), mode);
+		if (fd < 0) {
+			Error e = errno == ENOENT ? file_not_found() : io_error();
+			int ecode = errno; // Save errno in case it is modified before it is used below
+			TraceEvent ev("AsyncFileIOUringOpenFailed");
+			ev.error(e)
+			    .detail("Filename", filename)
+			    .detailf("Flags", "%x", flags)
+			    .detailf("OSFlags", "%x", openFlags(flags))
+			    .detailf("Mode", "0%o", mode)
+			    .GetLastError();
+			if (ecode == EINVAL)
+				ev.detail("Description", "Invalid argument - Does the target filesystem support O_DIRECT?");
+			return e;
+		} else {
+			TraceEvent("AsyncFileIOUringOpen")
+			    .detail("Filename", filename)
+			    .detail("Flags", flags)
+			    .detail("Mode", mode)
+			    .detail("Fd", fd);
+		}
+
+		Reference<AsyncFileIOUring> r(new AsyncFileIOUring(fd, flags, filename));
+
+		if (flags & OPEN_LOCK) {
+			// Acquire a "write" lock for the entire file
+			flock lockDesc;
+			lockDesc.l_type = F_WRLCK;
+			lockDesc.l_whence = SEEK_SET;
+			lockDesc.l_start = 0;
+			lockDesc.l_len = 0; // Lock all bytes from l_start through to the end of file, no matter how large it grows
+			lockDesc.l_pid = 0;
+			if (fcntl(fd, F_SETLK, &lockDesc) == -1) {
+				TraceEvent(SevWarn, "UnableToLockFile").detail("Filename", filename).GetLastError();
+				return lock_file_failure();
+			}
+		}
+
+		struct stat buf;
+		if (fstat(fd, &buf)) {
+			TraceEvent("AsyncFileIOUringFStatError").detail("Fd", fd).detail("Filename", filename).GetLastError();
+			return io_error();
+		}
+
+		r->lastFileSize = r->nextFileSize = buf.st_size;
+		return Reference<IAsyncFile>(std::move(r));
+	}
+
+	// Sets up the ring and makes launch() the network's run cycle function. Returns false if the kernel does not
+	// support io_uring (or it is disallowed, e.g. by a seccomp policy), in which case the caller should fall back to
+	// AsyncFileKAIO.
+	static bool init(Reference<IEventFD> ev, double ioTimeout) {
+		ASSERT(!g_network->isSimulated());
+		int rc = ctx.ring.setup(FLOW_KNOBS->MAX_OUTSTANDING);
+		if (rc < 0) {
+			errno = -rc;
+			TraceEvent(SevWarnAlways, "IOUringSetupError").GetLastError();
+			return false;
+		}
+
+		ctx.countSubmit.init("AsyncFile.CountIOUringSubmit"_sr);
+		ctx.countCollect.init("AsyncFile.CountIOUringCollect"_sr);
+		ctx.submitMetric.init("AsyncFile.Submit"_sr);
+		ctx.countPreSubmitTruncate.init("AsyncFile.CountPreIOUringSubmitTruncate"_sr);
+		ctx.preSubmitTruncateBytes.init("AsyncFile.PreIOUringSubmitTruncateBytes"_sr);
+
+		// The eventfd is signalled for every completion, but completions are normally reaped by launch() before the
+		// reactor gets to it. It only matters when the network thread would otherwise sleep.
+		ctx.evfd = ev->getFD();
+		if (io_uring_register(ctx.ring.fd, IORING_REGISTER_EVENTFD, &ctx.evfd, 1) < 0) {
+			TraceEvent(SevWarnAlways, "IOUringRegisterEventFDError").GetLastError();
+			ctx.ring.teardown(0);
+			return false;
+		}
+		registerFixedFileTable(FLOW_KNOBS->IO_URING_FIXED_FILES);
+		setTimeout(ioTimeout);
+		poll(ev);
+
+		g_network->setGlobal(INetwork::enRunCycleFunc, (flowGlobalType)&AsyncFileIOUring::launch);
+		TraceEvent("IOUringInitialized")
+		    .detail("Entries", ctx.ring.sqEntries)
+		    .detail("FixedFiles", ctx.freeFixedFiles.size());
+		return true;
+	}
+
+	static bool isInitialized() { return ctx.ring.fd >= 0; }
+	static void setTimeout(double ioTimeout) { ctx.setIOTimeout(ioTimeout); }
+
+	void addref() override { ReferenceCounted<AsyncFileIOUring>::addref(); }
+	void delref() override { ReferenceCounted<AsyncFileIOUring>::delref(); }
+	Future<int> read(void* data, int length, int64_t offset) override {
+		++countFileLogicalReads;
+		++countLogicalReads;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		IOBlock* io = new IOBlock(IORING_OP_READ, this);
+		io->buf = data;
+		io->nbytes = length;
+		io->offset = offset;
+
+		enqueue(io);
+		return io->result.getFuture();
+	}
+	Future<Void> write(void const* data, int length, int64_t offset) override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		IOBlock* io = new IOBlock(IORING_OP_WRITE, this);
+		io->buf = (void*)data;
+		io->nbytes = length;
+		io->offset = offset;
+
+		nextFileSize = std::max(nextFileSize, offset + length);
+
+		enqueue(io);
+		return success(io->result.getFuture());
+	}
+#ifndef FALLOC_FL_ZERO_RANGE
+#define FALLOC_FL_ZERO_RANGE 0x10
+#endif
+	Future<Void> zeroRange(int64_t offset, int64_t length) override {
+		bool success = false;
+		if (ctx.fallocateZeroSupported) {
+			int rc = fallocate(fd, FALLOC_FL_ZERO_RANGE, offset, length);
+			if (rc == EOPNOTSUPP) {
+				ctx.fallocateZeroSupported = false;
+			}
+			if (rc == 0) {
+				success = true;
+			}
+		}
+		return success ? Void() : IAsyncFile::zeroRange(offset, length);
+	}
+	Future<Void> truncate(int64_t size) override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		int result = -1;
+		bool completed = false;
+		double begin = timer_monotonic();
+
+		if (ctx.fallocateSupported && size >= lastFileSize) {
+			result = fallocate(fd, 0, 0, size);
+			if (result != 0) {
+				int fallocateErrCode = errno;
+				TraceEvent("AsyncFileIOUringAllocateError")
+				    .detail("Fd", fd)
+				    .detail("Filename", filename)
+				    .detail("Size", size)
+				    .GetLastError();
+				if (fallocateErrCode == EOPNOTSUPP) {
+					// Mark fallocate as unsupported. Try again with truncate.
+					ctx.fallocateSupported = false;
+				} else {
+					return io_error();
+				}
+			} else {
+				completed = true;
+			}
+		}
+		if (!completed)
+			result = ftruncate(fd, size);
+
+		double end = timer_monotonic();
+		if (nondeterministicRandom()->random01() < end - begin) {
+			TraceEvent("SlowIOUringTruncate")
+			    .detail("TruncateTime", end - begin)
+			    .detail("TruncateBytes", size - lastFileSize);
+		}
+
+		if (result != 0) {
+			TraceEvent("AsyncFileIOUringTruncateError").detail("Fd", fd).detail("Filename", filename).GetLastError();
+			return io_error();
+		}
+
+		lastFileSize = nextFileSize = size;
+
+		return Void();
+	}
+
+	Future<Void> sync() override {
+		++countFileLogicalWrites;
+		++countLogicalWrites;
+
+		if (failed) {
+			return io_timeout();
+		}
+
+		IOBlock* io = new IOBlock(IORING_OP_FSYNC, this);
+		enqueue(io);
+
+		double start_time = timer();
+		Future<Void> fsync = map(io->result.getFuture(), [start_time](int r) {
+			getMetrics().syncLatencySample.addMeasurement(timer() - start_time);
+			return Void();
+		});
+
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE) {
+			flags &= ~OPEN_ATOMIC_WRITE_AND_CREATE;
+
+			return AsyncFileEIO::waitAndAtomicRename(fsync, filename + ".part", filename);
+		}
+
+		return fsync;
+	}
+	Future<int64_t> size() const override { return nextFileSize; }
+	int64_t debugFD() const override { return fd; }
+	std::string getFilename() const override { return filename; }
+	~AsyncFileIOUring() override {
+		if (fixedFileIndex >= 0) {
+			int unregistered = -1;
+			io_uring_files_update update;
+			memset(&update, 0, sizeof(update));
+			update.offset = fixedFileIndex;
+			update.fds = (uint64_t)(uintptr_t)&unregistered;
+			if (io_uring_register(ctx.ring.fd, IORING_REGISTER_FILES_UPDATE, &update, 1) == 1)
+				ctx.freeFixedFiles.push_back(fixedFileIndex);
+			else
+				TraceEvent(SevWarnAlways, "IOUringUnregisterFileError").detail("Filename", filename).GetLastError();
+		}
+		close(fd);
+	}
+
+	// Reaps completions and then submits as much of the queue as fits in one batch. Called once per run loop
+	// iteration, and more often while the network thread is busy.
+	static void launch() {
+		reap();
+
+		if (ctx.queue.size() && ctx.outstanding < FLOW_KNOBS->MAX_OUTSTANDING - FLOW_KNOBS->MIN_SUBMIT) {
+			ctx.submitMetric = true;
+
+			double begin = timer_monotonic();
+			if (!ctx.outstanding)
+				ctx.ioStallBegin = begin;
+
+			int n = std::min<size_t>(FLOW_KNOBS->MAX_OUTSTANDING - ctx.outstanding, ctx.queue.size());
+			n = std::min<int>(n, ctx.ring.sqEntries - ctx.ring.pendingSubmissions());
+
+			double start = timer();
+			for (int i = 0; i < n; i++) {
+				auto io = ctx.queue.top();
+				ctx.queue.pop();
+				io->startTime = start;
+
+				if (ctx.ioTimeout > 0) {
+					ctx.appendToRequestList(io);
+				}
+
+				if (io->owner->lastFileSize != io->owner->nextFileSize) {
+					++ctx.countPreSubmitTruncate;
+					int64_t truncateSize = io->owner->nextFileSize - io->owner->lastFileSize;
+					ASSERT(truncateSize > 0);
+					ctx.preSubmitTruncateBytes += truncateSize;
+					io->owner->truncate(io->owner->nextFileSize);
+				}
+
+				io_uring_sqe* sqe = ctx.ring.prepare();
+				ASSERT(sqe != nullptr);
+				io->prepare(sqe);
+			}
+
+			ctx.outstanding += n;
+			++ctx.countSubmit;
+			submit();
+
+			ctx.submitMetric = false;
+			double elapsed = timer_monotonic() - begin;
+			g_network->networkInfo.metrics.secSquaredSubmit += elapsed * elapsed / 2;
+		} else if (ctx.ring.pendingSubmissions()) {
+			// Entries the kernel could not take earlier are still in the submission queue
+			submit();
+		}
+	}
+
+	bool failed;
+
+private:
+	int fd, flags;
+	int fixedFileIndex; // Index in the ring's registered file table, or -1 if the file is not registered
+	int64_t lastFileSize, nextFileSize;
+	std::string filename;
+	Int64MetricHandle countFileLogicalWrites;
+	Int64MetricHandle countFileLogicalReads;
+
+	Int64MetricHandle countLogicalWrites;
+	Int64MetricHandle countLogicalReads;
+
+	struct IOBlock : FastAllocated<IOBlock> {
+		uint8_t opcode;
+		void* buf;
+		uint32_t nbytes;
+		int64_t offset;
+		Promise<int> result;
+		Reference<AsyncFileIOUring> owner;
+		int64_t prio;
+		uint32_t sequence; // Order in which operations were issued
+		IOBlock* prev;
+		IOBlock* next;
+		uint64_t epoch; // The sync epoch of a write
+		double startTime;
+
+		struct indirect_order_by_priority {
+			bool operator()(IOBlock* a, IOBlock* b) { return a->prio < b->prio; }
+		};
+
+		IOBlock(uint8_t opcode, AsyncFileIOUring* owner)
+		  : opcode(opcode), buf(nullptr), nbytes(0), offset(0), owner(Reference<AsyncFileIOUring>::addRef(owner)),
+		    prio(0), sequence(0), prev(nullptr), next(nullptr), epoch(0), startTime(0) {}
+
+		TaskPriority getTask() const { return static_cast<TaskPriority>((prio >> 32) + 1); }
+
+		void prepare(io_uring_sqe* sqe) const {
+			sqe->opcode = opcode;
+			if (owner->fixedFileIndex >= 0) {
+				sqe->fd = owner->fixedFileIndex;
+				sqe->flags |= IOSQE_FIXED_FILE;
+			} else {
+				sqe->fd = owner->fd;
+			}
+			if (opcode == IORING_OP_FSYNC) {
+				sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+			} else {
+				sqe->addr = (uint64_t)(uintptr_t)buf;
+				sqe->len = nbytes;
+				sqe->off = offset;
+			}
+			sqe->user_data = (uint64_t)(uintptr_t)this;
+		}
+
+		ACTOR static void deliver(Promise<int> result, bool failed, int r, TaskPriority task) {
+			wait(delay(0, task));
+			if (failed)
+				result.sendError(io_timeout());
+			else if (r < 0)
+				result.sendError(io_error());
+			else
+				result.send(r);
+		}
+
+		void setResult(int r) {
+			if (r < 0) {
+				struct stat fst;
+				fstat(owner->fd, &fst);
+
+				errno = -r;
+				TraceEvent("AsyncFileIOUringIOError")
+				    .GetLastError()
+				    .detail("Fd", owner->fd)
+				    .detail("Op", opcode)
+				    .detail("Nbytes", nbytes)
+				    .detail("Offset", offset)
+				    .detail("Ptr", int64_t(buf))
+				    .detail("Size", fst.st_size)
+				    .detail("Filename", owner->filename);
+			}
+			if (opcode == IORING_OP_WRITE)
+				owner->writeCompleted(epoch);
+			deliver(result, owner->failed, r, getTask());
+			delete this;
+		}
+
+		void timeout(bool warnOnly) {
+			TraceEvent(SevWarnAlways, "AsyncFileIOUringTimeout")
+			    .detail("Fd", owner->fd)
+			    .detail("Op", opcode)
+			    .detail("Nbytes", nbytes)
+			    .detail("Offset", offset)
+			    .detail("Ptr", int64_t(buf))
+			    .detail("Filename", owner->filename);
+			g_network->setGlobal(INetwork::enASIOTimedOut, (flowGlobalType) true);
+
+			if (!warnOnly)
+				owner->failed = true;
+		}
+	};
+
+	// Unfinished writes by sync epoch, starting with firstEpoch. A sync issued while writes to this file are unfinished
+	// ends the current epoch and is held back until the writes of its epoch and all earlier ones have completed.
+	uint64_t firstEpoch;
+	std::deque<int> epochWrites;
+	std::deque<IOBlock*> heldSyncs;
+
+	struct Context {
+		linux_io_uring ring;
+		int evfd;
+		int outstanding;
+		double ioStallBegin;
+		bool fallocateSupported;
+		bool fallocateZeroSupported;
+		std::priority_queue<IOBlock*, std::vector<IOBlock*>, IOBlock::indirect_order_by_priority> queue;
+		std::vector<int> freeFixedFiles;
+		Int64MetricHandle countSubmit;
+		Int64MetricHandle countCollect;
+		Int64MetricHandle submitMetric;
+
+		double ioTimeout;
+		bool timeoutWarnOnly;
+		IOBlock* submittedRequestList;
+
+		Int64MetricHandle countPreSubmitTruncate;
+		Int64MetricHandle preSubmitTruncateBytes;
+
+		uint32_t opsIssued;
+		Context()
+		  : evfd(-1), outstanding(0), ioStallBegin(0), fallocateSupported(true), fallocateZeroSupported(true),
+		    submittedRequestList(nullptr), opsIssued(0) {
+			setIOTimeout(0);
+		}
+
+		void setIOTimeout(double timeout) {
+			ioTimeout = fabs(timeout);
+			timeoutWarnOnly = timeout < 0;
+		}
+
+		void appendToRequestList(IOBlock* io) {
+			ASSERT(!io->next && !io->prev);
+
+			if (submittedRequestList) {
+				io->prev = submittedRequestList->prev;
+				io->prev->next = io;
+
+				submittedRequestList->prev = io;
+				io->next = submittedRequestList;
+			} else {
+				submittedRequestList = io;
+				io->next = io->prev = io;
+			}
+		}
+
+		void removeFromRequestList(IOBlock* io) {
+			if (io->next == nullptr) {
+				ASSERT(io->prev == nullptr);
+				return;
+			}
+
+			ASSERT(io->prev != nullptr);
+
+			if (io == io->next) {
+				ASSERT(io == submittedRequestList && io == io->prev);
+				submittedRequestList = nullptr;
+			} else {
+				io->next->prev = io->prev;
+				io->prev->next = io->next;
+
+				if (submittedRequestList == io) {
+					submittedRequestList = io->next;
+				}
+			}
+
+			io->next = io->prev = nullptr;
+		}
+	};
+	static Context ctx;
+
+	explicit AsyncFileIOUring(int fd, int flags, std::string const& filename)
+	  : failed(false), fd(fd), flags(flags), fixedFileIndex(-1), filename(filename), firstEpoch(0), epochWrites(1, 0) {
+		countFileLogicalWrites.init("AsyncFile.CountFileLogicalWrites"_sr, filename);
+		countFileLogicalReads.init("AsyncFile.CountFileLogicalReads"_sr, filename);
+		countLogicalWrites.init("AsyncFile.CountLogicalWrites"_sr);
+		countLogicalReads.init("AsyncFile.CountLogicalReads"_sr);
+
+		if (!ctx.freeFixedFiles.empty()) {
+			io_uring_files_update update;
+			memset(&update, 0, sizeof(update));
+			update.offset = ctx.freeFixedFiles.back();
+			update.fds = (uint64_t)(uintptr_t)&this->fd;
+			if (io_uring_register(ctx.ring.fd, IORING_REGISTER_FILES_UPDATE, &update, 1) == 1) {
+				fixedFileIndex = ctx.freeFixedFiles.back();
+				ctx.freeFixedFiles.pop_back();
+			} else {
+				TraceEvent(SevWarnAlways, "IOUringRegisterFileError").detail("Filename", filename).GetLastError();
+			}
+		}
+	}
+
+	// Registers a sparse table of fixed files with the ring, which saves the kernel a file table lookup and reference
+	// count update per operation. Files take a free slot when they are opened and return it when they are closed.
+	static void registerFixedFileTable(int size) {
+		if (size <= 0)
+			return;
+		std::vector<int> fds(size, -1);
+		if (io_uring_register(ctx.ring.fd, IORING_REGISTER_FILES, fds.data(), size) < 0) {
+			TraceEvent(SevWarnAlways, "IOUringRegisterFilesError").detail("Size", size).GetLastError();
+			return;
+		}
+		for (int i = size - 1; i >= 0; i--)
+			ctx.freeFixedFiles.push_back(i);
+	}
+
+	void enqueue(IOBlock* io) {
+		ASSERT(io->opcode == IORING_OP_FSYNC ||
+		       (int64_t(io->buf) % 4096 == 0 && io->offset % 4096 == 0 && io->nbytes % 4096 == 0));
+
+		io->sequence = ++ctx.opsIssued;
+		io->prio = (int64_t(g_network->getCurrentTask()) << 32) - io->sequence;
+
+		if (io->opcode == IORING_OP_WRITE) {
+			io->epoch = firstEpoch + epochWrites.size() - 1;
+			++epochWrites.back();
+		} else if (io->opcode == IORING_OP_FSYNC && (!heldSyncs.empty() || epochWrites.back())) {
+			heldSyncs.push_back(io);
+			epochWrites.push_back(0);
+			return;
+		}
+
+		ctx.queue.push(io);
+	}
+
+	// Queues the held syncs which were only waiting for writes up to the one which completed
+	void writeCompleted(uint64_t epoch) {
+		--epochWrites[epoch - firstEpoch];
+		while (!heldSyncs.empty() && !epochWrites.front()) {
+			ctx.queue.push(heldSyncs.front());
+			heldSyncs.pop_front();
+			epochWrites.pop_front();
+			++firstEpoch;
+		}
+	}
+
+	static void submit() {
+		double begin = timer_monotonic();
+		int rc = ctx.ring.submit();
+		double end = timer_monotonic();
+
+		if (end - begin > FLOW_KNOBS->SLOW_LOOP_CUTOFF && nondeterministicRandom()->random01() < end - begin) {
+			TraceEvent("SlowIOUringLaunch").detail("IOSubmitTime", end - begin);
+		}
+		// Entries which the kernel did not consume stay in the submission queue and are submitted by the next launch
+		if (rc < 0 && rc != -EAGAIN && rc != -EBUSY) {
+			errno = -rc;
+			TraceEvent(SevWarnAlways, "IOUringSubmitError").suppressFor(1.0).GetLastError();
+		}
+	}
+
+	// Consumes the completion queue without entering the kernel
+	static void reap() {
+		double currentTime = timer();
+		int n = ctx.ring.reap([currentTime](const io_uring_cqe& cqe) {
+			IOBlock* iob = reinterpret_cast<IOBlock*>((uintptr_t)cqe.user_data);
+
+			if (ctx.ioTimeout > 0) {
+				ctx.removeFromRequestList(iob);
+			}
+
+			switch (iob->opcode) {
+			case IORING_OP_READ:
+				getMetrics().readLatencySample.addMeasurement(currentTime - iob->startTime);
+				break;
+			case IORING_OP_WRITE:
+				getMetrics().writeLatencySample.addMeasurement(currentTime - iob->startTime);
+				break;
+			}
+
+			iob->setResult(cqe.res);
+		});
+
+		if (n) {
+			++ctx.countCollect;
+			double t = timer_monotonic();
+			double elapsed = t - ctx.ioStallBegin;
+			ctx.ioStallBegin = t;
+			g_network->networkInfo.metrics.secSquaredDiskStall += elapsed * elapsed / 2;
+			ctx.outstanding -= n;
+		}
+
+		if (ctx.ioTimeout > 0) {
+			while (ctx.submittedRequestList && currentTime - ctx.submittedRequestList->startTime > ctx.ioTimeout) {
+				ctx.submittedRequestList->timeout(ctx.timeoutWarnOnly);
+				ctx.removeFromRequestList(ctx.submittedRequestList);
+			}
+		}
+	}
+
+	static int openFlags(int flags) {
+		int oflags = O_DIRECT | O_CLOEXEC;
+		ASSERT(bool(flags & OPEN_READONLY) != bool(flags & OPEN_READWRITE)); // readonly xor readwrite
+		if (flags & OPEN_EXCLUSIVE)
+			oflags |= O_EXCL;
+		if (flags & OPEN_CREATE)
+			oflags |= O_CREAT;
+		if (flags & OPEN_READONLY)
+			oflags |= O_RDONLY;
+		if (flags & OPEN_READWRITE)
+			oflags |= O_RDWR;
+		if (flags & OPEN_ATOMIC_WRITE_AND_CREATE)
+			oflags |= O_TRUNC;
+		return oflags;
+	}
+
+	// Wakes up the network thread when completions arrive while it is idle
+	ACTOR static void poll(Reference<IEventFD> ev) {
+		loop {
+			wait(success(ev->read()));
+			wait(delay(0, TaskPriority::DiskIOComplete));
+			reap();
+		}
+	}
+};
+
+TEST_CASE("/fdbrpc/AsyncFileIOUring/ReadWrite") {
+	// Only runs when the process uses io_uring, e.g. with --knob_use_io_uring=1, since the ring has to be driven by
+	// the network's run cycle function
+	if (g_network->isSimulated() || !AsyncFileIOUring::isInitialized()) {
+		return Void();
+	}
+
+	state Reference<IAsyncFile> f = wait(
+	    AsyncFileIOUring::open("/tmp/__IOURING_TEST_FILE__",
+	                           IAsyncFile::OPEN_UNBUFFERED | IAsyncFile::OPEN_READWRITE | IAsyncFile::OPEN_CREATE,
+	                           0666,
+	                           nullptr));
+	state int pages = 256;
+	state uint8_t* buf = (uint8_t*)aligned_alloc(4096, pages * 4096);
+	state uint8_t* readBuf = (uint8_t*)aligned_alloc(4096, pages * 4096);
+	try {
+		for (int i = 0; i < pages * 4096; i++)
+			buf[i] = (uint8_t)deterministicRandom()->randomInt(0, 256);
+
+		// The sync is held back until the writes issued before it have completed
+		state std::vector<Future<Void>> writes;
+		for (int p = 0; p < pages; p++)
+			writes.push_back(f->write(buf + p * 4096, 4096, p * 4096));
+		wait(f->sync());
+		wait(waitForAll(writes));
+
+		int read = wait(f->read(readBuf, pages * 4096, 0));
+		ASSERT_EQ(read, pages * 4096);
+		ASSERT(memcmp(buf, readBuf, pages * 4096) == 0);
+	} catch (Error& e) {
+		aligned_free(buf);
+		aligned_free(readBuf);
+		throw;
+	}
+	aligned_free(buf);
+	aligned_free(readBuf);
+	wait(AsyncFileEIO::deleteFile(f->getFilename(), true));
+	return Void();
+}
+
+AsyncFileIOUring::Context AsyncFileIOUring::ctx;
+
+#include "flow/unactorcompiler.h"
+#endif
+#endif
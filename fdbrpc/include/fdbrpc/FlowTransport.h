@@ -171,6 +171,8 @@ struct Peer : public ReferenceCounted<Peer> {
 	int64_t lastLoggedBytesReceived;
 	int64_t lastLoggedBytesSent;
 	int timeoutCount;
+	// Set while the current connection's peer accepts compressed packets and PEER_COMPRESSION_MODE selects it
+	bool compressOutgoing;
 
 	Reference<AsyncVar<Optional<ProtocolVersion>>> protocolVersion;
 
@@ -179,6 +181,11 @@ struct Peer : public ReferenceCounted<Peer> {
 	int connectIncomingCount;
 	int connectFailedCount;
 	DDSketch<double> connectLatencies;
+	// Sizes of compressed packets before compression and on the wire, in each direction
+	int64_t uncompressedBytesSent;
+	int64_t compressedBytesSent;
+	int64_t uncompressedBytesReceived;
+	int64_t compressedBytesReceived;
 	Promise<Void> disconnect;
 
 	explicit Peer(TransportData* transport, NetworkAddress const& destination);
@@ -213,6 +220,10 @@ public:
 	// Metrics must be initialized after FlowTransport::createInstance has been called
 	void initMetrics();
 
+	// Sets the data center this process is in, which PEER_COMPRESSION_MODE uses to decide which peers to compress
+	// packets for. Peers learn it from the connect packet of each new connection.
+	void setLocalDcId(Optional<Standalone<StringRef>> dcId);
+
 	// Starts a server listening on the given listenAddress, and sets publicAddress to be the public
 	// address of this server.  Returns only errors.
 	Future<Void> bind(NetworkAddress publicAddress, NetworkAddress listenAddress);
@@ -48,6 +48,22 @@ enum ComparisonType { TSS_COMPARISON, REPLICA_COMPARISON };
 
 enum RequiredReplicas { BEST_EFFORT = -2, ALL_REPLICAS = -1 };
 
+// Interfaces whose servers can abandon a request which lost a load balancing race define
+// enum { CancelsLostLoadBalancedRequests = 1 } and a cancelLostRequest(UID replyToken) const method, and the requests
+// which can be abandoned define enum { CancellableIfLost = 1 }.
+template <class Interface, class Request, class Enable = void>
+struct LBCancellation {
+	static void cancel(Interface const&, UID) {}
+};
+
+template <class Interface, class Request>
+struct LBCancellation<
+    Interface,
+    Request,
+    typename std::enable_if<Interface::CancelsLostLoadBalancedRequests && Request::CancellableIfLost>::type> {
+	static void cancel(Interface const& i, UID replyToken) { i.cancelLostRequest(replyToken); }
+};
+
 struct ModelHolder : NonCopyable, public ReferenceCounted<ModelHolder> {
 	QueueModel* model;
 	bool released;
@@ -458,6 +474,8 @@ struct RequestData : NonCopyable {
 	Reference<ModelHolder> modelHolder;
 	TriedAllOptions triedAllOptions{ false };
 	RequestStream<Request, P> const* requestStream = nullptr;
+	int alternative = -1; // The index of the alternative the request is sent to
+	UID replyToken;
 
 	bool requestStarted = false; // true once the request has been sent to an alternative
 	bool requestProcessed = false; // true once a response has been received and handled by checkAndProcessResult
@@ -533,6 +551,15 @@ struct RequestData : NonCopyable {
 		return Void();
 	}
 
+	// Sends the request with a reply promise of its own. The first and second requests are sent from the same Request,
+	// and a shared reply would give both servers the same replyToken and let either answer complete both requests.
+	Future<Reply> sendRequest(RequestStream<Request, P> const* stream, Request& request, TaskPriority taskID) {
+		resetReply(request, taskID);
+		Future<Reply> resp = stream->tryGetReply(request);
+		replyToken = request.reply.getEndpoint().token;
+		return resp;
+	}
+
 	// Initializes the request state and starts it, possibly after a backoff delay
 	void startRequest(
 	    double backoff,
@@ -541,23 +568,24 @@ struct RequestData : NonCopyable {
 	    Request& request,
 	    QueueModel* model,
 	    Reference<MultiInterface<Multi>> alternatives, // alternatives and channel passed through for TSS check
-	    RequestStream<Request, P> Interface::* channel) {
+	    RequestStream<Request, P> Interface::* channel,
+	    TaskPriority taskID) {
 		modelHolder = Reference<ModelHolder>();
 		requestStream = stream;
 		requestStarted = false;
 
 		if (backoff > 0) {
-			response = mapAsync(delay(backoff), [this, stream, &request, model, alternatives, channel](Void _) {
+			response = mapAsync(delay(backoff), [this, stream, &request, model, alternatives, channel, taskID](Void _) {
 				requestStarted = true;
 				modelHolder = Reference<ModelHolder>(new ModelHolder(model, stream->getEndpoint().token.first()));
-				Future<Reply> resp = stream->tryGetReply(request);
+				Future<Reply> resp = sendRequest(stream, request, taskID);
 				maybeDuplicateTSSRequest(stream, request, model, resp, alternatives, channel);
 				return resp;
 			});
 		} else {
 			requestStarted = true;
 			modelHolder = Reference<ModelHolder>(new ModelHolder(model, stream->getEndpoint().token.first()));
-			response = stream->tryGetReply(request);
+			response = sendRequest(stream, request, taskID);
 			maybeDuplicateTSSRequest(stream, request, model, response, alternatives, channel);
 		}
 
@@ -565,6 +593,13 @@ struct RequestData : NonCopyable {
 		this->triedAllOptions = triedAllOptions;
 	}
 
+	// Asks the server to abandon the request if it has not answered yet, because another alternative has
+	void cancelIfOutstanding(Reference<MultiInterface<Multi>> const& alternatives) {
+		if (FLOW_KNOBS->CANCEL_LOST_SECOND_REQUESTS && requestStarted && !requestProcessed && !response.isReady()) {
+			LBCancellation<Interface, Request>::cancel(alternatives->getInterface(alternative), replyToken);
+		}
+	}
+
 	// Implementation of the logic to handle a response.
 	// Checks the state of the response, updates the queue model, and returns one of the following outcomes:
 	// A return value of true means that the request completed successfully
@@ -594,9 +629,12 @@ struct RequestData : NonCopyable {
 		    loadBalancedReply.present() ? !loadBalancedReply.get().error.present() : result.present();
 		receivedResponse = receivedResponse || (!maybeDelivered && errCode != error_code_process_behind);
 		bool futureVersion = errCode == error_code_future_version || errCode == error_code_process_behind;
+		// A request abandoned by cancelIfOutstanding() ends early, so it must not lower the measured latency
+		bool abandoned = errCode == error_code_operation_obsolete;
 
-		modelHolder->release(
-		    receivedResponse, futureVersion, loadBalancedReply.present() ? loadBalancedReply.get().penalty : -1.0);
+		modelHolder->release(receivedResponse && !abandoned,
+		                     futureVersion,
+		                     loadBalancedReply.present() ? loadBalancedReply.get().penalty : -1.0);
 
 		if (errCode == error_code_server_overloaded) {
 			return false;
@@ -847,6 +885,7 @@ Future<REPLY_TYPE(Request)> loadBalance(
 		// nextAlt. This logic matters only if model == nullptr. Otherwise, the
 		// bestAlt and nextAlt have been decided.
 		state RequestStream<Request, P> const* stream = nullptr;
+		state int streamAlt = -1;
 		state LBDistance::Type distance;
 		for (int alternativeNum = 0; alternativeNum < alternatives->size(); alternativeNum++) {
 			int useAlt = nextAlt;
@@ -858,8 +897,11 @@ Future<REPLY_TYPE(Request)> loadBalance(
 			stream = &alternatives->get(useAlt, channel);
 			distance = alternatives->getDistance(useAlt);
 			if (!IFailureMonitor::failureMonitor().getState(stream->getEndpoint()).failed &&
-			    (!firstRequestEndpoint.present() || stream->getEndpoint().token.first() != firstRequestEndpoint.get()))
+			    (!firstRequestEndpoint.present() ||
+			     stream->getEndpoint().token.first() != firstRequestEndpoint.get())) {
+				streamAlt = useAlt;
 				break;
+			}
 			nextAlt = (nextAlt + 1) % alternatives->size();
 			if (nextAlt == startAlt)
 				triedAllOptions = TriedAllOptions::True;
@@ -917,7 +959,9 @@ Future<REPLY_TYPE(Request)> loadBalance(
 				    .detail("Best", alternatives->countBest())
 				    .detail("Attempts", numAttempts);
 			}
-			secondRequestData.startRequest(backoff, triedAllOptions, stream, request, model, alternatives, channel);
+			secondRequestData.startRequest(
+			    backoff, triedAllOptions, stream, request, model, alternatives, channel, taskID);
+			secondRequestData.alternative = streamAlt;
 
 			state bool firstRequestSuccessful = false;
 			state bool secondRequestSuccessful = false;
@@ -946,6 +990,9 @@ Future<REPLY_TYPE(Request)> loadBalance(
 				    firstRequestSuccessful ? &firstRequestData : &secondRequestData;
 				wait(requestData->maybeDoReplicaComparison(request, model, alternatives, channel, requiredReplicas));
 
+				// The other request lost the race, so its server need not finish it
+				(firstRequestSuccessful ? secondRequestData : firstRequestData).cancelIfOutstanding(alternatives);
+
 				ASSERT(requestData->response.isReady());
 				return requestData->response.get().get();
 			}
@@ -969,7 +1016,9 @@ Future<REPLY_TYPE(Request)> loadBalance(
 				    .detail("Best", alternatives->countBest())
 				    .detail("Attempts", numAttempts);
 			}
-			firstRequestData.startRequest(backoff, triedAllOptions, stream, request, model, alternatives, channel);
+			firstRequestData.startRequest(
+			    backoff, triedAllOptions, stream, request, model, alternatives, channel, taskID);
+			firstRequestData.alternative = streamAlt;
 			firstRequestEndpoint = stream->getEndpoint().token.first();
 
 			loop {
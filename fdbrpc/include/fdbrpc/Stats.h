@@ -45,6 +45,7 @@ MyCounters() : foo("foo", cc), bar("bar", cc), baz("baz", cc) {}
 #include <cstddef>
 #include "flow/flow.h"
 #include "flow/TDMetric.actor.h"
+#include "flow/Histogram.h"
 #include "fdbrpc/DDSketch.h"
 
 struct ICounter : public IMetric {
@@ -235,7 +236,8 @@ public:
 	              UID id,
 	              double loggingInterval,
 	              double accuracy,
-	              bool skipTraceOnSilentInterval = false);
+	              bool skipTraceOnSilentInterval = false,
+	              bool logLinearHistogram = false);
 	void addMeasurement(double measurement);
 
 private:
@@ -255,6 +257,9 @@ private:
 	double sampleEmit;
 
 	DDSketch<double> sketch;
+	// If set, measurements are also recorded with the finer bucketing of a LogLinearHistogram, whose percentiles are
+	// logged as HistogramP50, HistogramP90, HistogramP99 and HistogramP99.9
+	Reference<LogLinearHistogram> histogram;
 	Future<Void> logger;
 	bool skipTraceOnSilentInterval;
 
@@ -154,6 +154,8 @@ public:
 	}
 	bool isSet() const { return sav->isSet(); }
 	bool isValid() const { return sav != nullptr; }
+	// True if a reply sent to this promise will be serialized to another process
+	bool isRemoteEndpoint() const { return sav->isRemoteEndpoint(); }
 	ReplyPromise() : sav(new NetSAV<T>(0, 1)) {}
 	explicit ReplyPromise(const PeerCompatibilityPolicy& policy) : ReplyPromise() {
 		sav->setPeerCompatibilityPolicy(policy);
@@ -551,6 +553,8 @@ public:
 	// The endpoints of a ReplyPromiseStream must be initialized at Task::ReadSocket, because with lower priorities
 	// a delay(0) in FlowTransport deliver can cause out of order delivery.
 	const Endpoint& getEndpoint() const { return queue->getEndpoint(TaskPriority::ReadSocket); }
+	// True if values sent on this stream will be serialized to another process
+	bool isRemoteEndpoint() const { return queue->isRemoteEndpoint(); }
 
 	bool operator==(const ReplyPromiseStream<T>& rhs) const { return queue == rhs.queue; }
 	bool operator!=(const ReplyPromiseStream<T>& rhs) const { return !(*this == rhs); }
@@ -0,0 +1,179 @@
+/*
+ * linux_io_uring.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+#ifdef HAVE_IO_URING
+
+// io_uring system calls and the rings shared with the kernel
+
+#include <algorithm>
+#include <cstdint>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+static int io_uring_setup(unsigned entries, io_uring_params* params) {
+	return syscall(__NR_io_uring_setup, entries, params);
+}
+static int io_uring_enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+	return syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0);
+}
+static int io_uring_register(int fd, unsigned opcode, const void* arg, unsigned nrArgs) {
+	return syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs);
+}
+
+// The submission and completion queues of one io_uring instance. Only the thread which owns the ring may prepare
+// submissions or reap completions.
+struct linux_io_uring {
+	int fd = -1;
+
+	// Submission queue
+	unsigned* sqHead = nullptr;
+	unsigned* sqTail = nullptr;
+	unsigned* sqArray = nullptr;
+	unsigned sqMask = 0;
+	unsigned sqEntries = 0;
+	unsigned sqPreparedTail = 0; // Entries up to here have been prepared but possibly not yet published
+	io_uring_sqe* sqes = nullptr;
+
+	// Completion queue
+	unsigned* cqHead = nullptr;
+	unsigned* cqTail = nullptr;
+	unsigned cqMask = 0;
+	io_uring_cqe* cqes = nullptr;
+
+	void* sqRing = MAP_FAILED;
+	void* cqRing = MAP_FAILED;
+	size_t sqRingSize = 0;
+	size_t cqRingSize = 0;
+	size_t sqesSize = 0;
+
+	// Returns 0 on success or a negative errno value
+	int setup(unsigned entries) {
+		io_uring_params params;
+		memset(&params, 0, sizeof(params));
+		fd = io_uring_setup(entries, &params);
+		if (fd < 0)
+			return -errno;
+
+		sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+		if (singleMmap)
+			sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+
+		sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+		if (sqRing == MAP_FAILED)
+			return teardown(-errno);
+		if (singleMmap) {
+			cqRing = sqRing;
+		} else {
+			cqRing =
+			    mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+			if (cqRing == MAP_FAILED)
+				return teardown(-errno);
+		}
+		sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		void* sqesMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+		if (sqesMap == MAP_FAILED)
+			return teardown(-errno);
+		sqes = static_cast<io_uring_sqe*>(sqesMap);
+
+		uint8_t* sq = static_cast<uint8_t*>(sqRing);
+		sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+		sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+		sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+		sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+		sqEntries = params.sq_entries;
+		sqPreparedTail = *sqTail;
+
+		uint8_t* cq = static_cast<uint8_t*>(cqRing);
+		cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+		cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+		cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+		cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+		return 0;
+	}
+
+	// Unmaps the rings and closes the ring file descriptor, returning result
+	int teardown(int result) {
+		if (sqes != nullptr)
+			munmap(sqes, sqesSize);
+		if (cqRing != MAP_FAILED && cqRing != sqRing)
+			munmap(cqRing, cqRingSize);
+		if (sqRing != MAP_FAILED)
+			munmap(sqRing, sqRingSize);
+		if (fd >= 0)
+			close(fd);
+		sqes = nullptr;
+		sqRing = cqRing = MAP_FAILED;
+		fd = -1;
+		return result;
+	}
+
+	// Returns a zeroed submission queue entry to fill in, or nullptr if the submission queue is full. The entry is
+	// handed to the kernel by the next call to submit().
+	io_uring_sqe* prepare() {
+		const unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+		if (sqPreparedTail - head >= sqEntries)
+			return nullptr;
+		const unsigned index = sqPreparedTail & sqMask;
+		io_uring_sqe* sqe = &sqes[index];
+		memset(sqe, 0, sizeof(*sqe));
+		sqArray[index] = index;
+		++sqPreparedTail;
+		return sqe;
+	}
+
+	// Number of prepared or published entries which the kernel has not consumed yet
+	unsigned pendingSubmissions() const { return sqPreparedTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE); }
+
+	// Publishes all prepared entries and submits everything pending in the submission queue with one system call.
+	// Returns the number of entries the kernel consumed, or a negative errno value.
+	int submit() {
+		__atomic_store_n(sqTail, sqPreparedTail, __ATOMIC_RELEASE);
+		const unsigned toSubmit = pendingSubmissions();
+		if (!toSubmit)
+			return 0;
+		int rc;
+		do {
+			rc = io_uring_enter(fd, toSubmit, 0, 0);
+		} while (rc < 0 && errno == EINTR);
+		return rc < 0 ? -errno : rc;
+	}
+
+	// Calls f(cqe) for every completion currently in the completion queue, without any system call, and returns the
+	// number of completions consumed.
+	template <class F>
+	int reap(F&& f) {
+		unsigned head = *cqHead;
+		const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+		const int count = tail - head;
+		for (; head != tail; ++head)
+			f(cqes[head & cqMask]);
+		__atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+		return count;
+	}
+};
+
+#endif
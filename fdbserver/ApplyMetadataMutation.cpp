@@ -673,6 +673,37 @@ private:
 		}
 	}
 
+	// Sends a change feed's registration to every storage server which owns part of the feed's range.
+	void checkSetChangeFeedPrefix(MutationRef m) {
+		if (!m.param1.startsWith(changeFeedPrefix)) {
+			return;
+		}
+		if (toCommit && keyInfo) {
+			KeyRange feedRange = std::get<0>(decodeChangeFeedValue(m.param2));
+			MutationRef privatized = m;
+			privatized.clearChecksumAndAccumulativeIndex();
+			privatized.param1 = m.param1.withPrefix(systemKeys.begin, arena);
+			std::set<Tag> allTags;
+			for (auto& r : keyInfo->intersectingRanges(feedRange)) {
+				allTags.insert(r.value().tags.begin(), r.value().tags.end());
+			}
+			if (allTags.empty()) {
+				return;
+			}
+			TraceEvent(SevDebug, "SendingPrivatized_ChangeFeed", dbgid)
+			    .detail("Original", m)
+			    .detail("Privatized", privatized)
+			    .detail("Range", feedRange)
+			    .detail("Tags", allTags.size());
+			if (acsBuilder != nullptr) {
+				updateMutationWithAcsAndAddMutationToAcsBuilder(
+				    acsBuilder, privatized, allTags, accumulativeChecksumIndex, epoch.get(), version, dbgid);
+			}
+			toCommit->addTags(allTags);
+			writeMutation(privatized);
+		}
+	}
+
 	void checkSetOtherKeys(MutationRef m) {
 		if (initialCommit)
 			return;
@@ -1164,6 +1195,7 @@ public:
 				checkSetKeyServersPrefix(m);
 				checkSetServerKeysPrefix(m);
 				checkSetCheckpointKeys(m);
+				checkSetChangeFeedPrefix(m);
 				checkSetServerTagsPrefix(m);
 				checkSetConfigKeys(m);
 				checkSetServerListPrefix(m);
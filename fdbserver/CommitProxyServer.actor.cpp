@@ -41,6 +41,7 @@
 #include "fdbserver/AccumulativeChecksumUtil.h"
 #include "fdbserver/ApplyMetadataMutation.h"
 #include "fdbserver/ConflictSet.h"
+#include "fdbserver/CoroFlow.h"
 #include "fdbserver/DataDistributorInterface.h"
 #include "fdbserver/FDBExecHelper.actor.h"
 #include "fdbserver/IKeyValueStore.h"
@@ -488,6 +489,27 @@ ACTOR Future<Void> releaseResolvingAfter(ProxyCommitData* self, Future<Void> rel
 	return Void();
 }
 
+// Runs on the proxy's message copy thread (see PROXY_PIPELINE_MESSAGE_COPIES)
+struct MessageCopier final : IThreadPoolReceiver {
+	void init() override {}
+
+	struct CopyAction final : TypedAction<MessageCopier, CopyAction> {
+		std::unique_ptr<DeferredLogMessages> messages;
+		ThreadReturnPromise<std::vector<Standalone<StringRef>>> result;
+
+		explicit CopyAction(std::unique_ptr<DeferredLogMessages> messages) : messages(std::move(messages)) {}
+		double getTimeEstimate() const override { return 0; }
+	};
+
+	void action(CopyAction& a) {
+		try {
+			a.result.send(a.messages->gather());
+		} catch (Error& e) {
+			a.result.sendError(e);
+		}
+	}
+};
+
 ACTOR static Future<ResolveTransactionBatchReply> trackResolutionMetrics(Reference<Histogram> dist,
                                                                          Future<ResolveTransactionBatchReply> in) {
 	state double startTime = g_network->timer_monotonic();
@@ -752,6 +774,10 @@ CommitBatchContext::CommitBatchContext(ProxyCommitData* const pProxyCommitData_,
 
 	evaluateBatchSize();
 
+	if (pProxyCommitData->messageCopyThread) {
+		toCommit.deferMessageCopies();
+	}
+
 	if (batchOperations != 0) {
 		latencyBucket =
 		    std::min<int>(SERVER_KNOBS->PROXY_COMPUTE_BUCKETS - 1,
@@ -1516,6 +1542,34 @@ ACTOR Future<Void> assignMutationsToStorageServers(CommitBatchContext* self) {
 	return Void();
 }
 
+// Has the message copy thread build the batch's per-TLog messages, then pushes them once the previous batch handed to
+// the thread has been pushed. Meanwhile the main thread is free to assign tags for the next batch.
+ACTOR Future<Version> copyMessagesAndPush(CommitBatchContext* self,
+                                          ILogSystem::PushVersionSet versionSet,
+                                          SpanContext spanContext,
+                                          Optional<std::unordered_map<uint16_t, Version>> tpcvMap) {
+	state ProxyCommitData* const pProxyCommitData = self->pProxyCommitData;
+	state Future<Void> previousPush = pProxyCommitData->lastPipelinedPush;
+	state Promise<Void> pushed;
+	pProxyCommitData->lastPipelinedPush = pushed.getFuture();
+
+	auto action = new MessageCopier::CopyAction(self->toCommit.takeDeferredMessages());
+	state Future<std::vector<Standalone<StringRef>>> copied = action->result.getFuture();
+	pProxyCommitData->messageCopyThread->post(action);
+
+	std::vector<Standalone<StringRef>> messages = wait(copied);
+	self->toCommit.setGatheredMessages(std::move(messages));
+	wait(previousPush);
+
+	state Future<Version> loggingComplete =
+	    pProxyCommitData->logSystem->push(versionSet, self->toCommit, spanContext, self->debugID, tpcvMap);
+	pushed.send(Void());
+	pProxyCommitData->stats.commitBatchingEmptyMessageRatio.addMeasurement(self->toCommit.getEmptyMessageRatio());
+
+	Version version = wait(loggingComplete);
+	return version;
+}
+
 ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 	state double postResolutionStart = g_network->timer_monotonic();
 	state ProxyCommitData* const pProxyCommitData = self->pProxyCommitData;
@@ -1743,11 +1797,15 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 		                                                self->commitVersion,
 		                                                pProxyCommitData->committedVersion.get(),
 		                                                pProxyCommitData->minKnownCommittedVersion };
-	self->loggingComplete =
-	    pProxyCommitData->logSystem->push(versionSet, self->toCommit, span.context, self->debugID, tpcvMap);
+	if (self->toCommit.hasDeferredMessages()) {
+		self->loggingComplete = copyMessagesAndPush(self, versionSet, span.context, tpcvMap);
+	} else {
+		self->loggingComplete =
+		    pProxyCommitData->logSystem->push(versionSet, self->toCommit, span.context, self->debugID, tpcvMap);
 
-	float ratio = self->toCommit.getEmptyMessageRatio();
-	pProxyCommitData->stats.commitBatchingEmptyMessageRatio.addMeasurement(ratio);
+		float ratio = self->toCommit.getEmptyMessageRatio();
+		pProxyCommitData->stats.commitBatchingEmptyMessageRatio.addMeasurement(ratio);
+	}
 
 	if (!self->forceRecovery) {
 		ASSERT(pProxyCommitData->latestLocalCommitBatchLogging.get() == self->localBatchNumber - 1);
@@ -2852,6 +2910,12 @@ ACTOR Future<Void> commitProxyServerCore(CommitProxyInterface proxy,
 	                                 commitProxyIndex,
 	                                 epoch);
 
+	if (SERVER_KNOBS->PROXY_PIPELINE_MESSAGE_COPIES) {
+		commitData.messageCopyThread =
+		    g_network->isSimulated() ? CoroThreadPool::createThreadPool() : createGenericThreadPool();
+		commitData.messageCopyThread->addThread(new MessageCopier(), "fdb-proxy-msgcp");
+	}
+
 	state Future<Sequence> sequenceFuture = (Sequence)0;
 	state PromiseStream<std::pair<std::vector<CommitTransactionRequest>, int>> batchedCommits;
 	state Future<Void> commitBatcherActor;
@@ -162,11 +162,15 @@ struct GrvProxyStats {
 	    grvLatencySample("GRVLatencyMetrics",
 	                     id,
 	                     SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
-	                     SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	                     SERVER_KNOBS->LATENCY_SKETCH_ACCURACY,
+	                     /*skipTraceOnSilentInterval=*/false,
+	                     /*logLinearHistogram=*/true),
 	    grvBatchLatencySample("GRVBatchLatencyMetrics",
 	                          id,
 	                          SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
-	                          SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	                          SERVER_KNOBS->LATENCY_SKETCH_ACCURACY,
+	                          /*skipTraceOnSilentInterval=*/false,
+	                          /*logLinearHistogram=*/true),
 	    recentRequests(0), lastBucketBegin(now()),
 	    bucketInterval(FLOW_KNOBS->BASIC_LOAD_BALANCE_UPDATE_RATE / FLOW_KNOBS->BASIC_LOAD_BALANCE_BUCKETS),
 	    grvConfirmEpochLiveDist(
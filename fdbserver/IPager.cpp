@@ -19,11 +19,99 @@
  */
 #include "fdbserver/IPager.h"
 
+#include "flow/CompressionUtils.h"
 #include "flow/EncryptUtils.h"
 #include "flow/IRandom.h"
 #include "flow/UnitTest.h"
 #include <limits>
 
+bool ArenaPage::compressionSupported() {
+	return CompressionUtils::supportedFilters.count(CompressionFilter::ZSTD) != 0;
+}
+
+Reference<ArenaPage> ArenaPage::compress(int blockSize, int physicalBlockSize, double* compressTime) const {
+	if (!compressionSupported()) {
+		TraceEvent(SevWarnAlways, "InvalidPageEncoding").detail("EncodingType", page->encodingType);
+		throw page_encoding_not_supported();
+	}
+
+	double startTime = timer_monotonic();
+	Arena compressedArena;
+	StringRef compressed = CompressionUtils::compress(CompressionFilter::ZSTD, dataAsStringRef(), compressedArena);
+	// A payload which does not compress is stored as is so that the page never takes up more blocks than this one
+	bool useCompressed = compressed.size() < payloadSize;
+	StringRef stored = useCompressed ? compressed : dataAsStringRef();
+
+	int headerSize = pPayload - buffer;
+	int blocks = (headerSize + stored.size() + blockSize - 1) / blockSize;
+	ArenaPage* p = new ArenaPage(blocks * blockSize, blocks * physicalBlockSize);
+	memcpy(p->buffer, buffer, headerSize);
+	memcpy(p->buffer + headerSize, stored.begin(), stored.size());
+	memset(p->buffer + headerSize + stored.size(), 0, p->logicalSize - headerSize - stored.size());
+
+	// Non-verifying header parse just to initialize members
+	p->postReadHeader(invalidPhysicalPageID, false);
+	XXHashZstdEncoder::Header* h = reinterpret_cast<XXHashZstdEncoder::Header*>(p->page->getEncodingHeader());
+	h->payloadSize = payloadSize;
+	h->compressedSize = useCompressed ? compressed.size() : 0;
+
+	if (compressTime != nullptr) {
+		*compressTime += timer_monotonic() - startTime;
+	}
+	return Reference<ArenaPage>(p);
+}
+
+void ArenaPage::decompress(double* decompressTime) {
+	const XXHashZstdEncoder::Header* h = reinterpret_cast<const XXHashZstdEncoder::Header*>(page->getEncodingHeader());
+	int headerSize = pPayload - buffer;
+	uint32_t storedSize = h->compressedSize == 0 ? h->payloadSize : h->compressedSize;
+	if (storedSize > (uint32_t)payloadSize) {
+		throw page_decoding_failed();
+	}
+
+	// The payload was stored as is, so only the zeroed space after it in the last block needs to be dropped
+	if (h->compressedSize == 0) {
+		payloadSize = h->payloadSize;
+		logicalSize = headerSize + payloadSize;
+		return;
+	}
+
+	if (!compressionSupported()) {
+		TraceEvent(SevWarnAlways, "InvalidPageEncoding").detail("EncodingType", page->encodingType);
+		throw page_encoding_not_supported();
+	}
+
+	double startTime = timer_monotonic();
+	Arena decompressedArena;
+	StringRef decompressed = CompressionUtils::decompress(
+	    CompressionFilter::ZSTD, StringRef(pPayload, h->compressedSize), h->payloadSize, decompressedArena);
+	if (decompressed.size() != h->payloadSize) {
+		throw page_decoding_failed();
+	}
+
+	Arena newArena;
+	int newLogicalSize = headerSize + decompressed.size();
+	int newBufferSize = (newLogicalSize + 4095) & ~4095;
+	uint8_t* newBuffer = (uint8_t*)newArena.allocate4kAlignedBuffer(newBufferSize);
+	memcpy(newBuffer, buffer, headerSize);
+	memcpy(newBuffer + headerSize, decompressed.begin(), decompressed.size());
+	memset(newBuffer + newLogicalSize, 0, newBufferSize - newLogicalSize);
+
+	arena = newArena;
+	buffer = newBuffer;
+	logicalSize = newLogicalSize;
+	bufferSize = newBufferSize;
+	pPayload = page->getPayload();
+	payloadSize = decompressed.size();
+
+	// The page in memory describes its payload as stored uncompressed
+	reinterpret_cast<XXHashZstdEncoder::Header*>(page->getEncodingHeader())->compressedSize = 0;
+
+	if (decompressTime != nullptr) {
+		*decompressTime += timer_monotonic() - startTime;
+	}
+}
+
 TEST_CASE("/fdbserver/IPager/ArenaPage/PageContentChecksum") {
 	EncodingType encodingType = EncodingType::XXHash64;
 	// TODO: it should not be necessary to define this constant here.  ArenaPage or something
@@ -47,3 +135,63 @@ TEST_CASE("/fdbserver/IPager/ArenaPage/PageContentChecksum") {
 	}
 	return Void();
 }
+
+TEST_CASE("/fdbserver/IPager/ArenaPage/Compression") {
+	if (!ArenaPage::compressionSupported()) {
+		return Void();
+	}
+
+	constexpr int blockSize = 4096;
+	constexpr int blocks = 4;
+	Reference<ArenaPage> page = makeReference<ArenaPage>(blocks * blockSize, blocks * blockSize);
+	page->init(EncodingType::XXHash64Zstd, PageType::BTreeNode, 1);
+
+	// A payload of a few distinct bytes compresses into fewer blocks, random bytes do not compress
+	bool compressible = deterministicRandom()->coinflip();
+	if (compressible) {
+		for (int i = 0; i < page->dataSize(); ++i) {
+			page->mutateData()[i] = deterministicRandom()->randomInt(0, 4);
+		}
+	} else {
+		deterministicRandom()->randomBytes(page->mutateData(), page->dataSize());
+	}
+
+	int diskBlocks = page->getDiskBlockCount(blockSize, blockSize);
+	if (compressible) {
+		ASSERT_LT(diskBlocks, blocks);
+	} else {
+		ASSERT_EQ(diskBlocks, blocks);
+	}
+
+	PhysicalPageID pageID = deterministicRandom()->randomUInt32();
+	page->setWriteInfo(pageID, 1 /*version*/);
+	Reference<ArenaPage> diskPage = page->takeDiskPage(blockSize, blockSize);
+	ASSERT(diskPage != page);
+	ASSERT_EQ(diskPage->rawSize(), diskBlocks * blockSize);
+	diskPage->preWrite(pageID);
+
+	// Read the written blocks back into a page the way the pager does
+	Reference<ArenaPage> readPage = makeReference<ArenaPage>(diskBlocks * blockSize, diskBlocks * blockSize);
+	memcpy(readPage->rawData(), diskPage->rawData(), diskPage->rawSize());
+	readPage->postReadHeader(pageID);
+	readPage->postReadPayload(pageID);
+	ASSERT(readPage->dataAsStringRef() == page->dataAsStringRef());
+	ASSERT_EQ(readPage->getPhysicalPageID(), pageID);
+
+	// A decompressed page can be written again and compresses to the same blocks
+	ASSERT_EQ(readPage->getDiskBlockCount(blockSize, blockSize), diskBlocks);
+
+	// Corruption of the stored payload is detected before decompressing
+	readPage = makeReference<ArenaPage>(diskBlocks * blockSize, diskBlocks * blockSize);
+	memcpy(readPage->rawData(), diskPage->rawData(), diskPage->rawSize());
+	uint8_t* byte = readPage->rawData() + deterministicRandom()->randomInt(blockSize / 2, diskBlocks * blockSize);
+	*byte = ~(*byte);
+	readPage->postReadHeader(pageID);
+	try {
+		readPage->postReadPayload(pageID);
+		UNREACHABLE();
+	} catch (Error& e) {
+		ASSERT_EQ(e.code(), error_code_page_decoding_failed);
+	}
+	return Void();
+}
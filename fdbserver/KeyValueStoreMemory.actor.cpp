@@ -23,6 +23,7 @@
 #include "fdbclient/Notified.h"
 #include "fdbclient/SystemData.h"
 #include "fdbserver/ServerDBInfo.actor.h"
+#include "fdbserver/CoroFlow.h"
 #include "fdbserver/DeltaTree.h"
 #include "fdbserver/IDiskQueue.h"
 #include "fdbserver/IKeyValueContainer.h"
@@ -31,7 +32,10 @@
 #include "fdbserver/TransactionStoreMutationTracking.h"
 #include "flow/ActorCollection.h"
 #include "flow/EncryptUtils.h"
+#include "flow/IAsyncFile.h"
+#include "flow/IThreadPool.h"
 #include "flow/Knobs.h"
+#include "flow/xxhash.h"
 #include "flow/actorcompiler.h" // This must be the last #include.
 
 #define OP_DISK_OVERHEAD (sizeof(OpHeader) + 1)
@@ -47,7 +51,8 @@ public:
 	                    KeyValueStoreType storeType,
 	                    bool disableSnapshot,
 	                    bool replaceContent,
-	                    bool exactRecovery);
+	                    bool exactRecovery,
+	                    std::string imageFilename = std::string());
 
 	bool getReplaceContent() const override { return replaceContent; }
 	// IClosable
@@ -55,6 +60,12 @@ public:
 	Future<Void> onClosed() const override { return log->onClosed(); }
 	void dispose() override {
 		recovering.cancel();
+		imaging.cancel();
+		if (!imageFilename.empty()) {
+			// An image being written is in a temporary file until it is synced
+			uncancellable(IAsyncFileSystem::filesystem()->deleteFile(imageFilename, false));
+			uncancellable(IAsyncFileSystem::filesystem()->deleteFile(imageFilename + ".part", false));
+		}
 		log->dispose();
 		if (reserved_buffer != nullptr) {
 			delete[] reserved_buffer;
@@ -64,6 +75,7 @@ public:
 	}
 	void close() override {
 		recovering.cancel();
+		imaging.cancel();
 		log->close();
 		if (reserved_buffer != nullptr) {
 			delete[] reserved_buffer;
@@ -164,6 +176,7 @@ public:
 			semiCommit();
 		}
 
+		Optional<IDiskQueue::location> commitLocation;
 		if (transactionIsLarge) {
 			fullSnapshot(data);
 			resetSnapshot = true;
@@ -173,7 +186,7 @@ public:
 			if (disableSnapshot) {
 				return Void();
 			}
-			log_op(OpCommit, StringRef(), StringRef());
+			commitLocation = log_op(OpCommit, StringRef(), StringRef());
 		} else {
 			int64_t bytesWritten = commit_queue(queue, !disableSnapshot, sequential);
 
@@ -186,19 +199,28 @@ public:
 				                       OP_DISK_OVERHEAD; // OP_DISK_OVERHEAD is for the following log_op(OpCommit)
 				notifiedCommittedWriteBytes.set(committedWriteBytes); // This set will cause snapshot items to be
 				                                                      // written, so it must happen before the OpCommit
-				log_op(OpCommit, StringRef(), StringRef());
+				commitLocation = log_op(OpCommit, StringRef(), StringRef());
 				overheadWriteBytes = log->getCommitOverhead();
 			}
 		}
 
 		auto c = log->commit();
 
+		if (commitLocation.present() && writeImages) {
+			lastCommit = CommitPoint{ commitLocation.get(),
+				                      previousSnapshotEnd,
+				                      currentSnapshotEnd,
+				                      resetSnapshot ? Key() : snapshotResumeKey,
+				                      c };
+		}
+
 		committedDataSize = data.sumTo(data.end());
 		transactionSize = 0;
 		transactionIsLarge = false;
 		firstCommitWithSnapshot = false;
 
-		addActor.send(commitAndUpdateVersions(this, c, previousSnapshotEnd));
+		addActor.send(commitAndUpdateVersions(this, c, std::min(previousSnapshotEnd, imagePopLimit)));
+		commitTrigger.trigger();
 		return c;
 	}
 
@@ -363,6 +385,93 @@ private:
 		uint64_t numBytes;
 		std::vector<Arena> arenas;
 	};
+
+	// The log position just after an OpCommit, along with the state recovery has after reading up to it.  An image
+	// holds the data as of the commit point at which it was started, or later, so recovery from the image replays the
+	// log from that commit point.
+	struct CommitPoint {
+		IDiskQueue::location location;
+		IDiskQueue::location previousSnapshotEnd;
+		IDiskQueue::location currentSnapshotEnd;
+		Key snapshotKey; // The key from which the snapshot in progress continues
+		Future<Void> durable;
+	};
+
+	// Image file format:
+	// +----------------+-----------+-----+----------------+-----------+-------------+-------------+
+	// | ImageRunHeader | run items | ... | ImageRunHeader | run items | snapshotKey | ImageFooter |
+	// +----------------+-----------+-----+----------------+-----------+-------------+-------------+
+	// Runs are in key order, and each run item is a uint32_t key length, a uint32_t value length, the key, and the
+	// value.  The file is written with OPEN_ATOMIC_WRITE_AND_CREATE, so only complete images are ever found.
+	struct ImageRunHeader {
+		uint32_t items;
+		uint32_t bytes; // Size of the items following the header
+		uint64_t checksum; // XXH3 of the items
+	};
+
+	struct ImageFooter {
+		static constexpr uint64_t MAGIC = 0x314547414d49564b; // "KVIMAGE1"
+
+		uint64_t magic;
+		IDiskQueue::location location;
+		IDiskQueue::location previousSnapshotEnd;
+		IDiskQueue::location currentSnapshotEnd;
+		int64_t runBytes; // Size of all runs including their headers
+		int64_t items;
+		uint32_t runs;
+		uint32_t snapshotKeySize;
+		uint64_t checksum; // XXH3 of the snapshot key and the footer before this field
+
+		uint64_t calculateChecksum(StringRef snapshotKey) const {
+			return XXH3_64bits_withSeed(
+			    snapshotKey.begin(), snapshotKey.size(), XXH3_64bits(this, offsetof(ImageFooter, checksum)));
+		}
+	};
+
+	// Verifies and decodes image runs during recovery, so that inserting the decoded items is the only work left
+	// for the network thread
+	struct ImageRunDecoder final : IThreadPoolReceiver {
+		void init() override {}
+
+		struct DecodeAction final : TypedAction<ImageRunDecoder, DecodeAction>, FastAllocated<DecodeAction> {
+			ImageRunHeader header;
+			Standalone<StringRef> items;
+			ThreadReturnPromise<std::vector<std::pair<KeyValueMapPair, uint64_t>>> result;
+			DecodeAction(ImageRunHeader header, Standalone<StringRef> items) : header(header), items(items) {}
+			double getTimeEstimate() const override { return 0; }
+		};
+
+		void action(DecodeAction& a) {
+			if (a.items.size() != (int)a.header.bytes ||
+			    XXH3_64bits(a.items.begin(), a.items.size()) != a.header.checksum) {
+				a.result.sendError(checksum_failed());
+				return;
+			}
+
+			std::vector<std::pair<KeyValueMapPair, uint64_t>> pairs;
+			pairs.reserve(a.header.items);
+			StringRef rest = a.items;
+			for (uint32_t i = 0; i < a.header.items; ++i) {
+				if (rest.size() < (int)(2 * sizeof(uint32_t))) {
+					a.result.sendError(checksum_failed());
+					return;
+				}
+				uint32_t keySize, valueSize;
+				memcpy(&keySize, rest.begin(), sizeof(uint32_t));
+				memcpy(&valueSize, rest.begin() + sizeof(uint32_t), sizeof(uint32_t));
+				rest = rest.substr(2 * sizeof(uint32_t));
+				if ((uint64_t)rest.size() < (uint64_t)keySize + valueSize) {
+					a.result.sendError(checksum_failed());
+					return;
+				}
+				KeyValueMapPair pair(rest.substr(0, keySize), rest.substr(keySize, valueSize));
+				pairs.emplace_back(pair, pair.arena.getSize() + Container::getElementBytes());
+				rest = rest.substr(keySize + valueSize);
+			}
+			a.result.send(std::move(pairs));
+		}
+	};
+
 	KeyValueStoreType type;
 	UID id;
 
@@ -399,6 +508,14 @@ private:
 	int64_t memoryLimit; // The upper limit on the memory used by the store (excluding, possibly, some clear operations)
 	std::vector<std::pair<KeyValueMapPair, uint64_t>> dataSets;
 
+	std::string imageFilename; // Empty if the store has no image
+	bool writeImages;
+	Future<Void> imaging;
+	AsyncTrigger commitTrigger; // Triggered at the end of commit(), when data has no uncommitted mutations
+	CommitPoint lastCommit; // Only maintained when images are written
+	Key snapshotResumeKey; // The key from which the snapshot continues after the current commit
+	IDiskQueue::location imagePopLimit; // The log is not popped past the commit point of the latest image
+
 	int64_t commit_queue(OpQueue& ops, bool log, bool sequential = false) {
 		int64_t total = 0, count = 0;
 		IDiskQueue::location log_location = 0;
@@ -481,14 +598,46 @@ private:
 
 	ACTOR static Future<Void> recover(KeyValueStoreMemory* self, bool exactRecovery) {
 		loop {
+			// If there is an image, load it and replay only the log after the commit at which it was started
+			state bool imageLoaded = false;
+			state bool logEmpty = false;
+			wait(store(imageLoaded, loadImage(self)));
+			if (imageLoaded) {
+				wait(store(logEmpty, self->log->initializeRecovery(self->lastCommit.location)));
+				// The log is read from the image's commit point, unless it has been popped past it.  The image cannot
+				// belong to an empty log, and an image older than the popped point is missing the commits between
+				// them, so in either case the image is discarded and the log is recovered on its own, from where it
+				// was popped to.
+				if (logEmpty || self->log->getNextReadLocation() != self->lastCommit.location) {
+					TraceEvent(SevWarnAlways, "KVSMemImageDiscarded", self->id)
+					    .detail("Filename", self->imageFilename)
+					    .detail("Reason", logEmpty ? "EmptyLog" : "LogPoppedPastImage")
+					    .detail("ImageLocation", self->lastCommit.location)
+					    .detail("NextReadLocation", self->log->getNextReadLocation());
+					self->data.clear();
+					imageLoaded = false;
+					self->recoveredSnapshotKey = Key();
+					self->imagePopLimit = std::numeric_limits<IDiskQueue::location>::max();
+					wait(IAsyncFileSystem::filesystem()->deleteFile(self->imageFilename, true));
+				}
+			}
+			if (!imageLoaded) {
+				// not really, but popping up to here does nothing
+				self->previousSnapshotEnd = self->currentSnapshotEnd = self->log->getNextReadLocation();
+				self->lastCommit = CommitPoint{ self->previousSnapshotEnd,
+					                            self->previousSnapshotEnd,
+					                            self->currentSnapshotEnd,
+					                            self->recoveredSnapshotKey,
+					                            Void() };
+			}
+
 			// 'uncommitted' variables track something that might be rolled back by an OpRollback, and are copied into
 			// permanent variables (in self) in OpCommit.  OpRollback does the reverse (copying the permanent versions
 			// over the uncommitted versions) the uncommitted and committed variables should be equal initially (to
 			// whatever makes sense if there are no committed transactions recovered)
 			state Key uncommittedNextKey = self->recoveredSnapshotKey;
-			state IDiskQueue::location uncommittedPrevSnapshotEnd = self->previousSnapshotEnd =
-			    self->log->getNextReadLocation(); // not really, but popping up to here does nothing
-			state IDiskQueue::location uncommittedSnapshotEnd = self->currentSnapshotEnd = uncommittedPrevSnapshotEnd;
+			state IDiskQueue::location uncommittedPrevSnapshotEnd = self->previousSnapshotEnd;
+			state IDiskQueue::location uncommittedSnapshotEnd = self->currentSnapshotEnd;
 
 			state int zeroFillSize = 0;
 			state int dbgSnapshotItemCount = 0;
@@ -509,6 +658,10 @@ private:
 
 			try {
 				loop {
+					if (logEmpty) {
+						TraceEvent("KVSMemRecoveryComplete", self->id).detail("Reason", "Empty log");
+						break;
+					}
 					{
 						Standalone<StringRef> data = wait(self->log->readNext(sizeof(OpHeader)));
 						if (data.size() != sizeof(OpHeader)) {
@@ -609,6 +762,11 @@ private:
 							self->recoveredSnapshotKey = uncommittedNextKey;
 							self->previousSnapshotEnd = uncommittedPrevSnapshotEnd;
 							self->currentSnapshotEnd = uncommittedSnapshotEnd;
+							self->lastCommit = CommitPoint{ self->log->getNextReadLocation(),
+								                            uncommittedPrevSnapshotEnd,
+								                            uncommittedSnapshotEnd,
+								                            uncommittedNextKey,
+								                            Void() };
 						} else if (h.op == OpRollback) { // rollback previous transaction
 							recoveryQueue.rollback();
 							TraceEvent("KVSMemRecSnapshotRollback", self->id).detail("NextKey", uncommittedNextKey);
@@ -657,6 +815,7 @@ private:
 				self->committedDataSize = self->data.sumTo(self->data.end());
 
 				TraceEvent("KVSMemRecovered", self->id)
+				    .detail("FromImage", imageLoaded)
 				    .detail("SnapshotItems", dbgSnapshotItemCount)
 				    .detail("SnapshotEnd", dbgSnapshotEndCount)
 				    .detail("Mutations", dbgMutationCount)
@@ -723,6 +882,7 @@ private:
 		state bool lastSnapshotKeyUsingA = true;
 
 		TraceEvent("KVSMemStartingSnapshot", self->id).detail("StartKey", nextKey);
+		self->snapshotResumeKey = nextKey;
 
 		loop {
 			wait(self->notifiedCommittedWriteBytes.whenAtLeast(snapshotTotalWrittenBytes + 1));
@@ -786,6 +946,7 @@ private:
 						// Otherwise, save state for continuing after the next wait and stop
 						nextKey = Key();
 						nextKeyAfter = false;
+						self->snapshotResumeKey = Key();
 						break;
 					}
 
@@ -855,6 +1016,10 @@ private:
 						// Otherwise, save state for continuing after the next wait and stop
 						nextKey = destKey;
 						nextKeyAfter = true;
+						if (self->writeImages) {
+							// destKey is reused, so images need their own copy
+							self->snapshotResumeKey = keyAfter(destKey);
+						}
 						break;
 					}
 				}
@@ -862,6 +1027,258 @@ private:
 		}
 	}
 
+	// Encodes the items with keys >= nextKey into a run of about KVS_MEMORY_IMAGE_RUN_BYTES and advances nextKey past
+	// them.  Returns an empty run if there are no more items.
+	Standalone<StringRef> encodeImageRun(Key& nextKey, uint32_t& items, uint8_t* keyBuffer) {
+		auto it = data.lower_bound(nextKey);
+		if (it == data.end()) {
+			return Standalone<StringRef>();
+		}
+
+		BinaryWriter wr(Unversioned());
+		ImageRunHeader header = {};
+		wr.serializeBytes(&header, sizeof(header));
+		KeyRef lastKey;
+		while (it != data.end() && wr.getLength() < SERVER_KNOBS->KVS_MEMORY_IMAGE_RUN_BYTES) {
+			lastKey = it.getKey(keyBuffer);
+			ValueRef value = it.getValue();
+			wr << (uint32_t)lastKey.size() << (uint32_t)value.size();
+			wr.serializeBytes(lastKey);
+			wr.serializeBytes(value);
+			++header.items;
+			++it;
+		}
+		nextKey = keyAfter(lastKey);
+
+		Standalone<StringRef> run = wr.toValue();
+		StringRef runItems = run.substr(sizeof(header));
+		header.bytes = runItems.size();
+		header.checksum = XXH3_64bits(runItems.begin(), runItems.size());
+		memcpy(mutateString(run), &header, sizeof(header));
+		items = header.items;
+		return run;
+	}
+
+	// Writes an image of all committed data.  Since data keeps changing while the image is written, the image only
+	// reflects the data as of the commit point at which it was started or later, and recovery replays the log from
+	// that commit point on top of it.  This is correct for the same reason as replaying the log on top of a snapshot.
+	ACTOR static Future<Void> writeImage(KeyValueStoreMemory* self) {
+		state double startTime = now();
+		state Reference<IAsyncFile> file = wait(IAsyncFileSystem::filesystem()->open(
+		    self->imageFilename,
+		    IAsyncFile::OPEN_ATOMIC_WRITE_AND_CREATE | IAsyncFile::OPEN_CREATE | IAsyncFile::OPEN_READWRITE |
+		        IAsyncFile::OPEN_UNCACHED | IAsyncFile::OPEN_NO_AIO,
+		    0600));
+		state Key keyBuffer = makeString(CLIENT_KNOBS->SYSTEM_KEY_SIZE_LIMIT);
+		state std::deque<Future<Void>> writes;
+		state Optional<CommitPoint> start;
+		state CommitPoint end;
+		state Key nextKey;
+		state ImageFooter footer = ImageFooter();
+
+		loop {
+			// Mutations since the last commit may still be rolled back, so only read data when it has none
+			while (self->transactionSize > 0 || self->transactionIsLarge) {
+				wait(self->commitTrigger.onTrigger());
+			}
+			if (!start.present()) {
+				start = self->lastCommit;
+				// Keep the log after the commit point until this image replaces the previous one
+				self->imagePopLimit = std::min(self->imagePopLimit, start.get().location);
+			}
+
+			uint32_t items = 0;
+			Standalone<StringRef> run = self->encodeImageRun(nextKey, items, mutateString(keyBuffer));
+			// The runs so far hold data from commits up to this one
+			end = self->lastCommit;
+			if (run.empty()) {
+				break;
+			}
+			writes.push_back(holdWhile(run, file->write(run.begin(), run.size(), footer.runBytes)));
+			footer.runBytes += run.size();
+			footer.items += items;
+			++footer.runs;
+
+			if (writes.size() >= 4) {
+				wait(writes.front());
+				writes.pop_front();
+			}
+			wait(yield());
+		}
+
+		footer.magic = ImageFooter::MAGIC;
+		footer.location = start.get().location;
+		footer.previousSnapshotEnd = start.get().previousSnapshotEnd;
+		footer.currentSnapshotEnd = start.get().currentSnapshotEnd;
+		footer.snapshotKeySize = start.get().snapshotKey.size();
+		footer.checksum = footer.calculateChecksum(start.get().snapshotKey);
+		state Standalone<StringRef> tail =
+		    start.get().snapshotKey.withSuffix(StringRef((const uint8_t*)&footer, sizeof(footer)));
+		writes.push_back(file->write(tail.begin(), tail.size(), footer.runBytes));
+		wait(waitForAll(std::vector<Future<Void>>(writes.begin(), writes.end())));
+
+		// The image is only usable once the log through the last commit it holds data from is durable, since otherwise
+		// recovery could keep changes from commits the log lost
+		wait(start.get().durable);
+		wait(end.durable);
+		wait(file->sync());
+		self->imagePopLimit = start.get().location;
+
+		TraceEvent("KVSMemImageWritten", self->id)
+		    .detail("Filename", self->imageFilename)
+		    .detail("Location", footer.location)
+		    .detail("Runs", footer.runs)
+		    .detail("Items", footer.items)
+		    .detail("Bytes", footer.runBytes + tail.size())
+		    .detail("Duration", now() - startTime);
+		return Void();
+	}
+
+	ACTOR static Future<Void> imageWriter(KeyValueStoreMemory* self) {
+		wait(self->recovering);
+		loop {
+			wait(delay(SERVER_KNOBS->KVS_MEMORY_IMAGE_INTERVAL));
+			try {
+				wait(writeImage(self));
+			} catch (Error& e) {
+				if (e.code() == error_code_actor_cancelled) {
+					throw;
+				}
+				TraceEvent(SevWarnAlways, "KVSMemImageWriteError", self->id)
+				    .error(e)
+				    .detail("Filename", self->imageFilename);
+			}
+		}
+	}
+
+	// Loads the image, if there is one, into data.  Runs are read in order and verified and decoded by a pool of
+	// threads, while the network thread inserts the decoded items.  On success, the store's state is set to that at
+	// the image's commit point.  Returns false, with data empty, if there is no valid image.
+	ACTOR static Future<bool> loadImage(KeyValueStoreMemory* self) {
+		if (self->imageFilename.empty() || !fileExists(self->imageFilename)) {
+			return false;
+		}
+		if (!self->writeImages) {
+			// Without images being written the log is popped regardless of the image, which would then be stale if
+			// images were enabled again
+			TraceEvent("KVSMemImageDeleting", self->id).detail("Filename", self->imageFilename);
+			wait(IAsyncFileSystem::filesystem()->deleteFile(self->imageFilename, true));
+			return false;
+		}
+
+		state double startTime = now();
+		state Reference<IThreadPool> threads;
+		state std::deque<Future<std::vector<std::pair<KeyValueMapPair, uint64_t>>>> decoding;
+		state ImageFooter footer;
+		state Key snapshotKey;
+		state Optional<Error> failure;
+		try {
+			state Reference<IAsyncFile> file = wait(IAsyncFileSystem::filesystem()->open(
+			    self->imageFilename,
+			    IAsyncFile::OPEN_READONLY | IAsyncFile::OPEN_UNCACHED | IAsyncFile::OPEN_NO_AIO,
+			    0));
+			state int64_t fileSize = wait(file->size());
+			if (fileSize < (int64_t)sizeof(ImageFooter)) {
+				throw checksum_failed();
+			}
+			int footerRead = wait(file->read(&footer, sizeof(footer), fileSize - sizeof(footer)));
+			if (footerRead != (int)sizeof(footer) || footer.magic != ImageFooter::MAGIC ||
+			    footer.runBytes + footer.snapshotKeySize + (int64_t)sizeof(footer) != fileSize) {
+				throw checksum_failed();
+			}
+			snapshotKey = makeString(footer.snapshotKeySize);
+			int keyRead = wait(file->read(mutateString(snapshotKey), footer.snapshotKeySize, footer.runBytes));
+			if (keyRead != snapshotKey.size() || footer.checksum != footer.calculateChecksum(snapshotKey)) {
+				throw checksum_failed();
+			}
+
+			threads = g_network->isSimulated() ? CoroThreadPool::createThreadPool() : createGenericThreadPool();
+			for (int i = 0; i < SERVER_KNOBS->KVS_MEMORY_IMAGE_LOAD_THREADS; ++i) {
+				threads->addThread(new ImageRunDecoder(), "fdb-kvsmem-img");
+			}
+
+			// Each read returns a run's items followed by the next run's header
+			state int64_t offset = sizeof(ImageRunHeader);
+			state ImageRunHeader header;
+			state int64_t items = 0;
+			if (footer.runs > 0) {
+				int headerRead = wait(file->read(&header, sizeof(header), 0));
+				if (headerRead != (int)sizeof(header)) {
+					throw checksum_failed();
+				}
+			}
+			state uint32_t run = 0;
+			state int64_t readSize;
+			loop {
+				while (run < footer.runs && decoding.size() < 2 * SERVER_KNOBS->KVS_MEMORY_IMAGE_LOAD_THREADS) {
+					readSize = std::min<int64_t>(header.bytes + sizeof(ImageRunHeader), footer.runBytes - offset);
+					if (readSize != header.bytes && readSize != header.bytes + (int64_t)sizeof(ImageRunHeader)) {
+						throw checksum_failed();
+					}
+					state Standalone<StringRef> buffer = makeString(readSize);
+					int bytesRead = wait(file->read(mutateString(buffer), readSize, offset));
+					if (bytesRead != readSize) {
+						throw checksum_failed();
+					}
+					auto action = new ImageRunDecoder::DecodeAction(
+					    header, Standalone<StringRef>(buffer.substr(0, header.bytes), buffer.arena()));
+					decoding.push_back(action->result.getFuture());
+					threads->post(action);
+					if (readSize > header.bytes) {
+						memcpy(&header, buffer.begin() + header.bytes, sizeof(header));
+					}
+					offset += readSize;
+					++run;
+				}
+				if (decoding.empty()) {
+					break;
+				}
+				std::vector<std::pair<KeyValueMapPair, uint64_t>> pairs = wait(decoding.front());
+				decoding.pop_front();
+				items += pairs.size();
+				self->data.insert(pairs);
+			}
+			if (items != footer.items) {
+				throw checksum_failed();
+			}
+			wait(threads->stop());
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+			TraceEvent(SevWarnAlways, "KVSMemImageLoadFailed", self->id)
+			    .error(e)
+			    .detail("Filename", self->imageFilename);
+			failure = e;
+		}
+		if (failure.present()) {
+			decoding.clear();
+			if (threads) {
+				wait(threads->stop());
+			}
+			self->data.clear();
+			// The log is recovered on its own and popped past this image, which must not be loaded by a later recovery
+			wait(IAsyncFileSystem::filesystem()->deleteFile(self->imageFilename, true));
+			return false;
+		}
+
+		self->recoveredSnapshotKey = snapshotKey;
+		self->previousSnapshotEnd = footer.previousSnapshotEnd;
+		self->currentSnapshotEnd = footer.currentSnapshotEnd;
+		self->lastCommit = CommitPoint{
+			footer.location, footer.previousSnapshotEnd, footer.currentSnapshotEnd, snapshotKey, Void()
+		};
+		self->imagePopLimit = footer.location;
+
+		TraceEvent("KVSMemImageLoaded", self->id)
+		    .detail("Filename", self->imageFilename)
+		    .detail("Location", footer.location)
+		    .detail("Runs", footer.runs)
+		    .detail("Items", footer.items)
+		    .detail("Duration", now() - startTime);
+		return true;
+	}
+
 	ACTOR static Future<Optional<Value>> waitAndReadValue(KeyValueStoreMemory* self,
 	                                                      Key key,
 	                                                      Optional<ReadOptions> options) {
@@ -905,11 +1322,14 @@ KeyValueStoreMemory<Container>::KeyValueStoreMemory(IDiskQueue* log,
                                                     KeyValueStoreType storeType,
                                                     bool disableSnapshot,
                                                     bool replaceContent,
-                                                    bool exactRecovery)
+                                                    bool exactRecovery,
+                                                    std::string imageFilename)
   : type(storeType), id(id), log(log), db(db), committedWriteBytes(0), overheadWriteBytes(0), currentSnapshotEnd(-1),
     previousSnapshotEnd(-1), committedDataSize(0), transactionSize(0), transactionIsLarge(false), resetSnapshot(false),
     disableSnapshot(disableSnapshot), replaceContent(replaceContent), firstCommitWithSnapshot(true), snapshotCount(0),
-    memoryLimit(memoryLimit) {
+    memoryLimit(memoryLimit), imageFilename(imageFilename),
+    writeImages(!imageFilename.empty() && SERVER_KNOBS->KVS_MEMORY_IMAGE_INTERVAL > 0),
+    imagePopLimit(std::numeric_limits<IDiskQueue::location>::max()) {
 	// create reserved buffer for radixtree store type
 	this->reserved_buffer =
 	    (storeType == KeyValueStoreType::MEMORY) ? nullptr : new uint8_t[CLIENT_KNOBS->SYSTEM_KEY_SIZE_LIMIT];
@@ -919,6 +1339,9 @@ KeyValueStoreMemory<Container>::KeyValueStoreMemory(IDiskQueue* log,
 	recovering = recover(this, exactRecovery);
 	snapshotting = snapshot(this);
 	commitActors = actorCollection(addActor.getFuture());
+	if (writeImages) {
+		imaging = imageWriter(this);
+	}
 }
 
 IKeyValueStore* keyValueStoreMemory(std::string const& basename,
@@ -933,6 +1356,8 @@ IKeyValueStore* keyValueStoreMemory(std::string const& basename,
 
 	// Use DiskQueueVersion::V2 with xxhash3 checksum
 	IDiskQueue* log = openDiskQueue(basename, ext, logID, DiskQueueVersion::V2);
+	// The image file name does not end with the disk queue's "0." + ext suffix, so it is not mistaken for a store
+	std::string imageFilename = basename + "image." + ext;
 	if (storeType == KeyValueStoreType::MEMORY_RADIXTREE) {
 		return new KeyValueStoreMemory<radix_tree>(log,
 		                                           Reference<AsyncVar<ServerDBInfo> const>(),
@@ -941,7 +1366,8 @@ IKeyValueStore* keyValueStoreMemory(std::string const& basename,
 		                                           storeType,
 		                                           /*doc*/ false,
 		                                           /*ument*/ false,
-		                                           /*thisstuff FFS*/ false);
+		                                           /*thisstuff FFS*/ false,
+		                                           imageFilename);
 	} else {
 		return new KeyValueStoreMemory<IKeyValueContainer>(log,
 		                                                   Reference<AsyncVar<ServerDBInfo> const>(),
@@ -950,7 +1376,8 @@ IKeyValueStore* keyValueStoreMemory(std::string const& basename,
 		                                                   storeType,
 		                                                   /* name */ false,
 		                                                   /*the */ false,
-		                                                   /* effing parameter*/ false);
+		                                                   /* effing parameter*/ false,
+		                                                   imageFilename);
 	}
 }
 
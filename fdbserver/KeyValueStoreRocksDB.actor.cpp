@@ -1821,6 +1821,91 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 			}
 		}
 
+		struct ReadValuesAction : TypedAction<Reader, ReadValuesAction> {
+			Standalone<VectorRef<KeyRef>> keys;
+			ReadType type;
+			Optional<UID> debugID;
+			double startTime;
+			bool getHistograms;
+			ThreadReturnPromise<std::vector<Optional<Value>>> result;
+			ReadValuesAction(Standalone<VectorRef<KeyRef>> keys, ReadType type, Optional<UID> debugID)
+			  : keys(keys), type(type), debugID(debugID), startTime(timer_monotonic()),
+			    getHistograms(deterministicRandom()->random01() < SERVER_KNOBS->ROCKSDB_HISTOGRAMS_SAMPLE_RATE) {}
+			double getTimeEstimate() const override {
+				return SERVER_KNOBS->READ_VALUE_TIME_ESTIMATE * std::max(1, keys.size());
+			}
+		};
+		void action(ReadValuesAction& a) {
+			ASSERT(cf != nullptr);
+			const double readBeginTime = timer_monotonic();
+			if (a.getHistograms) {
+				metricPromiseStream->send(
+				    std::make_pair(ROCKSDB_READVALUE_QUEUEWAIT_HISTOGRAM.toString(), readBeginTime - a.startTime));
+			}
+			Optional<TraceBatch> traceBatch;
+			if (a.debugID.present()) {
+				traceBatch = { TraceBatch{} };
+				traceBatch.get().addEvent("GetValueDebug", a.debugID.get().first(), "Reader.Before");
+			}
+			const bool throttled = !a.keys.empty() && shouldThrottle(a.type, a.keys.front());
+			if (throttled && SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT && readBeginTime - a.startTime > readValueTimeout) {
+				TraceEvent(SevWarn, "KVSTimeout", id)
+				    .detail("Error", "Read values request timedout")
+				    .detail("Method", "ReadValuesAction")
+				    .detail("TimeoutValue", readValueTimeout);
+				a.result.sendError(transaction_too_old());
+				return;
+			}
+
+			rocksdb::ReadOptions readOptions = sharedState->getReadOptions();
+			if (throttled && SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT) {
+				uint64_t deadlineMircos =
+				    db->GetEnv()->NowMicros() + (readValueTimeout - (readBeginTime - a.startTime)) * 1000000;
+				std::chrono::seconds deadlineSeconds(deadlineMircos / 1000000);
+				readOptions.deadline = std::chrono::duration_cast<std::chrono::microseconds>(deadlineSeconds);
+			}
+
+			// One MultiGet shares the memtable and SST block lookups of the whole batch, and the keys are already
+			// sorted so RocksDB need not sort them again.
+			const int count = a.keys.size();
+			std::vector<rocksdb::Slice> keySlices;
+			keySlices.reserve(count);
+			for (const KeyRef& key : a.keys) {
+				keySlices.push_back(toSlice(key));
+			}
+			std::vector<rocksdb::PinnableSlice> values(count);
+			std::vector<rocksdb::Status> statuses(count);
+			db->MultiGet(readOptions, cf, count, keySlices.data(), values.data(), statuses.data(), true);
+
+			std::vector<Optional<Value>> result;
+			result.reserve(count);
+			for (int i = 0; i < count; ++i) {
+				if (statuses[i].ok()) {
+					result.push_back(Value(toStringRef(values[i])));
+				} else if (statuses[i].IsNotFound()) {
+					result.push_back(Optional<Value>());
+				} else {
+					logRocksDBError(id, statuses[i], "ReadValues");
+					a.result.sendError(statusToError(statuses[i]));
+					return;
+				}
+			}
+
+			if (a.debugID.present()) {
+				traceBatch.get().addEvent("GetValueDebug", a.debugID.get().first(), "Reader.After");
+				traceBatch.get().dump();
+			}
+			a.result.send(std::move(result));
+
+			const double endTime = timer_monotonic();
+			if (a.getHistograms) {
+				metricPromiseStream->send(
+				    std::make_pair(ROCKSDB_READVALUE_ACTION_HISTOGRAM.toString(), endTime - readBeginTime));
+				metricPromiseStream->send(
+				    std::make_pair(ROCKSDB_READVALUE_LATENCY_HISTOGRAM.toString(), endTime - a.startTime));
+			}
+		}
+
 		struct ReadValuePrefixAction : TypedAction<Reader, ReadValuePrefixAction> {
 			Key key;
 			int maxLength;
@@ -2486,6 +2571,52 @@ struct RocksDBKeyValueStore : IKeyValueStore {
 		return read(a.release(), &semaphore, readThreads.getPtr(), &counters.failedToAcquire);
 	}
 
+	ACTOR static Future<std::vector<Optional<Value>>> read(Reader::ReadValuesAction* action,
+	                                                       FlowLock* semaphore,
+	                                                       IThreadPool* pool,
+	                                                       Counter* counter) {
+		state std::unique_ptr<Reader::ReadValuesAction> a(action);
+		state Optional<Void> slot = wait(timeout(semaphore->take(), SERVER_KNOBS->ROCKSDB_READ_QUEUE_WAIT));
+		if (!slot.present()) {
+			++(*counter);
+			throw server_overloaded();
+		}
+
+		state FlowLock::Releaser release(*semaphore);
+
+		auto fut = a->result.getFuture();
+		pool->post(a.release());
+		std::vector<Optional<Value>> result = wait(fut);
+
+		return result;
+	}
+
+	Future<std::vector<Optional<Value>>> readValues(Standalone<VectorRef<KeyRef>> keys,
+	                                                Optional<ReadOptions> options) override {
+		ReadType type = ReadType::NORMAL;
+		Optional<UID> debugID;
+
+		if (options.present()) {
+			type = options.get().type;
+			debugID = options.get().debugID;
+		}
+
+		// The keys of one batch come from a single shard, so they are all system keys or none of them are
+		if (keys.empty() || !shouldThrottle(type, keys.front())) {
+			auto a = new Reader::ReadValuesAction(keys, type, debugID);
+			auto res = a->result.getFuture();
+			readThreads->post(a);
+			return res;
+		}
+
+		auto& semaphore = (type == ReadType::FETCH) ? fetchSemaphore : readSemaphore;
+		int maxWaiters = (type == ReadType::FETCH) ? numFetchWaiters : numReadWaiters;
+
+		checkWaiters(semaphore, maxWaiters);
+		auto a = std::make_unique<Reader::ReadValuesAction>(keys, type, debugID);
+		return read(a.release(), &semaphore, readThreads.getPtr(), &counters.failedToAcquire);
+	}
+
 	ACTOR static Future<Standalone<RangeResultRef>> read(Reader::ReadRangeAction* action,
 	                                                     FlowLock* semaphore,
 	                                                     IThreadPool* pool,
@@ -1624,6 +1624,8 @@ public:
 	Future<Void> commit(bool sequential = false) override;
 
 	Future<Optional<Value>> readValue(KeyRef key, Optional<ReadOptions> options) override;
+	Future<std::vector<Optional<Value>>> readValues(Standalone<VectorRef<KeyRef>> keys,
+	                                                Optional<ReadOptions> options) override;
 	Future<Optional<Value>> readValuePrefix(KeyRef key, int maxLength, Optional<ReadOptions> options) override;
 	Future<RangeResult> readRange(KeyRangeRef keys,
 	                              int rowLimit,
@@ -1713,6 +1715,38 @@ private:
 			// if (t >= 1.0) TraceEvent("ReadValueActionSlow",dbgid).detail("Elapsed", t);
 		}
 
+		struct ReadValuesAction final : TypedAction<Reader, ReadValuesAction>, FastAllocated<ReadValuesAction> {
+			Standalone<VectorRef<KeyRef>> keys;
+			Optional<UID> debugID;
+			ThreadReturnPromise<std::vector<Optional<Value>>> result;
+			ReadValuesAction(Standalone<VectorRef<KeyRef>> keys, Optional<UID> debugID)
+			  : keys(keys), debugID(debugID) {};
+			double getTimeEstimate() const override {
+				return SERVER_KNOBS->READ_VALUE_TIME_ESTIMATE * std::max(1, keys.size());
+			}
+		};
+		void action(ReadValuesAction& rv) {
+			if (rv.debugID.present())
+				g_traceBatch.addEvent("GetValueDebug",
+				                      rv.debugID.get().first(),
+				                      "Reader.Before"); //.detail("TaskID", g_network->getCurrentTask());
+
+			// All of the keys are looked up on this thread's cursor in one action
+			auto& cursor = getCursor()->get();
+			std::vector<Optional<Value>> values;
+			values.reserve(rv.keys.size());
+			for (const KeyRef& key : rv.keys) {
+				values.push_back(cursor.get(key));
+			}
+			rv.result.send(std::move(values));
+			++counter;
+
+			if (rv.debugID.present())
+				g_traceBatch.addEvent("GetValueDebug",
+				                      rv.debugID.get().first(),
+				                      "Reader.After"); //.detail("TaskID", g_network->getCurrentTask());
+		}
+
 		struct ReadValuePrefixAction final : TypedAction<Reader, ReadValuePrefixAction>,
 		                                     FastAllocated<ReadValuePrefixAction> {
 			Key key;
@@ -2258,6 +2292,18 @@ Future<Optional<Value>> KeyValueStoreSQLite::readValue(KeyRef key, Optional<Read
 	readThreads->post(p);
 	return f;
 }
+Future<std::vector<Optional<Value>>> KeyValueStoreSQLite::readValues(Standalone<VectorRef<KeyRef>> keys,
+                                                                     Optional<ReadOptions> options) {
+	++readsRequested;
+	Optional<UID> debugID;
+	if (options.present()) {
+		debugID = options.get().debugID;
+	}
+	auto p = new Reader::ReadValuesAction(keys, debugID);
+	auto f = p->result.getFuture();
+	readThreads->post(p);
+	return f;
+}
 Future<Optional<Value>> KeyValueStoreSQLite::readValuePrefix(KeyRef key, int maxLength, Optional<ReadOptions> options) {
 	++readsRequested;
 	Optional<UID> debugID;
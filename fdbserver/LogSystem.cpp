@@ -314,12 +314,22 @@ void LogPushData::writeMessage(StringRef rawMessageWithoutLength, bool usePrevio
 	uint32_t subseq = this->subsequence++;
 	uint32_t msgsize =
 	    rawMessageWithoutLength.size() + sizeof(subseq) + sizeof(uint16_t) + sizeof(Tag) * prev_tags.size();
+	int stagedOffset = -1;
 	for (int loc : msg_locations) {
-		BinaryWriter& wr = messagesWriter[loc];
+		if (stagedOffset >= 0) {
+			addDeferredRange(loc, stagedOffset, sizeof(msgsize) + msgsize);
+			continue;
+		}
+		BinaryWriter& wr = writerFor(loc);
+		int offset = wr.getLength();
 		wr << msgsize << subseq << uint16_t(prev_tags.size());
 		for (auto& tag : prev_tags)
 			wr << tag;
 		wr.serializeBytes(rawMessageWithoutLength);
+		if (deferred) {
+			stagedOffset = offset;
+			addDeferredRange(loc, stagedOffset, sizeof(msgsize) + msgsize);
+		}
 	}
 }
 
@@ -357,7 +367,12 @@ bool LogPushData::writeTransactionInfo(int location, uint32_t subseq) {
 	CODE_PROBE(true, "Wrote SpanContextMessage to a transaction log");
 	writtenLocations.insert(location);
 
-	BinaryWriter& wr = messagesWriter[location];
+	if (deferred && stagedTransactionInfoSubsequence == subseq) {
+		addDeferredRange(location, stagedTransactionInfo.first, stagedTransactionInfo.second);
+		return true;
+	}
+
+	BinaryWriter& wr = writerFor(location);
 	int offset = wr.getLength();
 	wr << uint32_t(0) << subseq << uint16_t(prev_tags.size());
 	for (auto& tag : prev_tags)
@@ -387,6 +402,11 @@ bool LogPushData::writeTransactionInfo(int location, uint32_t subseq) {
 	}
 	int length = wr.getLength() - offset;
 	*(uint32_t*)((uint8_t*)wr.getData() + offset) = length - sizeof(uint32_t);
+	if (deferred) {
+		stagedTransactionInfoSubsequence = subseq;
+		stagedTransactionInfo = std::make_pair(offset, length);
+		addDeferredRange(location, offset, length);
+	}
 	return true;
 }
 
@@ -399,7 +419,63 @@ void LogPushData::setMutations(uint32_t totalMutations, VectorRef<StringRef> mut
 	Standalone<StringRef> v = w.toValue();
 	const int header = v.size();
 	for (int i = 0; i < mutations.size(); i++) {
-		BinaryWriter& wr = messagesWriter[i];
+		BinaryWriter& wr = writerFor(i);
+		int offset = wr.getLength();
 		wr.serializeBytes(mutations[i].substr(header));
+		if (deferred) {
+			addDeferredRange(i, offset, wr.getLength() - offset);
+		}
+	}
+}
+
+void LogPushData::deferMessageCopies() {
+	ASSERT(!deferred && !gatheredMessages.present());
+	ASSERT_EQ(subsequence, 1);
+	deferred = std::make_unique<DeferredLogMessages>(g_network->protocolVersion(), messagesWriter.size());
+}
+
+std::unique_ptr<DeferredLogMessages> LogPushData::takeDeferredMessages() {
+	ASSERT(deferred);
+	return std::move(deferred);
+}
+
+void LogPushData::setGatheredMessages(std::vector<Standalone<StringRef>> messages) {
+	ASSERT(!deferred && !gatheredMessages.present());
+	ASSERT_EQ(messages.size(), messagesWriter.size());
+	gatheredMessages = std::move(messages);
+}
+
+void LogPushData::addDeferredRange(int loc, int offset, int length) {
+	auto& ranges = deferred->ranges[loc];
+	if (!ranges.empty() && ranges.back().first + ranges.back().second == offset) {
+		ranges.back().second += length;
+	} else {
+		ranges.emplace_back(offset, length);
+	}
+}
+
+std::vector<Standalone<StringRef>> DeferredLogMessages::gather() {
+	// Every location's messages start with whatever an empty writer holds, as in LogPushData
+	BinaryWriter empty(AssumeVersion(protocolVersion));
+	const uint8_t* data = (const uint8_t*)staged.getData();
+	std::vector<Standalone<StringRef>> messages;
+	messages.reserve(ranges.size());
+	for (const auto& locationRanges : ranges) {
+		int length = empty.getLength();
+		for (const auto& range : locationRanges) {
+			length += range.second;
+		}
+		Standalone<StringRef> result = makeString(length);
+		uint8_t* out = mutateString(result);
+		if (empty.getLength() > 0) {
+			memcpy(out, empty.getData(), empty.getLength());
+			out += empty.getLength();
+		}
+		for (const auto& [offset, rangeLength] : locationRanges) {
+			memcpy(out, data + offset, rangeLength);
+			out += rangeLength;
+		}
+		messages.push_back(std::move(result));
 	}
+	return messages;
 }
@@ -28,7 +28,8 @@ std::unique_ptr<LatencySample> createSample(std::string_view prefix, std::string
 	                                       serverId,
 	                                       SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
 	                                       SERVER_KNOBS->LATENCY_SKETCH_ACCURACY,
-	                                       /*skipTraceOnSilentInterval=*/true);
+	                                       /*skipTraceOnSilentInterval=*/true,
+	                                       /*logLinearHistogram=*/metricName == "ReadLatencyMetrics");
 }
 
 } // namespace
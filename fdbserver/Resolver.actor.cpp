@@ -192,7 +192,9 @@ struct Resolver : ReferenceCounted<Resolver> {
 
 	Resolver(UID dbgid, int commitProxyCount, int resolverCount)
 	  : dbgid(dbgid), commitProxyCount(commitProxyCount), resolverCount(resolverCount), version(-1),
-	    conflictSet(newConflictSet()), iopsSample(SERVER_KNOBS->KEY_BYTES_PER_SAMPLE), cc("Resolver", dbgid.toString()),
+	    conflictSet(newConflictSet(SERVER_KNOBS->RESOLVER_CONFLICT_SET_THREADS,
+	                               SERVER_KNOBS->RESOLVER_PARALLEL_MIN_CONFLICT_RANGES)),
+	    iopsSample(SERVER_KNOBS->KEY_BYTES_PER_SAMPLE), cc("Resolver", dbgid.toString()),
 	    resolveBatchIn("ResolveBatchIn", cc), resolveBatchStart("ResolveBatchStart", cc),
 	    resolvedTransactions("ResolvedTransactions", cc), resolvedBytes("ResolvedBytes", cc),
 	    resolvedReadConflictRanges("ResolvedReadConflictRanges", cc),
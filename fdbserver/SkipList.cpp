@@ -22,8 +22,15 @@
 #include <memory.h>
 #include <stdio.h>
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <numeric>
+#include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "flow/Platform.h"
@@ -32,6 +39,7 @@
 #include "fdbclient/FDBTypes.h"
 #include "fdbclient/KeyRangeMap.h"
 #include "fdbclient/SystemData.h"
+#include "fdbclient/Tuple.h"
 #include "fdbserver/ConflictSet.h"
 #include "flow/UnitTest.h"
 
@@ -340,6 +348,11 @@ public:
 		Node* x = nullptr;
 		Node* alreadyChecked = nullptr;
 		StringRef value;
+		// Lengths of the prefixes value shares with x and with alreadyChecked (0 if there is none). Every node between
+		// x and alreadyChecked shares the smaller of the two with value, so comparisons can skip it; keys in the same
+		// subspace or index often share a long tuple encoded prefix.
+		int lcpLow = 0;
+		int lcpHigh = 0;
 
 		Finger() = default;
 		Finger(Node* header, const StringRef& ptr) : x(header), value(ptr) {}
@@ -349,6 +362,7 @@ public:
 			x = header;
 			alreadyChecked = nullptr;
 			level = MaxLevels;
+			lcpLow = lcpHigh = 0;
 		}
 
 		// pre: !finished()
@@ -367,15 +381,25 @@ public:
 		force_inline bool advance() {
 			Node* next = x->getNext(level - 1);
 
-			if (next == alreadyChecked || !less(next->value(), next->length(), value.begin(), value.size())) {
+			if (next != alreadyChecked) {
+				const int skip = std::min(lcpLow, lcpHigh);
+				const int common = skip + commonPrefixLength(next->value() + skip,
+				                                             value.begin() + skip,
+				                                             std::min(next->length(), value.size()) - skip);
+				const bool nextLess = common == next->length()
+				                          ? common < value.size()
+				                          : common < value.size() && next->value()[common] < value[common];
+				if (nextLess) {
+					x = next;
+					lcpLow = common;
+					return false;
+				}
 				alreadyChecked = next;
-				level--;
-				finger[level] = x;
-				return true;
-			} else {
-				x = next;
-				return false;
+				lcpHigh = common;
 			}
+			level--;
+			finger[level] = x;
+			return true;
 		}
 
 		// pre: !finished()
@@ -442,7 +466,13 @@ public:
 		}
 	}
 
-	void detectConflicts(ReadConflictRange* ranges, int count, bool* transactionConflictStatus) {
+	// If reportedConflicts is given, conflicting ranges which report conflicting keys are appended to it instead of
+	// being pushed into their transaction's conflicting key range list, so that it is safe to check disjoint sets of
+	// ranges from several threads at once.
+	void detectConflicts(ReadConflictRange* ranges,
+	                     int count,
+	                     bool* transactionConflictStatus,
+	                     std::vector<const ReadConflictRange*>* reportedConflicts = nullptr) {
 		const int M = 16;
 		int nextJob[M];
 		CheckMax inProgress[M];
@@ -456,7 +486,8 @@ public:
 			                   transactionConflictStatus,
 			                   ranges[i].indexInTx,
 			                   ranges[i].conflictingKeyRange,
-			                   ranges[i].cKRArena);
+			                   ranges[i].cKRArena,
+			                   reportedConflicts);
 			nextJob[i] = i + 1;
 		}
 		nextJob[started - 1] = 0;
@@ -478,7 +509,8 @@ public:
 					                     transactionConflictStatus,
 					                     ranges[temp].indexInTx,
 					                     ranges[temp].conflictingKeyRange,
-					                     ranges[temp].cKRArena);
+					                     ranges[temp].cKRArena,
+					                     reportedConflicts);
 				}
 			}
 			prevJob = job;
@@ -492,7 +524,6 @@ public:
 	//   partitions.  In between, operations on each partition must not touch any keys outside
 	//   the partition.  Specifically, the partition to the left of 'key' must not have a range
 	//	 [...,key) inserted, since that would insert an entry at 'key'.
-	// Note this function is not used.
 	void partition(StringRef* begin, int splitCount, SkipList* output) {
 		for (int i = splitCount - 1; i >= 0; i--) {
 			Finger f(header, begin[i]);
@@ -504,7 +535,6 @@ public:
 	}
 
 	// Concatenates multiple SkipList objects into one and stores in input[0].
-	// Note this function is not used.
 	void concatenate(SkipList* input, int count) {
 		std::vector<Finger> ends(count - 1);
 		for (int i = 0; i < ends.size(); i++)
@@ -547,6 +577,7 @@ public:
 			results[i].x = x;
 			results[i].alreadyChecked = nullptr;
 			results[i].value = values[i];
+			results[i].lcpLow = results[i].lcpHigh = 0;
 			for (int j = startLevel; j < MaxLevels; j++)
 				results[i].finger[j] = results[0].finger[j];
 		}
@@ -665,21 +696,28 @@ private:
 		Version version;
 		bool* result;
 		int state;
+		int startEndCommon; // Length of the prefix shared by start.value and end.value
 		int indexInTx;
 		VectorRef<int>* conflictingKeyRange; // nullptr if report_conflicting_keys is not enabled.
 		Arena* cKRArena; // nullptr if report_conflicting_keys is not enabled.
+		const ReadConflictRange* range;
+		std::vector<const ReadConflictRange*>* reportedConflicts; // nullptr unless reporting is deferred
 
 		void init(const ReadConflictRange& r,
 		          Node* header,
 		          bool* tCS,
 		          int indexInTx,
 		          VectorRef<int>* cKR,
-		          Arena* cKRArena) {
+		          Arena* cKRArena,
+		          std::vector<const ReadConflictRange*>* reportedConflicts) {
 			this->start.init(r.begin, header);
 			this->end.init(r.end, header);
+			this->startEndCommon = commonPrefixLength(r.begin, r.end);
 			this->version = r.version;
 			this->indexInTx = indexInTx;
 			this->cKRArena = cKRArena;
+			this->range = &r;
+			this->reportedConflicts = reportedConflicts;
 			result = &tCS[r.transaction];
 			conflictingKeyRange = cKR;
 			this->state = 0;
@@ -688,8 +726,12 @@ private:
 		bool noConflict() const { return true; }
 		bool conflict() {
 			*result = true;
-			if (conflictingKeyRange != nullptr)
-				conflictingKeyRange->push_back(*cKRArena, indexInTx);
+			if (conflictingKeyRange != nullptr) {
+				if (reportedConflicts != nullptr)
+					reportedConflicts->push_back(range);
+				else
+					conflictingKeyRange->push_back(*cKRArena, indexInTx);
+			}
 			return true;
 		}
 
@@ -704,6 +746,8 @@ private:
 						return false;
 					}
 					end.x = start.x;
+					// end.value shares with start.x at least what both share with start.value
+					end.lcpLow = std::min(start.lcpLow, startEndCommon);
 					while (!end.advance())
 						;
 
@@ -784,17 +828,114 @@ private:
 	}
 };
 
+// A fixed set of threads which run the per-partition work of a ConflictBatch. The calling thread takes part in the
+// work, so a pool for N partitions starts N-1 threads.
+class ConflictSetWorkers : NonCopyable {
+public:
+	explicit ConflictSetWorkers(int threadCount) {
+		for (int i = 1; i < threadCount; i++)
+			threads.emplace_back([this]() { workerLoop(); });
+	}
+
+	~ConflictSetWorkers() {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (auto& t : threads)
+			t.join();
+	}
+
+	// Calls fn(i) for every i in [0, count) and returns once all of the calls have completed.
+	void run(int count, const std::function<void(int)>& fn) {
+		std::unique_lock<std::mutex> lock(mutex);
+		task = &fn;
+		taskCount = count;
+		nextTask = 0;
+		remaining = count;
+		generation++;
+		wake.notify_all();
+
+		runTasks(lock);
+		done.wait(lock, [this]() { return remaining == 0; });
+		task = nullptr;
+	}
+
+private:
+	// Runs tasks of the current generation until none are left to start. Called with the mutex held.
+	void runTasks(std::unique_lock<std::mutex>& lock) {
+		while (nextTask < taskCount) {
+			const int i = nextTask++;
+			lock.unlock();
+			(*task)(i);
+			lock.lock();
+			if (--remaining == 0)
+				done.notify_all();
+		}
+	}
+
+	void workerLoop() {
+		std::unique_lock<std::mutex> lock(mutex);
+		uint64_t seenGeneration = generation;
+		while (true) {
+			wake.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+			if (stopping)
+				return;
+			seenGeneration = generation;
+			runTasks(lock);
+		}
+	}
+
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable wake, done;
+	const std::function<void(int)>* task = nullptr;
+	int taskCount = 0, nextTask = 0, remaining = 0;
+	uint64_t generation = 0;
+	bool stopping = false;
+};
+
 struct ConflictSet {
-	ConflictSet() : removalKey(makeString(0)), oldestVersion(0) {}
+	ConflictSet(int threadCount, int minParallelRanges)
+	  : removalKey(makeString(0)), oldestVersion(0), partitionCount(std::max(threadCount, 1)),
+	    minParallelRanges(minParallelRanges) {
+		if (partitionCount > 1) {
+			partitions.resize(partitionCount);
+			// Simulation must stay deterministic, so the partitions are processed one after another on the calling
+			// thread there. The partitioning itself is still exercised.
+			if (!g_network || !g_network->isSimulated())
+				workers = std::make_unique<ConflictSetWorkers>(partitionCount);
+		}
+	}
 	~ConflictSet() {}
 
+	// Returns the number of partitions a batch with the given number of conflict ranges should be split into.
+	int batchPartitions(int rangeCount) const { return rangeCount >= minParallelRanges ? partitionCount : 1; }
+
+	// Calls fn(i) for every partition i in [0, count) and returns once all of the calls have completed.
+	void runPartitions(int count, const std::function<void(int)>& fn) {
+		if (workers && count > 1) {
+			workers->run(count, fn);
+		} else {
+			for (int i = 0; i < count; i++)
+				fn(i);
+		}
+	}
+
 	SkipList versionHistory;
 	Key removalKey;
 	Version oldestVersion;
+
+	const int partitionCount;
+	const int minParallelRanges;
+	// Scratch space which versionHistory is split into while write conflict ranges are merged in parallel
+	std::vector<SkipList> partitions;
+	std::unique_ptr<ConflictSetWorkers> workers;
 };
 
-ConflictSet* newConflictSet() {
-	return new ConflictSet;
+ConflictSet* newConflictSet(int threadCount, int minParallelRanges) {
+	return new ConflictSet(threadCount, minParallelRanges);
 }
 void clearConflictSet(ConflictSet* cs, Version v) {
 	SkipList(v).swap(cs->versionHistory);
@@ -1032,10 +1173,46 @@ void ConflictBatch::checkReadConflictRanges() {
 	if (combinedReadConflictRanges.empty())
 		return;
 
+	const int partitionCount = cs->batchPartitions(combinedReadConflictRanges.size());
+	if (partitionCount > 1) {
+		checkReadConflictRangesParallel(partitionCount);
+		return;
+	}
+
 	cs->versionHistory.detectConflicts(
 	    &combinedReadConflictRanges[0], combinedReadConflictRanges.size(), transactionConflictStatus);
 }
 
+// The version history is only read while checking read conflict ranges, so each partition checks a slice of the ranges
+// against the whole SkipList. The conflict bits and the conflicting key range arena are shared between transactions,
+// so every partition collects its results separately and they are merged once all partitions are done.
+void ConflictBatch::checkReadConflictRangesParallel(int partitionCount) {
+	struct PartitionResult {
+		std::unique_ptr<bool[]> conflictStatus;
+		std::vector<const ReadConflictRange*> reportedConflicts;
+	};
+	std::vector<PartitionResult> results(partitionCount);
+	const int rangeCount = combinedReadConflictRanges.size();
+
+	cs->runPartitions(partitionCount, [&](int p) {
+		const int begin = (int64_t)rangeCount * p / partitionCount;
+		const int end = (int64_t)rangeCount * (p + 1) / partitionCount;
+		PartitionResult& result = results[p];
+		result.conflictStatus.reset(new bool[transactionCount]());
+		cs->versionHistory.detectConflicts(&combinedReadConflictRanges[begin],
+		                                   end - begin,
+		                                   result.conflictStatus.get(),
+		                                   &result.reportedConflicts);
+	});
+
+	for (const PartitionResult& result : results) {
+		for (int t = 0; t < transactionCount; t++)
+			transactionConflictStatus[t] |= result.conflictStatus[t];
+		for (const ReadConflictRange* r : result.reportedConflicts)
+			r->conflictingKeyRange->push_back(*r->cKRArena, r->indexInTx);
+	}
+}
+
 void ConflictBatch::addConflictRanges(Version now,
                                       std::vector<std::pair<StringRef, StringRef>>::iterator begin,
                                       std::vector<std::pair<StringRef, StringRef>>::iterator end,
@@ -1063,9 +1240,51 @@ void ConflictBatch::mergeWriteConflictRanges(Version now) {
 	if (combinedWriteConflictRanges.empty())
 		return;
 
+	const int partitionCount = cs->batchPartitions(combinedWriteConflictRanges.size());
+	if (partitionCount > 1) {
+		mergeWriteConflictRangesParallel(now, partitionCount);
+		return;
+	}
+
 	addConflictRanges(now, combinedWriteConflictRanges.begin(), combinedWriteConflictRanges.end(), &cs->versionHistory);
 }
 
+// Splits the version history at the beginning of some of the (sorted and disjoint) combined write conflict ranges,
+// merges each group of ranges into its own partition and concatenates the partitions again afterwards. A split key
+// must not be the end of the previous range, since the partition to its left would then insert a node at the key.
+void ConflictBatch::mergeWriteConflictRangesParallel(Version now, int partitionCount) {
+	const int rangeCount = combinedWriteConflictRanges.size();
+	std::vector<int> firstRange = { 0 };
+	std::vector<StringRef> splitKeys;
+	for (int p = 1; p < partitionCount; p++) {
+		int r = std::max((int)((int64_t)rangeCount * p / partitionCount), firstRange.back() + 1);
+		while (r < rangeCount && combinedWriteConflictRanges[r].first == combinedWriteConflictRanges[r - 1].second)
+			r++;
+		if (r >= rangeCount)
+			break;
+		firstRange.push_back(r);
+		splitKeys.push_back(combinedWriteConflictRanges[r].first);
+	}
+	firstRange.push_back(rangeCount);
+
+	if (splitKeys.empty()) {
+		addConflictRanges(
+		    now, combinedWriteConflictRanges.begin(), combinedWriteConflictRanges.end(), &cs->versionHistory);
+		return;
+	}
+
+	SkipList* parts = &cs->partitions[0];
+	const int partCount = splitKeys.size() + 1;
+	cs->versionHistory.partition(&splitKeys[0], splitKeys.size(), parts);
+	cs->runPartitions(partCount, [&](int p) {
+		addConflictRanges(now,
+		                  combinedWriteConflictRanges.begin() + firstRange[p],
+		                  combinedWriteConflictRanges.begin() + firstRange[p + 1],
+		                  &parts[p]);
+	});
+	cs->versionHistory.concatenate(parts, partCount);
+}
+
 void ConflictBatch::combineWriteConflictRanges() {
 	int activeWriteCount = 0;
 	for (const KeyInfo& point : points) {
@@ -1546,3 +1765,196 @@ TEST_CASE("/fdbserver/skiplist/miniConflictSetCompatibility") {
 
 	return Void();
 }
+
+TEST_CASE("/fdbserver/skiplist/partitionedConflictSet") {
+	// Resolves the same random batches with a single threaded and a partitioned conflict set, which must agree on every
+	// transaction's outcome and on the conflicting key ranges reported.
+	const int threadCount = deterministicRandom()->randomInt(2, 9);
+	ConflictSet* serial = newConflictSet();
+	ConflictSet* partitioned = newConflictSet(threadCount, 0);
+
+	const int keySpace = deterministicRandom()->randomInt(50, 5000);
+	Version version = 0;
+	for (int b = 0; b < 200; b++) {
+		Arena arena;
+		std::vector<CommitTransactionRef> trs(deterministicRandom()->randomInt(1, 200));
+		for (auto& tr : trs) {
+			const int reads = deterministicRandom()->randomInt(0, 5);
+			const int writes = deterministicRandom()->randomInt(0, 5);
+			for (int r = 0; r < reads + writes; r++) {
+				const int begin = deterministicRandom()->randomInt(0, keySpace);
+				const int end = begin + 1 + deterministicRandom()->randomInt(0, 10);
+				KeyRangeRef range(setK(arena, begin), setK(arena, end));
+				if (r < reads)
+					tr.read_conflict_ranges.push_back(arena, range);
+				else
+					tr.write_conflict_ranges.push_back(arena, range);
+			}
+			tr.read_snapshot = version - deterministicRandom()->randomInt(0, 10);
+			tr.report_conflicting_keys = deterministicRandom()->coinflip();
+		}
+
+		const Version newOldestVersion = std::max<Version>(0, version - 5);
+		std::vector<int> nonConflicting[2], tooOld[2];
+		std::map<int, VectorRef<int>> conflictingKeyRanges[2];
+		Arena replyArena[2];
+		ConflictSet* sets[2] = { serial, partitioned };
+		for (int i = 0; i < 2; i++) {
+			ConflictBatch batch(sets[i], &conflictingKeyRanges[i], &replyArena[i]);
+			for (const auto& tr : trs)
+				batch.addTransaction(tr, newOldestVersion);
+			batch.detectConflicts(version + 1, newOldestVersion, nonConflicting[i], &tooOld[i]);
+		}
+
+		ASSERT(nonConflicting[0] == nonConflicting[1]);
+		ASSERT(tooOld[0] == tooOld[1]);
+		ASSERT_EQ(conflictingKeyRanges[0].size(), conflictingKeyRanges[1].size());
+		for (const auto& [t, ranges] : conflictingKeyRanges[0]) {
+			std::set<int> expected(ranges.begin(), ranges.end());
+			const VectorRef<int>& actual = conflictingKeyRanges[1][t];
+			ASSERT(expected == std::set<int>(actual.begin(), actual.end()));
+		}
+		version++;
+	}
+
+	destroyConflictSet(serial);
+	destroyConflictSet(partitioned);
+	return Void();
+}
+
+namespace {
+// Batches of transactions with two short read and two short write conflict ranges each, spread over a large key space.
+// Every key is prefix followed by a fixed width, big endian suffix, so that numeric order matches key order.
+struct ConflictSetWorkload {
+	Arena arena;
+	std::vector<std::vector<CommitTransactionRef>> batches;
+	int64_t transactionCount = 0;
+
+	ConflictSetWorkload(int transactionsPerBatch, StringRef prefix) {
+		for (int b = 0; b < 50; b++) {
+			std::vector<CommitTransactionRef>& batch = batches.emplace_back(transactionsPerBatch);
+			for (auto& tr : batch) {
+				for (int r = 0; r < 4; r++) {
+					const int begin = deterministicRandom()->randomInt(0, 20000000);
+					const int end = begin + 1 + deterministicRandom()->randomInt(0, 10);
+					KeyRangeRef range(key(begin, prefix), key(end, prefix));
+					if (r < 2)
+						tr.read_conflict_ranges.push_back(arena, range);
+					else
+						tr.write_conflict_ranges.push_back(arena, range);
+				}
+				// Every transaction reads at the previous batch's version, so only true conflicts abort it
+				tr.read_snapshot = b;
+			}
+			transactionCount += transactionsPerBatch;
+		}
+	}
+
+	KeyRef key(int i, StringRef prefix) {
+		uint8_t* k = new (arena) uint8_t[prefix.size() + 4];
+		memcpy(k, prefix.begin(), prefix.size());
+		for (int b = 0; b < 4; b++)
+			k[prefix.size() + b] = (uint8_t)(i >> (8 * (3 - b)));
+		return KeyRef(k, prefix.size() + 4);
+	}
+
+	// Resolves every batch into an empty conflict set and returns the transactions resolved per second of wall clock
+	// time, which unlike CPU time includes the work of the conflict set's worker threads
+	double resolve(ConflictSet* cs) const {
+		clearConflictSet(cs, 0);
+		const double start = timer();
+		Version version = 0;
+		for (const auto& transactions : batches) {
+			ConflictBatch batch(cs);
+			for (const auto& tr : transactions)
+				batch.addTransaction(tr, 0);
+			std::vector<int> nonConflicting;
+			batch.detectConflicts(++version, 0, nonConflicting);
+		}
+		return transactionCount / (timer() - start);
+	}
+};
+} // namespace
+
+// Reports resolver throughput versus the number of threads the conflict set is partitioned across
+TEST_CASE("performance/fdbserver/skiplist/conflictSetThreads") {
+	for (int transactions : { 1000, 10000 }) {
+		ConflictSetWorkload workload(transactions, "............"_sr);
+		for (int threads : { 1, 2, 4, 8 }) {
+			ConflictSet* cs = newConflictSet(threads, 0);
+			double best = 0;
+			for (int run = 0; run < 3; run++)
+				best = std::max(best, workload.resolve(cs));
+			destroyConflictSet(cs);
+			printf("transactions/batch=%d threads=%d: %.0f transactions/s\n", transactions, threads, best);
+		}
+	}
+	return Void();
+}
+
+// Reports single threaded resolver throughput versus the length of a tuple encoded subspace shared by every key,
+// which the skip list has to compare past on every step of a search
+TEST_CASE("performance/fdbserver/skiplist/conflictSetKeyPrefix") {
+	for (int subspaceBytes : { 0, 16, 64, 256 }) {
+		// Keys of a layer storing an index, (subspace, table, index), in a subspace with a long name
+		Tuple t;
+		t.append(StringRef(std::string(subspaceBytes, 's'))).append((int64_t)17).append((int64_t)2);
+		Standalone<StringRef> prefix = t.pack();
+		ConflictSetWorkload workload(10000, prefix);
+		ConflictSet* cs = newConflictSet();
+		double best = 0;
+		for (int run = 0; run < 3; run++)
+			best = std::max(best, workload.resolve(cs));
+		destroyConflictSet(cs);
+		printf("subspace=%d bytes: %.0f transactions/s\n", subspaceBytes, best);
+	}
+	return Void();
+}
+
+TEST_CASE("/fdbserver/skiplist/sharedPrefixFind") {
+	// Keys share long prefixes, and many are prefixes of each other, so that searches exercise comparisons which skip
+	// the bytes a finger already knows its neighbors share with the value being searched for.
+	const std::string prefix(deterministicRandom()->randomInt(0, 40), 'p');
+	auto randomKey = [&]() {
+		std::string key = prefix;
+		const int length = deterministicRandom()->randomInt(1, 20);
+		for (int i = 0; i < length; i++)
+			key += (char)('a' + deterministicRandom()->randomInt(0, 3));
+		return key;
+	};
+
+	// Adding the ranges [k0, k1), [k2, k3), ... inserts every key
+	std::set<std::string> inserted;
+	for (int i = 0; i < 2000; i++)
+		inserted.insert(randomKey());
+	if (inserted.size() % 2)
+		inserted.erase(std::prev(inserted.end()));
+	Arena arena;
+	std::vector<StringRef> keys;
+	for (const auto& k : inserted)
+		keys.push_back(StringRef(arena, k));
+	SkipList list;
+	{
+		std::vector<SkipList::Finger> fingers(keys.size());
+		std::vector<int> temp(keys.size());
+		list.find(keys.data(), fingers.data(), temp.data(), keys.size());
+		list.addConflictRanges(fingers.data(), keys.size() / 2, 1);
+	}
+
+	std::set<std::string> queries;
+	for (int i = 0; i < 500; i++)
+		queries.insert(randomKey());
+	std::vector<StringRef> values;
+	for (const auto& q : queries)
+		values.push_back(StringRef(arena, q));
+	std::vector<SkipList::Finger> fingers(values.size());
+	std::vector<int> temp(values.size());
+	list.find(values.data(), fingers.data(), temp.data(), values.size());
+
+	for (int i = 0; i < values.size(); i++) {
+		auto expected = inserted.lower_bound(values[i].toString());
+		ASSERT(fingers[i].getValue() == (expected == inserted.end() ? StringRef() : StringRef(*expected)));
+		ASSERT((fingers[i].found() != nullptr) == (expected != inserted.end() && *expected == values[i].toString()));
+	}
+	return Void();
+}
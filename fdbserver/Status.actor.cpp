@@ -468,6 +468,17 @@ struct RolesInfo {
 		latencyStats.setKeyRawNumber("p99", metrics.getValue("P99"));
 		latencyStats.setKeyRawNumber("p99.9", metrics.getValue("P99.9"));
 
+		// Samplers with a LogLinearHistogram also log its percentiles
+		std::string histogramP50;
+		if (metrics.tryGetValue("HistogramP50", histogramP50)) {
+			JsonBuilderObject histogram;
+			histogram.setKeyRawNumber("p50", histogramP50);
+			histogram.setKeyRawNumber("p90", metrics.getValue("HistogramP90"));
+			histogram.setKeyRawNumber("p99", metrics.getValue("HistogramP99"));
+			histogram.setKeyRawNumber("p999", metrics.getValue("HistogramP99.9"));
+			latencyStats["log_linear_histogram"] = histogram;
+		}
+
 		return latencyStats;
 	}
 
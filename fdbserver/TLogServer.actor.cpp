@@ -1673,10 +1673,60 @@ ACTOR Future<Void> waitForMessagesForTag(Reference<LogData> self, Tag reqTag, Ve
 	return Void();
 }
 
+// Assembles the messages of a peek reply as a list of segments which point at message bytes already held in memory
+// (message blocks, spilled values, or disk queue reads) instead of copying them into one buffer. The arenas owning
+// those bytes are kept alive by `arena`, and the bytes are copied only once, when the reply is serialized.
+struct PeekMessagesBuilder {
+	Arena arena;
+	VectorRef<StringRef> segments;
+	int length = 0;
+
+	int getLength() const { return length; }
+
+	void addVersion(Version version) {
+		uint8_t* header = new (arena) uint8_t[sizeof(VERSION_HEADER) + sizeof(Version)];
+		memcpy(header, &VERSION_HEADER, sizeof(VERSION_HEADER));
+		memcpy(header + sizeof(VERSION_HEADER), &version, sizeof(Version));
+		add(StringRef(header, sizeof(VERSION_HEADER) + sizeof(Version)));
+	}
+
+	// The caller must ensure that the memory of segment outlives arena
+	void add(StringRef segment) {
+		if (segment.empty()) {
+			return;
+		}
+		if (!segments.empty() && segments.back().end() == segment.begin()) {
+			segments.back() = StringRef(segments.back().begin(), segments.back().size() + segment.size());
+		} else {
+			segments.push_back(arena, segment);
+		}
+		length += segment.size();
+	}
+
+	void append(const PeekMessagesBuilder& other) {
+		arena.dependsOn(other.arena);
+		for (const auto& segment : other.segments) {
+			add(segment);
+		}
+	}
+
+	void moveTo(TLogPeekReply& reply) {
+		reply.arena.dependsOn(arena);
+		reply.messageSegments = segments;
+		reply.messageSegmentBytes = length;
+		if (segments.size() == 1) {
+			// A single segment is already contiguous
+			reply.messages = segments[0];
+			reply.messageSegments = VectorRef<StringRef>();
+			reply.messageSegmentBytes = 0;
+		}
+	}
+};
+
 void peekMessagesFromMemory(Reference<LogData> self,
                             Tag tag,
                             Version begin,
-                            BinaryWriter& messages,
+                            PeekMessagesBuilder& messages,
                             Version& endVersion) {
 	ASSERT(!messages.getLength());
 
@@ -1700,20 +1750,39 @@ void peekMessagesFromMemory(Reference<LogData> self,
 			}
 
 			currentVersion = it->first;
-			messages << VERSION_HEADER << currentVersion;
+			messages.addVersion(currentVersion);
 		}
 
-		// We need the 4 byte length prefix to be a TagsAndMessage format, but that prefix is added as part of StringRef
-		// serialization.
-		int offset = messages.getLength();
-		messages << it->second.toStringRef();
-		void* data = messages.getData();
-		DEBUG_TAGS_AND_MESSAGE(
-		    "TLogPeek", currentVersion, StringRef((uint8_t*)data + offset, messages.getLength() - offset), self->logId)
-		    .detail("PeekTag", tag);
+		// The message in the block is already in TagsAndMessage format, including its 4 byte length prefix
+		StringRef message((uint8_t*)it->second.getLengthPtr(), sizeof(uint32_t) + it->second.expectedSize());
+		messages.add(message);
+		DEBUG_TAGS_AND_MESSAGE("TLogPeek", currentVersion, message, self->logId).detail("PeekTag", tag);
 		versionCount++;
 	}
 
+	if (versionCount > 0) {
+		// The messages of a version live in the message blocks recorded under that version. The blocks may be
+		// discarded once the version is made durable, so the reply must keep their arenas alive. Consecutive blocks
+		// usually share an arena, which only needs to be referenced once.
+		auto& blocks = self->messageBlocks;
+		int lo = 0, hi = blocks.size();
+		while (lo < hi) {
+			int mid = lo + (hi - lo) / 2;
+			if (blocks[mid].first < begin) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+		Optional<Arena> lastArena;
+		for (int i = lo; i < blocks.size() && blocks[i].first <= currentVersion; ++i) {
+			if (!lastArena.present() || !lastArena.get().sameArena(blocks[i].second.arena())) {
+				messages.arena.dependsOn(blocks[i].second.arena());
+				lastArena = blocks[i].second.arena();
+			}
+		}
+	}
+
 	if (versionCount == 0) {
 		++self->emptyPeeks;
 	} else {
@@ -1750,6 +1819,17 @@ ACTOR Future<std::vector<StringRef>> parseMessagesForTag(StringRef commitBlob, T
 	return relevantMessages;
 }
 
+// Message segments are copied into the packet when a reply is serialized, but a reply delivered within this process is
+// never serialized, so it must own contiguous messages.
+void flattenPeekReplyIfLocal(const ReplyPromise<TLogPeekReply>& replyPromise, TLogPeekReply& reply) {
+	if (!replyPromise.isRemoteEndpoint()) {
+		reply.flattenMessages();
+	}
+}
+
+// A stream peek passes its reply on to tLogPeekStream, which checks its own peer
+void flattenPeekReplyIfLocal(const Promise<TLogPeekReply>& replyPromise, TLogPeekReply& reply) {}
+
 // Common logics to peek TLog and create TLogPeekReply that serves both streaming peek or normal peek request
 ACTOR template <typename PromiseType>
 Future<Void> tLogPeekMessages(PromiseType replyPromise,
@@ -1762,8 +1842,8 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
                               Optional<std::pair<UID, int>> reqSequence = Optional<std::pair<UID, int>>(),
                               Optional<Version> reqEnd = Optional<Version>(),
                               Optional<bool> reqReturnEmptyIfStopped = Optional<bool>()) {
-	state BinaryWriter messages(Unversioned());
-	state BinaryWriter messages2(Unversioned());
+	state PeekMessagesBuilder messages;
+	state PeekMessagesBuilder messages2;
 	state int sequence = -1;
 	state UID peekId;
 	state double queueStart = now();
@@ -2009,17 +2089,18 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 				    SERVER_KNOBS->DESIRED_TOTAL_BYTES,
 				    SERVER_KNOBS->DESIRED_TOTAL_BYTES));
 
+				messages.arena.dependsOn(kvs.arena());
 				for (auto& kv : kvs) {
 					auto ver = decodeTagMessagesKey(kv.key);
-					messages << VERSION_HEADER << ver;
-					messages.serializeBytes(kv.value);
+					messages.addVersion(ver);
+					messages.add(kv.value);
 				}
 
 				if (kvs.expectedSize() >= SERVER_KNOBS->DESIRED_TOTAL_BYTES) {
 					endVersion = decodeTagMessagesKey(kvs.end()[-1].key) + 1;
 					onlySpilled = true;
 				} else {
-					messages.serializeBytes(messages2.toValue());
+					messages.append(messages2);
 				}
 			} else {
 				// FIXME: Limit to approximately DESIRED_TOTATL_BYTES somehow.
@@ -2079,18 +2160,20 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 					uint8_t valid;
 					const uint32_t length = *(uint32_t*)queueEntryData.begin();
 					queueEntryData = queueEntryData.substr(4, queueEntryData.size() - 4);
-					BinaryReader rd(queueEntryData, IncludeVersion());
+					// The messages of the entry are read in place rather than copied out of the disk queue page
+					ArenaReader rd(queueEntryData.arena(), queueEntryData, IncludeVersion());
 					state TLogQueueEntry entry;
 					rd >> entry >> valid;
 					ASSERT(valid == 0x01);
 					ASSERT(length + sizeof(valid) == queueEntryData.size());
 
-					messages << VERSION_HEADER << entry.version;
+					messages.addVersion(entry.version);
 
 					std::vector<StringRef> rawMessages =
 					    wait(parseMessagesForTag(entry.messages, reqTag, logData->logRouterTags));
+					messages.arena.dependsOn(entry.arena());
 					for (const StringRef& msg : rawMessages) {
-						messages.serializeBytes(msg);
+						messages.add(msg);
 						DEBUG_TAGS_AND_MESSAGE("TLogPeekFromDisk", entry.version, msg, logData->logId)
 						    .detail("DebugID", self->dbgid)
 						    .detail("PeekTag", reqTag);
@@ -2107,7 +2190,7 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 					endVersion = lastRefMessageVersion + 1;
 					onlySpilled = true;
 				} else {
-					messages.serializeBytes(messages2.toValue());
+					messages.append(messages2);
 				}
 			}
 		} else {
@@ -2144,9 +2227,7 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 	TLogPeekReply reply;
 	reply.maxKnownVersion = logData->version.get();
 	reply.minKnownCommittedVersion = logData->minKnownCommittedVersion;
-	auto messagesValue = messages.toValue();
-	reply.arena.dependsOn(messagesValue.arena());
-	reply.messages = messagesValue;
+	messages.moveTo(reply);
 	reply.end = endVersion;
 	if (replyWithRecoveryVersion.present()) {
 		reply.end = replyWithRecoveryVersion.get();
@@ -2158,7 +2239,7 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 	    .detail("Tag", reqTag.toString())
 	    .detail("ReqBegin", reqBegin)
 	    .detail("EndVer", reply.end)
-	    .detail("MsgBytes", reply.messages.expectedSize());
+	    .detail("MsgBytes", reply.messageBytes());
 
 	if (reqSequence.present()) {
 		auto& trackerData = logData->peekTracker[peekId];
@@ -2169,7 +2250,7 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 		double workT = now() - workStart;
 
 		trackerData.totalPeeks++;
-		trackerData.replyBytes += reply.messages.size();
+		trackerData.replyBytes += reply.messageBytes();
 
 		if (queueT > trackerData.queueMax)
 			trackerData.queueMax = queueT;
@@ -2207,6 +2288,7 @@ Future<Void> tLogPeekMessages(PromiseType replyPromise,
 		reply.begin = reqBegin;
 	}
 
+	flattenPeekReplyIfLocal(replyPromise, reply);
 	replyPromise.send(reply);
 	return Void();
 }
@@ -2236,6 +2318,9 @@ ACTOR Future<Void> tLogPeekStream(TLogData* self, TLogPeekStreamRequest req, Ref
 			                      req.returnEmptyIfStopped));
 
 			reply.rep.begin = begin;
+			if (!req.reply.isRemoteEndpoint()) {
+				reply.rep.flattenMessages();
+			}
 			req.reply.send(reply);
 			begin = reply.rep.end;
 			onlySpilled = reply.rep.onlySpilled;
@@ -3910,3 +3995,56 @@ TEST_CASE("Lfdbserver/tlogserver/VersionMessagesOverheadFactor") {
 
 	return Void();
 }
+
+TEST_CASE("/fdbserver/tlogserver/PeekReplyGatheredMessages") {
+	// Messages held in several arenas, as they would be in message blocks and spilled data
+	std::vector<Standalone<StringRef>> blocks;
+	PeekMessagesBuilder builder;
+	BinaryWriter expected(Unversioned());
+	int versions = deterministicRandom()->randomInt(1, 20);
+	for (int v = 0; v < versions; ++v) {
+		builder.addVersion(v);
+		expected << VERSION_HEADER << Version(v);
+		Standalone<StringRef> block = makeString(deterministicRandom()->randomInt(0, 1000));
+		deterministicRandom()->randomBytes(mutateString(block), block.size());
+		blocks.push_back(block);
+		builder.arena.dependsOn(block.arena());
+		// Adjacent pieces of one block are merged into one segment
+		int split = deterministicRandom()->randomInt(0, block.size() + 1);
+		builder.add(block.substr(0, split));
+		builder.add(block.substr(split));
+		expected.serializeBytes(block);
+	}
+	ASSERT_EQ(builder.getLength(), expected.getLength());
+	ASSERT_LE(builder.segments.size(), 2 * versions);
+
+	TLogPeekReply gathered;
+	builder.moveTo(gathered);
+	gathered.end = versions;
+	gathered.maxKnownVersion = versions;
+	gathered.minKnownCommittedVersion = 0;
+	ASSERT_EQ(gathered.messageBytes(), expected.getLength());
+
+	TLogPeekReply flat = gathered;
+	flat.flattenMessages();
+	ASSERT(flat.messageSegments.empty());
+	ASSERT(flat.messages == expected.toValue());
+
+	// The gathered reply serializes exactly as the flat one, and reads back as contiguous messages
+	Standalone<StringRef> gatheredBytes = ObjectWriter::toValue(gathered, Unversioned());
+	ASSERT(gatheredBytes == ObjectWriter::toValue(flat, Unversioned()));
+	TLogPeekReply decoded;
+	ObjectReader reader(gatheredBytes.begin(), Unversioned());
+	reader.deserialize(decoded);
+	ASSERT(decoded.messageSegments.empty());
+	ASSERT(decoded.messages == expected.toValue());
+	ASSERT_EQ(decoded.end, versions);
+
+	// Serializing with BinaryWriter flattens the reply
+	BinaryWriter wr(IncludeVersion());
+	wr << gathered;
+	ASSERT(gathered.messageSegments.empty());
+	ASSERT(gathered.messages == expected.toValue());
+
+	return Void();
+}
@@ -1456,6 +1456,12 @@ struct RedwoodMetrics {
 		unsigned int pagerProbeMiss;
 		unsigned int pagerEvictUnhit;
 		unsigned int pagerEvictFail;
+		unsigned int pagerCachePromote;
+		unsigned int pagerCacheDemote;
+		unsigned int pagerCompressIn;
+		unsigned int pagerCompressOut;
+		unsigned int pagerCompressUs;
+		unsigned int pagerDecompressUs;
 		unsigned int btreeLeafPreload;
 		unsigned int btreeLeafPreloadExt;
 	};
@@ -1632,12 +1638,14 @@ class ObjectCache : NonCopyable {
 	typedef std::unordered_map<IndexType, Entry> CacheT;
 
 	struct Entry : public boost::intrusive::list_base_hook<> {
-		Entry() : hits(0), size(0) {}
+		Entry() : hits(0), size(0), isProtected(false) {}
 		IndexType index;
 		ObjectType item;
 		int hits;
 		int size;
 		bool ownedByEvictor;
+		// Entry is in the Evictor's protected segment rather than its probationary segment
+		bool isProtected;
 		CacheT* pCache;
 	};
 
@@ -1648,10 +1656,33 @@ public:
 	// Not all objects tracked by the Evictor are in its evictionOrder, as ObjectCaches
 	// using this Evictor can temporarily remove entries to an external order but they
 	// must eventually give them back with moveIn() or remove them with reclaim().
+	//
+	// With the SegmentedLRU policy the eviction order is split into a probationary segment, which new entries
+	// enter, and a protected segment, which entries enter when they are hit while probationary by an access that
+	// is allowed to promote them.  Evictions come from the front of the probationary segment, so a large scan
+	// which does not promote can only displace other probationary entries.  When the protected segment grows past
+	// its share of sizeLimit its oldest entries are demoted to the back of the probationary segment.
 	class Evictor : NonCopyable {
 	public:
+		enum class Policy { LRU, SegmentedLRU };
+
 		Evictor(int64_t sizeLimit = 0) : sizeLimit(sizeLimit) {}
 
+		static Policy parsePolicy(const std::string& name) {
+			if (name == "slru") {
+				return Policy::SegmentedLRU;
+			}
+			if (name != "lru") {
+				TraceEvent(SevWarnAlways, "RedwoodUnknownPageCachePolicy").detail("Policy", name);
+			}
+			return Policy::LRU;
+		}
+
+		void setPolicy(Policy p, double protectedFraction) {
+			policy = p;
+			protectedLimitFraction = std::clamp(protectedFraction, 0.0, 1.0);
+		}
+
 		// Evictors are normally singletons, either one per real process or one per virtual process in simulation
 		static Evictor* getEvictor() {
 			static Evictor nonSimEvictor;
@@ -1668,19 +1699,39 @@ public:
 		// but the entry size is still counted against the evictor
 		void moveOut(Entry& e, EvictionOrderT& dest) {
 			ASSERT(e.ownedByEvictor);
-			dest.splice(dest.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
+			dest.splice(dest.end(), segmentOf(e), EvictionOrderT::s_iterator_to(e));
+			unprotect(e);
 			e.ownedByEvictor = false;
 			++movedOutCount;
 		}
 
-		// Move an entry to the back of the eviction order if it is in the eviction order
-		void moveToBack(Entry& e) {
+		// Move an entry to the back of its segment of the eviction order.  If promote is true and the policy is
+		// SegmentedLRU then a probationary entry is moved to the back of the protected segment instead.
+		void moveToBack(Entry& e, bool promote = true) {
 			ASSERT(e.ownedByEvictor);
-			evictionOrder.splice(evictionOrder.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
+			if (promote && !e.isProtected && policy == Policy::SegmentedLRU) {
+				protectedOrder.splice(protectedOrder.end(), evictionOrder, EvictionOrderT::s_iterator_to(e));
+				e.isProtected = true;
+				protectedSize += e.size;
+				++g_redwoodMetrics.metric.pagerCachePromote;
+
+				// Demote the oldest protected entries until the protected segment fits in its share of the limit,
+				// but never demote the entry just promoted.
+				int64_t protectedLimit = sizeLimit * protectedLimitFraction;
+				while (protectedSize > protectedLimit && &protectedOrder.front() != &e) {
+					Entry& toDemote = protectedOrder.front();
+					evictionOrder.splice(evictionOrder.end(), protectedOrder, protectedOrder.begin());
+					unprotect(toDemote);
+					++g_redwoodMetrics.metric.pagerCacheDemote;
+				}
+			} else {
+				EvictionOrderT& segment = segmentOf(e);
+				segment.splice(segment.end(), segment, EvictionOrderT::s_iterator_to(e));
+			}
 		}
 
 		// Move entire contents of an external eviction order containing entries whose size is part of
-		// this Evictor to the front of its eviction order.
+		// this Evictor to the front of its probationary eviction order.
 		void moveIn(EvictionOrderT& otherOrder) {
 			for (auto& e : otherOrder) {
 				ASSERT(!e.ownedByEvictor);
@@ -1697,13 +1748,23 @@ public:
 			e.ownedByEvictor = true;
 		}
 
+		// Change the size an entry is counted as, without changing its place in the eviction order
+		void resize(Entry& e, int size) {
+			sizeUsed += size - e.size;
+			if (e.isProtected) {
+				protectedSize += size - e.size;
+			}
+			e.size = size;
+		}
+
 		// Claim ownership of an entry, removing its size from the current size and removing it
 		// from the eviction order if it exists there
 		void reclaim(Entry& e) {
 			sizeUsed -= e.size;
 			// If e is in evictionOrder then remove it
 			if (e.ownedByEvictor) {
-				evictionOrder.erase(EvictionOrderT::s_iterator_to(e));
+				segmentOf(e).erase(EvictionOrderT::s_iterator_to(e));
+				unprotect(e);
 				e.ownedByEvictor = false;
 			} else {
 				// Otherwise, it wasn't so it had to be a movedOut item so decrement the count
@@ -1714,13 +1775,15 @@ public:
 		void trim(int additionalSpaceNeeded = 0) {
 			int attemptsLeft = FLOW_KNOBS->MAX_EVICT_ATTEMPTS;
 			// While the cache is too big, evict the oldest entry until the oldest entry can't be evicted.
+			// Protected entries are only evicted once the probationary segment is empty.
 			while (attemptsLeft-- > 0 && sizeUsed > (sizeLimit - reservedSize - additionalSpaceNeeded) &&
-			       !evictionOrder.empty()) {
-				Entry& toEvict = evictionOrder.front();
+			       (!evictionOrder.empty() || !protectedOrder.empty())) {
+				EvictionOrderT& segment = evictionOrder.empty() ? protectedOrder : evictionOrder;
+				Entry& toEvict = segment.front();
 
 				debug_printf("Evictor count=%d sizeUsed=%" PRId64 " sizeLimit=%" PRId64 " sizePenalty=%" PRId64
 				             " needed=%d  Trying to evict %s evictable %d\n",
-				             (int)evictionOrder.size(),
+				             (int)(evictionOrder.size() + protectedOrder.size()),
 				             sizeUsed,
 				             sizeLimit,
 				             reservedSize,
@@ -1730,7 +1793,7 @@ public:
 
 				if (!toEvict.item.evictable()) {
 					// shift the front to the back
-					evictionOrder.shift_forward(1);
+					segment.shift_forward(1);
 					++g_redwoodMetrics.metric.pagerEvictFail;
 					break;
 				} else {
@@ -1739,32 +1802,39 @@ public:
 					}
 					sizeUsed -= toEvict.size;
 					debug_printf("Evicting %s\n", ::toString(toEvict.index).c_str());
-					evictionOrder.pop_front();
+					segment.pop_front();
+					unprotect(toEvict);
 					toEvict.pCache->erase(toEvict.index);
 				}
 			}
 		}
 
-		int64_t getCountUsed() const { return evictionOrder.size() + movedOutCount; }
+		int64_t getCountUsed() const { return evictionOrder.size() + protectedOrder.size() + movedOutCount; }
 		int64_t getCountMoved() const { return movedOutCount; }
+		int64_t getCountProtected() const { return protectedOrder.size(); }
 		int64_t getSizeUsed() const { return sizeUsed + reservedSize; }
+		int64_t getSizeProtected() const { return protectedSize; }
 
 		// Only to be used in tests at a point where all ObjectCache instances should be destroyed.
 		bool empty() const { return reservedSize == 0 && sizeUsed == 0 && getCountUsed() == 0; }
 
 		std::string toString() const {
 			std::string s = format("Evictor {sizeLimit=%" PRId64 " sizeUsed=%" PRId64 " countUsed=%" PRId64
-			                       " sizePenalty=%" PRId64 " movedOutCount=%" PRId64,
+			                       " sizePenalty=%" PRId64 " movedOutCount=%" PRId64 " protectedSize=%" PRId64,
 			                       sizeLimit,
 			                       sizeUsed,
 			                       getCountUsed(),
 			                       reservedSize,
-			                       movedOutCount);
-			for (auto& entry : evictionOrder) {
-				s += format("\n\tindex %s  size %d  evictable %d\n",
-				            ::toString(entry.index).c_str(),
-				            entry.size,
-				            entry.item.evictable());
+			                       movedOutCount,
+			                       protectedSize);
+			for (auto* segment : { &evictionOrder, &protectedOrder }) {
+				for (auto& entry : *segment) {
+					s += format("\n\tindex %s  size %d  evictable %d  protected %d\n",
+					            ::toString(entry.index).c_str(),
+					            entry.size,
+					            entry.item.evictable(),
+					            entry.isProtected);
+				}
 			}
 			s += "}\n";
 			return s;
@@ -1776,9 +1846,25 @@ public:
 		int64_t sizeLimit;
 
 	private:
+		EvictionOrderT& segmentOf(Entry& e) { return e.isProtected ? protectedOrder : evictionOrder; }
+
+		// Account for e leaving the protected segment, if it was in it
+		void unprotect(Entry& e) {
+			if (e.isProtected) {
+				protectedSize -= e.size;
+				e.isProtected = false;
+			}
+		}
+
+		Policy policy = Policy::LRU;
+		double protectedLimitFraction = 0;
+		// Probationary segment, or the only segment for the LRU policy
 		EvictionOrderT evictionOrder;
+		EvictionOrderT protectedOrder;
 		// Size of all entries in the eviction order or held in external eviction orders
 		int64_t sizeUsed = 0;
+		// Size of all entries in protectedOrder
+		int64_t protectedSize = 0;
 		// Number of items that have been moveOut()'d to other evictionOrders and aren't back yet
 		int64_t movedOutCount = 0;
 	};
@@ -1806,6 +1892,15 @@ public:
 		return nullptr;
 	}
 
+	// Change the size the object for index is counted as, if it exists and its size is still counted.
+	// Its eviction order does not change.
+	void resize(const IndexType& index, int size) {
+		auto i = cache.find(index);
+		if (i != cache.end() && i->second.is_linked()) {
+			pEvictor->resize(i->second, size);
+		}
+	}
+
 	// If index is in cache and not on the prioritized eviction order list, move it there.
 	void prioritizeEviction(const IndexType& index) {
 		auto i = cache.find(index);
@@ -1815,10 +1910,10 @@ public:
 	}
 
 	// Get the object for i or create a new one.
-	// After a get(), the object for i is the last in evictionOrder.
+	// After a get(), the object for i is the last in its segment of evictionOrder.
 	// If noHit is set, do not consider this access to be cache hit if the object is present
-	// If noMiss is set, do not consider this access to be a cache miss if the object is not present
-	ObjectType& get(const IndexType& index, int size, bool noHit = false) {
+	// If noPromote is set, a hit does not move the object into the Evictor's protected segment
+	ObjectType& get(const IndexType& index, int size, bool noHit = false, bool noPromote = false) {
 		Entry& entry = cache[index];
 
 		// If entry is linked into an evictionOrder
@@ -1828,7 +1923,7 @@ public:
 				++entry.hits;
 				// If item eviction is not prioritized, move to end of eviction order
 				if (entry.ownedByEvictor) {
-					pEvictor->moveToBack(entry);
+					pEvictor->moveToBack(entry, !noPromote);
 				}
 			}
 		} else {
@@ -1839,6 +1934,7 @@ public:
 			entry.pCache = &cache;
 			entry.hits = 0;
 			entry.size = size;
+			entry.isProtected = false;
 
 			pEvictor->trim(entry.size);
 			pEvictor->addNew(entry);
@@ -2021,8 +2117,11 @@ public:
 	    filename(filename), memoryOnly(memoryOnly), remapCleanupWindowBytes(remapCleanupWindowBytes),
 	    concurrentExtentReads(new FlowLock(concurrentExtentReads)) {
 
-		// This sets the page cache size for all PageCacheT instances using the same evictor
+		// This sets the page cache size and eviction policy for all PageCacheT instances using the same evictor
 		pageCache.evictor().sizeLimit = pageCacheBytes;
+		pageCache.evictor().setPolicy(
+		    PageCacheT::Evictor::parsePolicy(SERVER_KNOBS->REDWOOD_PAGE_CACHE_EVICTION_POLICY),
+		    SERVER_KNOBS->REDWOOD_PAGE_CACHE_PROTECTED_FRACTION);
 
 		g_redwoodMetrics.ioLock = ioLock.getPtr();
 		if (!g_redwoodMetricsActor.isValid()) {
@@ -2565,16 +2664,28 @@ public:
 		// last committed version + 1
 		page->setWriteInfo(pageIDs.front(), this->getLastCommittedVersion() + 1);
 
-		page->preWrite(pageIDs.front());
-
 		int blockSize = header ? smallestPhysicalBlock : physicalPageSize;
+
+		// For compressing encodings the page written is a compressed copy, as page is also the cached page
+		double compressTime = 0;
+		Reference<ArenaPage> diskPage =
+		    page->takeDiskPage(header ? smallestPhysicalBlock : logicalPageSize, blockSize, &compressTime);
+		if (diskPage != page) {
+			ASSERT(diskPage->rawSize() == pageIDs.size() * blockSize);
+			g_redwoodMetrics.metric.pagerCompressIn += page->getLogicalSize();
+			g_redwoodMetrics.metric.pagerCompressOut += diskPage->getLogicalSize();
+			g_redwoodMetrics.metric.pagerCompressUs += compressTime * 1e6;
+		}
+
+		diskPage->preWrite(pageIDs.front());
+
 		Future<Void> f;
 		if (pageIDs.size() == 1) {
-			f = writePhysicalBlock(this, page, 0, blockSize, pageIDs.front(), reason, level, header);
+			f = writePhysicalBlock(this, diskPage, 0, blockSize, pageIDs.front(), reason, level, header);
 		} else {
 			std::vector<Future<Void>> writers;
 			for (int i = 0; i < pageIDs.size(); ++i) {
-				Future<Void> p = writePhysicalBlock(this, page, i, blockSize, pageIDs[i], reason, level, header);
+				Future<Void> p = writePhysicalBlock(this, diskPage, i, blockSize, pageIDs[i], reason, level, header);
 				writers.push_back(p);
 			}
 			f = waitForAll(writers);
@@ -2597,7 +2708,8 @@ public:
 		// or as a cache miss because there is no benefit to the page already being in cache
 		// Similarly, this does not count as a point lookup for reason.
 		ASSERT(pageIDs.front() != invalidLogicalPageID);
-		PageCacheEntry& cacheEntry = pageCache.get(pageIDs.front(), pageIDs.size() * physicalPageSize, true);
+		// The entry is charged for the page in memory, which is larger than its disk pages if it is compressed
+		PageCacheEntry& cacheEntry = pageCache.get(pageIDs.front(), data->rawSize(), true);
 		debug_printf("DWALPager(%s) op=write %s cached=%d reading=%d writing=%d\n",
 		             filename.c_str(),
 		             toString(pageIDs).c_str(),
@@ -2634,6 +2746,16 @@ public:
 
 		// Always update the page contents immediately regardless of what happened above.
 		cacheEntry.readFuture = data;
+		pageCache.resize(pageIDs.front(), data->rawSize());
+	}
+
+	// Once a cached read completes, charge its cache entry for the page in memory rather than the disk pages it was
+	// read from, which are fewer if the page is compressed
+	Future<Reference<ArenaPage>> resizeOnRead(LogicalPageID pageID, Future<Reference<ArenaPage>> read) {
+		return map(read, [=](Reference<ArenaPage> page) {
+			pageCache.resize(pageID, page->rawSize());
+			return page;
+		});
 	}
 
 	Future<LogicalPageID> atomicUpdatePage(PagerEventReasons reason,
@@ -2806,7 +2928,9 @@ public:
 
 		try {
 			page->postReadHeader(pageID);
-			page->postReadPayload(pageID);
+			double decompressTime = 0;
+			page->postReadPayload(pageID, &decompressTime);
+			g_redwoodMetrics.metric.pagerDecompressUs += decompressTime * 1e6;
 			debug_printf("DWALPager(%s) op=readPhysicalVerified %s ptr=%p\n",
 			             self->filename.c_str(),
 			             toString(pageID).c_str(),
@@ -2871,7 +2995,9 @@ public:
 
 		try {
 			page->postReadHeader(pageIDs.front());
-			page->postReadPayload(pageIDs.front());
+			double decompressTime = 0;
+			page->postReadPayload(pageIDs.front(), &decompressTime);
+			g_redwoodMetrics.metric.pagerDecompressUs += decompressTime * 1e6;
 			debug_printf("DWALPager(%s) op=readPhysicalVerified %s ptr=%p bytes=%d\n",
 			             self->filename.c_str(),
 			             toString(pageIDs).c_str(),
@@ -2906,6 +3032,13 @@ public:
 		       reason == PagerEventReasons::RangeRead || reason == PagerEventReasons::RangePrefetch;
 	}
 
+	// Scans touch each page once in a long sequence, so a hit from one is not evidence that the page is hot and
+	// must not push pages reused by point reads out of the page cache's protected segment.
+	static bool isScanRequest(PagerEventReasons reason) {
+		return reason == PagerEventReasons::FetchRange || reason == PagerEventReasons::RangeRead ||
+		       reason == PagerEventReasons::RangePrefetch;
+	}
+
 	// Reads the most recent version of pageID, either previously committed or written using updatePage()
 	// in the current commit
 	Future<Reference<ArenaPage>> readPage(PagerEventReasons reason,
@@ -2935,7 +3068,7 @@ public:
 			debug_printf("DWALPager(%s) op=readUncachedMiss %s\n", filename.c_str(), toString(pageID).c_str());
 			return forwardError(readPhysicalPage(this, pageID, priority, false, reason), errorPromise);
 		}
-		PageCacheEntry& cacheEntry = pageCache.get(pageID, physicalPageSize, noHit);
+		PageCacheEntry& cacheEntry = pageCache.get(pageID, physicalPageSize, noHit, isScanRequest(reason));
 		debug_printf("DWALPager(%s) op=read %s cached=%d reading=%d writing=%d noHit=%d\n",
 		             filename.c_str(),
 		             toString(pageID).c_str(),
@@ -2945,7 +3078,8 @@ public:
 		             noHit);
 		if (!cacheEntry.initialized()) {
 			debug_printf("DWALPager(%s) issuing actual read of %s\n", filename.c_str(), toString(pageID).c_str());
-			cacheEntry.readFuture = forwardError(readPhysicalPage(this, pageID, priority, false, reason), errorPromise);
+			cacheEntry.readFuture = resizeOnRead(
+			    pageID, forwardError(readPhysicalPage(this, pageID, priority, false, reason), errorPromise));
 			cacheEntry.writeFuture = Void();
 
 			++g_redwoodMetrics.metric.pagerCacheMiss;
@@ -2985,7 +3119,8 @@ public:
 			return forwardError(readPhysicalMultiPage(this, pageIDs, priority, reason), errorPromise);
 		}
 
-		PageCacheEntry& cacheEntry = pageCache.get(pageIDs.front(), pageIDs.size() * physicalPageSize, noHit);
+		PageCacheEntry& cacheEntry =
+		    pageCache.get(pageIDs.front(), pageIDs.size() * physicalPageSize, noHit, isScanRequest(reason));
 		debug_printf("DWALPager(%s) op=read %s cached=%d reading=%d writing=%d noHit=%d\n",
 		             filename.c_str(),
 		             toString(pageIDs).c_str(),
@@ -2995,7 +3130,8 @@ public:
 		             noHit);
 		if (!cacheEntry.initialized()) {
 			debug_printf("DWALPager(%s) issuing actual read of %s\n", filename.c_str(), toString(pageIDs).c_str());
-			cacheEntry.readFuture = forwardError(readPhysicalMultiPage(this, pageIDs, priority, reason), errorPromise);
+			cacheEntry.readFuture = resizeOnRead(
+			    pageIDs.front(), forwardError(readPhysicalMultiPage(this, pageIDs, priority, reason), errorPromise));
 			cacheEntry.writeFuture = Void();
 
 			++g_redwoodMetrics.metric.pagerCacheMiss;
@@ -4910,6 +5046,38 @@ public:
 		m_pBuffer->erase(iBegin, iEnd);
 	}
 
+	// Replace the contents of range with records, which must be sorted and within range.  Rather than adding a
+	// mutation buffer boundary per record, records are kept as one run after the range's boundary.  At commit time
+	// they are merged into leaf pages in bulk, and subtrees whose whole range they replace are built anew from the
+	// bottom up into full pages.
+	void replaceRange(KeyRangeRef range, Standalone<VectorRef<KeyValueRef>> records) {
+		clear(range);
+		if (records.empty()) {
+			return;
+		}
+		ASSERT(range.contains(records.front().key) && range.contains(records.back().key));
+
+		m_mutationCount += records.size();
+		g_redwoodMetrics.metric.opSet += records.size();
+		for (const KeyValueRef& kv : records) {
+			g_redwoodMetrics.metric.opSetKeyBytes += kv.key.size();
+			g_redwoodMetrics.metric.opSetValueBytes += kv.value.size();
+		}
+
+		// The records are referenced in place
+		m_pBuffer->dependsOn(records.arena());
+		MutationBuffer::iterator i = m_pBuffer->insert(range.begin);
+		VectorRef<KeyValueRef> after = records;
+		if (after.front().key == range.begin) {
+			i.mutation().setBoundaryValue(after.front().value);
+			after = after.slice(1, after.size());
+		}
+		if (!after.empty()) {
+			ASSERT(i.mutation().clearAfterBoundary);
+			i.mutation().bulkRecords = after;
+		}
+	}
+
 	void setOldestReadableVersion(Version v) { m_newOldestVersion = v; }
 
 	Version getOldestReadableVersion() const { return m_pager->getOldestReadableVersion(); }
@@ -5063,6 +5231,10 @@ public:
 		state Value btreeHeader = self->m_pager->getCommitRecord();
 		if (btreeHeader.size() == 0) {
 			// Create new BTree
+			if (!self->m_enforceEncodingType && SERVER_KNOBS->REDWOOD_PAGE_COMPRESSION &&
+			    ArenaPage::compressionSupported()) {
+				self->m_encodingType = EncodingType::XXHash64Zstd;
+			}
 			self->m_header.formatVersion = BTreeCommitHeader::FORMAT_VERSION;
 			self->m_header.encodingType = self->m_encodingType;
 			self->m_header.height = 1;
@@ -5095,6 +5267,12 @@ public:
 				throw e;
 			}
 
+			// Unless an encoding type is enforced, an existing BTree keeps the encoding type it was created with
+			if (!self->m_enforceEncodingType && (self->m_header.encodingType == EncodingType::XXHash64 ||
+			                                     self->m_header.encodingType == EncodingType::XXHash64Zstd)) {
+				self->m_encodingType = self->m_header.encodingType;
+			}
+
 			if (self->m_encodingType != self->m_header.encodingType) {
 				TraceEvent(SevWarn, "RedwoodBTreeUnexpectedEncodingType")
 				    .detail("InstanceName", self->m_pager->getName())
@@ -5106,6 +5284,9 @@ public:
 			self->m_lazyClearQueue.recover(self->m_pager, self->m_header.lazyDeleteQueue, "LazyClearQueueRecovered");
 			debug_printf("BTree recovered.\n");
 		}
+		self->m_nodeBlocks = ArenaPage::isCompressed(self->m_encodingType)
+		                         ? std::max(1, SERVER_KNOBS->REDWOOD_COMPRESSED_NODE_PAGES)
+		                         : 1;
 		self->m_lazyClearActor = 0;
 
 		TraceEvent e(SevInfo, "RedwoodRecoveredBTree");
@@ -5222,6 +5403,9 @@ private:
 		bool boundaryChanged;
 		Optional<ValueRef> boundaryValue; // Not present means cleared
 		bool clearAfterBoundary;
+		// Sorted records set by replaceRange() with keys after the boundary, kept as one run instead of a boundary
+		// per record.  The range after the boundary is always cleared when there are records, as they replace it.
+		VectorRef<KeyValueRef> bulkRecords;
 
 		bool boundaryCleared() const { return boundaryChanged && !boundaryValue.present(); }
 		bool boundarySet() const { return boundaryChanged && boundaryValue.present(); }
@@ -5237,6 +5421,7 @@ private:
 		void clearAll() {
 			clearBoundary();
 			clearAfterBoundary = true;
+			bulkRecords = VectorRef<KeyValueRef>();
 		}
 
 		void setBoundaryValue(ValueRef v) {
@@ -5244,11 +5429,37 @@ private:
 			boundaryValue = v;
 		}
 
+		// Called on a new boundary inside the range after previous's boundary to take over the bulk records at or
+		// after the new boundary key.  A record with the boundary key becomes the boundary value.
+		void splitBulkRecords(RangeMutation& previous, KeyRef boundary) {
+			VectorRef<KeyValueRef>& records = previous.bulkRecords;
+			if (records.empty()) {
+				return;
+			}
+			KeyValueRef* split = std::lower_bound(records.begin(), records.end(), boundary, KeyValueRef::OrderByKey());
+			KeyValueRef* after = split;
+			if (split != records.end() && split->key == boundary) {
+				setBoundaryValue(split->value);
+				++after;
+			}
+			bulkRecords = VectorRef<KeyValueRef>(after, records.end() - after);
+			records = VectorRef<KeyValueRef>(records.begin(), split - records.begin());
+		}
+
+		// Get the bulk records with keys in [begin, end)
+		VectorRef<KeyValueRef> bulkRecordsWithin(KeyRef begin, KeyRef end) const {
+			const KeyValueRef* first =
+			    std::lower_bound(bulkRecords.begin(), bulkRecords.end(), begin, KeyValueRef::OrderByKey());
+			const KeyValueRef* last = std::lower_bound(first, bulkRecords.end(), end, KeyValueRef::OrderByKey());
+			return VectorRef<KeyValueRef>(const_cast<KeyValueRef*>(first), last - first);
+		}
+
 		std::string toString() const {
-			return format("boundaryChanged=%d clearAfterBoundary=%d boundaryValue=%s",
+			return format("boundaryChanged=%d clearAfterBoundary=%d boundaryValue=%s bulkRecords=%d",
 			              boundaryChanged,
 			              clearAfterBoundary,
-			              ::toString(boundaryValue).c_str());
+			              ::toString(boundaryValue).c_str(),
+			              bulkRecords.size());
 		}
 	};
 
@@ -5297,6 +5508,9 @@ public:
 			return T(arena, object);
 		}
 
+		// Keep memory referenced by mutations, such as bulk records, alive for the life of the buffer
+		void dependsOn(const Arena& other) { arena.dependsOn(other); }
+
 		const_iterator upper_bound(const KeyRef& k) const { return mutations.upper_bound(k); }
 
 		const_iterator lower_bound(const KeyRef& k) const { return mutations.lower_bound(k); }
@@ -5331,6 +5545,7 @@ public:
 			if (iPrevious.mutation().clearAfterBoundary) {
 				ib.mutation().clearAll();
 			}
+			ib.mutation().splitBulkRecords(iPrevious.mutation(), boundary);
 
 			return ib;
 		}
@@ -5399,6 +5614,10 @@ private:
 	EncodingType m_encodingType = EncodingType::XXHash64;
 	bool m_enforceEncodingType;
 
+	// Number of pager pages that new BTree nodes are sized in multiples of.  Nodes of compressed BTrees are built
+	// larger than a pager page so that they can be written to fewer pager pages than they take up uncompressed.
+	int m_nodeBlocks = 1;
+
 	// Counter to update with DecodeCache memory usage
 	int64_t* m_pDecodeCacheMemory = nullptr;
 
@@ -5589,7 +5808,7 @@ private:
 			deltaSizes[i] = records[i].deltaSize(records[i - 1], prefixLen, true);
 		}
 
-		PageToBuild p(0, m_blockSize, m_encodingType, height, splitByDomain);
+		PageToBuild p(0, m_blockSize * m_nodeBlocks, m_encodingType, height, splitByDomain);
 
 		for (int i = 0; i < records.size();) {
 			bool force = p.count < minRecords || p.slackFraction() > maxSlack;
@@ -5718,7 +5937,7 @@ private:
 			}
 
 			// Create and init page here otherwise many variables must become state vars
-			state Reference<ArenaPage> page = self->m_pager->newPageBuffer(p->blockCount);
+			state Reference<ArenaPage> page = self->m_pager->newPageBuffer(p->blockCount * self->m_nodeBlocks);
 			page->init(
 			    self->m_encodingType, (p->blockCount == 1) ? PageType::BTreeNode : PageType::BTreeSuperNode, height);
 
@@ -5759,10 +5978,11 @@ private:
 
 			// Write this btree page, which is made of 1 or more pager pages.
 			state BTreeNodeLinkRef childPageID;
+			state int diskBlockCount = self->getDiskBlockCount(page);
 
 			// If we are only writing 1 BTree node and its block count is 1 and the original node also had 1 block
 			// then try to update the page atomically so its logical page ID does not change
-			if (pagesToBuild.size() == 1 && p->blockCount == 1 && previousID.size() == 1) {
+			if (pagesToBuild.size() == 1 && diskBlockCount == 1 && previousID.size() == 1) {
 				page->setLogicalPageInfo(previousID.front(), parentID);
 				LogicalPageID id = wait(
 				    self->m_pager->atomicUpdatePage(PagerEventReasons::Commit, height, previousID.front(), page, v));
@@ -5796,7 +6016,7 @@ private:
 					self->freeBTreePage(height, previousID, v);
 				}
 
-				childPageID.resize(records.arena(), p->blockCount);
+				childPageID.resize(records.arena(), diskBlockCount);
 				state int i = 0;
 				for (i = 0; i < childPageID.size(); ++i) {
 					LogicalPageID id = wait(self->m_pager->newPageID());
@@ -5979,6 +6199,14 @@ private:
 		}
 	}
 
+	// Get the number of pager pages page is written to, compressing it for compressed encodings
+	int getDiskBlockCount(Reference<ArenaPage> const& page) {
+		double compressTime = 0;
+		int count = page->getDiskBlockCount(m_blockSize, m_pager->getPhysicalPageSize(), &compressTime);
+		g_redwoodMetrics.metric.pagerCompressUs += compressTime * 1e6;
+		return count;
+	}
+
 	// Write new version of pageID at version v using page as its data.
 	// If oldID size is 1, attempts to keep logical page ID via an atomic page update.
 	// Returns resulting BTreePageID which might be the same as the input
@@ -5989,8 +6217,9 @@ private:
 	                                                      Arena* arena,
 	                                                      Reference<ArenaPage> page,
 	                                                      Version writeVersion) {
+		// A compressed page can need a different number of pager pages once updated
 		state BTreeNodeLinkRef newID;
-		newID.resize(*arena, oldID.size());
+		newID.resize(*arena, self->getDiskBlockCount(page));
 
 		if (REDWOOD_DEBUG) {
 			const BTreePage* btPage = (const BTreePage*)page->mutateData();
@@ -6008,7 +6237,7 @@ private:
 
 		state unsigned int height = (unsigned int)((const BTreePage*)page->data())->height;
 		ASSERT(height < 0xf0);
-		if (oldID.size() == 1) {
+		if (oldID.size() == 1 && newID.size() == 1) {
 			page->setLogicalPageInfo(oldID.front(), parentID);
 			LogicalPageID id = wait(
 			    self->m_pager->atomicUpdatePage(PagerEventReasons::Commit, height, oldID.front(), page, writeVersion));
@@ -6017,7 +6246,7 @@ private:
 		}
 
 		state int i = 0;
-		for (i = 0; i < oldID.size(); ++i) {
+		for (i = 0; i < newID.size(); ++i) {
 			LogicalPageID id = wait(self->m_pager->newPageID());
 			newID[i] = id;
 		}
@@ -6191,6 +6420,44 @@ private:
 		}
 	};
 
+	// Build a new subtree of the given height from records set by replaceRange() which replace the entire range of
+	// the slice u.  The records are sorted, so full pages are written at each level from the leaves up and only
+	// the links to the top level pages are added to the parent.
+	ACTOR static Future<Void> buildSubtree(VersionedBTree* self,
+	                                       CommitBatch* batch,
+	                                       InternalPageSliceUpdate* u,
+	                                       VectorRef<KeyValueRef> bulkRecords,
+	                                       unsigned int height,
+	                                       LogicalPageID parentID) {
+		state Standalone<VectorRef<RedwoodRecordRef>> records;
+		records.reserve(records.arena(), bulkRecords.size());
+		for (const KeyValueRef& kv : bulkRecords) {
+			records.push_back(records.arena(), RedwoodRecordRef(kv.key, kv.value));
+		}
+
+		state unsigned int level = 1;
+		loop {
+			Standalone<VectorRef<RedwoodRecordRef>> links =
+			    wait(writePages(self,
+			                    &u->subtreeLowerBound,
+			                    &u->subtreeUpperBound,
+			                    records,
+			                    level,
+			                    batch->writeVersion,
+			                    BTreeNodeLinkRef(),
+			                    level == height ? parentID : invalidLogicalPageID));
+			records = links;
+			if (level == height) {
+				break;
+			}
+			++level;
+		}
+
+		debug_printf("buildSubtree: built height %d subtree with %d top level pages\n", height, records.size());
+		u->rebuilt(records);
+		return Void();
+	}
+
 	struct InternalPageModifier {
 		InternalPageModifier() {}
 		InternalPageModifier(Reference<const ArenaPage> p,
@@ -6464,6 +6731,18 @@ private:
 
 			state Standalone<VectorRef<RedwoodRecordRef>> merged;
 
+			// Switch from updating the DeltaTree to a linear merge by adding the records before cursor to merged
+			auto switchToMerge = [&]() {
+				auto c = cursor;
+				c.moveFirst();
+				while (c != cursor) {
+					debug_printf("%s catch-up adding %s\n", context.c_str(), c.get().toString().c_str());
+					merged.push_back(merged.arena(), c.get());
+					c.moveNext();
+				}
+				updatingDeltaTree = false;
+			};
+
 			// The first mutation buffer boundary has a key <= the first key in the page.
 
 			cursor.moveFirst();
@@ -6556,15 +6835,7 @@ private:
 								// mutations, accumulating the new record set in the merge vector and build new pages
 								// from it. First, we must populate the merged vector with all the records up to but not
 								// including the current mutation boundary key.
-								auto c = cursor;
-								c.moveFirst();
-								while (c != cursor) {
-									debug_printf(
-									    "%s catch-up adding %s\n", context.c_str(), c.get().toString().c_str());
-									merged.push_back(merged.arena(), c.get());
-									c.moveNext();
-								}
-								updatingDeltaTree = false;
+								switchToMerge();
 							}
 						}
 
@@ -6591,6 +6862,16 @@ private:
 
 				// Before advancing the iterator, get whether or not the records in the following range must be removed
 				bool remove = mBegin.mutation().clearAfterBoundary;
+
+				// Bulk records in the following range and in this page's subtree replace its records, and are always
+				// added by a linear merge rather than one DeltaTree insert at a time
+				VectorRef<KeyValueRef> bulkRecords = mBegin.mutation().bulkRecordsWithin(
+				    update->subtreeLowerBound.key, update->subtreeUpperBound.key);
+				if (!bulkRecords.empty() && updatingDeltaTree) {
+					debug_printf("%s Switching to merge for %d bulk records\n", context.c_str(), bulkRecords.size());
+					switchToMerge();
+				}
+
 				// Advance to the next boundary because we need to know the end key for the current range.
 				++mBegin;
 				if (mBegin == mEnd) {
@@ -6638,6 +6919,16 @@ private:
 						}
 					}
 				}
+
+				if (!bulkRecords.empty()) {
+					ASSERT(remove && !updatingDeltaTree);
+					changesMade = true;
+					merged.reserve(merged.arena(), merged.size() + bulkRecords.size());
+					for (const KeyValueRef& kv : bulkRecords) {
+						merged.push_back(merged.arena(), RedwoodRecordRef(kv.key, kv.value));
+					}
+					debug_printf("%s Added %d records [bulk, middle]\n", context.c_str(), bulkRecords.size());
+				}
 			}
 
 			// If there are still more records, they have the same key as the end boundary
@@ -6719,7 +7010,7 @@ private:
 					                                       update->decodeLowerBound,
 					                                       update->decodeUpperBound)));
 
-					update->updatedInPlace(newID, btPage, newID.size() * self->m_blockSize);
+					update->updatedInPlace(newID, btPage, pageCopy->getLogicalSize());
 					debug_printf("%s Leaf node updated in-place, returning slice:\n", context.c_str());
 					debug_print(addPrefix(context, update->toString()));
 				}
@@ -6901,6 +7192,17 @@ private:
 								}
 								c.moveNext();
 							}
+
+							// Bulk records in the cleared range are built into a new subtree to replace it
+							VectorRef<KeyValueRef> bulkRecords =
+							    range.bulkRecordsWithin(u.subtreeLowerBound.key, u.subtreeUpperBound.key);
+							if (!bulkRecords.empty()) {
+								debug_printf("%s Building subtree from %d bulk records\n",
+								             context.c_str(),
+								             bulkRecords.size());
+								recursions.push_back(
+								    buildSubtree(self, batch, &u, bulkRecords, height - 1, rootID.front()));
+							}
 						} else {
 							// Subtree range unchanged
 						}
@@ -7068,7 +7370,7 @@ private:
 						                                       update->decodeLowerBound,
 						                                       update->decodeUpperBound)));
 
-						update->updatedInPlace(newID, btPage, newID.size() * self->m_blockSize);
+						update->updatedInPlace(newID, btPage, pageCopy->getLogicalSize());
 						debug_printf("%s Internal node updated in-place, returning slice:\n", context.c_str());
 						debug_print(addPrefix(context, update->toString()));
 					} else {
@@ -7292,6 +7594,11 @@ public:
 
 		bool inRoot() const { return path.size() == 1; }
 
+		// Whether key is within the key range covered by the page of entry
+		static bool pageContains(const PathEntry& entry, KeyRef key) {
+			return key >= entry.cursor.cache->lowerBound.key && key < entry.cursor.cache->upperBound.key;
+		}
+
 		// To enable more efficient range scans, caller can read the lowest page
 		// of the cursor and pop it.
 		PathEntry& back() { return path.back(); }
@@ -7364,9 +7671,17 @@ public:
 		//     If there is a record in the tree > query then moveNext() will move to it.
 		// If non-zero is returned then the cursor is valid and the return value is logically equivalent
 		// to query.compare(cursor.get())
-		ACTOR Future<int> seek_impl(BTreeCursor* self, RedwoodRecordRef query) {
+		// If nearby is true, the pages on the current path whose key ranges still contain query are kept and the
+		// descent resumes from the lowest of them, otherwise it starts over from the root.
+		ACTOR Future<int> seek_impl(BTreeCursor* self, RedwoodRecordRef query, bool nearby) {
 			state RedwoodRecordRef internalPageQuery = query.withMaxPageID();
-			self->path.resize(1);
+			if (nearby) {
+				while (self->path.size() > 1 && !self->pageContains(self->path.back(), query.key)) {
+					self->path.pop_back();
+				}
+			} else {
+				self->path.resize(1);
+			}
 			debug_printf("seek(%s) start cursor = %s\n", query.toString().c_str(), self->toString().c_str());
 
 			loop {
@@ -7399,18 +7714,23 @@ public:
 			}
 		}
 
-		Future<int> seek(RedwoodRecordRef query) { return path.empty() ? 0 : seek_impl(this, query); }
+		Future<int> seek(RedwoodRecordRef query) { return path.empty() ? 0 : seek_impl(this, query, false); }
+
+		// Like seek(), but cheaper when query is close to the cursor's current position, such as for a sequence of
+		// ascending point reads which often land in the same leaf page.
+		Future<int> seekNearby(RedwoodRecordRef query) { return path.empty() ? 0 : seek_impl(this, query, true); }
 
-		ACTOR Future<Void> seekGTE_impl(BTreeCursor* self, RedwoodRecordRef query) {
+		ACTOR Future<Void> seekGTE_impl(BTreeCursor* self, RedwoodRecordRef query, bool nearby) {
 			debug_printf("seekGTE(%s) start\n", query.toString().c_str());
-			int cmp = wait(self->seek(query));
+			int cmp = wait(nearby ? self->seekNearby(query) : self->seek(query));
 			if (cmp > 0 || (cmp == 0 && !self->isValid())) {
 				wait(self->moveNext());
 			}
 			return Void();
 		}
 
-		Future<Void> seekGTE(RedwoodRecordRef query) { return seekGTE_impl(this, query); }
+		Future<Void> seekGTE(RedwoodRecordRef query) { return seekGTE_impl(this, query, false); }
+		Future<Void> seekGTENearby(RedwoodRecordRef query) { return seekGTE_impl(this, query, true); }
 
 		// Start fetching sibling nodes in the forward or backward direction, stopping after recordLimit or byteLimit
 		void prefetch(KeyRef rangeEnd, bool directionForward, int recordLimit, int byteLimit) {
@@ -7692,6 +8012,14 @@ public:
 		m_tree->set(keyValue);
 	}
 
+	Future<Void> replaceRange(KeyRange range, Standalone<VectorRef<KeyValueRef>> data) override {
+		debug_printf("REPLACE %s records=%d\n", printable(range).c_str(), data.size());
+		if (!range.empty()) {
+			m_tree->replaceRange(range, data);
+		}
+		return Void();
+	}
+
 	Future<RangeResult> readRange(KeyRangeRef keys,
 	                              int rowLimit,
 	                              int byteLimit,
@@ -7866,6 +8194,39 @@ public:
 		return catchError(readValue_impl(this, key, options));
 	}
 
+	// Reads sorted keys with one cursor, so keys sharing a leaf page are found without descending from the root again
+	ACTOR static Future<std::vector<Optional<Value>>> readValues_impl(KeyValueStoreRedwood* self,
+	                                                                  Standalone<VectorRef<KeyRef>> keys,
+	                                                                  Optional<ReadOptions> options) {
+		state VersionedBTree::BTreeCursor cur;
+		wait(self->m_tree->initBTreeCursor(
+		    &cur, self->m_tree->getLastCommittedVersion(), PagerEventReasons::PointRead, options));
+
+		state std::vector<Optional<Value>> values;
+		values.reserve(keys.size());
+		state int i = 0;
+		for (; i < keys.size(); ++i) {
+			++g_redwoodMetrics.metric.opGet;
+			wait(cur.seekGTENearby(keys[i]));
+			if (cur.isValid() && cur.get().key == keys[i]) {
+				Value v;
+				v.arena().dependsOn(cur.back().page->getArena());
+				v.contents() = cur.get().value.get();
+				g_redwoodMetrics.kvSizeReadByGet->sample(cur.get().kvBytes());
+				values.push_back(v);
+			} else {
+				values.push_back(Optional<Value>());
+			}
+		}
+
+		return values;
+	}
+
+	Future<std::vector<Optional<Value>>> readValues(Standalone<VectorRef<KeyRef>> keys,
+	                                                Optional<ReadOptions> options) override {
+		return catchError(readValues_impl(this, keys, options));
+	}
+
 	Future<Optional<Value>> readValuePrefix(KeyRef key, int maxLength, Optional<ReadOptions> options) override {
 		return catchError(map(readValue_impl(this, key, options), [maxLength](Optional<Value> v) {
 			if (v.present() && v.get().size() > maxLength) {
@@ -8415,9 +8776,17 @@ void RedwoodMetrics::getFields(TraceEvent* e, std::string* s, bool skipZeroes) {
 		                                               { "PagerEvictUnhit", metric.pagerEvictUnhit },
 		                                               { "PagerEvictFail", metric.pagerEvictFail },
 		                                               { "", 0 },
+		                                               { "PagerPromote", metric.pagerCachePromote },
+		                                               { "PagerDemote", metric.pagerCacheDemote },
+		                                               { "", 0 },
 		                                               { "PagerRemapFree", metric.pagerRemapFree },
 		                                               { "PagerRemapCopy", metric.pagerRemapCopy },
 		                                               { "PagerRemapSkip", metric.pagerRemapSkip },
+		                                               { "", 0 },
+		                                               { "PagerCompIn", metric.pagerCompressIn },
+		                                               { "PagerCompOut", metric.pagerCompressOut },
+		                                               { "PagerCompUs", metric.pagerCompressUs },
+		                                               { "PagerDecompUs", metric.pagerDecompressUs },
 		                                               { "", 0 } };
 
 	double elapsed = now() - startTime;
@@ -8451,7 +8820,9 @@ void RedwoodMetrics::getFields(TraceEvent* e, std::string* s, bool skipZeroes) {
 	std::pair<const char*, int64_t> cacheMetrics[] = { { "PageCacheCount", evictor->getCountUsed() },
 		                                               { "PageCacheMoved", evictor->getCountMoved() },
 		                                               { "PageCacheSize", evictor->getSizeUsed() },
-		                                               { "DecodeCacheSize", evictor->reservedSize } };
+		                                               { "DecodeCacheSize", evictor->reservedSize },
+		                                               { "PageCacheProtCount", evictor->getCountProtected() },
+		                                               { "PageCacheProtSize", evictor->getSizeProtected() } };
 
 	if (e != nullptr) {
 		for (auto& m : cacheMetrics) {
@@ -8466,6 +8837,35 @@ void RedwoodMetrics::getFields(TraceEvent* e, std::string* s, bool skipZeroes) {
 		*s += "\n";
 	}
 
+	// Page cache hit ratio for each read reason, across all levels
+	for (PagerEventReasons reason : { PagerEventReasons::PointRead,
+	                                  PagerEventReasons::RangeRead,
+	                                  PagerEventReasons::RangePrefetch,
+	                                  PagerEventReasons::FetchRange,
+	                                  PagerEventReasons::Commit,
+	                                  PagerEventReasons::LazyClear }) {
+		int64_t lookups = 0;
+		int64_t hits = 0;
+		for (auto& level : levels) {
+			lookups += level.metrics.events.getEventReason(PagerEvents::CacheLookup, reason);
+			hits += level.metrics.events.getEventReason(PagerEvents::CacheHit, reason);
+		}
+		if (skipZeroes && lookups == 0) {
+			continue;
+		}
+		double hitRatio = lookups > 0 ? (double)hits / lookups : 0;
+		std::string name = format("HitRatio%s", PagerEventReasonsStrings[(int)reason]);
+		if (s != nullptr) {
+			*s += format("%-15s %-8.4f            ", name.c_str(), hitRatio);
+		}
+		if (e != nullptr) {
+			e->detail(std::move(name), hitRatio);
+		}
+	}
+	if (s != nullptr) {
+		*s += "\n";
+	}
+
 	for (int i = 1; i < btreeLevels + 1; ++i) {
 		auto& metric = levels[i].metrics;
 
@@ -8551,6 +8951,78 @@ void RedwoodMetrics::getIOLockFields(TraceEvent* e, std::string* s) {
 	}
 }
 
+struct TestCacheObject {
+	bool evictable() const { return true; }
+	Future<Void> onEvictable() const { return Void(); }
+	Future<Void> cancel() const { return Void(); }
+};
+
+// Returns how many of the hot keys survive a scan of cold keys which touches each cold key twice without promotion
+int hotKeysAfterScan(ObjectCache<int, TestCacheObject>::Evictor::Policy policy) {
+	typedef ObjectCache<int, TestCacheObject> CacheT;
+	CacheT::Evictor evictor(10);
+	evictor.setPolicy(policy, 0.5);
+	CacheT cache(&evictor);
+
+	for (int i = 0; i < 4; ++i) {
+		cache.get(i, 1);
+		cache.get(i, 1);
+	}
+	for (int i = 100; i < 200; ++i) {
+		cache.get(i, 1, false, true);
+		cache.get(i, 1, false, true);
+		ASSERT(evictor.getSizeUsed() <= 10);
+	}
+
+	int hot = 0;
+	for (int i = 0; i < 4; ++i) {
+		if (cache.getIfExists(i) != nullptr) {
+			++hot;
+		}
+	}
+
+	Future<Void> cleared = cache.clear();
+	ASSERT(cleared.isReady() && evictor.empty());
+	return hot;
+}
+
+TEST_CASE("/redwood/correctness/unit/ObjectCacheScanResistance") {
+	typedef ObjectCache<int, TestCacheObject>::Evictor::Policy Policy;
+	ASSERT(hotKeysAfterScan(Policy::LRU) == 0);
+	ASSERT(hotKeysAfterScan(Policy::SegmentedLRU) == 4);
+	return Void();
+}
+
+TEST_CASE("/redwood/correctness/unit/ObjectCacheResize") {
+	typedef ObjectCache<int, TestCacheObject> CacheT;
+	CacheT::Evictor evictor(10);
+	evictor.setPolicy(CacheT::Evictor::Policy::SegmentedLRU, 0.5);
+	CacheT cache(&evictor);
+
+	// Entry 0 is protected, entry 1 is probationary
+	cache.get(0, 1);
+	cache.get(0, 1);
+	cache.get(1, 1);
+	ASSERT(evictor.getSizeUsed() == 2 && evictor.getSizeProtected() == 1);
+
+	cache.resize(0, 4);
+	cache.resize(1, 3);
+	ASSERT(evictor.getSizeUsed() == 7 && evictor.getSizeProtected() == 4);
+
+	// Resizing an entry which is not in the cache does nothing
+	cache.resize(2, 5);
+	ASSERT(evictor.getSizeUsed() == 7 && cache.getIfExists(2) == nullptr);
+
+	// Eviction makes room by the new sizes, so evicting entry 1 alone is enough for entry 3
+	cache.get(3, 4);
+	ASSERT(cache.getIfExists(1) == nullptr && cache.getIfExists(0) != nullptr);
+	ASSERT(evictor.getSizeUsed() == 8 && evictor.getSizeProtected() == 4);
+
+	Future<Void> cleared = cache.clear();
+	ASSERT(cleared.isReady() && evictor.empty());
+	return Void();
+}
+
 TEST_CASE("/redwood/correctness/unit/RedwoodRecordRef") {
 	ASSERT(RedwoodRecordRef::Delta::LengthFormatSizes[0] == 3);
 	ASSERT(RedwoodRecordRef::Delta::LengthFormatSizes[1] == 4);
@@ -9712,6 +10184,8 @@ TEST_CASE("Lredwood/correctness/btree") {
 	    params.getDouble("clearKnownNodeBoundaryProbability").orDefault(deterministicRandom()->random01() * .1);
 	state double clearPostSetProbability =
 	    params.getDouble("clearPostSetProbability").orDefault(deterministicRandom()->random01() * .1);
+	state double replaceRangeProbability =
+	    params.getDouble("replaceRangeProbability").orDefault(deterministicRandom()->random01() * .5);
 	state double coldStartProbability =
 	    params.getDouble("coldStartProbability").orDefault(pagerMemoryOnly ? 0 : (deterministicRandom()->random01()));
 	state double advanceOldVersionProbability =
@@ -9782,6 +10256,7 @@ TEST_CASE("Lredwood/correctness/btree") {
 	printf("clearKnownNodeBoundaryProbability: %f\n", clearKnownNodeBoundaryProbability);
 	printf("clearSingleKeyProbability: %f\n", clearSingleKeyProbability);
 	printf("clearPostSetProbability: %f\n", clearPostSetProbability);
+	printf("replaceRangeProbability: %f\n", replaceRangeProbability);
 	printf("coldStartProbability: %f\n", coldStartProbability);
 	printf("maxColdStarts: %d\n", maxColdStarts);
 	printf("advanceOldVersionProbability: %f\n", advanceOldVersionProbability);
@@ -9929,7 +10404,38 @@ TEST_CASE("Lredwood/correctness/btree") {
 				}
 			}
 
-			btree->clear(range);
+			// Sometimes replace the cleared range with new records in one call
+			if (deterministicRandom()->random01() < replaceRangeProbability) {
+				std::set<Key> replaceKeys;
+				if (deterministicRandom()->coinflip()) {
+					replaceKeys.insert(range.begin);
+				}
+				int count = deterministicRandom()->randomInt(1, 200);
+				for (int i = 0; i < count; ++i) {
+					Key k = range.begin.withSuffix(keyGen.next());
+					if (range.contains(k)) {
+						replaceKeys.insert(k);
+					}
+				}
+
+				Standalone<VectorRef<KeyValueRef>> records;
+				for (const Key& k : replaceKeys) {
+					Value v = valGen.next();
+					records.push_back_deep(records.arena(), KeyValueRef(k, v));
+					written[std::make_pair(k.toString(), version)] = v.toString();
+					keys.insert(k);
+					mutationBytes += k.size() + v.size();
+					mutationBytesThisCommit += k.size() + v.size();
+				}
+				debug_printf("      Mutation:  Replace '%s' to '%s' with %d records @%" PRId64 "\n",
+				             start.toString().c_str(),
+				             end.toString().c_str(),
+				             records.size(),
+				             version);
+				btree->replaceRange(range, records);
+			} else {
+				btree->clear(range);
+			}
 
 			// Sometimes set the range start after the clear
 			if (deterministicRandom()->random01() < clearPostSetProbability) {
@@ -670,8 +670,9 @@ static void printUsage(const char* name, bool devhelp) {
 	                 " Sets the LogGroup field with the specified value for all"
 	                 " events in the trace output (defaults to `default').");
 	printOptionUsage("--trace-format FORMAT",
-	                 " Select the format of the log files. xml (the default) and json"
-	                 " are supported.");
+	                 " Select the format of the log files. xml (the default), json"
+	                 " and binary are supported. Binary files are converted to json"
+	                 " with the tracedecode tool.");
 	printOptionUsage("--tracer       TRACER",
 	                 " Select a tracer for transaction tracing. Currently disabled"
 	                 " (the default) and log_file are supported.");
@@ -2176,6 +2177,7 @@ int main(int argc, char* argv[]) {
 
 			g_network->addStopCallback(Net2FileSystem::stop);
 			FlowTransport::createInstance(false, 1, WLTOKEN_RESERVED_COUNT, &opts.allowList);
+			FlowTransport::transport().setLocalDcId(opts.localities.dcId());
 			opts.buildNetwork(argv[0]);
 
 			const bool expectsPublicAddress =
@@ -112,6 +112,9 @@ public:
 		return T(arena, object);
 	}
 
+	// Keep memory referenced by mutations, such as bulk records, alive for the life of the buffer
+	void dependsOn(const Arena& other) { arena.dependsOn(other); }
+
 	const_iterator upper_bound(const KeyRef& k) const { return const_iterator(mutations->upper_bound(k)); }
 
 	const_iterator lower_bound(const KeyRef& k) const { return const_iterator(mutations->lower_bound(k)); }
@@ -141,6 +144,7 @@ public:
 		if (iPrevious.mutation().clearAfterBoundary) {
 			ib.mutation().clearAll();
 		}
+		ib.mutation().splitBulkRecords(iPrevious.mutation(), boundary);
 		return ib;
 	}
 };
@@ -29,7 +29,9 @@
 #include "fdbserver/ResolverBug.h"
 
 struct ConflictSet;
-ConflictSet* newConflictSet();
+// When threadCount > 1, batches with at least minParallelRanges conflict ranges are checked and merged into the
+// version history by threadCount threads, each owning a key range partition of the history for the merge.
+ConflictSet* newConflictSet(int threadCount = 1, int minParallelRanges = 0);
 void clearConflictSet(ConflictSet*, Version);
 void destroyConflictSet(ConflictSet*);
 
@@ -75,7 +77,9 @@ private:
 	void checkIntraBatchConflicts();
 	void combineWriteConflictRanges();
 	void checkReadConflictRanges();
+	void checkReadConflictRangesParallel(int partitionCount);
 	void mergeWriteConflictRanges(Version now);
+	void mergeWriteConflictRangesParallel(Version now, int partitionCount);
 	void addConflictRanges(Version now,
 	                       std::vector<std::pair<StringRef, StringRef>>::iterator begin,
 	                       std::vector<std::pair<StringRef, StringRef>>::iterator end,
@@ -106,7 +106,8 @@ enum EncodingType : uint8_t {
 	XOREncryption_TestOnly_DEPRECATED = 1,
 	AESEncryption_DEPRECATED = 2,
 	AESEncryptionWithAuth_DEPRECATED = 3,
-	MAX_ENCODING_TYPE_EVER_DEFINED_DONT_USE_THIS_DIRECTLY_BECAUSE_YOU_CANT_ASSUME_NO_VALUES_EVER_GET_DEPRECATED = 4,
+	XXHash64Zstd = 5,
+	MAX_ENCODING_TYPE_EVER_DEFINED_DONT_USE_THIS_DIRECTLY_BECAUSE_YOU_CANT_ASSUME_NO_VALUES_EVER_GET_DEPRECATED = 6,
 };
 
 enum PageType : uint8_t {
@@ -199,7 +200,9 @@ private:
 //                     possibly encrypting all payload bytes.
 //    Payload - User accessible bytes, protected and possibly encrypted based on the encoding
 //
-// preWrite() must be called before writing a page to disk to update checksums and encrypt as needed
+// takeDiskPage() must be called before writing a page to disk to get the page to write, which for compressing
+// encodings is a separate page holding the compressed payload, and preWrite() must be called on that page to update
+// checksums and encrypt as needed
 // After reading a page from disk,
 //   postReadHeader() must be called to verify the version, main, and encoding headers
 //   postReadPayload() must be called, after potentially setting encryption secret, to verify and possibly
@@ -333,6 +336,31 @@ public:
 		}
 	};
 
+	// An encoding that compresses the payload with zstd and validates the stored payload bytes with an XXHash
+	// checksum.  Only pages returned by takeDiskPage() hold a compressed payload, pages in memory are always
+	// uncompressed and describe themselves as a payload stored as is.
+	struct XXHashZstdEncoder {
+		struct Header {
+			XXH64_hash_t checksum;
+			// Size of the payload once decompressed
+			uint32_t payloadSize;
+			// Size of the compressed payload, or 0 if the payload is stored uncompressed
+			uint32_t compressedSize;
+		};
+
+		static void encode(void* header, uint8_t* payload, int len, PhysicalPageID seed) {
+			Header* h = reinterpret_cast<Header*>(header);
+			h->checksum = XXH3_64bits_withSeed(payload, len, seed);
+		}
+
+		static void decode(void* header, uint8_t* payload, int len, PhysicalPageID seed) {
+			Header* h = reinterpret_cast<Header*>(header);
+			if (h->checksum != XXH3_64bits_withSeed(payload, len, seed)) {
+				throw page_decoding_failed();
+			}
+		}
+	};
+
 #pragma pack(pop)
 
 	// Get the size of the encoding header based on type
@@ -341,12 +369,20 @@ public:
 	static int encodingHeaderSize(EncodingType t) {
 		if (t == EncodingType::XXHash64) {
 			return sizeof(XXHashEncoder::Header);
+		} else if (t == EncodingType::XXHash64Zstd) {
+			return sizeof(XXHashZstdEncoder::Header);
 		} else {
 			TraceEvent(SevWarnAlways, "InvalidPageEncoding").detail("EncodingType", t);
 			throw page_encoding_not_supported();
 		}
 	}
 
+	// Whether pages of encoding type t are written to disk with a compressed payload
+	static bool isCompressed(EncodingType t) { return t == EncodingType::XXHash64Zstd; }
+
+	// Whether compressing encodings can be used, as they depend on zstd support in the build
+	static bool compressionSupported();
+
 	// Get the usable size for a new page of pageSize using HEADER_WRITE_VERSION with encoding type t
 	static int getUsableSize(int pageSize, EncodingType t) {
 		return pageSize - sizeof(PageHeader) - sizeof(RedwoodHeaderV1) - encodingHeaderSize(t);
@@ -378,6 +414,12 @@ public:
 		h->lastKnownLogicalPageID = invalidLogicalPageID;
 		h->lastKnownParentLogicalPageID = invalidLogicalPageID;
 		h->writeVersion = invalidVersion;
+
+		if (t == EncodingType::XXHash64Zstd) {
+			XXHashZstdEncoder::Header* eh = reinterpret_cast<XXHashZstdEncoder::Header*>(page->getEncodingHeader());
+			eh->payloadSize = payloadSize;
+			eh->compressedSize = 0;
+		}
 	}
 
 	// Get the logical page buffer as a StringRef
@@ -431,6 +473,36 @@ public:
 		}
 	}
 
+	// Get the number of blocks the page takes up on disk, where blocks have blockSize logical bytes in a buffer of
+	// physicalBlockSize bytes.  For compressing encodings this compresses the payload, and the compressed page is kept
+	// for the next takeDiskPage() call so the payload must not change in between.  compressTime, if given, is
+	// incremented by the seconds spent compressing.
+	int getDiskBlockCount(int blockSize, int physicalBlockSize, double* compressTime = nullptr) {
+		if (!isCompressed(page->encodingType)) {
+			return (logicalSize + blockSize - 1) / blockSize;
+		}
+		if (!diskPage) {
+			diskPage = compress(blockSize, physicalBlockSize, compressTime);
+		}
+		return diskPage->logicalSize / blockSize;
+	}
+
+	// Get the page to write to disk in place of this page, on which preWrite() must then be called.  For compressing
+	// encodings it is a new page made of this page's headers followed by the compressed payload, using as few blocks
+	// as it fits in, and otherwise it is this page.  This page stays uncompressed so that it can be cached.
+	Reference<ArenaPage> takeDiskPage(int blockSize, int physicalBlockSize, double* compressTime = nullptr) {
+		if (!isCompressed(page->encodingType)) {
+			return Reference<ArenaPage>::addRef(this);
+		}
+		Reference<ArenaPage> result = std::move(diskPage);
+		if (!result) {
+			result = compress(blockSize, physicalBlockSize, compressTime);
+		}
+		// The main header may have been updated since the payload was compressed
+		memcpy(result->buffer, buffer, page->encodingHeaderOffset);
+		return result;
+	}
+
 	// Must be called before writing to disk to update headers and encrypt page
 	// Pre:   Encoding-specific header fields are set if needed
 	//        Secret is set if needed
@@ -444,6 +516,8 @@ public:
 
 		if (page->encodingType == EncodingType::XXHash64) {
 			XXHashEncoder::encode(page->getEncodingHeader(), pPayload, payloadSize, pageID);
+		} else if (page->encodingType == EncodingType::XXHash64Zstd) {
+			XXHashZstdEncoder::encode(page->getEncodingHeader(), pPayload, payloadSize, pageID);
 		} else {
 			TraceEvent(SevWarnAlways, "InvalidPageEncoding").detail("EncodingType", page->encodingType);
 			throw page_encoding_not_supported();
@@ -485,10 +559,14 @@ public:
 	}
 
 	// Pre:   postReadHeader has been called, encoding-specific parameters (such as the encryption secret) have been set
-	// Post:  Payload has been verified and decrypted if necessary
-	void postReadPayload(PhysicalPageID pageID, double* decryptTime = nullptr) {
+	// Post:  Payload has been verified and decrypted or decompressed if necessary
+	// decodeTime, if given, is incremented by the seconds spent decompressing
+	void postReadPayload(PhysicalPageID pageID, double* decodeTime = nullptr) {
 		if (page->encodingType == EncodingType::XXHash64) {
 			XXHashEncoder::decode(page->getEncodingHeader(), pPayload, payloadSize, pageID);
+		} else if (page->encodingType == EncodingType::XXHash64Zstd) {
+			XXHashZstdEncoder::decode(page->getEncodingHeader(), pPayload, payloadSize, pageID);
+			decompress(decodeTime);
 		} else {
 			TraceEvent(SevWarnAlways, "InvalidPageEncoding").detail("EncodingType", page->encodingType);
 			throw page_encoding_not_supported();
@@ -500,7 +578,16 @@ public:
 	// Return pointer to encoding header.
 	const void* getEncodingHeader() const { return encodingHeaderAvailable ? page->getEncodingHeader() : nullptr; }
 
+	int getLogicalSize() const { return logicalSize; }
+
 private:
+	// Get a page of the fewest blocks which hold this page's headers followed by its compressed payload, or by its
+	// payload as is if it does not compress
+	Reference<ArenaPage> compress(int blockSize, int physicalBlockSize, double* compressTime) const;
+
+	// Replace the compressed payload read from disk with the decompressed payload in a new buffer
+	void decompress(double* decompressTime);
+
 	Arena arena;
 
 	// The logical size of the page, which can be smaller than bufferSize, which is only of
@@ -524,6 +611,9 @@ private:
 	uint8_t* pPayload;
 	int payloadSize;
 
+	// Compressed page computed by getDiskBlockCount() for the next takeDiskPage() call
+	Reference<ArenaPage> diskPage;
+
 public:
 	EncodingType getEncodingType() const { return page->encodingType; }
 
@@ -22,6 +22,7 @@
 #define FDBSERVER_LOGSYSTEM_H
 
 #include <cstdint>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -769,6 +770,21 @@ struct LengthPrefixedStringRef {
 // such as LogProtocolMessage or SpanContextMessage. The type of `Mutation` is
 // uniquely identified by its first byte -- a value from MutationRef::Type.
 //
+// The messages of a LogPushData whose copies into the per-location buffers were deferred. Each message is written
+// once into `staged`, and ranges[loc] lists, in order, the (offset, length) pieces of `staged` which make up the
+// messages of location loc. gather() may run on any thread, provided nothing else touches this object meanwhile.
+struct DeferredLogMessages {
+	BinaryWriter staged;
+	std::vector<std::vector<std::pair<int, int>>> ranges;
+	ProtocolVersion protocolVersion;
+
+	DeferredLogMessages(ProtocolVersion protocolVersion, int tlogCount)
+	  : staged(AssumeVersion(protocolVersion)), ranges(tlogCount), protocolVersion(protocolVersion) {}
+
+	// Returns the messages of every location, as LogPushData::getMessages() would have
+	std::vector<Standalone<StringRef>> gather();
+};
+
 struct LogPushData : NonCopyable {
 	// Log subsequences have to start at 1 (the MergedPeekCursor relies on this to make sure we never have !hasMessage()
 	// in the middle of data for a version
@@ -821,7 +837,21 @@ struct LogPushData : NonCopyable {
 	template <class T>
 	void writeTypedMessage(T const& item, bool metadataMessage = false, bool allLocations = false);
 
-	Standalone<StringRef> getMessages(int loc) const { return messagesWriter[loc].toValue(); }
+	Standalone<StringRef> getMessages(int loc) const {
+		if (gatheredMessages.present()) {
+			return gatheredMessages.get()[loc];
+		}
+		ASSERT(!deferred);
+		return messagesWriter[loc].toValue();
+	}
+
+	// Messages written from now on are serialized once into a staging buffer instead of being copied into the buffer
+	// of every location they go to. Those copies are made by gather() on the DeferredLogMessages returned by
+	// takeDeferredMessages(), whose result must be handed back with setGatheredMessages() before getMessages().
+	void deferMessageCopies();
+	bool hasDeferredMessages() const { return deferred != nullptr; }
+	std::unique_ptr<DeferredLogMessages> takeDeferredMessages();
+	void setGatheredMessages(std::vector<Standalone<StringRef>> messages);
 
 	// Returns all locations' messages, including empty ones.
 	std::vector<Standalone<StringRef>> getAllMessages() const;
@@ -862,6 +892,18 @@ private:
 	SpanContext spanContext;
 	bool logsChanged = false; // if keyServers has any changes, i.e., shard boundary modifications.
 
+	std::unique_ptr<DeferredLogMessages> deferred;
+	Optional<std::vector<Standalone<StringRef>>> gatheredMessages;
+	// The transaction info message most recently staged, which is the same for every location it goes to
+	uint32_t stagedTransactionInfoSubsequence = 0;
+	std::pair<int, int> stagedTransactionInfo;
+
+	// Returns the writer a new message for location loc is serialized into
+	BinaryWriter& writerFor(int loc) { return deferred ? deferred->staged : messagesWriter[loc]; }
+
+	// Appends bytes [offset, offset + length) of the staging buffer to the messages of location loc
+	void addDeferredRange(int loc, int offset, int length);
+
 	// Writes transaction info to the message stream at the given location if
 	// it has not already been written (for the current transaction). Returns
 	// true on a successful write, and false if the location has already been
@@ -917,9 +959,8 @@ void LogPushData::writeTypedMessage(T const& item, bool metadataMessage, bool al
 	bool first = true;
 	int firstOffset = -1, firstLength = -1;
 	for (int loc : msg_locations) {
-		BinaryWriter& wr = messagesWriter[loc];
-
 		if (first) {
+			BinaryWriter& wr = writerFor(loc);
 			firstOffset = wr.getLength();
 			wr << uint32_t(0) << subseq << uint16_t(prev_tags.size());
 			for (auto& tag : prev_tags)
@@ -931,9 +972,12 @@ void LogPushData::writeTypedMessage(T const& item, bool metadataMessage, bool al
 			    "ProxyPushLocations", invalidVersion, StringRef(((uint8_t*)wr.getData() + firstOffset), firstLength))
 			    .detail("PushLocations", msg_locations);
 			first = false;
-		} else {
+		} else if (!deferred) {
 			BinaryWriter& from = messagesWriter[msg_locations[0]];
-			wr.serializeBytes((uint8_t*)from.getData() + firstOffset, firstLength);
+			messagesWriter[loc].serializeBytes((uint8_t*)from.getData() + firstOffset, firstLength);
+		}
+		if (deferred) {
+			addDeferredRange(loc, firstOffset, firstLength);
 		}
 	}
 	written_tags.insert(next_message_tags.begin(), next_message_tags.end());
@@ -35,6 +35,7 @@
 #include "fdbserver/MasterInterface.h"
 #include "fdbserver/ResolverInterface.h"
 #include "flow/IRandom.h"
+#include "flow/IThreadPool.h"
 
 #include "flow/actorcompiler.h" // This must be the last #include.
 
@@ -131,7 +132,9 @@ struct ProxyStats {
 	    commitLatencySample("CommitLatencyMetrics",
 	                        id,
 	                        SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
-	                        SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	                        SERVER_KNOBS->LATENCY_SKETCH_ACCURACY,
+	                        /*skipTraceOnSilentInterval=*/false,
+	                        /*logLinearHistogram=*/true),
 	    commitLatencyBands("CommitLatencyBands", id, SERVER_KNOBS->STORAGE_LOGGING_DELAY),
 	    commitBatchingEmptyMessageRatio("CommitBatchingEmptyMessageRatio",
 	                                    id,
@@ -215,6 +218,10 @@ struct ProxyCommitData {
 	int64_t localCommitBatchesStarted;
 	NotifiedVersion latestLocalCommitBatchResolving;
 	NotifiedVersion latestLocalCommitBatchLogging;
+	// With PROXY_PIPELINE_MESSAGE_COPIES, the thread which copies each batch's messages into the buffers of their
+	// TLogs, and the push of the latest batch handed to it. Pushes happen in batch order, after the copies.
+	Reference<IThreadPool> messageCopyThread;
+	Future<Void> lastPipelinedPush = Void();
 
 	PublicRequestStream<GetReadVersionRequest> getConsistentReadVersion;
 	PublicRequestStream<CommitTransactionRequest> commit;
@@ -204,8 +204,43 @@ struct TLogPeekReply {
 	Optional<Version> begin;
 	bool onlySpilled = false;
 
+	// Not serialized. When non-empty, the reply's messages are the concatenation of these segments rather than
+	// `messages`, which lets the TLog hand out message bytes it already holds without copying them into one buffer.
+	// The segments are copied straight into the outgoing packet when the reply is serialized; a reply delivered
+	// within the process must be flattened first.
+	VectorRef<StringRef> messageSegments;
+	int messageSegmentBytes = 0;
+
+	int messageBytes() const { return messageSegments.empty() ? messages.size() : messageSegmentBytes; }
+
+	// Copies any message segments into `messages`
+	void flattenMessages() {
+		if (messageSegments.empty()) {
+			return;
+		}
+		uint8_t* out = new (arena) uint8_t[messageSegmentBytes];
+		messages = StringRef(out, messageSegmentBytes);
+		for (const auto& segment : messageSegments) {
+			out = std::copy(segment.begin(), segment.end(), out);
+		}
+		messageSegments = VectorRef<StringRef>();
+		messageSegmentBytes = 0;
+	}
+
 	template <class Ar>
 	void serialize(Ar& ar) {
+		if constexpr (Ar::isSerializing) {
+			if (!messageSegments.empty()) {
+				if constexpr (is_fb_function<Ar>) {
+					GatheredStringRef gathered(messageSegments, messageSegmentBytes);
+					serializer(
+					    ar, gathered, end, popped, maxKnownVersion, minKnownCommittedVersion, begin, onlySpilled, arena);
+					return;
+				} else {
+					flattenMessages();
+				}
+			}
+		}
 		serializer(ar, messages, end, popped, maxKnownVersion, minKnownCommittedVersion, begin, onlySpilled, arena);
 	}
 };
@@ -246,7 +281,7 @@ struct TLogPeekStreamReply : public ReplyPromiseStreamReply {
 	TLogPeekStreamReply() = default;
 	explicit TLogPeekStreamReply(const TLogPeekReply& rep) : rep(rep) {}
 
-	int expectedSize() const { return rep.messages.expectedSize() + sizeof(TLogPeekStreamReply); }
+	int expectedSize() const { return rep.messageBytes() + sizeof(TLogPeekStreamReply); }
 
 	template <class Ar>
 	void serialize(Ar& ar) {
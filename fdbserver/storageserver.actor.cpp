@@ -22,6 +22,8 @@
 #include <functional>
 #include <iterator>
 #include <limits>
+#include <list>
+#include <map>
 #include <memory>
 #include <type_traits>
 #include <unordered_map>
@@ -65,6 +67,7 @@
 #include "fdbclient/SystemData.h"
 #include "fdbclient/TransactionLineage.h"
 #include "fdbclient/Tuple.h"
+#include "fdbclient/VersionedArtMap.h"
 #include "fdbclient/VersionedMap.h"
 #include "fdbrpc/sim_validation.h"
 #include "fdbrpc/Smoother.h"
@@ -145,6 +148,10 @@ bool canReplyWith(Error e) {
 	case error_code_process_behind:
 	case error_code_watch_cancelled:
 	case error_code_server_overloaded:
+	case error_code_inverted_range:
+	case error_code_unknown_change_feed:
+	case error_code_change_feed_popped:
+	case error_code_operation_obsolete:
 	// getMappedRange related exceptions that are not retriable:
 	case error_code_mapper_bad_index:
 	case error_code_mapper_no_such_key:
@@ -242,6 +249,56 @@ inline uint16_t decodePersistAccumulativeChecksumKey(const Key& key) {
 	return bigEndian16(acsIndex);
 }
 
+// Change feed related prefixes. The metadata key of a feed holds its range, emptyVersion, stopVersion and moved in
+// ranges; its data keys hold one MutationsAndVersionRef each, ordered by version.
+static const KeyRangeRef persistChangeFeedKeys =
+    KeyRangeRef(PERSIST_PREFIX "ChangeFeed/"_sr, PERSIST_PREFIX "ChangeFeed0"_sr);
+static const KeyRangeRef persistChangeFeedDataKeys =
+    KeyRangeRef(PERSIST_PREFIX "ChangeFeedData/"_sr, PERSIST_PREFIX "ChangeFeedData0"_sr);
+
+inline Key persistChangeFeedDataKey(KeyRef feedID, Version version) {
+	BinaryWriter wr(Unversioned());
+	wr.serializeBytes(persistChangeFeedDataKeys.begin);
+	wr << feedID;
+	wr << bigEndian64(version);
+	return wr.toValue();
+}
+
+inline Version decodePersistChangeFeedDataKeyVersion(KeyRef key) {
+	Version version;
+	BinaryReader rd(key.substr(key.size() - sizeof(Version)), Unversioned());
+	rd >> version;
+	return bigEndian64(version);
+}
+
+inline KeyRange persistChangeFeedDataRange(KeyRef feedID) {
+	return KeyRangeRef(persistChangeFeedDataKey(feedID, 0), persistChangeFeedDataKey(feedID, MAX_VERSION));
+}
+
+// Parts of a change feed's range which were moved to a storage server, each with the first version captured for it
+using ChangeFeedMovedIn = std::vector<std::pair<KeyRange, Version>>;
+
+inline Value persistChangeFeedValue(KeyRangeRef const& range,
+                                    Version emptyVersion,
+                                    Version stopVersion,
+                                    ChangeFeedMovedIn const& movedIn) {
+	BinaryWriter wr(IncludeVersion());
+	wr << range << emptyVersion << stopVersion << movedIn;
+	return wr.toValue();
+}
+
+inline std::tuple<KeyRange, Version, Version, ChangeFeedMovedIn> decodePersistChangeFeedValue(ValueRef const& value) {
+	KeyRange range;
+	Version emptyVersion, stopVersion;
+	ChangeFeedMovedIn movedIn;
+	BinaryReader rd(value, IncludeVersion());
+	rd >> range >> emptyVersion >> stopVersion;
+	if (!rd.empty()) {
+		rd >> movedIn;
+	}
+	return std::make_tuple(range, emptyVersion, stopVersion, movedIn);
+}
+
 // MoveInUpdates caches new updates of a move-in shard, before that shard is ready to accept writes.
 struct MoveInUpdates {
 	MoveInUpdates() : spilled(MoveInUpdatesSpilled::False) {}
@@ -298,7 +355,7 @@ ACTOR Future<Void> MoveInUpdates::loadUpdates(MoveInUpdates* self, Version begin
 	for (int i = 0; i < res.size(); ++i) {
 		const Version version = decodePersistUpdateVersion(res[i].key.removePrefix(self->range.begin));
 		Standalone<VerUpdateRef> vur =
-		    BinaryReader::fromStringRef<Standalone<VerUpdateRef>>(res[i].value, IncludeVersion());
+		    ArenaReader::fromStringRef<Standalone<VerUpdateRef>>(res.arena(), res[i].value, IncludeVersion());
 		ASSERT(version == vur.version);
 		TraceEvent(self->logSev, "MoveInUpdatesLoadedMutations", self->id)
 		    .detail("Version", version)
@@ -603,8 +660,127 @@ public:
 	}
 };
 
+// A bounded LRU cache of values read from the storage engine by point reads, keyed by key. Entries hold exactly
+// what the engine would return, including absent values, so every write to the engine must invalidate the keys it
+// touches. A read which completes after any invalidation since it started is not inserted, as it may have raced
+// with the write.
+//
+// Some engines keep serving the last committed data until a commit completes, so a read which starts between a
+// write and the end of its commit can cache the old value.  Written keys are therefore invalidated again once their
+// commit completes: startCommit() takes the writes since the previous commit, and commitCompleted() invalidates them.
+class StorageRowCache {
+public:
+	explicit StorageRowCache(int64_t capacity) : capacity(capacity) {}
+
+	bool enabled() const { return capacity > 0; }
+
+	// Returns the cached value for key, which may itself be absent, or an empty Optional on a miss
+	Optional<Optional<Value>> get(KeyRef key) {
+		auto it = entries.find(key);
+		if (it == entries.end()) {
+			return Optional<Optional<Value>>();
+		}
+		lru.splice(lru.end(), lru, it->second.lruPosition);
+		return it->second.value;
+	}
+
+	// Must be sampled before a read is started and passed to insert() with its result
+	uint64_t generation() const { return invalidations; }
+
+	void insert(KeyRef key, const Optional<Value>& value, uint64_t readGeneration) {
+		int64_t size = entryOverhead + key.size() + value.expectedSize();
+		if (!enabled() || readGeneration != invalidations || size > capacity) {
+			return;
+		}
+
+		auto it = entries.find(key);
+		if (it == entries.end()) {
+			it = entries.emplace(Key(key), Entry()).first;
+		} else {
+			bytes -= it->second.bytes;
+			lru.erase(it->second.lruPosition);
+		}
+		// Copy the value so the entry does not hold on to the engine's read arena
+		it->second.value = value.present() ? Optional<Value>(Value(value.get().contents())) : Optional<Value>();
+		it->second.bytes = size;
+		it->second.lruPosition = lru.insert(lru.end(), it->first);
+		bytes += size;
+
+		while (bytes > capacity) {
+			erase(entries.find(lru.front()));
+		}
+	}
+
+	void invalidate(KeyRangeRef range) {
+		++invalidations;
+		if (enabled()) {
+			uncommitted.push_back_deep(uncommitted.arena(), range);
+		}
+		erase(range);
+	}
+
+	void invalidate(KeyRef key) {
+		++invalidations;
+		if (enabled()) {
+			uncommitted.push_back(uncommitted.arena(), singleKeyRange(key, uncommitted.arena()));
+		}
+		auto it = entries.find(key);
+		if (it != entries.end()) {
+			erase(it);
+		}
+	}
+
+	// Returns the ranges written since the previous call, which must be passed to commitCompleted() once the commit
+	// started after this call has completed
+	Standalone<VectorRef<KeyRangeRef>> startCommit() { return std::exchange(uncommitted, {}); }
+
+	void commitCompleted(Standalone<VectorRef<KeyRangeRef>> const& written) {
+		++invalidations;
+		for (auto& range : written) {
+			erase(range);
+		}
+	}
+
+	int64_t getBytes() const { return bytes; }
+	int64_t getCount() const { return entries.size(); }
+
+private:
+	// Approximate memory used by the map and list nodes of an entry
+	static constexpr int entryOverhead = 128;
+
+	struct Entry {
+		Optional<Value> value;
+		int64_t bytes = 0;
+		std::list<KeyRef>::iterator lruPosition;
+	};
+	using EntryMap = std::map<Key, Entry, std::less<>>;
+
+	void erase(EntryMap::iterator it) {
+		bytes -= it->second.bytes;
+		lru.erase(it->second.lruPosition);
+		entries.erase(it);
+	}
+
+	void erase(KeyRangeRef range) {
+		auto it = entries.lower_bound(range.begin);
+		while (it != entries.end() && it->first < range.end) {
+			erase(it++);
+		}
+	}
+
+	int64_t capacity;
+	int64_t bytes = 0;
+	uint64_t invalidations = 0;
+	EntryMap entries;
+	// Least recently used first, referencing the keys owned by entries
+	std::list<KeyRef> lru;
+	// Ranges written since the last startCommit()
+	Standalone<VectorRef<KeyRangeRef>> uncommitted;
+};
+
 struct StorageServerDisk {
-	explicit StorageServerDisk(struct StorageServer* data, IKeyValueStore* storage) : data(data), storage(storage) {}
+	explicit StorageServerDisk(struct StorageServer* data, IKeyValueStore* storage)
+	  : data(data), storage(storage), rowCache(SERVER_KNOBS->STORAGE_ROW_CACHE_BYTES) {}
 
 	IKeyValueStore* getKeyValueStore() const { return this->storage; }
 
@@ -637,6 +813,7 @@ struct StorageServerDisk {
 	void markRangeAsActive(KeyRangeRef range) { storage->markRangeAsActive(range); }
 
 	Future<Void> replaceRange(KeyRange range, Standalone<VectorRef<KeyValueRef>> data) {
+		rowCache.invalidate(range);
 		return storage->replaceRange(range, data);
 	}
 
@@ -647,7 +824,12 @@ struct StorageServerDisk {
 	Future<Void> getError() { return storage->getError(); }
 	Future<Void> init() { return storage->init(); }
 	Future<Void> canCommit() { return storage->canCommit(); }
-	Future<Void> commit() { return storage->commit(); }
+	Future<Void> commit() {
+		if (rowCache.enabled()) {
+			return commitAndInvalidate(this);
+		}
+		return storage->commit();
+	}
 
 	void logRecentRocksDBBackgroundWorkStats(UID ssId, std::string logReason) {
 		return storage->logRecentRocksDBBackgroundWorkStats(ssId, logReason);
@@ -664,9 +846,24 @@ struct StorageServerDisk {
 		return readFirstKey(storage, KeyRangeRef(key, allKeys.end), options);
 	}
 	Future<Optional<Value>> readValue(KeyRef key, Optional<ReadOptions> options = Optional<ReadOptions>()) {
+		if (rowCache.enabled()) {
+			Optional<Optional<Value>> cached = rowCache.get(key);
+			if (cached.present()) {
+				++(*rowCacheHits);
+				return cached.get();
+			}
+			++(*rowCacheMisses);
+			++(*kvGets);
+			return readValueAndCache(this, key, options);
+		}
 		++(*kvGets);
 		return storage->readValue(key, options);
 	}
+	Future<std::vector<Optional<Value>>> readValues(Standalone<VectorRef<KeyRef>> keys,
+	                                                Optional<ReadOptions> options = Optional<ReadOptions>()) {
+		(*kvGets) += keys.size();
+		return storage->readValues(keys, options);
+	}
 	Future<Optional<Value>> readValuePrefix(KeyRef key,
 	                                        int maxLength,
 	                                        Optional<ReadOptions> options = Optional<ReadOptions>()) {
@@ -699,6 +896,10 @@ struct StorageServerDisk {
 	StorageBytes getStorageBytes() const { return storage->getStorageBytes(); }
 	std::tuple<size_t, size_t, size_t> getSize() const { return storage->getSize(); }
 
+	// Must be called for any change to the engine's contents which does not go through this interface
+	void invalidateRowCache(KeyRangeRef keys) { rowCache.invalidate(keys); }
+	const StorageRowCache& getRowCache() const { return rowCache; }
+
 	// The following are pointers to the Counters in StorageServer::counters of the same names.
 	Counter* kvCommitLogicalBytes;
 	Counter* kvClearRanges;
@@ -706,13 +907,34 @@ struct StorageServerDisk {
 	Counter* kvGets;
 	Counter* kvScans;
 	Counter* kvCommits;
+	Counter* rowCacheHits;
+	Counter* rowCacheMisses;
 
 private:
 	struct StorageServer* data;
 	IKeyValueStore* storage;
+	StorageRowCache rowCache;
 	void writeMutations(const VectorRef<MutationRef>& mutations, Version debugVersion, const char* debugContext);
 	void writeMutationsBuggy(const VectorRef<MutationRef>& mutations, Version debugVersion, const char* debugContext);
 
+	ACTOR static Future<Void> commitAndInvalidate(StorageServerDisk* self) {
+		state Standalone<VectorRef<KeyRangeRef>> written = self->rowCache.startCommit();
+		wait(self->storage->commit());
+		self->rowCache.commitCompleted(written);
+		return Void();
+	}
+
+	ACTOR static Future<Optional<Value>> readValueAndCache(StorageServerDisk* self,
+	                                                       Key key,
+	                                                       Optional<ReadOptions> options) {
+		state uint64_t generation = self->rowCache.generation();
+		Optional<Value> value = wait(self->storage->readValue(key, options));
+		if (!options.present() || options.get().cacheResult) {
+			self->rowCache.insert(key, value, generation);
+		}
+		return value;
+	}
+
 	ACTOR static Future<Key> readFirstKey(IKeyValueStore* storage, KeyRangeRef range, Optional<ReadOptions> options) {
 		RangeResult r = wait(storage->readRange(range, 1, 1 << 30, options));
 		if (r.size())
@@ -731,14 +953,31 @@ struct UpdateEagerReadInfo {
 
 	Arena arena;
 	bool enableClearRangeEagerReads;
+	// If set, atomic ops on keys whose value is already known from the latest version of this data are not read from
+	// storage.  This relies on update() holding the durableVersionLock from the eager reads until the mutations have
+	// been applied, so that such keys can only stay known (see convertAtomicOp()).
+	AnyVersionedMap<ValueOrClearToRef> const* knownData;
+	int skippedKeys = 0;
 
-	UpdateEagerReadInfo(bool enableClearRangeEagerReads) : enableClearRangeEagerReads(enableClearRangeEagerReads) {}
+	UpdateEagerReadInfo(bool enableClearRangeEagerReads,
+	                    AnyVersionedMap<ValueOrClearToRef> const* knownData = nullptr)
+	  : enableClearRangeEagerReads(enableClearRangeEagerReads), knownData(knownData) {}
 
 	void addMutations(VectorRef<MutationRef> const& mutations) {
 		for (auto& m : mutations)
 			addMutation(m);
 	}
 
+	// Returns true if the latest version of knownData has a value for key or a clear containing it
+	bool isKnown(KeyRef key) const {
+		if (knownData == nullptr) {
+			return false;
+		}
+		auto it = knownData->atLatest().lastLessOrEqual(key);
+		return it != knownData->atLatest().end() &&
+		       ((it->isValue() && it.key() == key) || (it->isClearTo() && it->getEndKey() > key));
+	}
+
 	void addMutation(MutationRef const& m) {
 		// SOMEDAY: Theoretically we can avoid a read if there is an earlier overlapping ClearRange
 		if (m.type == MutationRef::ClearRange && !m.param2.startsWith(systemKeys.end) && enableClearRangeEagerReads)
@@ -746,7 +985,9 @@ struct UpdateEagerReadInfo {
 		else if (m.type == MutationRef::CompareAndClear) {
 			if (enableClearRangeEagerReads)
 				keyBegin.push_back(keyAfter(m.param1, arena));
-			if (keys.size() > 0 && keys.back().first == m.param1) {
+			if (isKnown(m.param1)) {
+				++skippedKeys;
+			} else if (keys.size() > 0 && keys.back().first == m.param1) {
 				// Don't issue a second read, if the last read was equal to the current key.
 				// CompareAndClear is likely to be used after another atomic operation on same key.
 				keys.back().second = std::max(keys.back().second, m.param2.size() + 1);
@@ -754,10 +995,17 @@ struct UpdateEagerReadInfo {
 				keys.emplace_back(m.param1, m.param2.size() + 1);
 			}
 		} else if ((m.type == MutationRef::AppendIfFits) || (m.type == MutationRef::ByteMin) ||
-		           (m.type == MutationRef::ByteMax))
-			keys.emplace_back(m.param1, CLIENT_KNOBS->VALUE_SIZE_LIMIT);
-		else if (isAtomicOp((MutationRef::Type)m.type))
-			keys.emplace_back(m.param1, m.param2.size());
+		           (m.type == MutationRef::ByteMax)) {
+			if (isKnown(m.param1))
+				++skippedKeys;
+			else
+				keys.emplace_back(m.param1, CLIENT_KNOBS->VALUE_SIZE_LIMIT);
+		} else if (isAtomicOp((MutationRef::Type)m.type)) {
+			if (isKnown(m.param1))
+				++skippedKeys;
+			else
+				keys.emplace_back(m.param1, m.param2.size());
+		}
 	}
 
 	void finishKeyBegin() {
@@ -777,7 +1025,8 @@ struct UpdateEagerReadInfo {
 		// value gets populated in doEagerReads
 	}
 
-	Optional<Value>& getValue(KeyRef key) {
+	// Returns the value read for key, or nullptr if its read was skipped
+	Optional<Value>* findValue(KeyRef key) {
 		int i = std::lower_bound(keys.begin(),
 		                         keys.end(),
 		                         std::pair<KeyRef, int>(key, 0),
@@ -785,8 +1034,17 @@ struct UpdateEagerReadInfo {
 			                         return lhs.first < rhs.first;
 		                         }) -
 		        keys.begin();
-		ASSERT(i < keys.size() && keys[i].first == key);
-		return value[i];
+		if (i < keys.size() && keys[i].first == key) {
+			return &value[i];
+		}
+		ASSERT(knownData != nullptr);
+		return nullptr;
+	}
+
+	Optional<Value>& getValue(KeyRef key) {
+		Optional<Value>* v = findValue(key);
+		ASSERT(v != nullptr);
+		return *v;
 	}
 
 	KeyRef getKeyEnd(KeyRef key) {
@@ -848,8 +1106,47 @@ private:
 	int ongoingTasks = 0;
 };
 
+// A change feed registered on this storage server. Mutations to the feed's range are captured as they are applied,
+// held in memory until they are durable and then read back from persistChangeFeedDataKeys.
+struct ChangeFeedInfo : ReferenceCounted<ChangeFeedInfo> {
+	Key id;
+	KeyRange range;
+	Version emptyVersion = 0; // Mutations before this version have been popped or were never captured here
+	// Reads of a moved in part of the range from before its version are answered with change_feed_popped
+	ChangeFeedMovedIn movedIn;
+	Version stopVersion = MAX_VERSION; // No mutations are captured at or after this version
+	Version durableVersion = invalidVersion; // Mutations up to this version are readable from storage
+	Version storageVersion = invalidVersion; // Mutations up to this version have been written to the mutation log
+	std::deque<Standalone<MutationsAndVersionRef>> mutations; // Not yet durable, ordered by version
+	bool pendingPersist = false; // The metadata has changed since it was last written to the mutation log
+	bool removing = false;
+
+	// Returns the first version whose mutations to every key of keys were captured here
+	Version emptyVersionFor(KeyRangeRef keys) const {
+		Version version = emptyVersion;
+		for (auto& [movedRange, movedVersion] : movedIn) {
+			if (movedRange.intersects(keys)) {
+				version = std::max(version, movedVersion);
+			}
+		}
+		return version;
+	}
+
+	// Trims the in-memory mutations after everything up to version has been made durable, returning how many
+	// mutations were trimmed
+	int64_t durable(Version version) {
+		int64_t count = 0;
+		while (!mutations.empty() && mutations.front().version <= version) {
+			count += mutations.front().mutations.size();
+			mutations.pop_front();
+		}
+		durableVersion = std::max(durableVersion, version);
+		return count;
+	}
+};
+
 struct StorageServer : public IStorageMetricsService {
-	typedef VersionedMap<KeyRef, ValueOrClearToRef> VersionedData;
+	typedef AnyVersionedMap<ValueOrClearToRef> VersionedData;
 
 private:
 	// versionedData contains sets and clears.
@@ -905,6 +1202,9 @@ public:
 	std::map<Version, std::vector<CheckpointMetaData>> pendingCheckpoints; // Pending checkpoint requests
 	std::unordered_map<UID, CheckpointMetaData> checkpoints; // Existing and deleting checkpoints
 	std::unordered_map<UID, ICheckpointReader*> liveCheckpointReaders; // Active checkpoint readers
+	// Reads which the client may abandon once another replica has answered, by the token of their reply endpoint. The
+	// flag is set by a CancelReadRequest, and checked by the read before it goes to disk and before it replies.
+	std::unordered_map<UID, bool> cancellableReads;
 	std::map<Version, std::vector<PendingNewShard>>
 	    pendingAddRanges; // Pending requests to add ranges to physical shards
 	std::map<Version, std::vector<KeyRange>>
@@ -1229,6 +1529,14 @@ public:
 
 	std::unordered_map<UID, std::shared_ptr<MoveInShard>> moveInShards;
 
+	std::map<Key, Reference<ChangeFeedInfo>> uidChangeFeed;
+	KeyRangeMap<std::vector<Reference<ChangeFeedInfo>>> keyChangeFeed;
+	// Feeds which captured mutations in the versions being applied by the current update()
+	std::vector<Reference<ChangeFeedInfo>> currentChangeFeeds;
+	// Versions at which feeds this server did not know about were destroyed, so that fetchKeys does not register a
+	// feed again from a read at an older version. Pruned once no fetch could read at those versions.
+	std::map<Key, Version> destroyedChangeFeeds;
+
 	Reference<PriorityMultiLock> ssLock;
 	std::vector<int> readPriorityRanks;
 
@@ -1274,8 +1582,8 @@ public:
 
 	struct Counters : CommonStorageCounters {
 
-		Counter allQueries, systemKeyQueries, getKeyQueries, getValueQueries, getRangeQueries, getRangeSystemKeyQueries,
-		    getRangeStreamQueries, lowPriorityQueries, rowsQueried, watchQueries, emptyQueries;
+		Counter allQueries, systemKeyQueries, getKeyQueries, getValueQueries, getValuesQueries, getRangeQueries,
+		    getRangeSystemKeyQueries, getRangeStreamQueries, lowPriorityQueries, rowsQueried, watchQueries, emptyQueries;
 
 		// counters related to getMappedRange queries
 		Counter getMappedRangeBytesQueried, finishedGetMappedRangeSecondaryQueries, getMappedRangeQueries,
@@ -1312,6 +1620,9 @@ public:
 		Counter loops;
 		Counter fetchWaitingMS, fetchWaitingCount, fetchExecutingMS, fetchExecutingCount;
 		Counter readsRejected;
+		// Reads abandoned because the client got its answer from another replica, before reading from the storage
+		// engine or after reading but before sending the reply.
+		Counter readsCancelledBeforeIO, readsCancelledAfterIO;
 		Counter wrongShardServer;
 		Counter fetchedVersions;
 		Counter fetchesFromLogs;
@@ -1326,8 +1637,12 @@ public:
 		Counter kvGetBytes;
 		// The number of keys read from storage engine by eagerReads.
 		Counter eagerReadsKeys;
+		// The number of atomic ops whose eager read was skipped because the old value was in versioned data.
+		Counter eagerReadsSkipped;
 		// The count of readValue operation to the storage engine.
 		Counter kvGets;
+		// The count of readValue operations answered by, or missing, the storage server's row cache.
+		Counter rowCacheHits, rowCacheMisses;
 		// The count of readValue operation to the storage engine.
 		Counter kvScans;
 		// The count of commit operation to the storage engine.
@@ -1355,7 +1670,8 @@ public:
 		explicit Counters(StorageServer* self)
 		  : CommonStorageCounters("StorageServer", self->thisServerID.toString(), &self->metrics),
 		    allQueries("QueryQueue", cc), systemKeyQueries("SystemKeyQueries", cc), getKeyQueries("GetKeyQueries", cc),
-		    getValueQueries("GetValueQueries", cc), getRangeQueries("GetRangeQueries", cc),
+		    getValueQueries("GetValueQueries", cc), getValuesQueries("GetValuesQueries", cc),
+		    getRangeQueries("GetRangeQueries", cc),
 		    getRangeSystemKeyQueries("GetRangeSystemKeyQueries", cc),
 		    getMappedRangeQueries("GetMappedRangeQueries", cc), getRangeStreamQueries("GetRangeStreamQueries", cc),
 		    lowPriorityQueries("LowPriorityQueries", cc), rowsQueried("RowsQueried", cc),
@@ -1370,12 +1686,15 @@ public:
 		    updateVersions("UpdateVersions", cc), loops("Loops", cc), fetchWaitingMS("FetchWaitingMS", cc),
 		    fetchWaitingCount("FetchWaitingCount", cc), fetchExecutingMS("FetchExecutingMS", cc),
 		    fetchExecutingCount("FetchExecutingCount", cc), readsRejected("ReadsRejected", cc),
+		    readsCancelledBeforeIO("ReadsCancelledBeforeIO", cc), readsCancelledAfterIO("ReadsCancelledAfterIO", cc),
 		    wrongShardServer("WrongShardServer", cc), fetchedVersions("FetchedVersions", cc),
 		    fetchesFromLogs("FetchesFromLogs", cc), quickGetValueHit("QuickGetValueHit", cc),
 		    quickGetValueMiss("QuickGetValueMiss", cc), quickGetKeyValuesHit("QuickGetKeyValuesHit", cc),
 		    quickGetKeyValuesMiss("QuickGetKeyValuesMiss", cc), kvScanBytes("KVScanBytes", cc),
-		    kvGetBytes("KVGetBytes", cc), eagerReadsKeys("EagerReadsKeys", cc), kvGets("KVGets", cc),
-		    kvScans("KVScans", cc), kvCommits("KVCommits", cc), changeFeedDiskReads("ChangeFeedDiskReads", cc),
+		    kvGetBytes("KVGetBytes", cc), eagerReadsKeys("EagerReadsKeys", cc),
+		    eagerReadsSkipped("EagerReadsSkipped", cc), kvGets("KVGets", cc),
+		    rowCacheHits("RowCacheHits", cc), rowCacheMisses("RowCacheMisses", cc), kvScans("KVScans", cc),
+		    kvCommits("KVCommits", cc), changeFeedDiskReads("ChangeFeedDiskReads", cc),
 		    getMappedRangeBytesQueried("GetMappedRangeBytesQueried", cc),
 		    finishedGetMappedRangeQueries("FinishedGetMappedRangeQueries", cc),
 		    finishedGetMappedRangeSecondaryQueries("FinishedGetMappedRangeSecondaryQueries", cc),
@@ -1425,6 +1744,8 @@ public:
 			specialCounter(cc, "KvstoreSizeTotal", [self]() { return std::get<0>(self->storage.getSize()); });
 			specialCounter(cc, "KvstoreNodeTotal", [self]() { return std::get<1>(self->storage.getSize()); });
 			specialCounter(cc, "KvstoreInlineKey", [self]() { return std::get<2>(self->storage.getSize()); });
+			specialCounter(cc, "RowCacheBytes", [self]() { return self->storage.getRowCache().getBytes(); });
+			specialCounter(cc, "RowCacheEntries", [self]() { return self->storage.getRowCache().getCount(); });
 		}
 	} counters;
 
@@ -1440,7 +1761,7 @@ public:
 	StorageServer(IKeyValueStore* storage,
 	              Reference<AsyncVar<ServerDBInfo> const> const& db,
 	              StorageServerInterface const& ssi)
-	  : shardAware(false), locality(ssi.locality),
+	  : versionedData(SERVER_KNOBS->STORAGE_VERSIONED_DATA_ART), shardAware(false), locality(ssi.locality),
 	    tlogCursorReadsLatencyHistogram(Histogram::getHistogram(STORAGESERVER_HISTOGRAM_GROUP,
 	                                                            TLOG_CURSOR_READS_LATENCY_HISTOGRAM,
 	                                                            Histogram::Unit::milliseconds)),
@@ -1527,6 +1848,8 @@ public:
 		this->storage.kvGets = &counters.kvGets;
 		this->storage.kvScans = &counters.kvScans;
 		this->storage.kvCommits = &counters.kvCommits;
+		this->storage.rowCacheHits = &counters.rowCacheHits;
+		this->storage.rowCacheMisses = &counters.rowCacheMisses;
 	}
 
 	//~StorageServer() { fclose(log); }
@@ -1537,6 +1860,8 @@ public:
 	void addShard(ShardInfo* newShard) {
 		ASSERT(!newShard->range().empty());
 		newShard->setChangeCounter(++shardChangeCounter);
+		// Shard transitions can change the engine's contents outside of StorageServerDisk, e.g. by ingesting files
+		storage.invalidateRowCache(newShard->range());
 		// TraceEvent("AddShard", this->thisServerID).detail("KeyBegin", newShard->keys.begin).detail("KeyEnd", newShard->keys.end).detail("State",newShard->isReadable() ? "Readable" : newShard->notAssigned() ? "NotAssigned" : "Adding").detail("Version", this->version.get());
 		/*auto affected = shards.getAffectedRangesAfterInsertion( newShard->keys, Reference<ShardInfo>() );
 		for(auto i = affected.begin(); i != affected.end(); ++i)
@@ -1564,6 +1889,7 @@ public:
 	                 MutationRef const& mutation,
 	                 KeyRangeRef const& shard,
 	                 UpdateEagerReadInfo* eagerReads);
+	void addChangeFeedMutation(Version version, MutationRef const& mutation);
 	void setInitialVersion(Version ver) {
 		version = ver;
 		desiredOldestVersion = ver;
@@ -1782,6 +2108,32 @@ public:
 	}
 };
 
+// Registers a read from another process in StorageServer::cancellableReads for as long as it runs. Reads made within
+// this process are not registered, so that their reply promises do not become endpoints.
+class CancellableRead : NonCopyable {
+public:
+	template <class Reply>
+	CancellableRead(StorageServer* data, ReplyPromise<Reply> const& reply) : data(data), cancelledFlag(nullptr) {
+		if (reply.isRemoteEndpoint()) {
+			replyToken = reply.getEndpoint().token;
+			auto result = data->cancellableReads.emplace(replyToken, false);
+			if (result.second)
+				cancelledFlag = &result.first->second;
+		}
+	}
+	~CancellableRead() {
+		if (cancelledFlag)
+			data->cancellableReads.erase(replyToken);
+	}
+
+	bool cancelled() const { return cancelledFlag && *cancelledFlag; }
+
+private:
+	StorageServer* data;
+	UID replyToken;
+	bool* cancelledFlag;
+};
+
 const StringRef StorageServer::CurrentRunningFetchKeys::emptyString = ""_sr;
 const KeyRangeRef StorageServer::CurrentRunningFetchKeys::emptyKeyRange =
     KeyRangeRef(StorageServer::CurrentRunningFetchKeys::emptyString,
@@ -2175,6 +2527,7 @@ std::shared_ptr<MoveInShard> StorageServer::getMoveInShard(const UID& dataMoveId
 
 ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 	state int64_t resultSize = 0;
+	state CancellableRead cancellation(data, req.reply);
 	Span span("SS:getValue"_loc, req.spanContext);
 	// Temporarily disabled -- this path is hit a lot
 	// getCurrentLineage()->modify(&TransactionLineage::txID) = req.spanContext.first();
@@ -2214,6 +2567,11 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 			                      req.options.get().debugID.get().first(),
 			                      "getValueQ.AfterVersion"); //.detail("TaskID", g_network->getCurrentTask());
 
+		if (cancellation.cancelled()) {
+			++data->counters.readsCancelledBeforeIO;
+			throw operation_obsolete();
+		}
+
 		state uint64_t changeCounter = data->shardChangeCounter;
 
 		if (!data->shards[req.key]->isReadable()) {
@@ -2237,6 +2595,11 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 			}
 			data->checkChangeCounter(changeCounter, req.key);
 			v = vv;
+
+			if (cancellation.cancelled()) {
+				++data->counters.readsCancelledAfterIO;
+				throw operation_obsolete();
+			}
 		}
 
 		DEBUG_MUTATION("ShardGetValue",
@@ -2312,6 +2675,134 @@ ACTOR Future<Void> getValueQ(StorageServer* data, GetValueRequest req) {
 	return Void();
 }
 
+// Point reads of a sorted batch of keys. Keys which the versioned data in memory does not answer are read from the
+// storage engine with a single readValues() call, so engines can share work across neighbouring keys.
+ACTOR Future<Void> getValuesQ(StorageServer* data, GetValuesRequest req) {
+	state int64_t resultSize = 0;
+	state int64_t keySize = 0;
+	Span span("SS:getValues"_loc, req.spanContext);
+
+	try {
+		++data->counters.getValuesQueries;
+		++data->counters.allQueries;
+		if (!req.keys.empty() && req.keys.back().startsWith(systemKeys.begin)) {
+			++data->counters.systemKeyQueries;
+		}
+		data->maxQueryQueue = std::max<int>(
+		    data->maxQueryQueue, data->counters.allQueries.getValue() - data->counters.finishedQueries.getValue());
+
+		// Active load balancing runs at a very high priority (to obtain accurate queue lengths)
+		// so we need to downgrade here
+		wait(data->getQueryDelay());
+		state PriorityMultiLock::Lock readLock = wait(data->getReadLock(req.options));
+
+		// Track time from requestTime through now as read queueing wait time
+		state double queueWaitEnd = g_network->timer();
+		data->counters.readLatencySamples.sample(
+		    queueWaitEnd - req.requestTime(), ReadLatencySamples::READ_QUEUE_WAIT, trackedReadType(req));
+
+		if (req.options.present() && req.options.get().debugID.present())
+			g_traceBatch.addEvent("GetValueDebug", req.options.get().debugID.get().first(), "getValuesQ.DoRead");
+
+		Version commitVersion = getLatestCommitVersion(req.ssLatestCommitVersions, data->tag);
+		state Version version = wait(waitForVersion(data, commitVersion, req.version, req.spanContext));
+		data->counters.readLatencySamples.sample(
+		    g_network->timer() - queueWaitEnd, ReadLatencySamples::READ_VERSION_WAIT, trackedReadType(req));
+
+		state uint64_t changeCounter = data->shardChangeCounter;
+
+		// Answer what the versioned data in memory can, and collect the rest for the storage engine
+		state std::vector<Optional<Value>> values(req.keys.size());
+		state std::vector<int> engineIndexes;
+		state Standalone<VectorRef<KeyRef>> engineKeys;
+		for (int k = 0; k < req.keys.size(); ++k) {
+			const KeyRef& key = req.keys[k];
+			if (k > 0 && key <= req.keys[k - 1]) {
+				throw inverted_range();
+			}
+			if (!data->shards[key]->isReadable()) {
+				throw wrong_shard_server();
+			}
+			auto i = data->data().at(version).lastLessOrEqual(key);
+			if (i && i->isValue() && i.key() == key) {
+				values[k] = (Value)i->getValue();
+			} else if (!i || !i->isClearTo() || i->getEndKey() <= key) {
+				engineIndexes.push_back(k);
+				engineKeys.push_back(engineKeys.arena(), key);
+			}
+		}
+
+		if (!engineKeys.empty()) {
+			engineKeys.arena().dependsOn(req.arena);
+			std::vector<Optional<Value>> engineValues = wait(data->storage.readValues(engineKeys, req.options));
+			// Validate that while we were reading the data we didn't lose the version or shard
+			if (version < data->storageVersion()) {
+				CODE_PROBE(true, "transaction_too_old after readValues");
+				throw transaction_too_old();
+			}
+			data->checkChangeCounter(changeCounter,
+			                         KeyRangeRef(req.keys.front(), keyAfter(req.keys.back(), engineKeys.arena())));
+			for (int j = 0; j < engineIndexes.size(); ++j) {
+				data->counters.kvGetBytes += engineValues[j].expectedSize();
+				values[engineIndexes[j]] = engineValues[j];
+			}
+		}
+
+		GetValuesReply reply;
+		for (int k = 0; k < req.keys.size(); ++k) {
+			const KeyRef& key = req.keys[k];
+			const Optional<Value>& v = values[k];
+			keySize += key.size();
+			if (v.present()) {
+				++data->counters.rowsQueried;
+				resultSize += v.get().size();
+				reply.arena.dependsOn(v.get().arena());
+				reply.data.push_back(reply.arena, KeyValueRef(key, v.get()));
+			} else {
+				++data->counters.emptyQueries;
+			}
+
+			if (SERVER_KNOBS->READ_SAMPLING_ENABLED) {
+				// If the read yields no value, randomly sample the empty read.
+				int64_t bytesReadPerKSecond =
+				    v.present() ? std::max((int64_t)(key.size() + v.get().size()), SERVER_KNOBS->EMPTY_READ_PENALTY)
+				                : SERVER_KNOBS->EMPTY_READ_PENALTY;
+				data->metrics.notifyBytesReadPerKSecond(key, bytesReadPerKSecond);
+			}
+			reply.cached = reply.cached || data->cachedRangeMap[key];
+		}
+		reply.arena.dependsOn(req.arena);
+		data->counters.bytesQueried += resultSize;
+
+		if (req.options.present() && req.options.get().debugID.present())
+			g_traceBatch.addEvent("GetValueDebug", req.options.get().debugID.get().first(), "getValuesQ.AfterRead");
+
+		reply.penalty = data->getPenalty();
+		req.reply.send(reply);
+	} catch (Error& e) {
+		if (!canReplyWith(e))
+			throw;
+		data->sendErrorWithPenalty(req.reply, e, data->getPenalty());
+	}
+
+	// Key size is not included in "BytesQueried", but still contributes to cost,
+	// so it must be accounted for here.
+	data->transactionTagCounter.addRequest(req.tags, keySize + resultSize);
+
+	++data->counters.finishedQueries;
+
+	double duration = g_network->timer() - req.requestTime();
+	data->counters.readLatencySamples.sample(duration, ReadLatencySamples::READ, trackedReadType(req));
+	data->counters.readLatencySamples.sample(duration, ReadLatencySamples::READ_VALUE, trackedReadType(req));
+	if (data->latencyBandConfig.present()) {
+		int maxReadBytes =
+		    data->latencyBandConfig.get().readConfig.maxReadBytes.orDefault(std::numeric_limits<int>::max());
+		data->counters.readLatencyBands.addMeasurement(duration, 1, Filtered(resultSize > maxReadBytes));
+	}
+
+	return Void();
+}
+
 // Pessimistic estimate the number of overhead bytes used by each
 // watch. Watch key references are stored in an AsyncMap<Key,bool>, and actors
 // must be kept alive until the watch is finished.
@@ -2333,7 +2824,7 @@ ACTOR Future<Version> watchWaitForValueChange(StorageServer* data, SpanContext p
 		                      metadata->debugID.get().first(),
 		                      "watchValueSendReply.AfterVersion"); //.detail("TaskID", g_network->getCurrentTask());
 
-	state Version minVersion = data->data().latestVersion;
+	state Version minVersion = data->data().getLatestVersion();
 	state Future<Void> watchFuture = data->watches.onChange(metadata->key);
 	state ReadOptions options;
 	loop {
@@ -2342,7 +2833,7 @@ ACTOR Future<Version> watchWaitForValueChange(StorageServer* data, SpanContext p
 			state Version latest = data->version.get();
 			options.debugID = metadata->debugID;
 
-			CODE_PROBE(latest >= minVersion && latest < data->data().latestVersion,
+			CODE_PROBE(latest >= minVersion && latest < data->data().getLatestVersion(),
 			           "Starting watch loop with latestVersion > data->version",
 			           probe::decoration::rare);
 			GetValueRequest getReq(span.context, metadata->key, latest, metadata->tags, options, VersionVector());
@@ -2428,7 +2919,7 @@ ACTOR Future<Version> watchWaitForValueChange(StorageServer* data, SpanContext p
 
 		watchFuture = data->watches.onChange(metadata->key);
 
-		wait(data->version.whenAtLeast(data->data().latestVersion));
+		wait(data->version.whenAtLeast(data->data().getLatestVersion()));
 	}
 }
 
@@ -3351,6 +3842,7 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 {
 	state Span span("SS:getKeyValues"_loc, req.spanContext);
 	state int64_t resultSize = 0;
+	state CancellableRead cancellation(data, req.reply);
 
 	getCurrentLineage()->modify(&TransactionLineage::txID) = req.spanContext.traceID;
 
@@ -3391,6 +3883,11 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 		data->counters.readLatencySamples.sample(
 		    g_network->timer() - queueWaitEnd, ReadLatencySamples::READ_VERSION_WAIT, trackedReadType(req));
 
+		if (cancellation.cancelled()) {
+			++data->counters.readsCancelledBeforeIO;
+			throw operation_obsolete();
+		}
+
 		state uint64_t changeCounter = data->shardChangeCounter;
 		//		try {
 		state KeyRange shard = getShardKeyRange(data, req.begin);
@@ -3481,6 +3978,10 @@ ACTOR Future<Void> getKeyValuesQ(StorageServer* data, GetKeyValuesRequest req)
 			    data, version, KeyRangeRef(begin, end), req.limit, &remainingLimitBytes, span.context, req.options));
 			const double duration = g_network->timer() - kvReadRange;
 			data->counters.readLatencySamples.sample(duration, ReadLatencySamples::KV_READ_RANGE, trackedReadType(req));
+			if (cancellation.cancelled()) {
+				++data->counters.readsCancelledAfterIO;
+				throw operation_obsolete();
+			}
 			GetKeyValuesReply r = _r;
 
 			if (req.options.present() && req.options.get().debugID.present())
@@ -5444,6 +5945,103 @@ TEST_CASE("/fdbserver/storageserver/constructMappedKey") {
 	return Void();
 }
 
+TEST_CASE("/fdbserver/storageserver/rowCache") {
+	StorageRowCache cache(1000);
+
+	uint64_t generation = cache.generation();
+	cache.insert("a"_sr, Optional<Value>("1"_sr), generation);
+	cache.insert("b"_sr, Optional<Value>(), generation);
+	ASSERT(cache.get("a"_sr).get().get() == "1"_sr);
+	ASSERT(!cache.get("b"_sr).get().present());
+	ASSERT(!cache.get("c"_sr).present());
+
+	// A read which raced with an invalidation is not cached
+	generation = cache.generation();
+	cache.invalidate("a"_sr);
+	cache.insert("c"_sr, Optional<Value>("3"_sr), generation);
+	ASSERT(!cache.get("a"_sr).present());
+	ASSERT(!cache.get("c"_sr).present());
+
+	generation = cache.generation();
+	cache.insert("c"_sr, Optional<Value>("3"_sr), generation);
+	cache.invalidate(KeyRangeRef("b"_sr, "c"_sr));
+	ASSERT(!cache.get("b"_sr).present());
+	ASSERT(cache.get("c"_sr).present());
+
+	// The least recently used entries are evicted to stay within capacity
+	generation = cache.generation();
+	for (int i = 0; i < 100; ++i) {
+		cache.get("c"_sr);
+		cache.insert(StringRef(format("k%03d", i)), Optional<Value>("v"_sr), generation);
+		ASSERT(cache.getBytes() <= 1000);
+	}
+	ASSERT(cache.get("c"_sr).present());
+	ASSERT(!cache.get("k000"_sr).present());
+	ASSERT(cache.get("k099"_sr).present());
+
+	return Void();
+}
+
+TEST_CASE("/fdbserver/storageserver/rowCache/readDuringCommit") {
+	StorageRowCache cache(1000);
+
+	// "a" is written and its commit starts, but the engine still returns the old value until the commit completes
+	cache.invalidate("a"_sr);
+	cache.invalidate(KeyRangeRef("m"_sr, "n"_sr));
+	Standalone<VectorRef<KeyRangeRef>> written = cache.startCommit();
+	ASSERT_EQ(written.size(), 2);
+
+	// Reads which start during the commit can cache the old values
+	uint64_t generation = cache.generation();
+	cache.insert("a"_sr, Optional<Value>("old"_sr), generation);
+	cache.insert("m1"_sr, Optional<Value>(), generation);
+	cache.insert("z"_sr, Optional<Value>("1"_sr), generation);
+	// A write during the commit belongs to the next one
+	cache.invalidate("b"_sr);
+	ASSERT(cache.get("a"_sr).present());
+
+	// A read which completes after the commit may have read the old value, so it is not cached
+	generation = cache.generation();
+	cache.commitCompleted(written);
+	cache.insert("a"_sr, Optional<Value>("old"_sr), generation);
+
+	ASSERT(!cache.get("a"_sr).present());
+	ASSERT(!cache.get("m1"_sr).present());
+	ASSERT(cache.get("z"_sr).present());
+
+	written = cache.startCommit();
+	ASSERT_EQ(written.size(), 1);
+	ASSERT(written[0] == singleKeyRange("b"_sr));
+
+	generation = cache.generation();
+	cache.insert("a"_sr, Optional<Value>("new"_sr), generation);
+	ASSERT(cache.get("a"_sr).get().get() == "new"_sr);
+
+	return Void();
+}
+
+TEST_CASE("/fdbserver/storageserver/changeFeedMovedIn") {
+	ChangeFeedInfo feed;
+	feed.range = KeyRangeRef("a"_sr, "z"_sr);
+	feed.emptyVersion = 10;
+	feed.movedIn.emplace_back(KeyRangeRef("f"_sr, "h"_sr), 100);
+	feed.movedIn.emplace_back(KeyRangeRef("m"_sr, "p"_sr), 200);
+
+	// History of the parts of the feed this server always owned is not limited by moves
+	ASSERT_EQ(feed.emptyVersionFor(KeyRangeRef("a"_sr, "f"_sr)), 10);
+	ASSERT_EQ(feed.emptyVersionFor(KeyRangeRef("h"_sr, "m"_sr)), 10);
+	// Reads touching a moved in part start where its history does
+	ASSERT_EQ(feed.emptyVersionFor(KeyRangeRef("a"_sr, "g"_sr)), 100);
+	ASSERT_EQ(feed.emptyVersionFor(KeyRangeRef("g"_sr, "n"_sr)), 200);
+	ASSERT_EQ(feed.emptyVersionFor(feed.range), 200);
+
+	// The moved in parts are persisted with the feed's metadata
+	auto [range, emptyVersion, stopVersion, movedIn] =
+	    decodePersistChangeFeedValue(persistChangeFeedValue(feed.range, feed.emptyVersion, 300, feed.movedIn));
+	ASSERT(range == feed.range && emptyVersion == 10 && stopVersion == 300 && movedIn == feed.movedIn);
+	return Void();
+}
+
 // Issues a secondary query (either range and point read) and fills results into "kvm".
 ACTOR Future<Void> mapSubquery(StorageServer* data,
                                Version version,
@@ -6099,6 +6697,7 @@ ACTOR Future<Void> doEagerReads(StorageServer* data, UpdateEagerReadInfo* eager)
 		}
 	}
 	data->counters.eagerReadsKeys += eager->keys.size();
+	data->counters.eagerReadsSkipped += eager->skippedKeys;
 	eager->value = optionalValues;
 
 	return Void();
@@ -6196,10 +6795,14 @@ bool convertAtomicOp(MutationRef& m, StorageServer::VersionedData const& data, U
 			oldVal = it->getValue();
 		else if (it != data.atLatest().end() && it->isClearTo() && it->getEndKey() > m.param1) {
 			CODE_PROBE(true, "Atomic op right after a clear.");
+		} else if (Optional<Value>* oldThing = eager->findValue(m.param1)) {
+			if (oldThing->present())
+				oldVal = oldThing->get();
 		} else {
-			Optional<Value>& oldThing = eager->getValue(m.param1);
-			if (oldThing.present())
-				oldVal = oldThing.get();
+			// The key was known from data when its eager read was skipped, and removeDataRange() has since erased it
+			// with its shard.  The removal cleared the key, and a shard assigned again without being fetched is
+			// empty, so the key has no value.
+			CODE_PROBE(true, "Atomic op on a key removed from data after its eager read was skipped");
 		}
 
 		switch (m.type) {
@@ -6391,6 +6994,40 @@ void removeDataRange(StorageServer* ss,
 	data.erase(range.begin, range.end);
 }
 
+TEST_CASE("/fdbserver/storageserver/atomicOpAfterShardRemoved") {
+	StorageServer::VersionedData data(deterministicRandom()->coinflip());
+	Arena arena;
+	UpdateEagerReadInfo eager(false, &data);
+	Standalone<StringRef> one = makeString(8);
+	memset(mutateString(one), 0, 8);
+	mutateString(one)[0] = 1;
+
+	data.createNewVersion(1);
+	data.insert("a"_sr, ValueOrClearToRef::value(one));
+
+	// The read of "a" is skipped because its value is in data, while "b" is read
+	eager.addMutation(MutationRef(MutationRef::AddValue, "a"_sr, one));
+	eager.addMutation(MutationRef(MutationRef::AddValue, "b"_sr, one));
+	ASSERT_EQ(eager.skippedKeys, 1);
+	eager.finishKeyBegin();
+	eager.value.resize(eager.keys.size());
+	eager.getValue("b"_sr) = one;
+
+	// The shard is removed, as by removeDataRange(), then assigned again as an empty shard before the atomic ops
+	data.createNewVersion(2);
+	data.erase("a"_sr, "c"_sr);
+
+	MutationRef a(MutationRef::AddValue, "a"_sr, one);
+	ASSERT(convertAtomicOp(a, data, &eager, arena));
+	ASSERT(a.type == MutationRef::SetValue && a.param2 == one);
+
+	MutationRef b(MutationRef::AddValue, "b"_sr, one);
+	ASSERT(convertAtomicOp(b, data, &eager, arena));
+	ASSERT(b.type == MutationRef::SetValue && b.param2[0] == 2);
+
+	return Void();
+}
+
 void setAvailableStatus(StorageServer* self, KeyRangeRef keys, bool available);
 void setAssignedStatus(StorageServer* self, KeyRangeRef keys, bool nowAssigned);
 void updateStorageShard(StorageServer* self, StorageServerShard shard);
@@ -6557,6 +7194,136 @@ ACTOR Future<Void> tryGetRange(PromiseStream<RangeResult> results, Transaction*
 	}
 }
 
+void registerChangeFeed(StorageServer* data, Reference<ChangeFeedInfo> const& feed) {
+	data->uidChangeFeed[feed->id] = feed;
+	for (auto& r : data->keyChangeFeed.modify(feed->range)) {
+		r->value().push_back(feed);
+	}
+}
+
+// Schedules the feed's metadata, and the removal of any data it popped, to be written by the next
+// persistChangeFeedMutations()
+void changeFeedMetadataChanged(StorageServer* data, Reference<ChangeFeedInfo> const& feed) {
+	if (!feed->pendingPersist) {
+		feed->pendingPersist = true;
+		data->currentChangeFeeds.push_back(feed);
+	}
+}
+
+// Forgets the mutations the feed captured before version
+void popChangeFeed(StorageServer* data, Reference<ChangeFeedInfo> const& feed, Version version) {
+	if (version <= feed->emptyVersion) {
+		return;
+	}
+	feed->emptyVersion = version;
+	while (!feed->mutations.empty() && feed->mutations.front().version < version) {
+		feed->mutations.pop_front();
+	}
+	// Moved in ranges whose history begins at or before the popped version no longer limit reads
+	auto& movedIn = feed->movedIn;
+	movedIn.erase(std::remove_if(movedIn.begin(), movedIn.end(), [&](auto const& m) { return m.second <= version; }),
+	              movedIn.end());
+	changeFeedMetadataChanged(data, feed);
+}
+
+// Records that the mutations to keys, part of the feed's range which was just moved to this server, are only captured
+// from version on. History of the rest of the feed is unaffected.
+void changeFeedMovedIn(StorageServer* data, Reference<ChangeFeedInfo> const& feed, KeyRangeRef keys, Version version) {
+	if (version <= feed->emptyVersion) {
+		return;
+	}
+	auto& movedIn = feed->movedIn;
+	movedIn.erase(std::remove_if(movedIn.begin(),
+	                             movedIn.end(),
+	                             [&](auto const& m) { return keys.contains(m.first) && m.second <= version; }),
+	              movedIn.end());
+	movedIn.emplace_back(keys, version);
+	changeFeedMetadataChanged(data, feed);
+}
+
+// Unregisters the feed and removes everything persisted for it
+void removeChangeFeed(StorageServer* data, Reference<ChangeFeedInfo> feed) {
+	TraceEvent(SevDebug, "ChangeFeedRemoved", data->thisServerID)
+	    .detail("FeedID", feed->id)
+	    .detail("Range", feed->range)
+	    .detail("Version", data->data().getLatestVersion());
+	feed->removing = true;
+	feed->mutations.clear();
+	data->uidChangeFeed.erase(feed->id);
+	for (auto& r : data->keyChangeFeed.modify(feed->range)) {
+		auto& feeds = r->value();
+		feeds.erase(std::remove(feeds.begin(), feeds.end(), feed), feeds.end());
+	}
+	data->keyChangeFeed.coalesce(feed->range.contents());
+
+	auto& mLV = data->addVersionToMutationLog(data->data().getLatestVersion());
+	KeyRange dataRange = persistChangeFeedDataRange(feed->id);
+	Key metadataKey = feed->id.withPrefix(persistChangeFeedKeys.begin);
+	data->addMutationToMutationLog(mLV, MutationRef(MutationRef::ClearRange, dataRange.begin, dataRange.end));
+	data->addMutationToMutationLog(mLV, MutationRef(MutationRef::ClearRange, metadataKey, keyAfter(metadataKey)));
+}
+
+// Removes the change feeds overlapping keys which no longer overlap any shard assigned to this server
+void removeUnownedChangeFeeds(StorageServer* data, KeyRangeRef keys) {
+	std::vector<Reference<ChangeFeedInfo>> feeds;
+	for (auto& r : data->keyChangeFeed.intersectingRanges(keys)) {
+		for (auto& feed : r.value()) {
+			if (std::find(feeds.begin(), feeds.end(), feed) == feeds.end()) {
+				feeds.push_back(feed);
+			}
+		}
+	}
+	for (auto& feed : feeds) {
+		bool owned = false;
+		for (auto& shard : data->shards.intersectingRanges(feed->range)) {
+			if (shard.value()->assigned()) {
+				owned = true;
+				break;
+			}
+		}
+		if (!owned) {
+			removeChangeFeed(data, feed);
+		}
+	}
+}
+
+// Registers the change feeds overlapping keys which existed at fetchVersion. Feeds created or destroyed after
+// fetchVersion reach this server through private mutations.
+ACTOR Future<Void> fetchChangeFeedRegistrations(StorageServer* data, KeyRange keys, Version fetchVersion) {
+	state Transaction tr(data->cx);
+	tr.setOption(FDBTransactionOptions::PRIORITY_SYSTEM_IMMEDIATE);
+	tr.setOption(FDBTransactionOptions::LOCK_AWARE);
+	tr.setOption(FDBTransactionOptions::READ_SYSTEM_KEYS);
+	tr.trState->taskID = TaskPriority::FetchKeys;
+	tr.setVersion(fetchVersion);
+	RangeResult feeds = wait(tr.getRange(changeFeedKeys, CLIENT_KNOBS->TOO_MANY));
+	ASSERT(!feeds.more);
+
+	for (auto& kv : feeds) {
+		Key feedID = decodeChangeFeedKey(kv.key);
+		auto [range, popVersion, status] = decodeChangeFeedValue(kv.value);
+		if (status == ChangeFeedStatus::CHANGE_FEED_DESTROY || !range.intersects(keys) ||
+		    data->uidChangeFeed.count(feedID) || data->destroyedChangeFeeds.count(feedID)) {
+			continue;
+		}
+		Reference<ChangeFeedInfo> feed = makeReference<ChangeFeedInfo>();
+		feed->id = feedID;
+		feed->range = range;
+		feed->emptyVersion = std::max(popVersion, fetchVersion + 1);
+		if (status == ChangeFeedStatus::CHANGE_FEED_STOP) {
+			feed->stopVersion = feed->emptyVersion;
+		}
+		registerChangeFeed(data, feed);
+		changeFeedMetadataChanged(data, feed);
+		TraceEvent(SevDebug, "FetchedChangeFeed", data->thisServerID)
+		    .detail("FeedID", feedID)
+		    .detail("Range", range)
+		    .detail("Keys", keys)
+		    .detail("FetchVersion", fetchVersion);
+	}
+	return Void();
+}
+
 bool fetchKeyCanRetry(const Error& e) {
 	switch (e.code()) {
 	case error_code_end_of_stream:
@@ -7165,6 +7932,7 @@ ACTOR Future<Void> fetchKeys(StorageServer* data, AddingShard* shard) {
 			state Key blockBegin = keys.begin;
 
 			try {
+				wait(fetchChangeFeedRegistrations(data, keys, fetchVersion));
 				loop {
 					CODE_PROBE(true, "Fetching keys for transferred shard");
 					while (data->fetchKeysBudgetUsed.get()) {
@@ -7405,6 +8173,14 @@ ACTOR Future<Void> fetchKeys(StorageServer* data, AddingShard* shard) {
 		//   version
 		//     its mutations haven't been processed yet
 		shard->transferredVersion = data->version.get() + 1;
+		// This server did not see the mutations to the shard before transferredVersion, and the fetched updates
+		// replayed at transferredVersion are not captured, so feeds overlapping the shard only have history for it
+		// after transferredVersion.
+		for (auto& r : data->keyChangeFeed.intersectingRanges(keys)) {
+			for (auto& feed : r.value()) {
+				changeFeedMovedIn(data, feed, keys & feed->range, shard->transferredVersion + 1);
+			}
+		}
 		// shard->transferredVersion = batch->changes[0].version;  //< FIXME: This obeys the documented properties,
 		// and seems "safer" because it never introduces extra versions into the data structure, but violates some
 		// ASSERTs currently
@@ -9211,6 +9987,142 @@ void StorageServer::addMutation(Version version,
 	    .detail("ShardEnd", shard.end);
 
 	applyMutation(this, expanded, mLog.arena(), mutableData(), version);
+
+	// Mutations replayed by fetchKeys at the transferredVersion were never seen by this server's feeds
+	if (!fromFetch && !uidChangeFeed.empty()) {
+		addChangeFeedMutation(version, expanded.type == MutationRef::ClearRange ? nonExpanded : expanded);
+	}
+}
+
+void StorageServer::addChangeFeedMutation(Version version, MutationRef const& mutation) {
+	auto addTo = [&](Reference<ChangeFeedInfo> const& feed) {
+		if (feed->removing || version < feed->emptyVersion || version >= feed->stopVersion) {
+			return;
+		}
+		MutationRef m = mutation;
+		if (m.type == MutationRef::ClearRange) {
+			KeyRangeRef clipped = feed->range & KeyRangeRef(m.param1, m.param2);
+			if (clipped.empty()) {
+				return;
+			}
+			m = MutationRef(MutationRef::ClearRange, clipped.begin, clipped.end);
+		}
+		if (feed->mutations.empty() || feed->mutations.back().version != version) {
+			feed->mutations.emplace_back();
+			feed->mutations.back().version = version;
+			feed->mutations.back().knownCommittedVersion = knownCommittedVersion.get();
+			currentChangeFeeds.push_back(feed);
+		}
+		auto& entry = feed->mutations.back();
+		entry.mutations.push_back_deep(entry.arena(), m);
+		++counters.changeFeedMutations;
+	};
+
+	if (mutation.type == MutationRef::ClearRange) {
+		// A clear may span several entries of keyChangeFeed which share feeds
+		std::vector<ChangeFeedInfo*> seen;
+		for (auto& r : keyChangeFeed.intersectingRanges(KeyRangeRef(mutation.param1, mutation.param2))) {
+			for (auto& feed : r.value()) {
+				if (std::find(seen.begin(), seen.end(), feed.getPtr()) == seen.end()) {
+					seen.push_back(feed.getPtr());
+					addTo(feed);
+				}
+			}
+		}
+	} else {
+		for (auto& feed : keyChangeFeed.rangeContaining(mutation.param1).value()) {
+			addTo(feed);
+		}
+	}
+}
+
+// Applies a change to the registration of a change feed, sent by the commit proxies to the owners of its range
+void handleChangeFeedPrivateMutation(StorageServer* data, MutationRef const& m, Version ver) {
+	Key feedID = decodeChangeFeedKey(m.param1.substr(1));
+	auto [range, popVersion, status] = decodeChangeFeedValue(m.param2);
+	auto it = data->uidChangeFeed.find(feedID);
+	TraceEvent(SevDebug, "ChangeFeedPrivateMutation", data->thisServerID)
+	    .detail("FeedID", feedID)
+	    .detail("Range", range)
+	    .detail("PopVersion", popVersion)
+	    .detail("Status", static_cast<int>(status))
+	    .detail("Known", it != data->uidChangeFeed.end())
+	    .detail("Version", ver);
+
+	if (status == ChangeFeedStatus::CHANGE_FEED_DESTROY) {
+		if (it != data->uidChangeFeed.end()) {
+			removeChangeFeed(data, it->second);
+		}
+		// Remember the destruction in case an in-flight fetchKeys read the registration before it
+		data->destroyedChangeFeeds[feedID] = ver;
+		while (!data->destroyedChangeFeeds.empty()) {
+			auto oldest = std::min_element(data->destroyedChangeFeeds.begin(),
+			                               data->destroyedChangeFeeds.end(),
+			                               [](auto const& a, auto const& b) { return a.second < b.second; });
+			if (oldest->second >= ver - SERVER_KNOBS->MAX_READ_TRANSACTION_LIFE_VERSIONS) {
+				break;
+			}
+			data->destroyedChangeFeeds.erase(oldest);
+		}
+		return;
+	}
+
+	Reference<ChangeFeedInfo> feed;
+	if (it == data->uidChangeFeed.end()) {
+		feed = makeReference<ChangeFeedInfo>();
+		feed->id = feedID;
+		feed->range = range;
+		// Mutations at this version were applied before the registration
+		feed->emptyVersion = ver + 1;
+		registerChangeFeed(data, feed);
+		changeFeedMetadataChanged(data, feed);
+	} else {
+		feed = it->second;
+	}
+	popChangeFeed(data, feed, popVersion);
+	if (status == ChangeFeedStatus::CHANGE_FEED_STOP && feed->stopVersion == MAX_VERSION) {
+		feed->stopVersion = ver;
+		changeFeedMetadataChanged(data, feed);
+	}
+}
+
+// Writes the change feed mutations captured by this batch of versions to the mutation log, so that they become durable
+// together with the versions they were captured at.
+void persistChangeFeedMutations(StorageServer* data) {
+	for (auto& feed : data->currentChangeFeeds) {
+		if (feed->removing) {
+			continue;
+		}
+		if (feed->pendingPersist) {
+			auto& mLV = data->addVersionToMutationLog(data->data().getLatestVersion());
+			if (feed->emptyVersion > 0) {
+				data->addMutationToMutationLog(mLV,
+				                               MutationRef(MutationRef::ClearRange,
+				                                           persistChangeFeedDataKey(feed->id, 0),
+				                                           persistChangeFeedDataKey(feed->id, feed->emptyVersion)));
+			}
+			data->addMutationToMutationLog(
+			    mLV,
+			    MutationRef(MutationRef::SetValue,
+			                feed->id.withPrefix(persistChangeFeedKeys.begin),
+			                persistChangeFeedValue(feed->range, feed->emptyVersion, feed->stopVersion, feed->movedIn)));
+			feed->pendingPersist = false;
+		}
+		auto it = feed->mutations.end();
+		while (it != feed->mutations.begin() && std::prev(it)->version > feed->storageVersion) {
+			--it;
+		}
+		for (; it != feed->mutations.end(); ++it) {
+			auto& mLV = data->addVersionToMutationLog(it->version);
+			data->addMutationToMutationLog(
+			    mLV,
+			    MutationRef(MutationRef::SetValue,
+			                persistChangeFeedDataKey(feed->id, it->version),
+			                BinaryWriter::toValue(static_cast<MutationsAndVersionRef const&>(*it), IncludeVersion())));
+			feed->storageVersion = it->version;
+		}
+	}
+	data->currentChangeFeeds.clear();
 }
 
 struct OrderByVersion {
@@ -9244,6 +10156,8 @@ public:
 		if (m.param1.startsWith(systemKeys.end)) {
 			if ((m.type == MutationRef::SetValue) && m.param1.substr(1).startsWith(checkpointPrefix)) {
 				handleCheckpointPrivateMutation(data, m, ver);
+			} else if ((m.type == MutationRef::SetValue) && m.param1.substr(1).startsWith(changeFeedPrefix)) {
+				handleChangeFeedPrivateMutation(data, m, ver);
 			} else {
 				applyPrivateData(data, ver, m);
 			}
@@ -9315,6 +10229,9 @@ private:
 					changeServerKeys(
 					    data, keys, nowAssigned, currentVersion - 1, context, dataMoveReason, bulkLoadMetadata);
 				}
+				if (!nowAssigned) {
+					removeUnownedChangeFeeds(data, keys);
+				}
 			}
 
 			processedStartKey = false;
@@ -9570,7 +10487,9 @@ ACTOR Future<Void> update(StorageServer* data, bool* pReceivedUpdate) {
 	     data->storage.getKeyValueStoreType() == KeyValueStoreType::SSD_SHARDED_ROCKSDB)
 	        ? SERVER_KNOBS->ROCKSDB_ENABLE_CLEAR_RANGE_EAGER_READS
 	        : SERVER_KNOBS->ENABLE_CLEAR_RANGE_EAGER_READS;
-	state UpdateEagerReadInfo eager(enableClearRangeEagerReads);
+	state AnyVersionedMap<ValueOrClearToRef> const* eagerKnownData =
+	    SERVER_KNOBS->SKIP_KNOWN_ATOMIC_OP_EAGER_READS ? &data->data() : nullptr;
+	state UpdateEagerReadInfo eager(enableClearRangeEagerReads, eagerKnownData);
 	try {
 
 		// If we are disk bound and durableVersion is very old, we need to block updates or we could run out of
@@ -9759,7 +10678,7 @@ ACTOR Future<Void> update(StorageServer* data, bool* pReceivedUpdate) {
 			           "A fetchKeys completed while we were doing this, so eager might be outdated.  Read it again.");
 			// SOMEDAY: Theoretically we could check the change counters of individual shards and retry the
 			// reads only selectively
-			eager = UpdateEagerReadInfo(enableClearRangeEagerReads);
+			eager = UpdateEagerReadInfo(enableClearRangeEagerReads, eagerKnownData);
 			cloneCursor2 = cursor->cloneNoMore();
 		}
 		data->eagerReadsLatencyHistogram->sampleSeconds(now() - start);
@@ -9952,6 +10871,8 @@ ACTOR Future<Void> update(StorageServer* data, bool* pReceivedUpdate) {
 		if (injectedChanges)
 			data->lastVersionWithData = ver;
 
+		persistChangeFeedMutations(data);
+
 		data->updateEagerReads = nullptr;
 		data->debug_inApplyUpdate = false;
 
@@ -10647,6 +11568,9 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 				wait(data->durableVersionLock.take());
 			}
 		}
+		for (auto& [id, feed] : data->uidChangeFeed) {
+			data->counters.changeFeedMutationsDurable += feed->durable(newOldestVersion);
+		}
 
 		data->durableVersionLock.release();
 		data->ssDurableVersionUpdateLatencyHistogram->sampleSeconds(now() - beforeSSDurableVersionUpdate);
@@ -10800,6 +11724,7 @@ void setRangeBasedBulkLoadStatus(StorageServer* self, KeyRangeRef keys, const SS
 }
 
 void StorageServerDisk::clearRange(KeyRangeRef keys) {
+	rowCache.invalidate(keys);
 	storage->clear(keys);
 	++(*kvClearRanges);
 	if (keys.singleKeyRange()) {
@@ -10808,15 +11733,18 @@ void StorageServerDisk::clearRange(KeyRangeRef keys) {
 }
 
 void StorageServerDisk::writeKeyValue(KeyValueRef kv) {
+	rowCache.invalidate(kv.key);
 	storage->set(kv);
 	*kvCommitLogicalBytes += kv.expectedSize();
 }
 
 void StorageServerDisk::writeMutation(MutationRef mutation) {
 	if (mutation.type == MutationRef::SetValue) {
+		rowCache.invalidate(mutation.param1);
 		storage->set(KeyValueRef(mutation.param1, mutation.param2));
 		*kvCommitLogicalBytes += mutation.expectedSize();
 	} else if (mutation.type == MutationRef::ClearRange) {
+		rowCache.invalidate(KeyRangeRef(mutation.param1, mutation.param2));
 		storage->clear(KeyRangeRef(mutation.param1, mutation.param2));
 		++(*kvClearRanges);
 		if (KeyRangeRef(mutation.param1, mutation.param2).singleKeyRange()) {
@@ -10856,9 +11784,11 @@ void StorageServerDisk::writeMutations(const VectorRef<MutationRef>& mutations,
 		DEBUG_MUTATION(debugContext, debugVersion, m, data->thisServerID);
 		ASSERT(m.validateChecksum());
 		if (m.type == MutationRef::SetValue) {
+			rowCache.invalidate(m.param1);
 			storage->set(KeyValueRef(m.param1, m.param2));
 			*kvCommitLogicalBytes += m.expectedSize();
 		} else if (m.type == MutationRef::ClearRange) {
+			rowCache.invalidate(KeyRangeRef(m.param1, m.param2));
 			storage->clear(KeyRangeRef(m.param1, m.param2));
 			++(*kvClearRanges);
 			if (KeyRangeRef(m.param1, m.param2).singleKeyRange()) {
@@ -11063,6 +11993,7 @@ ACTOR Future<bool> restoreDurableState(StorageServer* data, IKeyValueStore* stor
 	state Future<RangeResult> fStorageShards = storage->readRange(persistStorageServerShardKeys);
 	state Future<RangeResult> fAccumulativeChecksum = storage->readRange(persistAccumulativeChecksumKeys);
 	state Future<RangeResult> fBulkLoadTask = storage->readRange(persistBulkLoadTaskKeys);
+	state Future<RangeResult> fChangeFeeds = storage->readRange(persistChangeFeedKeys);
 
 	state Promise<Void> byteSampleSampleRecovered;
 	state Promise<Void> startByteSampleRestore;
@@ -11079,7 +12010,8 @@ ACTOR Future<bool> restoreDurableState(StorageServer* data, IKeyValueStore* stor
 	                             fMoveInShards,
 	                             fStorageShards,
 	                             fAccumulativeChecksum,
-	                             fBulkLoadTask }));
+	                             fBulkLoadTask,
+	                             fChangeFeeds }));
 	wait(byteSampleSampleRecovered.getFuture());
 	TraceEvent("RestoringDurableState", data->thisServerID).log();
 
@@ -11162,6 +12094,25 @@ ACTOR Future<bool> restoreDurableState(StorageServer* data, IKeyValueStore* stor
 		wait(yield());
 	}
 
+	state RangeResult changeFeeds = fChangeFeeds.get();
+	data->bytesRestored += changeFeeds.logicalSize();
+	state int feedLoc;
+	for (feedLoc = 0; feedLoc < changeFeeds.size(); feedLoc++) {
+		Reference<ChangeFeedInfo> feed = makeReference<ChangeFeedInfo>();
+		feed->id = changeFeeds[feedLoc].key.removePrefix(persistChangeFeedKeys.begin);
+		std::tie(feed->range, feed->emptyVersion, feed->stopVersion, feed->movedIn) =
+		    decodePersistChangeFeedValue(changeFeeds[feedLoc].value);
+		feed->durableVersion = version;
+		feed->storageVersion = version;
+		registerChangeFeed(data, feed);
+		TraceEvent(SevDebug, "RestoredChangeFeed", data->thisServerID)
+		    .detail("FeedID", feed->id)
+		    .detail("Range", feed->range)
+		    .detail("EmptyVersion", feed->emptyVersion)
+		    .detail("StopVersion", feed->stopVersion);
+		wait(yield());
+	}
+
 	state RangeResult available = fShardAvailable.get();
 	data->bytesRestored += available.logicalSize();
 	state int availableLoc;
@@ -11763,6 +12714,31 @@ ACTOR Future<Void> serveGetValueRequests(StorageServer* self, FutureStream<GetVa
 	}
 }
 
+ACTOR Future<Void> serveGetValuesRequests(StorageServer* self, FutureStream<GetValuesRequest> getValues) {
+	getCurrentLineage()->modify(&TransactionLineage::operation) = TransactionLineage::Operation::GetValue;
+	loop {
+		GetValuesRequest req = waitNext(getValues);
+		// Warning: This code is executed at extremely high priority (TaskPriority::LoadBalancedEndpoint), so
+		// downgrade before doing real work
+		if (req.options.present() && req.options.get().debugID.present())
+			g_traceBatch.addEvent("GetValueDebug",
+			                      req.options.get().debugID.get().first(),
+			                      "storageServer.received"); //.detail("TaskID", g_network->getCurrentTask());
+
+		self->actors.add(self->readGuard(req, getValuesQ));
+	}
+}
+
+ACTOR Future<Void> serveCancelReadRequests(StorageServer* self, FutureStream<CancelReadRequest> cancelRead) {
+	loop {
+		CancelReadRequest req = waitNext(cancelRead);
+		auto it = self->cancellableReads.find(req.replyToken);
+		if (it != self->cancellableReads.end()) {
+			it->second = true;
+		}
+	}
+}
+
 ACTOR Future<Void> serveGetKeyValuesRequests(StorageServer* self, FutureStream<GetKeyValuesRequest> getKeyValues) {
 	getCurrentLineage()->modify(&TransactionLineage::operation) = TransactionLineage::Operation::GetKeyValues;
 	loop {
@@ -11941,14 +12917,242 @@ ACTOR Future<Void> serveWatchValueRequests(StorageServer* self, FutureStream<Wat
 	}
 }
 
-// Change feed related message handlers that exist but do nothing.
-// The reason for these existing is that we do not want to change the StorageServerInterface
-// to remove change feed related interfaces.  Figure out how to do that later.
+// Returns the feed to read range from, throwing if this server cannot serve all of range for it
+Reference<ChangeFeedInfo> getChangeFeedForRead(StorageServer* data, KeyRef feedID, KeyRangeRef range) {
+	for (auto& shard : data->shards.intersectingRanges(range)) {
+		if (!shard.value()->isCFInVersionedData()) {
+			throw wrong_shard_server();
+		}
+	}
+	auto it = data->uidChangeFeed.find(feedID);
+	if (it == data->uidChangeFeed.end()) {
+		throw unknown_change_feed();
+	}
+	return it->second;
+}
+
+// Appends the part of entry which touches range to result, returning the number of bytes added
+int appendChangeFeedMutations(Standalone<VectorRef<MutationsAndVersionRef>>& result,
+                              MutationsAndVersionRef const& entry,
+                              KeyRangeRef range) {
+	MutationsAndVersionRef filtered(entry.version, entry.knownCommittedVersion);
+	for (auto& m : entry.mutations) {
+		if (m.type == MutationRef::ClearRange) {
+			KeyRangeRef clipped = range & KeyRangeRef(m.param1, m.param2);
+			if (!clipped.empty()) {
+				filtered.mutations.push_back_deep(result.arena(),
+				                                  MutationRef(MutationRef::ClearRange, clipped.begin, clipped.end));
+			}
+		} else if (range.contains(m.param1)) {
+			filtered.mutations.push_back_deep(result.arena(), m);
+		}
+	}
+	if (filtered.mutations.empty()) {
+		return 0;
+	}
+	result.push_back(result.arena(), filtered);
+	return filtered.expectedSize();
+}
+
+// Reads the mutations the feed captured in [begin, end) which touch range. Returns them with the last version read,
+// which is end - 1 unless byteLimit was reached first.
+ACTOR Future<std::pair<Standalone<VectorRef<MutationsAndVersionRef>>, Version>>
+getChangeFeedMutations(StorageServer* data,
+                       Reference<ChangeFeedInfo> feed,
+                       KeyRange range,
+                       Version begin,
+                       Version end,
+                       int byteLimit) {
+	state Standalone<VectorRef<MutationsAndVersionRef>> result;
+	state Version lastRead = end - 1;
+	state int bytes = 0;
+
+	// Everything the feed captured in [begin, end) which is not in memory now is durable, and stays readable from
+	// storage even if the memory is trimmed while storage is read.
+	state std::vector<Standalone<MutationsAndVersionRef>> memory;
+	for (auto& entry : feed->mutations) {
+		if (entry.version >= end) {
+			break;
+		}
+		if (entry.version >= begin) {
+			memory.push_back(entry);
+		}
+	}
+	state Version memoryBegin = memory.empty() ? end : memory.front().version;
+
+	if (begin < memoryBegin) {
+		++data->counters.changeFeedDiskReads;
+		RangeResult stored = wait(data->storage.readRange(KeyRangeRef(persistChangeFeedDataKey(feed->id, begin),
+		                                                              persistChangeFeedDataKey(feed->id, memoryBegin)),
+		                                                  1 << 30,
+		                                                  byteLimit));
+		for (auto& kv : stored) {
+			MutationsAndVersionRef entry;
+			BinaryReader rd(kv.value, IncludeVersion());
+			rd >> entry;
+			bytes += appendChangeFeedMutations(result, entry, range);
+		}
+		if (stored.more) {
+			lastRead = decodePersistChangeFeedDataKeyVersion(stored.back().key);
+			return std::make_pair(result, lastRead);
+		}
+	}
+
+	for (auto& entry : memory) {
+		if (bytes >= byteLimit) {
+			lastRead = entry.version - 1;
+			break;
+		}
+		bytes += appendChangeFeedMutations(result, entry, range);
+	}
+	return std::make_pair(result, lastRead);
+}
+
+ACTOR Future<Void> changeFeedStreamQ(StorageServer* data, ChangeFeedStreamRequest req) {
+	state Span span("SS:getChangeFeedStream"_loc, req.spanContext);
+	state Version begin = req.begin;
+	req.reply.setByteLimit(SERVER_KNOBS->CHANGEFEEDSTREAM_LIMIT_BYTES);
+
+	wait(delay(0, TaskPriority::DefaultEndpoint));
+
+	try {
+		loop {
+			wait(req.reply.onReady());
+			if (begin >= req.end) {
+				req.reply.sendError(end_of_stream());
+				break;
+			}
+
+			state Reference<ChangeFeedInfo> feed = getChangeFeedForRead(data, req.rangeID, req.range);
+			state Version emptyVersion = feed->emptyVersionFor(req.range & feed->range);
+			if (begin < emptyVersion) {
+				if (!req.canReadPopped) {
+					throw change_feed_popped();
+				}
+				begin = emptyVersion;
+			}
+
+			// Only committed versions are served, since a rollback would otherwise leave readers with mutations that
+			// never happened
+			state Version readable = std::min(data->version.get(), data->knownCommittedVersion.get());
+			if (begin > readable) {
+				wait(data->version.whenAtLeast(begin) && data->knownCommittedVersion.whenAtLeast(begin));
+				continue;
+			}
+
+			state std::pair<Standalone<VectorRef<MutationsAndVersionRef>>, Version> read =
+			    wait(getChangeFeedMutations(data,
+			                                feed,
+			                                req.range & feed->range,
+			                                begin,
+			                                std::min(req.end, readable + 1),
+			                                SERVER_KNOBS->CHANGEFEED_REPLY_BYTES));
+
+			// The feed may have been popped, removed or moved away while storage was read
+			feed = getChangeFeedForRead(data, req.rangeID, req.range);
+			emptyVersion = feed->emptyVersionFor(req.range & feed->range);
+			if (begin < emptyVersion && !req.canReadPopped) {
+				throw change_feed_popped();
+			}
+
+			ChangeFeedStreamReply reply;
+			reply.arena.dependsOn(read.first.arena());
+			reply.mutations = read.first;
+			// An empty entry tells the reader how far it has read when nothing changed at the last version read
+			if (reply.mutations.empty() || reply.mutations.back().version < read.second) {
+				reply.mutations.push_back(reply.arena,
+				                          MutationsAndVersionRef(read.second, data->knownCommittedVersion.get()));
+			}
+			reply.atLatestVersion = read.second == readable;
+			reply.minStreamVersion = read.second;
+			reply.popVersion = emptyVersion;
+			req.reply.send(reply);
+			begin = read.second + 1;
+		}
+	} catch (Error& e) {
+		if (e.code() != error_code_operation_obsolete) {
+			if (!canReplyWith(e))
+				throw;
+			req.reply.sendError(e);
+		}
+	}
+	return Void();
+}
+
+ACTOR Future<Void> overlappingChangeFeedsQ(StorageServer* data, OverlappingChangeFeedsRequest req) {
+	wait(delay(0, TaskPriority::DefaultEndpoint));
+
+	try {
+		wait(success(waitForVersionNoTooOld(data, req.minVersion)));
+		for (auto& shard : data->shards.intersectingRanges(req.range)) {
+			if (!shard.value()->isCFInVersionedData()) {
+				throw wrong_shard_server();
+			}
+		}
+
+		OverlappingChangeFeedsReply reply;
+		reply.feedMetadataVersion = data->version.get();
+		std::vector<ChangeFeedInfo*> seen;
+		for (auto& r : data->keyChangeFeed.intersectingRanges(req.range)) {
+			for (auto& feed : r.value()) {
+				if (std::find(seen.begin(), seen.end(), feed.getPtr()) == seen.end()) {
+					seen.push_back(feed.getPtr());
+					reply.feeds.push_back_deep(reply.arena,
+					                           OverlappingChangeFeedEntry(feed->id,
+					                                                      feed->range,
+					                                                      feed->emptyVersion,
+					                                                      feed->stopVersion,
+					                                                      reply.feedMetadataVersion));
+				}
+			}
+		}
+		req.reply.send(reply);
+	} catch (Error& e) {
+		if (!canReplyWith(e))
+			throw;
+		req.reply.sendError(e);
+	}
+	return Void();
+}
+
+ACTOR Future<Void> changeFeedPopQ(StorageServer* data, ChangeFeedPopRequest req) {
+	wait(delay(0, TaskPriority::DefaultEndpoint));
+
+	try {
+		Reference<ChangeFeedInfo> feed = getChangeFeedForRead(data, req.rangeID, req.range);
+		popChangeFeed(data, feed, req.version);
+		// The pop is written to the mutation log by the next update(). Popped data can be read again after a reboot
+		// until that version is durable.
+		wait(data->version.whenAtLeast(data->version.get() + 1));
+		req.reply.send(Void());
+	} catch (Error& e) {
+		if (!canReplyWith(e))
+			throw;
+		req.reply.sendError(e);
+	}
+	return Void();
+}
+
+ACTOR Future<Void> changeFeedVersionUpdateQ(StorageServer* data, ChangeFeedVersionUpdateRequest req) {
+	wait(delay(0, TaskPriority::DefaultEndpoint));
+
+	try {
+		wait(data->version.whenAtLeast(req.minVersion) && data->knownCommittedVersion.whenAtLeast(req.minVersion));
+		req.reply.send(
+		    ChangeFeedVersionUpdateReply(std::min(data->version.get(), data->knownCommittedVersion.get())));
+	} catch (Error& e) {
+		if (!canReplyWith(e))
+			throw;
+		req.reply.sendError(e);
+	}
+	return Void();
+}
+
 ACTOR Future<Void> serveChangeFeedStreamRequests(StorageServer* self,
                                                  FutureStream<ChangeFeedStreamRequest> changeFeedStream) {
 	loop {
 		ChangeFeedStreamRequest req = waitNext(changeFeedStream);
-		TraceEvent(SevWarn, "serveChangeFeedStreamRequests").detail("Unexpected", "Invocation");
+		self->actors.add(changeFeedStreamQ(self, req));
 	}
 }
 
@@ -11957,14 +13161,14 @@ ACTOR Future<Void> serveOverlappingChangeFeedsRequests(
     FutureStream<OverlappingChangeFeedsRequest> overlappingChangeFeeds) {
 	loop {
 		OverlappingChangeFeedsRequest req = waitNext(overlappingChangeFeeds);
-		TraceEvent(SevWarn, "serveOverlappingChangeFeedsRequests").detail("Unexpected", "Invocation");
+		self->actors.add(overlappingChangeFeedsQ(self, req));
 	}
 }
 
 ACTOR Future<Void> serveChangeFeedPopRequests(StorageServer* self, FutureStream<ChangeFeedPopRequest> changeFeedPops) {
 	loop {
 		ChangeFeedPopRequest req = waitNext(changeFeedPops);
-		TraceEvent(SevWarn, "serveChangeFeedPopRequests").detail("Unexpected", "Invocation");
+		self->actors.add(changeFeedPopQ(self, req));
 	}
 }
 
@@ -11973,7 +13177,7 @@ ACTOR Future<Void> serveChangeFeedVersionUpdateRequests(
     FutureStream<ChangeFeedVersionUpdateRequest> changeFeedVersionUpdate) {
 	loop {
 		ChangeFeedVersionUpdateRequest req = waitNext(changeFeedVersionUpdate);
-		TraceEvent(SevWarn, "serveChangeFeedVersionUpdateRequests").detail("Unexpected", "Invocation");
+		self->actors.add(changeFeedVersionUpdateQ(self, req));
 	}
 }
 
@@ -12094,7 +13298,9 @@ ACTOR Future<Void> storageServerCore(StorageServer* self, StorageServerInterface
 	self->actors.add(logLongByteSampleRecovery(self->byteSampleRecovery));
 	self->actors.add(checkBehind(self));
 	self->actors.add(serveGetValueRequests(self, ssi.getValue.getFuture()));
+	self->actors.add(serveGetValuesRequests(self, ssi.getValues.getFuture()));
 	self->actors.add(serveGetKeyValuesRequests(self, ssi.getKeyValues.getFuture()));
+	self->actors.add(serveCancelReadRequests(self, ssi.cancelRead.getFuture()));
 	self->actors.add(serveGetMappedKeyValuesRequests(self, ssi.getMappedKeyValues.getFuture()));
 	self->actors.add(serveGetKeyValuesStreamRequests(self, ssi.getKeyValuesStream.getFuture()));
 	self->actors.add(serveGetKeyRequests(self, ssi.getKey.getFuture()));
@@ -0,0 +1,192 @@
+/*
+ * CancelLostReads.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/NativeAPI.actor.h"
+#include "fdbclient/RunRYWTransaction.actor.h"
+#include "fdbserver/Knobs.h"
+#include "fdbserver/QuietDatabase.h"
+#include "fdbserver/WorkerInterface.actor.h"
+#include "fdbserver/workloads/workloads.actor.h"
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// Sends reads to each storage server and cancels them the way loadBalance cancels a request which lost the race to
+// another replica, then checks that the storage servers counted the abandoned reads in ReadsCancelledBeforeIO and
+// ReadsCancelledAfterIO.
+struct CancelLostReadsWorkload : TestWorkload {
+	static constexpr auto NAME = "CancelLostReads";
+
+	int nodeCount;
+	int readsPerServer;
+	int obsoleteReplies = 0;
+	int64_t cancelledBeforeIO = 0;
+	int64_t cancelledAfterIO = 0;
+	bool testFailed = false;
+
+	CancelLostReadsWorkload(WorkloadContext const& wcx) : TestWorkload(wcx) {
+		nodeCount = getOption(options, "nodeCount"_sr, 100);
+		readsPerServer = getOption(options, "readsPerServer"_sr, 200);
+	}
+
+	Key keyForIndex(int n) const { return StringRef(format("cancelLostReads/%08d", n)); }
+
+	Future<Void> setup(Database const& cx) override {
+		if (clientId != 0) {
+			return Void();
+		}
+		return runRYWTransaction(cx, [this](Reference<ReadYourWritesTransaction> tr) -> Future<Void> {
+			for (int i = 0; i < nodeCount; ++i) {
+				tr->set(keyForIndex(i), "value"_sr);
+			}
+			return Void();
+		});
+	}
+
+	// Returns the totals of ReadsCancelledBeforeIO and ReadsCancelledAfterIO in the latest StorageMetrics event of the
+	// storage server
+	ACTOR static Future<std::pair<int64_t, int64_t>> getCancelledReads(WorkerInterface worker, UID storageId) {
+		TraceEventFields fields = wait(timeoutError(
+		    worker.eventLogRequest.getReply(EventLogRequest(StringRef(storageId.toString() + "/StorageMetrics"))),
+		    10.0));
+		std::pair<int64_t, int64_t> result(0, 0);
+		double hz, roughness;
+		std::string beforeIO, afterIO;
+		if (fields.tryGetValue("ReadsCancelledBeforeIO", beforeIO)) {
+			sscanf(beforeIO.c_str(), "%lf %lf %" SCNd64, &hz, &roughness, &result.first);
+		}
+		if (fields.tryGetValue("ReadsCancelledAfterIO", afterIO)) {
+			sscanf(afterIO.c_str(), "%lf %lf %" SCNd64, &hz, &roughness, &result.second);
+		}
+		return result;
+	}
+
+	ACTOR static Future<Void> testStorage(CancelLostReadsWorkload* self,
+	                                      Database cx,
+	                                      StorageServerInterface ssi,
+	                                      WorkerInterface worker) {
+		state Transaction tr(cx);
+		state Version readVersion;
+		loop {
+			try {
+				Version v = wait(tr.getReadVersion());
+				readVersion = v;
+				break;
+			} catch (Error& e) {
+				wait(tr.onError(e));
+			}
+		}
+
+		state std::pair<int64_t, int64_t> before = wait(getCancelledReads(worker, ssi.id()));
+
+		// Half of the reads are cancelled as soon as they are sent, so that they are abandoned before reading from
+		// the storage engine, and the rest a little later, when some of them are reading from it
+		state std::vector<Future<ErrorOr<GetValueReply>>> replies;
+		state std::vector<UID> lateCancels;
+		for (int i = 0; i < self->readsPerServer; ++i) {
+			GetValueRequest req(SpanContext(),
+			                    self->keyForIndex(deterministicRandom()->randomInt(0, self->nodeCount)),
+			                    readVersion,
+			                    Optional<TagSet>(),
+			                    Optional<ReadOptions>(),
+			                    VersionVector());
+			replies.push_back(ssi.getValue.tryGetReply(req));
+			if (i % 2 == 0) {
+				ssi.cancelLostRequest(req.reply.getEndpoint().token);
+			} else {
+				lateCancels.push_back(req.reply.getEndpoint().token);
+			}
+		}
+		wait(delay(deterministicRandom()->random01() * 0.01));
+		for (auto const& token : lateCancels) {
+			ssi.cancelLostRequest(token);
+		}
+		wait(waitForAllReady(replies));
+
+		state int obsolete = 0;
+		for (auto const& reply : replies) {
+			if (reply.get().present() && reply.get().get().error.present() &&
+			    reply.get().get().error.get().code() == error_code_operation_obsolete) {
+				++obsolete;
+			}
+		}
+
+		// The counters are traced every STORAGE_LOGGING_DELAY
+		wait(delay(2 * SERVER_KNOBS->STORAGE_LOGGING_DELAY));
+		std::pair<int64_t, int64_t> after = wait(getCancelledReads(worker, ssi.id()));
+		int64_t beforeIO = after.first - before.first;
+		int64_t afterIO = after.second - before.second;
+
+		TraceEvent("CancelLostReadsStorage")
+		    .detail("Storage", ssi.id())
+		    .detail("ObsoleteReplies", obsolete)
+		    .detail("CancelledBeforeIO", beforeIO)
+		    .detail("CancelledAfterIO", afterIO);
+		// Reads cancelled by other clients' load balancing can only add to the counters
+		if (obsolete == 0 || beforeIO <= 0 || beforeIO + afterIO < obsolete) {
+			self->testFailed = true;
+			TraceEvent(SevError, "CancelLostReadsNotCounted")
+			    .detail("Storage", ssi.id())
+			    .detail("ObsoleteReplies", obsolete)
+			    .detail("CancelledBeforeIO", beforeIO)
+			    .detail("CancelledAfterIO", afterIO);
+		}
+		self->obsoleteReplies += obsolete;
+		self->cancelledBeforeIO += beforeIO;
+		self->cancelledAfterIO += afterIO;
+		return Void();
+	}
+
+	ACTOR static Future<Void> _start(CancelLostReadsWorkload* self, Database cx) {
+		state std::vector<StorageServerInterface> storageServers = wait(getStorageServers(cx));
+		state std::vector<WorkerDetails> workers = wait(getWorkers(self->dbInfo));
+		state std::vector<Future<Void>> tests;
+		for (auto const& ssi : storageServers) {
+			// Reads from within the storage server's process cannot be cancelled
+			if (ssi.address() == g_network->getLocalAddress()) {
+				continue;
+			}
+			for (auto const& worker : workers) {
+				if (worker.interf.address() == ssi.address()) {
+					tests.push_back(testStorage(self, cx, ssi, worker.interf));
+					break;
+				}
+			}
+		}
+		wait(waitForAll(tests));
+		return Void();
+	}
+
+	Future<Void> start(Database const& cx) override {
+		// we run this only on one client
+		if (clientId != 0 || !g_network->isSimulated()) {
+			return Void();
+		}
+		return _start(this, cx);
+	}
+
+	Future<bool> check(Database const& cx) override { return !testFailed; }
+
+	void getMetrics(std::vector<PerfMetric>& m) override {
+		m.emplace_back("Obsolete replies", obsoleteReplies, Averaged::False);
+		m.emplace_back("Reads cancelled before IO", cancelledBeforeIO, Averaged::False);
+		m.emplace_back("Reads cancelled after IO", cancelledAfterIO, Averaged::False);
+	}
+};
+
+WorkloadFactory<CancelLostReadsWorkload> CancelLostReadsWorkloadFactory;
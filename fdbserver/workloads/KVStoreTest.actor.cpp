@@ -203,15 +203,15 @@ struct KVStoreTestWorkload : TestWorkload {
 	double testDuration, operationsPerSecond;
 	double commitFraction, setFraction;
 	int nodeCount, keyBytes, valueBytes;
-	bool doSetup, doClear, doCount;
+	bool doSetup, doClear, doCount, doRecover;
 	std::string filename;
 	PerfIntCounter reads, sets, commits;
 	TestHistogram<float> readLatency, commitLatency;
-	double setupTook;
+	double setupTook, recoveryTook;
 	KeyValueStoreType storeType;
 
 	KVStoreTestWorkload(WorkloadContext const& wcx)
-	  : TestWorkload(wcx), reads("Reads"), sets("Sets"), commits("Commits"), setupTook(0) {
+	  : TestWorkload(wcx), reads("Reads"), sets("Sets"), commits("Commits"), setupTook(0), recoveryTook(0) {
 		enabled = !clientId; // only do this on the "first" client
 		testDuration = getOption(options, "testDuration"_sr, 10.0);
 		operationsPerSecond = getOption(options, "operationsPerSecond"_sr, 100e3);
@@ -223,6 +223,8 @@ struct KVStoreTestWorkload : TestWorkload {
 		doSetup = getOption(options, "setup"_sr, false);
 		doClear = getOption(options, "clear"_sr, false);
 		doCount = getOption(options, "count"_sr, false);
+		// Close and reopen the store at the end of the test, measuring the time until it has recovered
+		doRecover = getOption(options, "recover"_sr, false);
 		filename = getOption(options, "filename"_sr, Value()).toString();
 		saturation = getOption(options, "saturation"_sr, false);
 		storeType = KeyValueStoreType::fromString(getOption(options, "storeType"_sr, "ssd"_sr).toString());
@@ -244,6 +246,8 @@ struct KVStoreTestWorkload : TestWorkload {
 	void getMetrics(std::vector<PerfMetric>& m) override {
 		if (setupTook)
 			m.emplace_back("SetupTook", setupTook, Averaged::False);
+		if (recoveryTook)
+			m.emplace_back("RecoveryTook", recoveryTook, Averaged::False);
 
 		m.push_back(reads.getMetric());
 		m.push_back(sets.getMetric());
@@ -371,6 +375,45 @@ ACTOR Future<Void> testKVStoreMain(KVStoreTestWorkload* workload, KVTest* ptest)
 	return Void();
 }
 
+IKeyValueStore* openKVStore(KeyValueStoreType storeType, std::string const& fn, UID id) {
+	if (storeType == KeyValueStoreType::SSD_BTREE_V2) {
+		return keyValueStoreSQLite(fn, id, KeyValueStoreType::SSD_BTREE_V2);
+	} else if (storeType == KeyValueStoreType::SSD_BTREE_V1) {
+		return keyValueStoreSQLite(fn, id, KeyValueStoreType::SSD_BTREE_V1);
+	} else if (storeType == KeyValueStoreType::SSD_REDWOOD_V1) {
+		return keyValueStoreRedwoodV1(fn, id);
+	} else if (storeType == KeyValueStoreType::SSD_ROCKSDB_V1) {
+		return keyValueStoreRocksDB(fn, id, KeyValueStoreType::SSD_ROCKSDB_V1);
+	} else if (storeType == KeyValueStoreType::SSD_SHARDED_ROCKSDB) {
+		return keyValueStoreRocksDB(
+		    fn, id, KeyValueStoreType::SSD_SHARDED_ROCKSDB); // TODO: to replace the KVS in the future
+	} else if (storeType == KeyValueStoreType::MEMORY) {
+		return keyValueStoreMemory(fn, id, 500e6);
+	} else if (storeType == KeyValueStoreType::MEMORY_RADIXTREE) {
+		return keyValueStoreMemory(fn, id, 500e6, "fdr", KeyValueStoreType::MEMORY_RADIXTREE);
+	}
+	ASSERT(false);
+	return nullptr;
+}
+
+// Closes the store and reopens it, returning the time taken to recover
+ACTOR Future<double> testKVRecovery(KVStoreTestWorkload* workload, KVTest* test, std::string fn, UID id) {
+	state Future<Void> closed = test->store->onClosed();
+	test->store->close();
+	test->store = nullptr;
+	wait(closed);
+
+	state double recoveryBegin = timer();
+	test->store = openKVStore(workload->storeType, fn, id);
+	wait(test->store->init());
+	// Reads wait for recovery to complete
+	wait(success(test->store->readValue(test->makeKey(0))));
+	state double took = timer() - recoveryBegin;
+	TraceEvent("KVStoreRecovery").detail("StoreType", workload->storeType.toString()).detail("Took", took);
+	fmt::print("Recovered in {0:0.3f}s\n", took);
+	return took;
+}
+
 ACTOR Future<Void> testKVStore(KVStoreTestWorkload* workload) {
 	state KVTest test(workload->nodeCount, !workload->filename.size(), workload->keyBytes);
 	state Error err;
@@ -378,26 +421,9 @@ ACTOR Future<Void> testKVStore(KVStoreTestWorkload* workload) {
 	// wait( delay(1) );
 	TraceEvent("GO").log();
 
-	UID id = deterministicRandom()->randomUniqueID();
-	std::string fn = workload->filename.size() ? workload->filename : id.toString();
-	if (workload->storeType == KeyValueStoreType::SSD_BTREE_V2) {
-		test.store = keyValueStoreSQLite(fn, id, KeyValueStoreType::SSD_BTREE_V2);
-	} else if (workload->storeType == KeyValueStoreType::SSD_BTREE_V1) {
-		test.store = keyValueStoreSQLite(fn, id, KeyValueStoreType::SSD_BTREE_V1);
-	} else if (workload->storeType == KeyValueStoreType::SSD_REDWOOD_V1) {
-		test.store = keyValueStoreRedwoodV1(fn, id);
-	} else if (workload->storeType == KeyValueStoreType::SSD_ROCKSDB_V1) {
-		test.store = keyValueStoreRocksDB(fn, id, KeyValueStoreType::SSD_ROCKSDB_V1);
-	} else if (workload->storeType == KeyValueStoreType::SSD_SHARDED_ROCKSDB) {
-		test.store = keyValueStoreRocksDB(
-		    fn, id, KeyValueStoreType::SSD_SHARDED_ROCKSDB); // TODO: to replace the KVS in the future
-	} else if (workload->storeType == KeyValueStoreType::MEMORY) {
-		test.store = keyValueStoreMemory(fn, id, 500e6);
-	} else if (workload->storeType == KeyValueStoreType::MEMORY_RADIXTREE) {
-		test.store = keyValueStoreMemory(fn, id, 500e6, "fdr", KeyValueStoreType::MEMORY_RADIXTREE);
-	} else {
-		ASSERT(false);
-	}
+	state UID id = deterministicRandom()->randomUniqueID();
+	state std::string fn = workload->filename.size() ? workload->filename : id.toString();
+	test.store = openKVStore(workload->storeType, fn, id);
 
 	wait(test.store->init());
 
@@ -409,6 +435,9 @@ ACTOR Future<Void> testKVStore(KVStoreTestWorkload* workload) {
 				ASSERT(false);
 			}
 		}
+		if (workload->doRecover) {
+			wait(store(workload->recoveryTook, testKVRecovery(workload, &test, fn, id)));
+		}
 	} catch (Error& e) {
 		err = e;
 	}
@@ -83,6 +83,8 @@ public: // introduced features
     API_VERSION_FEATURE(@FDB_AV_GET_CLIENT_STATUS@, GetClientStatus);
     API_VERSION_FEATURE(@FDB_AV_INITIALIZE_TRACE_ON_SETUP@, InitializeTraceOnSetup);
     API_VERSION_FEATURE(@FDB_AV_TENANT_GET_ID@, TenantGetId);
+    API_VERSION_FEATURE(@FDB_AV_CHANGE_FEED_API@, ChangeFeedApi);
+    API_VERSION_FEATURE(@FDB_AV_MULTI_GET@, MultiGet);
 };
 
 #endif // FLOW_CODE_API_VERSION_H
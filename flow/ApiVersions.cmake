@@ -25,3 +25,5 @@ set(FDB_AV_FUTURE_GET_DOUBLE                "730")
 set(FDB_AV_GET_CLIENT_STATUS                "730")
 set(FDB_AV_INITIALIZE_TRACE_ON_SETUP        "730")
 set(FDB_AV_TENANT_GET_ID                    "730")
+set(FDB_AV_CHANGE_FEED_API                  "800")
+set(FDB_AV_MULTI_GET                        "800")
@@ -105,6 +105,99 @@ void makeNoAccess(void*, size_t) {}
 void makeDefined(void*, size_t) {}
 void makeUndefined(void*, size_t) {}
 #endif
+
+// Blocks of 512 bytes and larger are allocated with operator new rather than by a FastAllocator, so arenas which are
+// created and destroyed at a high rate (request and reply arenas) spend much of their time in malloc and free. When
+// FLOW_KNOBS->ARENA_BLOCK_POOL_BYTES is positive, each thread keeps up to that many bytes of freed blocks, in one free
+// list per power of two size class, and reuses them for new blocks of the same size class.
+class ArenaBlockPool {
+public:
+	static constexpr int MIN_CLASS_SHIFT = 9; // 512 bytes, the smallest block not served by a FastAllocator
+	static constexpr int MAX_CLASS_SHIFT = 16; // 64KB, larger blocks are never pooled
+
+	~ArenaBlockPool() {
+		closed = true;
+		for (auto& head : freeLists) {
+			while (head) {
+				FreeBlock* b = head;
+				head = b->next;
+				makeDefined(b, sizeof(FreeBlock));
+				delete[] reinterpret_cast<uint8_t*>(b);
+			}
+		}
+	}
+
+	static bool enabled() {
+		return FLOW_KNOBS && FLOW_KNOBS->ARENA_BLOCK_POOL_BYTES > 0 && !keepalive_allocator::isActive();
+	}
+
+	// Returns the size class of a block of the given size, or -1 if blocks of this size are not pooled
+	static int sizeClass(int size) {
+		if (size < (1 << MIN_CLASS_SHIFT) || size > (1 << MAX_CLASS_SHIFT) || (size & (size - 1)) != 0) {
+			return -1;
+		}
+		return 31 - clz(size) - MIN_CLASS_SHIFT;
+	}
+
+	void* take(int size) {
+		int c = sizeClass(size);
+		if (c < 0 || !freeLists[c]) {
+			return nullptr;
+		}
+		FreeBlock* b = freeLists[c];
+		makeDefined(b, sizeof(FreeBlock));
+		freeLists[c] = b->next;
+		pooledBytes -= size;
+		makeUndefined(b, size);
+		return b;
+	}
+
+	// Keeps the block for reuse unless that would grow the pool beyond maxBytes
+	bool put(void* p, int size, int64_t maxBytes) {
+		int c = sizeClass(size);
+		if (c < 0 || closed || pooledBytes + size > maxBytes) {
+			return false;
+		}
+		FreeBlock* b = static_cast<FreeBlock*>(p);
+		b->next = freeLists[c];
+		freeLists[c] = b;
+		pooledBytes += size;
+		makeNoAccess(p, size);
+		return true;
+	}
+
+	int64_t getPooledBytes() const { return pooledBytes; }
+
+private:
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+
+	std::array<FreeBlock*, MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1> freeLists{};
+	int64_t pooledBytes = 0;
+	bool closed = false;
+};
+
+thread_local ArenaBlockPool arenaBlockPool;
+
+uint8_t* allocateBlock(int size) {
+	if (ArenaBlockPool::enabled()) {
+		static SimpleCounter<int64_t>* hits = SimpleCounter<int64_t>::makeCounter("/flow/arena/blockPoolHits");
+		static SimpleCounter<int64_t>* misses = SimpleCounter<int64_t>::makeCounter("/flow/arena/blockPoolMisses");
+		if (void* p = arenaBlockPool.take(size)) {
+			hits->increment(1);
+			return static_cast<uint8_t*>(p);
+		}
+		misses->increment(1);
+	}
+	return allocateAndMaybeKeepalive(size);
+}
+
+void releaseBlock(void* p, int size) {
+	if (!ArenaBlockPool::enabled() || !arenaBlockPool.put(p, size, FLOW_KNOBS->ARENA_BLOCK_POOL_BYTES)) {
+		freeOrMaybeKeepalive(p);
+	}
+}
 } // namespace
 
 Arena::Arena() : impl(nullptr) {}
@@ -411,23 +504,23 @@ ArenaBlock* ArenaBlock::create(int dataSize, Reference<ArenaBlock>& next) {
 				b->bigSize = 256;
 				INSTRUMENT_ALLOCATE("Arena256");
 			} else if (reqSize <= 512) {
-				b = (ArenaBlock*)allocateAndMaybeKeepalive(512);
+				b = (ArenaBlock*)allocateBlock(512);
 				b->bigSize = 512;
 				INSTRUMENT_ALLOCATE("Arena512");
 			} else if (reqSize <= 1024) {
-				b = (ArenaBlock*)allocateAndMaybeKeepalive(1024);
+				b = (ArenaBlock*)allocateBlock(1024);
 				b->bigSize = 1024;
 				INSTRUMENT_ALLOCATE("Arena1024");
 			} else if (reqSize <= 2048) {
-				b = (ArenaBlock*)allocateAndMaybeKeepalive(2048);
+				b = (ArenaBlock*)allocateBlock(2048);
 				b->bigSize = 2048;
 				INSTRUMENT_ALLOCATE("Arena2048");
 			} else if (reqSize <= 4096) {
-				b = (ArenaBlock*)allocateAndMaybeKeepalive(4096);
+				b = (ArenaBlock*)allocateBlock(4096);
 				b->bigSize = 4096;
 				INSTRUMENT_ALLOCATE("Arena4096");
 			} else {
-				b = (ArenaBlock*)allocateAndMaybeKeepalive(8192);
+				b = (ArenaBlock*)allocateBlock(8192);
 				b->bigSize = 8192;
 				INSTRUMENT_ALLOCATE("Arena8192");
 			}
@@ -439,7 +532,11 @@ ArenaBlock* ArenaBlock::create(int dataSize, Reference<ArenaBlock>& next) {
 #ifdef ALLOC_INSTRUMENTATION
 			allocInstr["ArenaHugeKB"].alloc((reqSize + 1023) >> 10);
 #endif
-			b = (ArenaBlock*)allocateAndMaybeKeepalive(reqSize);
+			if (ArenaBlockPool::enabled() && reqSize <= (1 << ArenaBlockPool::MAX_CLASS_SHIFT)) {
+				// Round up to a size class so that the block can be reused by the pool
+				reqSize = 1 << (32 - clz(reqSize - 1));
+			}
+			b = (ArenaBlock*)allocateBlock(reqSize);
 			b->tinySize = b->tinyUsed = NOT_TINY;
 			b->bigSize = reqSize;
 			b->totalSizeEstimate = b->bigSize;
@@ -535,26 +632,26 @@ void ArenaBlock::destroyLeaf() {
 			FastAllocator<256>::release(this);
 			INSTRUMENT_RELEASE("Arena256");
 		} else if (bigSize <= 512) {
-			freeOrMaybeKeepalive(this);
+			releaseBlock(this, bigSize);
 			INSTRUMENT_RELEASE("Arena512");
 		} else if (bigSize <= 1024) {
-			freeOrMaybeKeepalive(this);
+			releaseBlock(this, bigSize);
 			INSTRUMENT_RELEASE("Arena1024");
 		} else if (bigSize <= 2048) {
-			freeOrMaybeKeepalive(this);
+			releaseBlock(this, bigSize);
 			INSTRUMENT_RELEASE("Arena2048");
 		} else if (bigSize <= 4096) {
-			freeOrMaybeKeepalive(this);
+			releaseBlock(this, bigSize);
 			INSTRUMENT_RELEASE("Arena4096");
 		} else if (bigSize <= 8192) {
-			freeOrMaybeKeepalive(this);
+			releaseBlock(this, bigSize);
 			INSTRUMENT_RELEASE("Arena8192");
 		} else {
 #ifdef ALLOC_INSTRUMENTATION
 			allocInstr["ArenaHugeKB"].dealloc((bigSize + 1023) >> 10);
 #endif
 			g_hugeArenaMemory.fetch_sub(bigSize);
-			freeOrMaybeKeepalive(this);
+			releaseBlock(this, bigSize);
 		}
 	}
 }
@@ -1026,6 +1123,40 @@ TEST_CASE("/flow/Arena/OptionalMap") {
 	return Void();
 }
 
+TEST_CASE("/flow/Arena/BlockPool") {
+	ASSERT_EQ(ArenaBlockPool::sizeClass(256), -1);
+	ASSERT_EQ(ArenaBlockPool::sizeClass(512), 0);
+	ASSERT_EQ(ArenaBlockPool::sizeClass(8192), 4);
+	ASSERT_EQ(ArenaBlockPool::sizeClass(9000), -1);
+	ASSERT_EQ(ArenaBlockPool::sizeClass(1 << ArenaBlockPool::MAX_CLASS_SHIFT), 7);
+	ASSERT_EQ(ArenaBlockPool::sizeClass(2 << ArenaBlockPool::MAX_CLASS_SHIFT), -1);
+
+	ArenaBlockPool pool;
+	const int64_t maxBytes = 8192;
+	uint8_t* small = new uint8_t[1024];
+	uint8_t* large = new uint8_t[4096];
+	ASSERT(pool.put(small, 1024, maxBytes));
+	ASSERT(pool.put(large, 4096, maxBytes));
+	ASSERT_EQ(pool.getPooledBytes(), 5120);
+
+	// Blocks which are not pooled are left to the caller to free
+	uint8_t* odd = new uint8_t[3000];
+	ASSERT(!pool.put(odd, 3000, maxBytes));
+	delete[] odd;
+	uint8_t* overLimit = new uint8_t[4096];
+	ASSERT(!pool.put(overLimit, 4096, maxBytes));
+	delete[] overLimit;
+
+	ASSERT(pool.take(2048) == nullptr);
+	ASSERT(pool.take(4096) == large);
+	ASSERT(pool.take(4096) == nullptr);
+	ASSERT_EQ(pool.getPooledBytes(), 1024);
+	delete[] large;
+
+	// The remaining block is freed by the pool's destructor
+	return Void();
+}
+
 TEST_CASE("/flow/Arena/Secure") {
 	auto& rng = *deterministicRandom();
 	auto sizes = std::vector<int>{ 1 };
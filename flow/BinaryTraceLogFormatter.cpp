@@ -0,0 +1,155 @@
+/*
+ * BinaryTraceLogFormatter.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "flow/flow.h"
+#include "flow/BinaryTraceLogFormatter.h"
+#include "flow/JsonTraceLogFormatter.h"
+#include "flow/UnitTest.h"
+
+#include <cstring>
+
+void BinaryTraceLogFormatter::addref() {
+	ReferenceCounted<BinaryTraceLogFormatter>::addref();
+}
+
+void BinaryTraceLogFormatter::delref() {
+	ReferenceCounted<BinaryTraceLogFormatter>::delref();
+}
+
+const char* BinaryTraceLogFormatter::getExtension() const {
+	return "bin";
+}
+
+const char* BinaryTraceLogFormatter::getHeader() const {
+	return HEADER.data();
+}
+
+const char* BinaryTraceLogFormatter::getFooter() const {
+	return "";
+}
+
+namespace {
+
+void appendUInt32(std::string& out, uint32_t value) {
+	uint8_t bytes[4] = { uint8_t(value), uint8_t(value >> 8), uint8_t(value >> 16), uint8_t(value >> 24) };
+	out.append(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+bool readUInt32(std::string_view& data, uint32_t& value) {
+	if (data.size() < 4) {
+		return false;
+	}
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.data());
+	value = uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) | (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[3]) << 24);
+	data.remove_prefix(4);
+	return true;
+}
+
+bool readString(std::string_view& data, std::string& value) {
+	uint32_t length;
+	if (!readUInt32(data, length) || data.size() < length) {
+		return false;
+	}
+	value.assign(data.data(), length);
+	data.remove_prefix(length);
+	return true;
+}
+
+} // namespace
+
+std::string BinaryTraceLogFormatter::formatEvent(const TraceEventFields& fields) const {
+	std::string result;
+	result.reserve(4 + 8 * fields.size() + fields.sizeBytes());
+	appendUInt32(result, fields.size());
+	for (const auto& [key, value] : fields) {
+		appendUInt32(result, key.size());
+		result.append(key);
+		appendUInt32(result, value.size());
+		result.append(value);
+	}
+	return result;
+}
+
+bool BinaryTraceLogFormatter::decode(std::string_view data, std::vector<TraceEventFields>& events) {
+	// Each trace file, including every file after a roll, starts with the header exactly once
+	if (data.substr(0, HEADER.size()) != HEADER) {
+		return false;
+	}
+	data.remove_prefix(HEADER.size());
+
+	while (!data.empty()) {
+		TraceEventFields event;
+		uint32_t fieldCount;
+		if (!readUInt32(data, fieldCount)) {
+			return false;
+		}
+		for (uint32_t i = 0; i < fieldCount; i++) {
+			std::string key, value;
+			if (!readString(data, key) || !readString(data, value)) {
+				return false;
+			}
+			event.addField(std::move(key), std::move(value));
+		}
+		events.push_back(std::move(event));
+	}
+	return true;
+}
+
+TEST_CASE("/flow/Trace/BinaryFormat") {
+	BinaryTraceLogFormatter binary;
+	JsonTraceLogFormatter json;
+
+	std::vector<TraceEventFields> events;
+	for (int i = 0; i < 100; i++) {
+		TraceEventFields event;
+		event.addField("Type", "Test" + std::to_string(i));
+		int fields = deterministicRandom()->randomInt(0, 10);
+		for (int f = 0; f < fields; f++) {
+			// Values may contain any bytes, including the ones the JSON formatter has to escape
+			event.addField("Field" + std::to_string(f),
+			               deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(0, 20)) +
+			                   std::string("\0\"\n", 3));
+		}
+		events.push_back(std::move(event));
+	}
+
+	std::string file = binary.getHeader();
+	for (const auto& event : events) {
+		file += binary.formatEvent(event);
+	}
+
+	std::vector<TraceEventFields> decoded;
+	ASSERT(BinaryTraceLogFormatter::decode(file, decoded));
+	ASSERT_EQ(decoded.size(), events.size());
+	for (int i = 0; i < events.size(); i++) {
+		ASSERT(json.formatEvent(decoded[i]) == json.formatEvent(events[i]));
+	}
+
+	// A file cut short while writing keeps the events before the partial one
+	decoded.clear();
+	std::string_view truncated(file.data(), file.size() - 1);
+	ASSERT(!BinaryTraceLogFormatter::decode(truncated, decoded));
+	ASSERT_EQ(decoded.size(), events.size() - 1);
+
+	decoded.clear();
+	ASSERT(!BinaryTraceLogFormatter::decode("<?xml", decoded));
+	ASSERT(decoded.empty());
+	return Void();
+}
@@ -25,6 +25,8 @@
 #include "flow/IRandom.h"
 #include "flow/UnitTest.h"
 
+#include <limits>
+
 #ifdef ZSTD_LIB_SUPPORTED
 #define ZSTD_STATIC_LINKING_ONLY
 #include <zstd.h>
@@ -83,15 +85,28 @@ StringRef CompressionUtils::compress(const CompressionFilter filter, const Strin
 }
 
 StringRef CompressionUtils::decompress(const CompressionFilter filter, const StringRef& data, Arena& arena) {
+	return decompress(filter, data, std::numeric_limits<int64_t>::max(), arena);
+}
+
+StringRef CompressionUtils::decompress(const CompressionFilter filter,
+                                       const StringRef& data,
+                                       int64_t maxSize,
+                                       Arena& arena) {
 	checkFilterSupported(filter);
 
 	if (filter == CompressionFilter::NONE) {
+		if (data.size() > maxSize) {
+			throw serialization_failed();
+		}
 		return StringRef(arena, data);
 	}
 #ifdef ZSTD_LIB_SUPPORTED
 	if (filter == CompressionFilter::ZSTD) {
 		const char* src = reinterpret_cast<const char*>(data.begin());
-		size_t destSize = ZSTD_decompressBound(src, data.size());
+		unsigned long long destSize = ZSTD_decompressBound(src, data.size());
+		if (destSize == ZSTD_CONTENTSIZE_ERROR || destSize > static_cast<unsigned long long>(maxSize)) {
+			throw serialization_failed();
+		}
 		std::unique_ptr<uint8_t[]> dest = std::make_unique<uint8_t[]>(destSize);
 		size_t bytes = ZSTD_decompress(dest.get(), destSize, src, data.size());
 		if (ZSTD_isError(bytes)) {
@@ -206,4 +221,21 @@ TEST_CASE("/CompressionUtils/zstdCompression2") {
 
 	return Void();
 }
+
+TEST_CASE("/CompressionUtils/zstdMaxSize") {
+	Arena arena;
+	const int size = deterministicRandom()->randomInt(512, 1024);
+	std::string s(size, 'x');
+	StringRef compressed = CompressionUtils::compress(CompressionFilter::ZSTD, StringRef(s), arena);
+
+	ASSERT_EQ(CompressionUtils::decompress(CompressionFilter::ZSTD, compressed, size, arena).compare(StringRef(s)), 0);
+	try {
+		CompressionUtils::decompress(CompressionFilter::ZSTD, compressed, size - 1, arena);
+		ASSERT(false);
+	} catch (Error& e) {
+		ASSERT_EQ(e.code(), error_code_serialization_failed);
+	}
+
+	return Void();
+}
 #endif
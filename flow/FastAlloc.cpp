@@ -30,6 +30,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <mutex>
 #include <unordered_map>
 
 #ifdef WIN32
@@ -113,6 +114,7 @@ template <int Size>
 void* FastAllocator<Size>::freelist = nullptr;
 
 std::atomic<int64_t> g_hugeArenaMemory(0);
+std::atomic<int64_t> g_hugePageMagazineMemory(0);
 
 double hugeArenaLastLogged = 0;
 std::map<std::string, std::pair<int, int64_t>> hugeArenaTraces;
@@ -251,7 +253,12 @@ struct FastAllocator<Size>::GlobalData {
 	std::atomic<long long> totalMemory;
 	long long partialMagazineUnallocatedMemory;
 	std::atomic<long long> activeThreads;
-	GlobalData() : totalMemory(0), partialMagazineUnallocatedMemory(0), activeThreads(0) {
+	SimpleCounter<int64_t>* allocatedBytes;
+	SimpleCounter<int64_t>* releasedBytes;
+	GlobalData()
+	  : totalMemory(0), partialMagazineUnallocatedMemory(0), activeThreads(0),
+	    allocatedBytes(SimpleCounter<int64_t>::makeCounter(format("/flow/fastalloc/allocateBytesSize%d", Size))),
+	    releasedBytes(SimpleCounter<int64_t>::makeCounter(format("/flow/fastalloc/releaseBytesSize%d", Size))) {
 		InitializeCriticalSection(&mutex);
 	}
 };
@@ -276,6 +283,16 @@ long long FastAllocator<Size>::getActiveThreads() {
 	return globalData()->activeThreads.load();
 }
 
+template <int Size>
+long long FastAllocator<Size>::getLiveMemory() {
+	return globalData()->allocatedBytes->get() - globalData()->releasedBytes->get();
+}
+
+template <int Size>
+long long FastAllocator<Size>::getMagazineCount() {
+	return globalData()->totalMemory.load() / (magazine_size * Size);
+}
+
 #if FAST_ALLOCATOR_DEBUG
 static int64_t getSizeCode(int i) {
 	switch (i) {
@@ -380,8 +397,7 @@ void* FastAllocator<Size>::allocate() {
 	static int size = Size;
 	static SimpleCounter<int64_t>* calls =
 	    SimpleCounter<int64_t>::makeCounter(format("/flow/fastalloc/allocateCallsSize%d", size));
-	static SimpleCounter<int64_t>* bytes =
-	    SimpleCounter<int64_t>::makeCounter(format("/flow/fastalloc/allocateBytesSize%d", size));
+	static SimpleCounter<int64_t>* bytes = globalData()->allocatedBytes;
 	calls->increment(1);
 	bytes->increment(size);
 
@@ -464,8 +480,7 @@ void FastAllocator<Size>::release(void* ptr) {
 	static int size = Size;
 	static SimpleCounter<int64_t>* calls =
 	    SimpleCounter<int64_t>::makeCounter(format("/flow/fastalloc/releaseCallsSize%d", size));
-	static SimpleCounter<int64_t>* bytes =
-	    SimpleCounter<int64_t>::makeCounter(format("/flow/fastalloc/releaseBytesSize%d", size));
+	static SimpleCounter<int64_t>* bytes = globalData()->releasedBytes;
 	calls->increment(1);
 	bytes->increment(size);
 
@@ -568,6 +583,46 @@ FastAllocator<Size>::ThreadData::ThreadData() {
 	count = 0;
 }
 
+namespace {
+
+// Magazines are much smaller than a 2MB huge page, so allocating each one from its own huge page would strand most of
+// the page (see issue #909). Instead, huge page backed magazines of every size class are carved out of shared 2MB
+// regions. Like all other magazines they are never returned to the system, so no region is ever partially freed.
+constexpr size_t kHugePageBytes = 2 << 20;
+static_assert(kHugePageBytes % kFastAllocMagazineBytes == 0);
+
+std::mutex hugePageRegionMutex;
+uint8_t* hugePageRegionNext = nullptr;
+uint8_t* hugePageRegionEnd = nullptr;
+bool hugePagesUnavailable = false;
+
+// Returns kFastAllocMagazineBytes of huge page backed memory, or nullptr if FLOW_KNOBS->FAST_ALLOC_HUGE_PAGES is not
+// set or the system has no huge pages
+void* allocateHugePageMagazine() {
+	if (!FLOW_KNOBS || FLOW_KNOBS->FAST_ALLOC_HUGE_PAGES == 0 || FLOW_KNOBS->FAST_ALLOC_ALLOW_GUARD_PAGES) {
+		return nullptr;
+	}
+	std::lock_guard<std::mutex> lock(hugePageRegionMutex);
+	if (hugePageRegionNext == hugePageRegionEnd) {
+		if (hugePagesUnavailable) {
+			return nullptr;
+		}
+		void* region = allocateHugePages(kHugePageBytes, FLOW_KNOBS->FAST_ALLOC_HUGE_PAGES == 2);
+		if (!region) {
+			hugePagesUnavailable = true;
+			return nullptr;
+		}
+		hugePageRegionNext = static_cast<uint8_t*>(region);
+		hugePageRegionEnd = hugePageRegionNext + kHugePageBytes;
+	}
+	void* magazine = hugePageRegionNext;
+	hugePageRegionNext += kFastAllocMagazineBytes;
+	g_hugePageMagazineMemory.fetch_add(kFastAllocMagazineBytes);
+	return magazine;
+}
+
+} // namespace
+
 template <int Size>
 void FastAllocator<Size>::getMagazine() {
 	ThreadData& thr = threadData();
@@ -617,9 +672,6 @@ void FastAllocator<Size>::getMagazine() {
 	ASSERT(block == desiredBlock);
 #endif
 #else
-	// FIXME: We should be able to allocate larger magazine sizes here if we
-	// detect that the underlying system supports hugepages.  Using hugepages
-	// with smaller-than-2MiB magazine sizes strands memory.  See issue #909.
 #if !DEBUG_DETERMINISM
 	if (FLOW_KNOBS && g_allocation_tracing_disabled == 0 &&
 	    nondeterministicRandom()->random01() < (magazine_size * Size) / FLOW_KNOBS->FAST_ALLOC_LOGGING_BYTES) {
@@ -635,7 +687,10 @@ void FastAllocator<Size>::getMagazine() {
 #endif
 	// NOTE: rely on lower level metrics in allocate() (and whatever it calls)
 	// for accounting the allocations it does.
-	block = (void**)::allocate(magazine_size * Size, /*allowLargePages*/ false, includeGuardPages);
+	block = (void**)allocateHugePageMagazine();
+	if (!block) {
+		block = (void**)::allocate(magazine_size * Size, /*allowLargePages*/ false, includeGuardPages);
+	}
 #endif
 
 	// void** block = new void*[ magazine_size * PSize ];
@@ -28,6 +28,8 @@
 // either we pull g_simulator into flow, or flow (and the I/O path) will be unable to log performance
 // metrics.
 #include <limits>
+#include <thread>
+#include <vector>
 
 #pragma region HistogramRegistry
 
@@ -68,17 +70,48 @@ Histogram* HistogramRegistry::lookupHistogram(std::string const& name) {
 	return h->second;
 }
 
+void HistogramRegistry::registerHistogram(LogLinearHistogram* h) {
+	if (logLinearHistograms.find(h->name()) != logLinearHistograms.end()) {
+		TraceEvent(SevError, "HistogramDoubleRegistered").detail("group", h->group).detail("op", h->op);
+		ASSERT(false);
+	}
+	logLinearHistograms.insert(std::pair<std::string, LogLinearHistogram*>(h->name(), h));
+}
+
+void HistogramRegistry::unregisterHistogram(LogLinearHistogram* h) {
+	std::string name = h->name();
+	if (logLinearHistograms.find(name) == logLinearHistograms.end()) {
+		TraceEvent(SevError, "HistogramNotRegistered").detail("group", h->group).detail("op", h->op);
+	}
+	int count = logLinearHistograms.erase(name);
+	ASSERT(count == 1);
+}
+
+LogLinearHistogram* HistogramRegistry::lookupLogLinearHistogram(std::string const& name) {
+	auto h = logLinearHistograms.find(name);
+	if (h == logLinearHistograms.end()) {
+		return nullptr;
+	}
+	return h->second;
+}
+
 void HistogramRegistry::logReport(double elapsed) {
 	for (auto& i : histograms) {
 		// Reset all buckets in writeToLog function
 		i.second->writeToLog(elapsed);
 	}
+	for (auto& i : logLinearHistograms) {
+		i.second->writeToLog(elapsed);
+	}
 }
 
 void HistogramRegistry::clear() {
 	for (auto& i : histograms) {
 		i.second->clear();
 	}
+	for (auto& i : logLinearHistograms) {
+		i.second->clear();
+	}
 }
 
 #pragma endregion // HistogramRegistry
@@ -205,6 +238,104 @@ std::string Histogram::drawHistogram() {
 
 #pragma endregion // Histogram
 
+#pragma region LogLinearHistogram
+
+Reference<LogLinearHistogram> LogLinearHistogram::getHistogram(StringRef group, StringRef op, Unit unit) {
+	std::string group_str = group.toString();
+	std::string op_str = op.toString();
+	HistogramRegistry& registry = GetHistogramRegistry();
+	LogLinearHistogram* h = registry.lookupLogLinearHistogram(group_str + ":" + op_str);
+	if (!h) {
+		h = new LogLinearHistogram(Reference<HistogramRegistry>::addRef(&registry), group_str, op_str, unit);
+		registry.registerHistogram(h);
+		return Reference<LogLinearHistogram>(h);
+	} else {
+		return Reference<LogLinearHistogram>::addRef(h);
+	}
+}
+
+void LogLinearHistogram::merge(LogLinearHistogram const& other) {
+	for (int i = 0; i < BUCKETS; i++) {
+		uint64_t n = other.buckets[i].load(std::memory_order_relaxed);
+		if (n) {
+			buckets[i].fetch_add(n, std::memory_order_relaxed);
+		}
+	}
+	count.fetch_add(other.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	sum.fetch_add(other.sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	updateMin(other.min.load(std::memory_order_relaxed));
+	updateMax(other.max.load(std::memory_order_relaxed));
+}
+
+uint64_t LogLinearHistogram::getMin() const {
+	return getCount() ? min.load(std::memory_order_relaxed) : 0;
+}
+
+double LogLinearHistogram::getMean() const {
+	uint64_t n = getCount();
+	return n ? double(sum.load(std::memory_order_relaxed)) / n : 0;
+}
+
+uint64_t LogLinearHistogram::percentile(double p) const {
+	ASSERT(p >= 0 && p <= 1);
+	// The total is taken from the buckets rather than count, which a concurrent sample may have updated first
+	uint64_t total = 0;
+	for (auto const& b : buckets) {
+		total += b.load(std::memory_order_relaxed);
+	}
+	if (total == 0) {
+		return 0;
+	}
+
+	uint64_t rank = std::max<uint64_t>(1, std::ceil(p * total));
+	uint64_t seen = 0;
+	int index = 0;
+	for (; index < BUCKETS - 1; index++) {
+		seen += buckets[index].load(std::memory_order_relaxed);
+		if (seen >= rank) {
+			break;
+		}
+	}
+	uint64_t lower = bucketLowerBound(index);
+	uint64_t value = lower + (bucketUpperBound(index) - lower) / 2;
+	return std::clamp(value, getMin(), std::max(getMin(), getMax()));
+}
+
+void LogLinearHistogram::clear() {
+	for (auto& b : buckets) {
+		b.store(0, std::memory_order_relaxed);
+	}
+	count.store(0, std::memory_order_relaxed);
+	sum.store(0, std::memory_order_relaxed);
+	min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+	max.store(0, std::memory_order_relaxed);
+}
+
+void LogLinearHistogram::writeToLog(double elapsed) {
+	uint64_t n = getCount();
+	if (!n) {
+		return;
+	}
+
+	// Latencies are sampled in microseconds and reported in milliseconds, like the bucket bounds of Histogram
+	double scale = unit == Unit::milliseconds ? 1e-3 : 1.0;
+	TraceEvent e(SevInfo, "LogLinearHistogram");
+	e.detail("Group", group).detail("Op", op).detail("Unit", Histogram::UnitToStringMapper[(size_t)unit]);
+	if (elapsed > 0)
+		e.detail("Elapsed", elapsed);
+	e.detail("Count", n)
+	    .detail("Min", getMin() * scale)
+	    .detail("Max", getMax() * scale)
+	    .detail("Mean", getMean() * scale)
+	    .detail("P50", percentile(0.5) * scale)
+	    .detail("P90", percentile(0.9) * scale)
+	    .detail("P99", percentile(0.99) * scale)
+	    .detail("P99.9", percentile(0.999) * scale);
+	clear();
+}
+
+#pragma endregion // LogLinearHistogram
+
 TEST_CASE("/flow/histogram/smoke_test") {
 	{
 		Reference<Histogram> h = Histogram::getHistogram("smoke_test"_sr, "counts"_sr, Histogram::Unit::bytes);
@@ -249,3 +380,64 @@ TEST_CASE("/flow/histogram/smoke_test") {
 
 	return Void();
 }
+
+TEST_CASE("/flow/histogram/log_linear") {
+	using H = LogLinearHistogram;
+
+	// Every value falls in a bucket whose bounds are within 1/SUB_BUCKETS of it
+	for (int i = 0; i < 10000; i++) {
+		uint64_t value = deterministicRandom()->randomInt64(0, H::MAX_VALUE) >> deterministicRandom()->randomInt(0, 40);
+		int index = H::bucketIndex(value);
+		ASSERT(index >= 0 && index < H::BUCKETS);
+		ASSERT(H::bucketLowerBound(index) <= value && value <= H::bucketUpperBound(index));
+		ASSERT(H::bucketUpperBound(index) - H::bucketLowerBound(index) <= value / H::SUB_BUCKETS);
+	}
+	ASSERT_EQ(H::bucketIndex(H::MAX_VALUE), H::BUCKETS - 1);
+	ASSERT_EQ(H::bucketIndex(std::numeric_limits<uint64_t>::max()), H::BUCKETS - 1);
+	for (int i = 1; i < H::BUCKETS; i++) {
+		ASSERT_EQ(H::bucketLowerBound(i), H::bucketUpperBound(i - 1) + 1);
+	}
+
+	Reference<H> h = H::getHistogram("log_linear_test"_sr, "latency"_sr, H::Unit::milliseconds);
+	ASSERT(GetHistogramRegistry().lookupLogLinearHistogram("log_linear_test:latency") == h.getPtr());
+	ASSERT_EQ(h->percentile(0.5), 0);
+
+	// Samples from several threads are neither lost nor double counted
+	constexpr int threadCount = 4;
+	constexpr int samplesPerThread = 100000;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCount; t++) {
+		threads.emplace_back([h = h.getPtr()]() {
+			for (int i = 1; i <= samplesPerThread; i++) {
+				h->sample(i);
+			}
+		});
+	}
+	for (auto& t : threads) {
+		t.join();
+	}
+	ASSERT_EQ(h->getCount(), threadCount * samplesPerThread);
+	ASSERT_EQ(h->getMin(), 1);
+	ASSERT_EQ(h->getMax(), samplesPerThread);
+	ASSERT(std::abs(h->getMean() - (samplesPerThread + 1) / 2.0) < 1e-6);
+	for (double p : { 0.5, 0.9, 0.99, 0.999 }) {
+		double expected = p * samplesPerThread;
+		ASSERT(std::abs(h->percentile(p) - expected) <= expected / H::SUB_BUCKETS);
+	}
+
+	// Merging two histograms gives the distribution of the union of their samples
+	H other(Reference<HistogramRegistry>(), "", "", H::Unit::MAXHISTOGRAMUNIT);
+	for (int i = 0; i < 1000; i++) {
+		other.sample(1000000 + i);
+	}
+	h->merge(other);
+	ASSERT_EQ(h->getCount(), threadCount * samplesPerThread + 1000);
+	ASSERT_EQ(h->getMax(), 1000999);
+	ASSERT(h->percentile(1.0) >= 1000000);
+	ASSERT(h->percentile(0.5) < samplesPerThread);
+
+	GetHistogramRegistry().logReport();
+	ASSERT_EQ(h->getCount(), 0);
+	ASSERT_EQ(h->getMin(), 0);
+	return Void();
+}
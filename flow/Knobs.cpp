@@ -73,8 +73,10 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 
 	init( FAST_ALLOC_LOGGING_BYTES,                           10e6 );
 	init( FAST_ALLOC_ALLOW_GUARD_PAGES,                      false );
+	init( FAST_ALLOC_HUGE_PAGES,                                  0 ); if( randomize && BUGGIFY ) FAST_ALLOC_HUGE_PAGES = 1; // 0: regular pages, 1: transparent huge pages, 2: explicit huge pages, falling back to transparent ones
 	init( HUGE_ARENA_LOGGING_BYTES,                          100e6 );
 	init( HUGE_ARENA_LOGGING_INTERVAL,                         5.0 );
+	init( ARENA_BLOCK_POOL_BYTES,                                0 ); if( randomize && BUGGIFY ) ARENA_BLOCK_POOL_BYTES = 1 << 20; // Per thread, 0 disables pooling of freed arena blocks
 	init( ABORT_ON_FAILURE,                                  false );
 
 	init( MEMORY_USAGE_CHECK_INTERVAL,                         1.0 );
@@ -161,7 +163,7 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( BUGGIFY_SIM_PAGE_CACHE_64K,                          1e6 );
 	init( BLOB_WORKER_PAGE_CACHE,                            500e6 );
 	init( MAX_EVICT_ATTEMPTS,                                  100 ); if( randomize && BUGGIFY ) MAX_EVICT_ATTEMPTS = 2;
-	init( CACHE_EVICTION_POLICY,                          "random" );
+	init( CACHE_EVICTION_POLICY,                          "random" ); if( randomize && BUGGIFY ) CACHE_EVICTION_POLICY = deterministicRandom()->coinflip() ? "lru" : "clock";
 	init( PAGE_CACHE_TRUNCATE_LOOKUP_FRACTION,                 0.1 ); if( randomize && BUGGIFY ) PAGE_CACHE_TRUNCATE_LOOKUP_FRACTION = 0.0; else if( randomize && BUGGIFY ) PAGE_CACHE_TRUNCATE_LOOKUP_FRACTION = 1.0;
 	init( FLOW_CACHEDFILE_WRITE_IO_SIZE,                         0 );
 	if ( randomize && BUGGIFY) {
@@ -187,6 +189,10 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( PAGE_WRITE_CHECKSUM_HISTORY,                           0 ); if( randomize && BUGGIFY ) PAGE_WRITE_CHECKSUM_HISTORY = 10000000;
 	init( DISABLE_POSIX_KERNEL_AIO,                              0 );
 
+	//AsyncFileIOUring
+	init( USE_IO_URING,                                          0 );
+	init( IO_URING_FIXED_FILES,                               1024 );
+
 	//AsyncFileNonDurable
 	init( NON_DURABLE_MAX_WRITE_DELAY,                         2.0 ); if( randomize && BUGGIFY ) NON_DURABLE_MAX_WRITE_DELAY = 5.0;
 	init( MAX_PRIOR_MODIFICATION_DELAY,                        1.0 ); if( randomize && BUGGIFY ) MAX_PRIOR_MODIFICATION_DELAY = 10.0;
@@ -220,6 +226,7 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( MIN_LOGGED_PRIORITY_BUSY_FRACTION,                  0.05 );
 	init( CERT_FILE_MAX_SIZE,                      5 * 1024 * 1024 );
 	init( READY_QUEUE_RESERVED_SIZE,                          8192 );
+	init( BUCKETED_TASK_QUEUE,                               false ); if( randomize && BUGGIFY ) BUCKETED_TASK_QUEUE = true;
 	init( TASKS_PER_REACTOR_CHECK,                             100 );
 
 	//Network
@@ -232,6 +239,8 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( FLOW_TCP_NODELAY,                                      1 );
 	init( FLOW_TCP_QUICKACK,                                     0 );
 	init( RESOLVE_PREFER_IPV4_ADDR,                          false );  // Default to prefer IPv6 addresses. Set to true to prefer IPv4 addresses.
+	init( PEER_COMPRESSION_MODE,                                 0 ); if( randomize && BUGGIFY ) PEER_COMPRESSION_MODE = deterministicRandom()->randomInt(0, 3); // 0: never, 1: between data centers, 2: always
+	init( PEER_COMPRESSION_MIN_PACKET_BYTES,                  4096 ); if( randomize && BUGGIFY ) PEER_COMPRESSION_MIN_PACKET_BYTES = deterministicRandom()->randomInt(0, 4096);
 
 	//Sim2
 	init( MIN_OPEN_TIME,                                    0.0002 );
@@ -285,6 +294,7 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( SECOND_REQUEST_MULTIPLIER_DECAY,                 0.00025 );
 	init( SECOND_REQUEST_BUDGET_GROWTH,                       0.05 );
 	init( SECOND_REQUEST_MAX_BUDGET,                         100.0 );
+	init( CANCEL_LOST_SECOND_REQUESTS,                        true ); if( randomize && BUGGIFY ) CANCEL_LOST_SECOND_REQUESTS = false;
 	init( ALTERNATIVES_FAILURE_RESET_TIME,                     5.0 );
 	init( ALTERNATIVES_FAILURE_MIN_DELAY,                     0.05 );
 	init( ALTERNATIVES_FAILURE_DELAY_RATIO,                    0.2 );
@@ -29,6 +29,7 @@
 #include "flow/swift_concurrency_hooks.h"
 #include <algorithm>
 #include <memory>
+#include <numeric>
 #include <string_view>
 #ifndef BOOST_SYSTEM_NO_LIB
 #define BOOST_SYSTEM_NO_LIB
@@ -2309,6 +2310,70 @@ TEST_CASE("flow/Net2/ThreadSafeQueue/Interface") {
 	return Void();
 }
 
+TEST_CASE("flow/Net2/TaskQueue/Bucketed") {
+	// Runs the same random schedule through the heap and bucketed task queues. Ready tasks must come out in the same
+	// order, and the same timers must become ready at each step.
+	TaskQueue<int> heap(false);
+	TaskQueue<int> bucketed(true);
+	std::vector<int> tasks(20000);
+	std::iota(tasks.begin(), tasks.end(), 0);
+	auto randomPriority = []() {
+		return static_cast<TaskPriority>(deterministicRandom()->randomChoice(
+		    std::vector<int>{ 0, 1000, 2000, 7000, 7010, 8000, 8999, 9000, 10000, 30000, 1000000 }));
+	};
+
+	int next = 0;
+	while (next < 10000) {
+		for (int i = deterministicRandom()->randomInt(0, 20); i > 0 && next < 10000; --i) {
+			TaskPriority priority = randomPriority();
+			heap.addReady(priority, &tasks[next]);
+			bucketed.addReady(priority, &tasks[next++]);
+		}
+		for (int i = deterministicRandom()->randomInt(0, 20); i > 0 && heap.hasReadyTask(); --i) {
+			ASSERT(bucketed.hasReadyTask());
+			ASSERT_EQ(heap.getNumReadyTasks(), bucketed.getNumReadyTasks());
+			ASSERT(heap.getReadyTaskID() == bucketed.getReadyTaskID());
+			ASSERT(heap.getReadyTask() == bucketed.getReadyTask());
+			ASSERT(bucketed.getReadyTaskPriority() < int64_t(heap.getReadyTaskID()) << 32);
+			ASSERT(bucketed.getReadyTaskPriority() > (int64_t(heap.getReadyTaskID()) - 1) << 32);
+			heap.popReadyTask();
+			bucketed.popReadyTask();
+		}
+	}
+	heap.clear();
+	bucketed.clear();
+	ASSERT(!bucketed.hasReadyTask());
+
+	// Timers from a millisecond to days away, in both the wheel and its overflow
+	double now = 1e9;
+	while (next < tasks.size()) {
+		for (int i = deterministicRandom()->randomInt(0, 50); i > 0 && next < tasks.size(); --i) {
+			double at = now + deterministicRandom()->random01() * std::pow(10, deterministicRandom()->randomInt(-3, 6));
+			TaskPriority priority = randomPriority();
+			heap.addTimer(at, priority, &tasks[next]);
+			bucketed.addTimer(at, priority, &tasks[next++]);
+		}
+		ASSERT_EQ(heap.getSleepTime(now), bucketed.getSleepTime(now));
+		now += deterministicRandom()->coinflip() ? heap.getSleepTime(now)
+		                                         : deterministicRandom()->random01() * 0.01;
+		heap.processReadyTimers(now);
+		bucketed.processReadyTimers(now);
+		std::vector<int*> fromHeap, fromBucketed;
+		while (heap.hasReadyTask()) {
+			fromHeap.push_back(heap.getReadyTask());
+			heap.popReadyTask();
+		}
+		while (bucketed.hasReadyTask()) {
+			fromBucketed.push_back(bucketed.getReadyTask());
+			bucketed.popReadyTask();
+		}
+		std::sort(fromHeap.begin(), fromHeap.end());
+		std::sort(fromBucketed.begin(), fromBucketed.end());
+		ASSERT(fromHeap == fromBucketed);
+	}
+	return Void();
+}
+
 // A helper struct used by queueing tests which use multiple threads.
 struct QueueTestThreadState {
 	QueueTestThreadState(int threadId, int toProduce) : threadId(threadId), toProduce(toProduce) {}
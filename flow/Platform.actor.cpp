@@ -2184,6 +2184,44 @@ void* allocate(size_t length, bool allowLargePages, bool includeGuardPages) {
 	return block;
 }
 
+void* allocateHugePages(size_t length, bool explicitHugePages) {
+#if defined(__linux__)
+	static std::atomic<bool> explicitHugePagesFailed(false);
+	if (explicitHugePages && !explicitHugePagesFailed.load()) {
+		void* block = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (block != MAP_FAILED) {
+			return block;
+		}
+		// Usually no huge pages are reserved (vm.nr_hugepages), so don't retry for every allocation
+		explicitHugePagesFailed = true;
+	}
+
+	// Transparent huge pages are only used for 2MB aligned ranges, so map an extra 2MB and trim both ends
+	constexpr size_t hugePageSize = 2 << 20;
+	size_t mappedLength = length + hugePageSize;
+	void* mapped = mmap(nullptr, mappedLength, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (mapped == MAP_FAILED) {
+		return nullptr;
+	}
+	uintptr_t begin = uintptr_t(mapped);
+	uintptr_t aligned = (begin + hugePageSize - 1) & ~uintptr_t(hugePageSize - 1);
+	if (aligned > begin) {
+		munmap(mapped, aligned - begin);
+	}
+	if (begin + mappedLength > aligned + length) {
+		munmap((void*)(aligned + length), begin + mappedLength - (aligned + length));
+	}
+	if (madvise((void*)aligned, length, MADV_HUGEPAGE) != 0) {
+		// The kernel was built without transparent huge page support
+		munmap((void*)aligned, length);
+		return nullptr;
+	}
+	return (void*)aligned;
+#else
+	return nullptr;
+#endif
+}
+
 void setAffinity(int proc) {
 #if defined(_WIN32)
 	/*if (SetProcessAffinityMask(GetCurrentProcess(), 0x5555))//0x5555555555555555UL))
@@ -4340,6 +4378,27 @@ void platformSpecificDirectoryOpsTests(const std::string& cwd, int& errors) {
 void platformSpecificDirectoryOpsTests(const std::string& cwd, int& errors) {}
 #endif
 
+// Checks that a block returned by allocateHugePages() is aligned and usable, then unmaps it
+static void checkHugePageBlock(uint8_t* block, size_t length) {
+#if defined(__linux__)
+	ASSERT_EQ(uintptr_t(block) % (2 << 20), 0);
+	memset(block, 0xab, length);
+	ASSERT(block[0] == 0xab && block[length - 1] == 0xab);
+	munmap(block, length);
+#else
+	ASSERT(false); // Huge pages are only supported on Linux
+#endif
+}
+
+TEST_CASE("/flow/Platform/allocateHugePages") {
+	constexpr size_t length = 4 << 20;
+	uint8_t* block = (uint8_t*)allocateHugePages(length, deterministicRandom()->coinflip());
+	if (block) {
+		checkHugePageBlock(block, length);
+	}
+	return Void();
+}
+
 TEST_CASE("/flow/Platform/directoryOps") {
 	int errors = 0;
 
@@ -71,7 +71,9 @@ SystemStatistics getSystemStatistics() {
 #define DETAILALLOCATORMEMUSAGE(size)                                                                                  \
 	detail("TotalMemory" #size, FastAllocator<size>::getTotalMemory())                                                 \
 	    .detail("ApproximateUnusedMemory" #size, FastAllocator<size>::getApproximateMemoryUnused())                    \
-	    .detail("ActiveThreads" #size, FastAllocator<size>::getActiveThreads())
+	    .detail("ActiveThreads" #size, FastAllocator<size>::getActiveThreads())                                        \
+	    .detail("LiveMemory" #size, FastAllocator<size>::getLiveMemory())                                              \
+	    .detail("Magazines" #size, FastAllocator<size>::getMagazineCount())
 
 namespace {
 
@@ -202,6 +204,7 @@ SystemStatistics customSystemMonitor(std::string const& eventName, StatisticsSta
 			    .DETAILALLOCATORMEMUSAGE(8192)
 			    .DETAILALLOCATORMEMUSAGE(16384)
 			    .detail("HugeArenaMemory", g_hugeArenaMemory.load())
+			    .detail("HugePageMagazineMemory", g_hugePageMagazineMemory.load())
 			    .detail("DCID", machineState.dcId)
 			    .detail("ZoneID", machineState.zoneId)
 			    .detail("MachineID", machineState.machineId);
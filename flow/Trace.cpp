@@ -24,6 +24,7 @@
 #include "flow/Knobs.h"
 #include "flow/XmlTraceLogFormatter.h"
 #include "flow/JsonTraceLogFormatter.h"
+#include "flow/BinaryTraceLogFormatter.h"
 #include "flow/flow.h"
 #include "flow/DeterministicRandom.h"
 #include "flow/ProcessEvents.h"
@@ -261,7 +262,7 @@ public:
 		struct WriteBuffer final : TypedAction<WriterThread, WriteBuffer> {
 			std::vector<TraceEventFields> events;
 
-			WriteBuffer(std::vector<TraceEventFields> events) : events(events) {}
+			WriteBuffer(std::vector<TraceEventFields> events) : events(std::move(events)) {}
 			double getTimeEstimate() const override { return .001; }
 		};
 		void action(WriteBuffer& a) {
@@ -403,7 +404,6 @@ public:
 
 		// FIXME: What if we are using way too much memory for buffer?
 		ASSERT(!isOpen() || fields.isAnnotated());
-		eventBuffer.push_back(fields);
 		bufferLength += fields.sizeBytes();
 
 		if (g_network && g_network->isSimulated()) {
@@ -430,6 +430,7 @@ public:
 		if (!trackLatestKey.empty()) {
 			latestEventCache.set(trackLatestKey, fields);
 		}
+		eventBuffer.push_back(std::move(fields));
 	}
 
 	void logMetrics(int severity, const char* name, UID id, uint64_t event_ts) {
@@ -693,6 +694,11 @@ bool traceFormatImpl(std::string& format) {
 			g_traceLog.formatter = Reference<ITraceLogFormatter>(new JsonTraceLogFormatter());
 		}
 		return true;
+	} else if (format == "binary") {
+		if (!validate) {
+			g_traceLog.formatter = Reference<ITraceLogFormatter>(new BinaryTraceLogFormatter());
+		}
+		return true;
 	} else {
 		if (!validate) {
 			g_traceLog.formatter = Reference<ITraceLogFormatter>(new XmlTraceLogFormatter());
@@ -0,0 +1,114 @@
+/*
+ * TraceDecodeCli.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Converts trace files written with --trace-format binary to the JSON trace format, so that they can be consumed by
+// the same tools as the trace files of processes which log JSON directly.
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <fmt/format.h>
+#include "flow/BinaryTraceLogFormatter.h"
+#include "flow/JsonTraceLogFormatter.h"
+#include "SimpleOpt/SimpleOpt.h"
+
+enum ETraceDecodeOpt : int { OPT_HELP, OPT_OUTPUT };
+
+CSimpleOpt::SOption gOptions[] = { { OPT_HELP, "--help", SO_NONE },
+	                               { OPT_HELP, "-h", SO_NONE },
+	                               { OPT_OUTPUT, "--output", SO_REQ_SEP },
+	                               { OPT_OUTPUT, "-o", SO_REQ_SEP },
+	                               SO_END_OF_OPTIONS };
+
+static void printUsage(const char* program) {
+	fmt::print(stdout,
+	           "Usage: {} [--output FILE] TRACE_FILE...\n"
+	           "Converts binary trace files to the JSON trace format.\n\n"
+	           "  -o, --output FILE  Write the JSON events to FILE instead of standard output.\n"
+	           "  -h, --help         Print this help message.\n",
+	           program);
+}
+
+int main(int argc, char** argv) {
+	CSimpleOpt args(argc, argv, gOptions, SO_O_EXACT | SO_O_HYPHEN_TO_UNDERSCORE);
+	std::string outputPath;
+	while (args.Next()) {
+		if (args.LastError() != SO_SUCCESS) {
+			fmt::print(stderr, "ERROR: invalid argument '{}'\n", args.OptionText());
+			printUsage(argv[0]);
+			return 1;
+		}
+		switch (args.OptionId()) {
+		case OPT_HELP:
+			printUsage(argv[0]);
+			return 0;
+		case OPT_OUTPUT:
+			outputPath = args.OptionArg();
+			break;
+		}
+	}
+	if (args.FileCount() == 0) {
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	std::ofstream outputFile;
+	if (!outputPath.empty()) {
+		outputFile.open(outputPath, std::ios::binary | std::ios::trunc);
+		if (!outputFile) {
+			fmt::print(stderr, "ERROR: cannot open '{}' for writing\n", outputPath);
+			return 1;
+		}
+	}
+	std::ostream& output = outputPath.empty() ? std::cout : outputFile;
+
+	JsonTraceLogFormatter json;
+	int result = 0;
+	for (int i = 0; i < args.FileCount(); i++) {
+		std::ifstream input(args.File(i), std::ios::binary);
+		if (!input) {
+			fmt::print(stderr, "ERROR: cannot open '{}'\n", args.File(i));
+			result = 1;
+			continue;
+		}
+		std::stringstream contents;
+		contents << input.rdbuf();
+		const std::string data = std::move(contents).str();
+
+		std::vector<TraceEventFields> events;
+		if (!BinaryTraceLogFormatter::decode(data, events)) {
+			// A process which is killed while writing leaves a partial event at the end of the file, so the complete
+			// events are still converted
+			fmt::print(stderr,
+			           "WARNING: '{}' is not a binary trace file or ends with an incomplete event, decoded {} events\n",
+			           args.File(i),
+			           events.size());
+			result = 1;
+		}
+		for (const auto& event : events) {
+			output << json.formatEvent(event);
+		}
+	}
+	output.flush();
+	return result;
+}
@@ -510,6 +510,40 @@ TEST_CASE("/flow/FlatBuffers/Standalone2") {
 	return Void();
 }
 
+TEST_CASE("/flow/FlatBuffers/ReadInPlace") {
+	Standalone<VectorRef<StringRef>> in;
+	int kSize = deterministicRandom()->randomInt(1, 100);
+	for (int i = 0; i < kSize; ++i) {
+		in.push_back_deep(in.arena(), StringRef(deterministicRandom()->randomAlphaNumeric(100)));
+	}
+	auto inBuffer = [](StringRef buffer, StringRef str) {
+		return str.begin() >= buffer.begin() && str.end() <= buffer.end();
+	};
+
+	Standalone<StringRef> value = ObjectWriter::toValue(in, Unversioned());
+	Standalone<VectorRef<StringRef>> out =
+	    ArenaObjectReader::fromStringRef<Standalone<VectorRef<StringRef>>>(value.arena(), value, Unversioned());
+	Standalone<VectorRef<StringRef>> copied =
+	    ObjectReader::fromStringRef<Standalone<VectorRef<StringRef>>>(value, Unversioned());
+	ASSERT(out == in && copied == in);
+	for (int i = 0; i < kSize; ++i) {
+		ASSERT(inBuffer(value, out[i]));
+		ASSERT(!inBuffer(value, copied[i]));
+	}
+
+	// The result keeps the buffer alive after the last reference to it is gone
+	value = Standalone<StringRef>();
+	ASSERT(out == in);
+
+	Standalone<StringRef> binary = BinaryWriter::toValue(in, Unversioned());
+	out = ArenaReader::fromStringRef<Standalone<VectorRef<StringRef>>>(binary.arena(), binary, Unversioned());
+	ASSERT(out == in);
+	for (int i = 0; i < kSize; ++i) {
+		ASSERT(inBuffer(binary, out[i]));
+	}
+	return Void();
+}
+
 // Meant to be run with valgrind or asan, to catch heap buffer overflows
 TEST_CASE("/flow/FlatBuffers/Void") {
 	Standalone<StringRef> msg = ObjectWriter::toValue(Void(), Unversioned());
@@ -1580,4 +1580,37 @@ struct dynamic_size_traits<VectorRef<V, VecSerStrategy::String>> : std::true_typ
 	}
 };
 
+// A string whose bytes are spread over segments which need not be contiguous or share an arena. It serializes
+// exactly as the StringRef formed by concatenating its segments, with each segment copied straight into the
+// serialized output, so a reply can be assembled from data already held in memory without first gathering it into
+// one buffer. It is only ever written; the receiver reads the field back as an ordinary StringRef.
+struct GatheredStringRef {
+	VectorRef<StringRef> segments;
+	int length = 0;
+
+	GatheredStringRef() = default;
+	GatheredStringRef(VectorRef<StringRef> segments, int length) : segments(segments), length(length) {}
+
+	int size() const { return length; }
+};
+
+template <>
+struct dynamic_size_traits<GatheredStringRef> : std::true_type {
+	template <class Context>
+	static size_t size(const GatheredStringRef& t, Context&) {
+		return t.size();
+	}
+	template <class Context>
+	static void save(uint8_t* out, const GatheredStringRef& t, Context&) {
+		for (const auto& segment : t.segments) {
+			out = std::copy(segment.begin(), segment.end(), out);
+		}
+	}
+
+	template <class Context>
+	static void load(const uint8_t*, size_t, GatheredStringRef&, Context&) {
+		UNREACHABLE();
+	}
+};
+
 #endif
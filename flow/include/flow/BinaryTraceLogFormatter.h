@@ -0,0 +1,53 @@
+/*
+ * BinaryTraceLogFormatter.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLOW_BINARY_TRACE_LOG_FORMATTER_H
+#define FLOW_BINARY_TRACE_LOG_FORMATTER_H
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "flow/FastRef.h"
+#include "flow/Trace.h"
+
+// Writes trace events as length prefixed fields, which avoids the escaping and markup of the XML and JSON formats.
+// Each file starts with the header, followed by one record per event:
+//
+//   uint32_t fieldCount, then for each field: uint32_t keyLength, key, uint32_t valueLength, value
+//
+// All integers are little endian. Binary trace files are converted to the JSON format with the tracedecode tool.
+struct BinaryTraceLogFormatter final : public ITraceLogFormatter, ReferenceCounted<BinaryTraceLogFormatter> {
+	static constexpr std::string_view HEADER = "FDBBinaryTrace1\n";
+
+	const char* getExtension() const override;
+	const char* getHeader() const override; // Called when starting a new file
+	const char* getFooter() const override; // Called when ending a file
+	std::string formatEvent(const TraceEventFields&) const override; // Called for each event
+
+	// Decodes the contents of a binary trace file into events. Returns false if the data does not start with the
+	// header or ends with an incomplete event, in which case events holds every complete event before that point.
+	static bool decode(std::string_view data, std::vector<TraceEventFields>& events);
+
+	void addref() override;
+	void delref() override;
+};
+
+#endif
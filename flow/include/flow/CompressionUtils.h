@@ -36,6 +36,8 @@ struct CompressionUtils {
 	static StringRef compress(const CompressionFilter filter, const StringRef& data, Arena& arena);
 	static StringRef compress(const CompressionFilter filter, const StringRef& data, int level, Arena& arena);
 	static StringRef decompress(const CompressionFilter filter, const StringRef& data, Arena& arena);
+	// Throws serialization_failed() instead of decompressing more than maxSize bytes, for data which is not trusted
+	static StringRef decompress(const CompressionFilter filter, const StringRef& data, int64_t maxSize, Arena& arena);
 
 	static int getDefaultCompressionLevel(CompressionFilter filter);
 	static CompressionFilter getRandomFilter();
@@ -88,6 +88,41 @@ struct GetFutureType<FutureStream<T> const&> {
 template <class F>
 inline constexpr FutureType GetFutureTypeV = GetFutureType<F>::value;
 
+// The size of a coroutine frame is only known to the compiler, so frames can't be FastAllocated classes like the state
+// of an actor. They are allocated from the FastAllocator of their size class instead, which also covers the frames
+// larger than 256 bytes that allocateFast leaves to the heap.
+[[nodiscard]] inline void* allocateFrame(size_t size) {
+	if (size <= 256)
+		return allocateFast(int(size));
+	if (size <= 512)
+		return FastAllocator<512>::allocate();
+	if (size <= 1024)
+		return FastAllocator<1024>::allocate();
+	if (size <= 2048)
+		return FastAllocator<2048>::allocate();
+	if (size <= 4096)
+		return FastAllocator<4096>::allocate();
+	if (size <= 8192)
+		return FastAllocator<8192>::allocate();
+	return countedNew(size);
+}
+
+inline void freeFrame(void* ptr, size_t size) {
+	if (size <= 256)
+		return freeFast(int(size), ptr);
+	if (size <= 512)
+		return FastAllocator<512>::release(ptr);
+	if (size <= 1024)
+		return FastAllocator<1024>::release(ptr);
+	if (size <= 2048)
+		return FastAllocator<2048>::release(ptr);
+	if (size <= 4096)
+		return FastAllocator<4096>::release(ptr);
+	if (size <= 8192)
+		return FastAllocator<8192>::release(ptr);
+	countedDelete(size, ptr);
+}
+
 template <class T, bool IsCancellable>
 struct CoroActor final : Actor<std::conditional_t<std::is_void_v<T>, Void, T>> {
 	using ValType = std::conditional_t<std::is_void_v<T>, Void, T>;
@@ -385,8 +420,8 @@ struct CoroPromise : CoroReturn<T, CoroPromise<T, IsCancellable>> {
 		return n_coroutine::coroutine_handle<promise_type>::from_promise(*this);
 	}
 
-	static void* operator new(size_t s) { return allocateFast(int(s)); }
-	static void operator delete(void* p, size_t s) { freeFast(int(s), p); }
+	static void* operator new(size_t s) { return allocateFrame(s); }
+	static void operator delete(void* p, size_t s) { freeFrame(p, s); }
 
 	ReturnFutureType get_return_object() noexcept { return ReturnFutureType(coroActor); }
 
@@ -452,8 +487,8 @@ struct CoroPromise : CoroReturn<T, CoroPromise<T, IsCancellable>> {
 template <class T>
 struct GeneratorPromise {
 	using handle_type = n_coroutine::coroutine_handle<GeneratorPromise<T>>;
-	static void* operator new(size_t s) { return allocateFast(int(s)); }
-	static void operator delete(void* p, size_t s) { freeFast(int(s), p); }
+	static void* operator new(size_t s) { return allocateFrame(s); }
+	static void operator delete(void* p, size_t s) { freeFrame(p, s); }
 
 	Error error;
 	std::optional<T> value;
@@ -496,8 +531,8 @@ template <class T>
 struct AsyncGeneratorPromise {
 	using promise_type = AsyncGeneratorPromise<T>;
 
-	static void* operator new(size_t s) { return allocateFast(int(s)); }
-	static void operator delete(void* p, size_t s) { freeFast(int(s), p); }
+	static void* operator new(size_t s) { return allocateFrame(s); }
+	static void operator delete(void* p, size_t s) { freeFrame(p, s); }
 
 	n_coroutine::coroutine_handle<promise_type> handle() {
 		return n_coroutine::coroutine_handle<promise_type>::from_promise(*this);
@@ -123,6 +123,9 @@ public:
 	static long long getTotalMemory();
 	static long long getApproximateMemoryUnused();
 	static long long getActiveThreads();
+	// Bytes handed out by allocate() and not yet released
+	static long long getLiveMemory();
+	static long long getMagazineCount();
 
 #ifdef ALLOC_INSTRUMENTATION
 	static volatile int32_t pageCount;
@@ -181,6 +184,7 @@ private:
 };
 
 extern std::atomic<int64_t> g_hugeArenaMemory;
+extern std::atomic<int64_t> g_hugePageMagazineMemory;
 void hugeArenaSample(int size);
 void releaseAllThreadMagazines();
 int64_t getTotalUnusedAllocatedMemory();
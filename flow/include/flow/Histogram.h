@@ -23,6 +23,7 @@
 #pragma once
 
 #include <flow/Arena.h>
+#include <atomic>
 #include <string>
 #include <map>
 #include <unordered_map>
@@ -30,22 +31,28 @@
 #ifdef _WIN32
 #include <intrin.h>
 #pragma intrinsic(_BitScanReverse)
+#pragma intrinsic(_BitScanReverse64)
 #endif
 
 class Histogram;
+class LogLinearHistogram;
 
 class HistogramRegistry : public ReferenceCounted<HistogramRegistry> {
 public:
 	void registerHistogram(Histogram* h);
 	void unregisterHistogram(Histogram* h);
 	Histogram* lookupHistogram(std::string const& name);
+	void registerHistogram(LogLinearHistogram* h);
+	void unregisterHistogram(LogLinearHistogram* h);
+	LogLinearHistogram* lookupLogLinearHistogram(std::string const& name);
 	void logReport(double elapsed = -1.0);
 	void clear();
 
 private:
-	// This map is ordered by key so that ops within the same group end up
+	// These maps are ordered by key so that ops within the same group end up
 	// next to each other in the trace log.
 	std::map<std::string, Histogram*> histograms;
+	std::map<std::string, LogLinearHistogram*> logLinearHistograms;
 };
 
 HistogramRegistry& GetHistogramRegistry();
@@ -177,4 +184,122 @@ public:
 	uint32_t upperBound;
 };
 
+/*
+ * A histogram with log-linear buckets: every power-of-two range is split into SUB_BUCKETS linear buckets, so a
+ * percentile is within 1/SUB_BUCKETS of the true value, where the power-of-two buckets of Histogram are only within a
+ * factor of two. This is the bucketing of HdrHistogram.
+ *
+ * Samples are recorded with relaxed atomic operations, so any thread may call sample() and merge() without a lock.
+ * Construction, destruction (which unregisters the histogram) and the registry's logReport() belong to the network
+ * thread. Since clear() is not atomic with respect to concurrent samples, a sample recorded while the histogram is
+ * being logged may be counted in either interval.
+ */
+class LogLinearHistogram final : public ReferenceCounted<LogLinearHistogram> {
+public:
+	using Unit = Histogram::Unit;
+
+	static constexpr int SUB_BUCKET_BITS = 6;
+	static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+	// Samples are clamped to MAX_VALUE, which is about 12 days in microseconds
+	static constexpr int MAX_BITS = 40;
+	static constexpr uint64_t MAX_VALUE = (uint64_t(1) << MAX_BITS) - 1;
+	static constexpr int BUCKETS = (MAX_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+	LogLinearHistogram(Reference<HistogramRegistry> regis,
+	                   std::string const& group = "",
+	                   std::string const& op = "",
+	                   Unit unit = Unit::MAXHISTOGRAMUNIT)
+	  : group(group), op(op), unit(unit), registry(regis) {
+		ASSERT(unit <= Unit::MAXHISTOGRAMUNIT);
+		clear();
+	}
+
+	~LogLinearHistogram() {
+		if (registry.isValid() && unit != Unit::MAXHISTOGRAMUNIT) {
+			registry->unregisterHistogram(this);
+		}
+		registry.clear();
+	}
+
+	static Reference<LogLinearHistogram> getHistogram(StringRef group, StringRef op, Unit unit);
+
+	// Values below 2 * SUB_BUCKETS have a bucket of their own. Above that, the bucket of a value is given by its top
+	// SUB_BUCKET_BITS + 1 bits and the position of its highest set bit.
+	static int bucketIndex(uint64_t value) {
+		value = std::min(value, MAX_VALUE);
+#ifdef _WIN32
+		unsigned long msb;
+		_BitScanReverse64(&msb, value | 1);
+#else
+		int msb = 63 - __builtin_clzll(value | 1);
+#endif
+		int shift = std::max(0, int(msb) - SUB_BUCKET_BITS);
+		return (shift << SUB_BUCKET_BITS) + int(value >> shift);
+	}
+
+	static uint64_t bucketLowerBound(int index) {
+		int shift = std::max(0, (index >> SUB_BUCKET_BITS) - 1);
+		return uint64_t(index - (shift << SUB_BUCKET_BITS)) << shift;
+	}
+
+	static uint64_t bucketUpperBound(int index) {
+		int shift = std::max(0, (index >> SUB_BUCKET_BITS) - 1);
+		return bucketLowerBound(index) + (uint64_t(1) << shift) - 1;
+	}
+
+	void sample(uint64_t value) {
+		value = std::min(value, MAX_VALUE);
+		buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+		count.fetch_add(1, std::memory_order_relaxed);
+		sum.fetch_add(value, std::memory_order_relaxed);
+		updateMin(value);
+		updateMax(value);
+	}
+
+	// Records a duration in microseconds
+	void sampleSeconds(double delta) { sample(delta > 0 ? uint64_t(std::min(delta * 1e6, double(MAX_VALUE))) : 0); }
+
+	// Adds the samples of other to this histogram. other may be sampled concurrently, in which case the samples it
+	// records during the merge may or may not be included.
+	void merge(LogLinearHistogram const& other);
+
+	uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+	uint64_t getMin() const;
+	uint64_t getMax() const { return max.load(std::memory_order_relaxed); }
+	double getMean() const;
+
+	// Returns the midpoint of the bucket holding the sample of the given rank, clamped to the sampled range, or 0 if
+	// the histogram is empty. p is in [0, 1].
+	uint64_t percentile(double p) const;
+
+	void clear();
+	void writeToLog(double elapsed = -1.0);
+
+	std::string name() const { return group + ":" + op; }
+
+	std::string const group;
+	std::string const op;
+	Unit const unit;
+	Reference<HistogramRegistry> registry;
+
+private:
+	void updateMin(uint64_t value) {
+		uint64_t current = min.load(std::memory_order_relaxed);
+		while (value < current && !min.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+		}
+	}
+
+	void updateMax(uint64_t value) {
+		uint64_t current = max.load(std::memory_order_relaxed);
+		while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+		}
+	}
+
+	std::atomic<uint64_t> buckets[BUCKETS];
+	std::atomic<uint64_t> count;
+	std::atomic<uint64_t> sum;
+	std::atomic<uint64_t> min;
+	std::atomic<uint64_t> max;
+};
+
 #endif // FLOW_HISTOGRAM_H
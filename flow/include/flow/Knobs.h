@@ -131,8 +131,10 @@ public:
 
 	double FAST_ALLOC_LOGGING_BYTES;
 	bool FAST_ALLOC_ALLOW_GUARD_PAGES;
+	int FAST_ALLOC_HUGE_PAGES;
 	double HUGE_ARENA_LOGGING_BYTES;
 	double HUGE_ARENA_LOGGING_INTERVAL;
+	int64_t ARENA_BLOCK_POOL_BYTES;
 	// This setting allows to let the fdbserver abort instead of exit to generate coredumps
 	// in case of a failure.
 	bool ABORT_ON_FAILURE;
@@ -227,7 +229,7 @@ public:
 	int64_t BUGGIFY_SIM_PAGE_CACHE_4K;
 	int64_t BUGGIFY_SIM_PAGE_CACHE_64K;
 	int64_t BLOB_WORKER_PAGE_CACHE;
-	std::string CACHE_EVICTION_POLICY; // for now, "random", "lru", are supported
+	std::string CACHE_EVICTION_POLICY; // for now, "random", "lru", "clock" are supported
 	int MAX_EVICT_ATTEMPTS;
 	double PAGE_CACHE_TRUNCATE_LOOKUP_FRACTION;
 	double TOO_MANY_CONNECTIONS_CLOSED_RESET_DELAY;
@@ -253,6 +255,10 @@ public:
 	int PAGE_WRITE_CHECKSUM_HISTORY;
 	int DISABLE_POSIX_KERNEL_AIO;
 
+	// AsyncFileIOUring
+	int USE_IO_URING; // Use io_uring instead of kernel AIO for unbuffered files, if the kernel supports it
+	int IO_URING_FIXED_FILES;
+
 	// AsyncFileNonDurable
 	double NON_DURABLE_MAX_WRITE_DELAY;
 	double MAX_PRIOR_MODIFICATION_DELAY;
@@ -287,6 +293,7 @@ public:
 	double MIN_LOGGED_PRIORITY_BUSY_FRACTION;
 	int CERT_FILE_MAX_SIZE;
 	int READY_QUEUE_RESERVED_SIZE;
+	bool BUCKETED_TASK_QUEUE;
 	int TASKS_PER_REACTOR_CHECK;
 
 	// Network
@@ -299,6 +306,9 @@ public:
 	int FLOW_TCP_NODELAY;
 	int FLOW_TCP_QUICKACK;
 	bool RESOLVE_PREFER_IPV4_ADDR;
+	int PEER_COMPRESSION_MODE; // Which peers packets are compressed for, if they support it: 0 none, 1 peers in other
+	                           // data centers, 2 all peers
+	int PEER_COMPRESSION_MIN_PACKET_BYTES;
 
 	// Sim2
 	// FIMXE: more parameters could be factored out
@@ -353,6 +363,7 @@ public:
 	double SECOND_REQUEST_MULTIPLIER_DECAY;
 	double SECOND_REQUEST_BUDGET_GROWTH;
 	double SECOND_REQUEST_MAX_BUDGET;
+	bool CANCEL_LOST_SECOND_REQUESTS;
 	double ALTERNATIVES_FAILURE_RESET_TIME;
 	double ALTERNATIVES_FAILURE_MIN_DELAY;
 	double ALTERNATIVES_FAILURE_DELAY_RATIO;
@@ -147,6 +147,17 @@ public:
 		vo.read(*this);
 	}
 
+	// Deserializes in place: unlike ObjectReader::fromStringRef, which copies every string of the result into a new
+	// arena, the StringRefs of the result point into sr. sr must be memory owned by arena, which any Arena or
+	// Standalone in the result will depend on.
+	template <class T, class VersionOptions>
+	static T fromStringRef(Arena const& arena, StringRef sr, VersionOptions vo) {
+		T t;
+		ArenaObjectReader reader(arena, sr, vo);
+		reader.deserialize(t);
+		return t;
+	}
+
 	const uint8_t* data() { return _data; }
 
 	Arena& arena() { return _arena; }
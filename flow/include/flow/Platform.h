@@ -326,6 +326,11 @@ void setMemoryQuota(size_t limit);
 
 void* allocate(size_t length, bool allowLargePages, bool includeGuardPages);
 
+// Maps length bytes backed by 2MB huge pages: explicit (hugetlbfs) pages if explicitHugePages is set and the system has
+// them reserved, and otherwise a 2MB aligned region advised to use transparent huge pages. Returns nullptr instead of
+// failing if neither is available, so that callers can fall back to allocate().
+void* allocateHugePages(size_t length, bool explicitHugePages);
+
 void setAffinity(int proc);
 
 void threadSleep(double seconds);
@@ -22,8 +22,14 @@
 #define FLOW_TASK_QUEUE_H
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
 #include <queue>
 #include <vector>
+#include "flow/Deque.h"
+#include "flow/Platform.h"
 #include "flow/TDMetric.actor.h"
 #include "flow/network.h"
 #include "flow/ThreadSafeQueue.h"
@@ -31,15 +37,28 @@
 template <typename Task>
 // A queue of ordered tasks, both ready to execute, and delayed for later execution.
 // All functions must be called on the main thread, except for addReadyThreadSafe() which can be called from any thread.
+// By default ready tasks and timers are kept in binary heaps. A bucketed queue instead keeps ready tasks in one FIFO
+// per TaskPriority and timers in a hierarchical timing wheel, which avoids comparing tasks on every push and pop. The
+// only difference in ordering is that a timer which fires runs after the ready tasks of its priority added before it.
 class TaskQueue {
 public:
-	TaskQueue() : tasksIssued(0), ready(FLOW_KNOBS->READY_QUEUE_RESERVED_SIZE) {}
+	TaskQueue() : TaskQueue(FLOW_KNOBS->BUCKETED_TASK_QUEUE) {}
+	explicit TaskQueue(bool bucketed)
+	  : tasksIssued(0), bucketed(bucketed), ready(bucketed ? 0 : FLOW_KNOBS->READY_QUEUE_RESERVED_SIZE) {}
 
 	// Add a task that is ready to be executed.
-	void addReady(TaskPriority taskId, Task* t) { this->ready.push(OrderedTask(getFIFOPriority(taskId), taskId, t)); }
+	void addReady(TaskPriority taskId, Task* t) {
+		if (bucketed)
+			readyBuckets.push(taskId, t);
+		else
+			this->ready.push(OrderedTask(getFIFOPriority(taskId), taskId, t));
+	}
 	// Add a task to be executed at a given future time instant (a "timer").
 	void addTimer(double at, TaskPriority taskId, Task* t) {
-		this->timers.push(DelayedTask(at, getFIFOPriority(taskId), taskId, t));
+		if (bucketed)
+			timerWheel.add(DelayedTask(at, 0, taskId, t));
+		else
+			this->timers.push(DelayedTask(at, getFIFOPriority(taskId), taskId, t));
 	}
 	// Add a task that is ready to be executed, potentially called from a thread that is different from main.
 	// Returns true iff the main thread need to be woken up to execute this task.
@@ -55,7 +74,7 @@ public:
 	}
 	// Returns true if the there are no tasks that are ready to be executed.
 	bool canSleep() {
-		bool b = ready.empty();
+		bool b = !hasReadyTask();
 		if (b) {
 			b = threadReady.canSleep();
 			if (!b)
@@ -66,6 +85,9 @@ public:
 	}
 	// Returns a time interval a caller should sleep from now until the next timer.
 	double getSleepTime(double now) const {
+		if (bucketed) {
+			return timerWheel.empty() ? 0 : timerWheel.nextAt() - now;
+		}
 		if (!timers.empty()) {
 			return timers.top().at - now;
 		}
@@ -75,6 +97,13 @@ public:
 	// Moves all timers that are scheduled to be executed at or before now to the ready queue.
 	void processReadyTimers(double now) {
 		[[maybe_unused]] int numTimers = 0;
+		if (bucketed) {
+			timerWheel.popReady(now + INetwork::TIME_EPS, [&](DelayedTask const& t) {
+				++numTimers;
+				++countTimers;
+				readyBuckets.push(t.taskID, t.task);
+			});
+		}
 		while (!timers.empty() && timers.top().at <= now + INetwork::TIME_EPS) {
 			++numTimers;
 			++countTimers;
@@ -98,12 +127,20 @@ public:
 		FDB_TRACE_PROBE(run_loop_thread_ready, numReady);
 	}
 
-	bool hasReadyTask() const { return !ready.empty(); }
-	size_t getNumReadyTasks() const { return ready.size(); }
-	TaskPriority getReadyTaskID() const { return ready.top().taskID; }
-	int64_t getReadyTaskPriority() const { return ready.top().priority; }
-	Task* getReadyTask() const { return ready.top().task; }
-	void popReadyTask() { ready.pop(); }
+	bool hasReadyTask() const { return bucketed ? !readyBuckets.empty() : !ready.empty(); }
+	size_t getNumReadyTasks() const { return bucketed ? readyBuckets.size() : ready.size(); }
+	TaskPriority getReadyTaskID() const { return bucketed ? readyBuckets.topID() : ready.top().taskID; }
+	// Only comparable with (int64_t(taskID) << 32): the result is greater iff the ready task has a higher priority.
+	int64_t getReadyTaskPriority() const {
+		return bucketed ? (int64_t(readyBuckets.topID()) << 32) - 1 : ready.top().priority;
+	}
+	Task* getReadyTask() const { return bucketed ? readyBuckets.topTask() : ready.top().task; }
+	void popReadyTask() {
+		if (bucketed)
+			readyBuckets.pop();
+		else
+			ready.pop();
+	}
 
 	void initMetrics() {
 		countTimers.init("Net2.CountTimers"_sr);
@@ -116,6 +153,8 @@ public:
 		ready.swap(_1);
 		decltype(timers) _2;
 		timers.swap(_2);
+		readyBuckets.clear();
+		timerWheel.clear();
 	}
 
 private:
@@ -143,16 +182,249 @@ private:
 		void reserve(size_type capacity) { this->c.reserve(capacity); }
 	};
 
+	// Ready tasks in one FIFO per distinct priority. Buckets are ranked in priority order, and a bit per rank marks the
+	// non-empty buckets, so the highest priority ready task is found by scanning a few words rather than a heap.
+	class ReadyBuckets {
+	public:
+		bool empty() const { return count == 0; }
+		size_t size() const { return count; }
+		TaskPriority topID() const { return top->taskID; }
+		Task* topTask() const { return top->tasks.front(); }
+
+		void push(TaskPriority taskID, Task* t) {
+			Bucket* b = find(taskID);
+			if (b == nullptr)
+				b = insert(taskID);
+			if (b->tasks.empty()) {
+				nonEmpty[b->rank >> 6] |= uint64_t(1) << (b->rank & 63);
+				if (top == nullptr || b->rank > top->rank)
+					top = b;
+			}
+			b->tasks.push_back(t);
+			++count;
+		}
+
+		void pop() {
+			top->tasks.pop_front();
+			--count;
+			if (top->tasks.empty()) {
+				nonEmpty[top->rank >> 6] &= ~(uint64_t(1) << (top->rank & 63));
+				top = highestNonEmpty();
+			}
+		}
+
+		void clear() {
+			for (auto& b : buckets)
+				b->tasks.clear();
+			std::fill(nonEmpty.begin(), nonEmpty.end(), 0);
+			top = nullptr;
+			count = 0;
+		}
+
+	private:
+		struct Bucket {
+			TaskPriority taskID;
+			int rank = 0;
+			Deque<Task*> tasks;
+			explicit Bucket(TaskPriority taskID) : taskID(taskID) {}
+		};
+
+		Bucket* highestNonEmpty() const {
+			for (int w = nonEmpty.size() - 1; w >= 0; --w) {
+				if (nonEmpty[w])
+					return buckets[w * 64 + 63 - clzll(nonEmpty[w])].get();
+			}
+			return nullptr;
+		}
+
+		size_t slotFor(TaskPriority taskID) const {
+			return (static_cast<uint32_t>(taskID) * 0x9E3779B1u) >> tableShift;
+		}
+
+		Bucket* find(TaskPriority taskID) const {
+			if (table.empty())
+				return nullptr;
+			for (size_t i = slotFor(taskID);; i = (i + 1) & (table.size() - 1)) {
+				if (table[i] == nullptr || table[i]->taskID == taskID)
+					return table[i];
+			}
+		}
+
+		// Adds the bucket for a priority seen for the first time, which re-ranks every bucket after it. There are only
+		// as many buckets as distinct priorities, so this is rare.
+		Bucket* insert(TaskPriority taskID) {
+			auto it = std::lower_bound(buckets.begin(), buckets.end(), taskID, [](auto const& b, TaskPriority p) {
+				return b->taskID < p;
+			});
+			Bucket* b = buckets.insert(it, std::make_unique<Bucket>(taskID))->get();
+			nonEmpty.assign((buckets.size() + 63) / 64, 0);
+			for (int i = 0; i < buckets.size(); i++) {
+				buckets[i]->rank = i;
+				if (!buckets[i]->tasks.empty())
+					nonEmpty[i >> 6] |= uint64_t(1) << (i & 63);
+			}
+
+			if (buckets.size() * 2 > table.size()) {
+				table.assign(std::max<size_t>(16, table.size() * 2), nullptr);
+				tableShift = 32 - ctzll(table.size());
+				for (auto& bucket : buckets)
+					place(bucket.get());
+			} else {
+				place(b);
+			}
+			return b;
+		}
+
+		void place(Bucket* b) {
+			size_t i = slotFor(b->taskID);
+			while (table[i] != nullptr)
+				i = (i + 1) & (table.size() - 1);
+			table[i] = b;
+		}
+
+		std::vector<std::unique_ptr<Bucket>> buckets; // Sorted by priority; the index of a bucket is its rank
+		std::vector<uint64_t> nonEmpty; // Bit per rank
+		std::vector<Bucket*> table; // Open addressing hash table from priority to bucket
+		int tableShift = 32;
+		Bucket* top = nullptr; // Highest priority non-empty bucket
+		size_t count = 0;
+	};
+
+	// Timers in a hierarchical timing wheel with millisecond ticks. Level l holds the timers whose tick first differs
+	// from the current tick in bits [6l, 6l+6), in the slot given by those bits, so a timer is added in constant time
+	// and only cascades to a lower level as the current tick approaches it. Timers whose tick has been reached wait in
+	// a heap ordered by their exact time, as do the rare timers too far in the future for the wheel.
+	class TimerWheel {
+	public:
+		TimerWheel() { clearSlots(); }
+
+		bool empty() const { return count == 0; }
+		void add(DelayedTask const& t) {
+			++count;
+			insert(t);
+		}
+
+		// Returns the time of the earliest timer. The wheel must not be empty.
+		double nextAt() const {
+			if (!due.empty())
+				return due.top().at;
+			// Every timer on a level is earlier than those on higher levels, and slots are in time order
+			for (int l = 0; l < levels; l++) {
+				if (occupied[l])
+					return minAt[l][ctzll(occupied[l])];
+			}
+			return overflow.top().at;
+		}
+
+		// Calls f() with every timer scheduled at or before now, in time order, and removes them.
+		template <class F>
+		void popReady(double now, F&& f) {
+			const int64_t tick = toTick(now);
+			if (tick > current)
+				advance(tick);
+			while (!due.empty() && due.top().at <= now) {
+				f(due.top());
+				due.pop();
+				--count;
+			}
+		}
+
+		void clear() {
+			clearSlots();
+			decltype(due) _1;
+			due.swap(_1);
+			decltype(overflow) _2;
+			overflow.swap(_2);
+			count = 0;
+		}
+
+	private:
+		static constexpr int levels = 4;
+		static constexpr int slotBits = 6;
+		static constexpr int slots = 1 << slotBits;
+
+		static int64_t toTick(double at) { return int64_t(at * 1000); }
+
+		void clearSlots() {
+			for (int l = 0; l < levels; l++) {
+				for (auto& slot : wheel[l])
+					slot.clear();
+				minAt[l].fill(std::numeric_limits<double>::infinity());
+				occupied[l] = 0;
+			}
+		}
+
+		void insert(DelayedTask const& t) {
+			const int64_t tick = toTick(t.at);
+			if (tick <= current) {
+				due.push(t);
+				return;
+			}
+			const int level = (63 - clzll(uint64_t(tick ^ current))) / slotBits;
+			if (level >= levels) {
+				overflow.push(t);
+				return;
+			}
+			const int slot = (tick >> (level * slotBits)) & (slots - 1);
+			wheel[level][slot].push_back(t);
+			occupied[level] |= uint64_t(1) << slot;
+			minAt[level][slot] = std::min(minAt[level][slot], t.at);
+		}
+
+		// Moves the current tick forward, re-inserting the timers which are now due or belong on a lower level
+		void advance(int64_t tick) {
+			moved.clear();
+			for (int l = 0; l < levels; l++) {
+				const int shift = l * slotBits;
+				uint64_t affected = occupied[l];
+				// If the tick still agrees with the current one above this level, later slots are unaffected
+				if (((tick ^ current) >> (shift + slotBits)) == 0)
+					affected &= (uint64_t(2) << ((tick >> shift) & (slots - 1))) - 1;
+				while (affected) {
+					const int slot = ctzll(affected);
+					affected &= affected - 1;
+					moved.insert(moved.end(), wheel[l][slot].begin(), wheel[l][slot].end());
+					wheel[l][slot].clear();
+					minAt[l][slot] = std::numeric_limits<double>::infinity();
+					occupied[l] &= ~(uint64_t(1) << slot);
+				}
+			}
+			current = tick;
+			while (!overflow.empty()) {
+				const int64_t t = toTick(overflow.top().at);
+				if (t > current && ((t ^ current) >> (levels * slotBits)) != 0)
+					break;
+				moved.push_back(overflow.top());
+				overflow.pop();
+			}
+			for (auto const& t : moved)
+				insert(t);
+		}
+
+		std::array<std::array<std::vector<DelayedTask>, slots>, levels> wheel;
+		std::array<std::array<double, slots>, levels> minAt; // Earliest timer in each slot
+		std::array<uint64_t, levels> occupied; // Bit per non-empty slot
+		std::priority_queue<DelayedTask, std::vector<DelayedTask>> due;
+		std::priority_queue<DelayedTask, std::vector<DelayedTask>> overflow;
+		std::vector<DelayedTask> moved;
+		int64_t current = 0; // Never ahead of the time passed to popReady()
+		size_t count = 0;
+	};
+
 	// Returns a unique priority value for a task which preserves FIFO ordering
 	// for tasks with the same priority.
 	int64_t getFIFOPriority(TaskPriority taskId) { return (int64_t(taskId) << 32) - (++tasksIssued); }
 	uint64_t tasksIssued;
+	const bool bucketed;
 
 	ReadyQueue<OrderedTask> ready;
 	ThreadSafeQueue<std::pair<TaskPriority, Task*>> threadReady;
 
 	std::priority_queue<DelayedTask, std::vector<DelayedTask>> timers;
 
+	ReadyBuckets readyBuckets;
+	TimerWheel timerWheel;
+
 	Int64MetricHandle countTimers;
 	Int64MetricHandle countCantSleep;
 	Int64MetricHandle countWontSleep;
@@ -713,6 +713,16 @@ public:
 		}
 	}
 
+	// Like BinaryReader::fromStringRef, but reads in place: the StringRefs of the result point into sr, which must be
+	// memory owned by arena, instead of being copied.
+	template <class T, class VersionOptions>
+	static T fromStringRef(Arena const& arena, StringRef sr, VersionOptions vo) {
+		T t;
+		ArenaReader r(arena, sr, vo);
+		r >> t;
+		return t;
+	}
+
 	template <class T>
 	void deserialize(T& t) {
 		if constexpr (HasFileIdentifier<T>::value) {
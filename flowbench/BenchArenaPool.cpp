@@ -0,0 +1,79 @@
+/*
+ * BenchArenaPool.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+#include "fdbclient/IKnobCollection.h"
+#include "flow/Arena.h"
+#include "flow/Platform.h"
+#include <vector>
+
+// Measures the cost of the arena churn seen by request and reply arenas: a fixed number of arenas are in flight, and
+// each iteration replaces the oldest one with a new arena filled with small allocations. Blocks come either from the
+// FastAllocator and operator new (the default) or from the per thread arena block pool, and the arena is either grown
+// block by block or reserved up front from a size hint.
+
+enum class BlockSource { DEFAULT, POOL };
+enum class Growth { INCREMENTAL, RESERVED };
+
+static void setArenaBlockPoolBytes(int64_t bytes) {
+	IKnobCollection::getMutableGlobalKnobCollection().setKnob("arena_block_pool_bytes",
+	                                                          KnobValueRef::create(ParsedKnobValue(bytes)));
+}
+
+template <BlockSource source, Growth growth>
+static void bench_arena_churn(benchmark::State& state) {
+	const int arenaBytes = state.range(0);
+	constexpr int itemBytes = 96;
+	constexpr int inFlight = 64;
+	setArenaBlockPoolBytes(source == BlockSource::POOL ? 64 << 20 : 0);
+
+	std::vector<Arena> arenas(inFlight);
+	int next = 0;
+	for (auto _ : state) {
+		Arena arena = growth == Growth::RESERVED ? Arena(arenaBytes) : Arena();
+		for (int allocated = 0; allocated < arenaBytes; allocated += itemBytes) {
+			benchmark::DoNotOptimize(new (arena) uint8_t[itemBytes]);
+		}
+		arenas[next] = std::move(arena);
+		next = (next + 1) % inFlight;
+	}
+	state.SetBytesProcessed(static_cast<long>(state.iterations()) * arenaBytes);
+	state.counters["RSS"] = getResidentMemoryUsage();
+
+	arenas.clear();
+	setArenaBlockPoolBytes(0);
+}
+
+BENCHMARK_TEMPLATE(bench_arena_churn, BlockSource::DEFAULT, Growth::INCREMENTAL)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 18)
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_arena_churn, BlockSource::POOL, Growth::INCREMENTAL)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 18)
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_arena_churn, BlockSource::DEFAULT, Growth::RESERVED)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 18)
+    ->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_arena_churn, BlockSource::POOL, Growth::RESERVED)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 18)
+    ->ReportAggregatesOnly(true);
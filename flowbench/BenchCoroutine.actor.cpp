@@ -0,0 +1,96 @@
+/*
+ * BenchCoroutine.actor.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include <array>
+#include <vector>
+
+#include "flow/flow.h"
+#include "flow/Coroutines.h"
+#include "flow/ThreadHelper.actor.h"
+
+#include "flow/actorcompiler.h" // This must be the last #include.
+
+// Compares the cost of calling an actor with the cost of calling the equivalent C++20 coroutine. Each call keeps Size
+// bytes of state across a wait, so the actor state and the coroutine frame grow with Size. The awaited future is
+// either ready, in which case the call completes without suspending, or set after all calls have been made.
+
+enum class CallType { Actor, Coroutine };
+
+ACTOR template <size_t Size>
+static Future<Void> incrementActor(Future<Void> f, uint32_t* sum) {
+	state std::array<uint8_t, Size> arr;
+	wait(f);
+	benchmark::DoNotOptimize(arr);
+	++(*sum);
+	return Void();
+}
+
+template <size_t Size>
+static Future<Void> incrementCoroutine(Future<Void> f, uint32_t* sum) {
+	std::array<uint8_t, Size> arr;
+	co_await f;
+	benchmark::DoNotOptimize(arr);
+	++(*sum);
+}
+
+ACTOR template <CallType type, size_t Size, bool Ready>
+static Future<Void> benchCallActor(benchmark::State* benchState) {
+	state size_t callCount = benchState->range(0);
+	state uint32_t sum;
+	while (benchState->KeepRunning()) {
+		sum = 0;
+		Promise<Void> trigger;
+		if (Ready) {
+			trigger.send(Void());
+		}
+		std::vector<Future<Void>> futures;
+		futures.reserve(callCount);
+		for (int i = 0; i < callCount; ++i) {
+			if (type == CallType::Actor) {
+				futures.push_back(incrementActor<Size>(trigger.getFuture(), &sum));
+			} else {
+				futures.push_back(incrementCoroutine<Size>(trigger.getFuture(), &sum));
+			}
+		}
+		if (!Ready) {
+			trigger.send(Void());
+		}
+		wait(waitForAll(futures));
+		benchmark::DoNotOptimize(sum);
+	}
+	benchState->SetItemsProcessed(callCount * static_cast<long>(benchState->iterations()));
+	return Void();
+}
+
+template <CallType type, size_t Size, bool Ready>
+static void bench_call(benchmark::State& benchState) {
+	onMainThread([&benchState]() { return benchCallActor<type, Size, Ready>(&benchState); }).blockUntilReady();
+}
+
+BENCHMARK_TEMPLATE(bench_call, CallType::Actor, 32, true)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_call, CallType::Coroutine, 32, true)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_call, CallType::Actor, 32, false)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_call, CallType::Coroutine, 32, false)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_call, CallType::Actor, 1024, true)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_call, CallType::Coroutine, 1024, true)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_call, CallType::Actor, 1024, false)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_call, CallType::Coroutine, 1024, false)->Range(1, 1 << 8)->ReportAggregatesOnly(true);
@@ -0,0 +1,118 @@
+/*
+ * BenchTLogPeek.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+#include "fdbclient/CommitTransaction.h"
+#include "fdbserver/TLogInterface.h"
+#include "flow/Arena.h"
+#include "flow/IRandom.h"
+#include "flow/ObjectSerializer.h"
+#include <vector>
+
+// Measures the single core throughput of building and serializing a TLog peek reply, either by copying every message
+// into one buffer first (the old behavior) or by gathering segments which are copied once, during serialization.
+
+struct PeekMessages {
+	Arena arena;
+	std::vector<StringRef> messages; // Each message includes its 4 byte length prefix, as stored by the TLog
+	int versions;
+	int bytes = 0;
+};
+
+static PeekMessages createPeekMessages(int versions, int messagesPerVersion, int messageSize) {
+	PeekMessages result;
+	result.versions = versions;
+	for (int i = 0; i < versions * messagesPerVersion; i++) {
+		uint8_t* data = new (result.arena) uint8_t[sizeof(uint32_t) + messageSize];
+		uint32_t length = messageSize;
+		memcpy(data, &length, sizeof(length));
+		deterministicRandom()->randomBytes(data + sizeof(length), messageSize);
+		result.messages.emplace_back(data, sizeof(uint32_t) + messageSize);
+		result.bytes += result.messages.back().size();
+	}
+	result.bytes += versions * (sizeof(VERSION_HEADER) + sizeof(Version));
+	return result;
+}
+
+static void bench_tlog_peek_copy(benchmark::State& state) {
+	const int messagesPerVersion = state.range(1);
+	PeekMessages input = createPeekMessages(state.range(0), messagesPerVersion, state.range(2));
+	size_t size = 0;
+	for (auto _ : state) {
+		BinaryWriter wr(Unversioned());
+		for (int v = 0; v < input.versions; v++) {
+			wr << VERSION_HEADER << Version(v);
+			for (int m = 0; m < messagesPerVersion; m++) {
+				wr.serializeBytes(input.messages[v * messagesPerVersion + m]);
+			}
+		}
+		TLogPeekReply reply;
+		Standalone<StringRef> messages = wr.toValue();
+		reply.arena.dependsOn(messages.arena());
+		reply.messages = messages;
+		reply.end = input.versions;
+		Standalone<StringRef> serialized = ObjectWriter::toValue(reply, Unversioned());
+		size = serialized.size();
+		benchmark::DoNotOptimize(serialized);
+	}
+	state.SetBytesProcessed(static_cast<long>(state.iterations()) * input.bytes);
+	state.counters["Size"] = size;
+}
+
+static void bench_tlog_peek_gather(benchmark::State& state) {
+	const int messagesPerVersion = state.range(1);
+	PeekMessages input = createPeekMessages(state.range(0), messagesPerVersion, state.range(2));
+	size_t size = 0;
+	for (auto _ : state) {
+		TLogPeekReply reply;
+		reply.arena.dependsOn(input.arena);
+		for (int v = 0; v < input.versions; v++) {
+			uint8_t* header = new (reply.arena) uint8_t[sizeof(VERSION_HEADER) + sizeof(Version)];
+			Version version = v;
+			memcpy(header, &VERSION_HEADER, sizeof(VERSION_HEADER));
+			memcpy(header + sizeof(VERSION_HEADER), &version, sizeof(version));
+			reply.messageSegments.push_back(reply.arena, StringRef(header, sizeof(VERSION_HEADER) + sizeof(Version)));
+			for (int m = 0; m < messagesPerVersion; m++) {
+				reply.messageSegments.push_back(reply.arena, input.messages[v * messagesPerVersion + m]);
+			}
+		}
+		reply.messageSegmentBytes = input.bytes;
+		reply.end = input.versions;
+		Standalone<StringRef> serialized = ObjectWriter::toValue(reply, Unversioned());
+		size = serialized.size();
+		benchmark::DoNotOptimize(serialized);
+	}
+	state.SetBytesProcessed(static_cast<long>(state.iterations()) * input.bytes);
+	state.counters["Size"] = size;
+}
+
+// Arguments are versions per reply, messages per version, and bytes per message
+BENCHMARK(bench_tlog_peek_copy)
+    ->Args({ 100, 1, 100 })
+    ->Args({ 100, 10, 100 })
+    ->Args({ 1000, 10, 16 })
+    ->Args({ 100, 10, 1000 })
+    ->ReportAggregatesOnly(true);
+BENCHMARK(bench_tlog_peek_gather)
+    ->Args({ 100, 1, 100 })
+    ->Args({ 100, 10, 100 })
+    ->Args({ 1000, 10, 16 })
+    ->Args({ 100, 10, 1000 })
+    ->ReportAggregatesOnly(true);
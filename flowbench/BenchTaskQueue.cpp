@@ -0,0 +1,97 @@
+/*
+ * BenchTaskQueue.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark/benchmark.h"
+
+#include "flow/DeterministicRandom.h"
+#include "flow/TaskQueue.h"
+
+// Compares the scheduling throughput of the heap based TaskQueue with the bucketed one (BUCKETED_TASK_QUEUE)
+
+static constexpr bool HEAP = false;
+static constexpr bool BUCKETED = true;
+
+static const TaskPriority priorities[] = { TaskPriority::RunLoop,
+	                                       TaskPriority::WriteSocket,
+	                                       TaskPriority::ReadSocket,
+	                                       TaskPriority::TLogCommit,
+	                                       TaskPriority::ProxyCommit,
+	                                       TaskPriority::DefaultPromiseEndpoint,
+	                                       TaskPriority::DefaultOnMainThread,
+	                                       TaskPriority::DefaultDelay,
+	                                       TaskPriority::DefaultYield,
+	                                       TaskPriority::DiskRead,
+	                                       TaskPriority::DefaultEndpoint,
+	                                       TaskPriority::DataDistribution,
+	                                       TaskPriority::UpdateStorage,
+	                                       TaskPriority::FetchKeys,
+	                                       TaskPriority::Low,
+	                                       TaskPriority::Min };
+
+static TaskPriority getRandomTaskPriority(DeterministicRandom& rand) {
+	return priorities[rand.randomInt(0, std::size(priorities))];
+}
+
+// Each iteration adds one ready task and runs the highest priority one, with range(0) tasks queued
+template <bool bucketed>
+static void bench_task_queue_ready(benchmark::State& state) {
+	DeterministicRandom rand(platform::getRandomSeed());
+	TaskQueue<int> queue(bucketed);
+	int task = 0;
+	for (int i = 0; i < state.range(0); i++) {
+		queue.addReady(getRandomTaskPriority(rand), &task);
+	}
+	for (auto _ : state) {
+		queue.addReady(getRandomTaskPriority(rand), &task);
+		benchmark::DoNotOptimize(queue.getReadyTask());
+		queue.popReadyTask();
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+// Each iteration adds one timer up to a second away and runs the timers which are due, with about range(0) timers
+// outstanding, as a run loop with many pending delays would
+template <bool bucketed>
+static void bench_task_queue_timers(benchmark::State& state) {
+	DeterministicRandom rand(platform::getRandomSeed());
+	TaskQueue<int> queue(bucketed);
+	int task = 0;
+	const double step = 0.5 / state.range(0);
+	double now = 1e9;
+	for (int i = 0; i < state.range(0); i++) {
+		queue.addTimer(now + rand.random01(), getRandomTaskPriority(rand), &task);
+	}
+	for (auto _ : state) {
+		queue.addTimer(now + rand.random01(), getRandomTaskPriority(rand), &task);
+		now += step;
+		queue.processReadyTimers(now);
+		while (queue.hasReadyTask()) {
+			benchmark::DoNotOptimize(queue.getReadyTask());
+			queue.popReadyTask();
+		}
+		benchmark::DoNotOptimize(queue.getSleepTime(now));
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+BENCHMARK_TEMPLATE(bench_task_queue_ready, HEAP)->Range(1, 1 << 16)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_task_queue_ready, BUCKETED)->Range(1, 1 << 16)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_task_queue_timers, HEAP)->Range(1, 1 << 16)->ReportAggregatesOnly(true);
+BENCHMARK_TEMPLATE(bench_task_queue_timers, BUCKETED)->Range(1, 1 << 16)->ReportAggregatesOnly(true);
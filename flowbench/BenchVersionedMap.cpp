@@ -0,0 +1,141 @@
+/*
+ * BenchVersionedMap.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <optional>
+
+#include "benchmark/benchmark.h"
+
+#include "fdbclient/FDBTypes.h"
+#include "fdbclient/VersionedArtMap.h"
+#include "fdbclient/VersionedMap.h"
+#include "flow/Arena.h"
+#include "flow/FastAlloc.h"
+#include "flow/IRandom.h"
+
+// Compares the storage server's versioned data structures: VersionedMap's PTree and VersionedArtMap.
+// Benchmarks take the number of keys, the key size and the number of keys changed by each version.  Each version
+// copies the nodes it changes, so small versions cost more per key than large ones.
+
+using PTreeData = VersionedMap<KeyRef, ValueOrClearToRef>;
+using ArtData = VersionedArtMap<ValueOrClearToRef>;
+
+// Both structures allocate all of their nodes from FastAllocator
+static int64_t fastAllocatorLiveMemory() {
+	return FastAllocator<16>::getLiveMemory() + FastAllocator<32>::getLiveMemory() +
+	       FastAllocator<64>::getLiveMemory() + FastAllocator<96>::getLiveMemory() +
+	       FastAllocator<128>::getLiveMemory() + FastAllocator<256>::getLiveMemory() +
+	       FastAllocator<512>::getLiveMemory() + FastAllocator<1024>::getLiveMemory() +
+	       FastAllocator<2048>::getLiveMemory() + FastAllocator<4096>::getLiveMemory() +
+	       FastAllocator<8192>::getLiveMemory() + FastAllocator<16384>::getLiveMemory();
+}
+
+// Keys share a short prefix, like the keys of one tenant or subspace
+static std::vector<KeyRef> randomKeys(Arena& arena, int count, int keySize) {
+	std::vector<KeyRef> keys;
+	keys.reserve(count);
+	for (int i = 0; i < count; ++i) {
+		keys.push_back(KeyRef(arena, "\x15\x01" + deterministicRandom()->randomAlphaNumeric(keySize - 2)));
+	}
+	return keys;
+}
+
+template <class Map>
+static void populate(Map& map, std::vector<KeyRef> const& keys, int keysPerVersion, ValueRef value) {
+	Version v = map.getLatestVersion();
+	for (int i = 0; i < keys.size(); ++i) {
+		if (i % keysPerVersion == 0) {
+			map.createNewVersion(++v);
+		}
+		map.insert(keys[i], ValueOrClearToRef::value(value));
+	}
+}
+
+template <class Map>
+static void bench_versioned_map_insert(benchmark::State& state) {
+	int count = state.range(0);
+	int keySize = state.range(1);
+	int keysPerVersion = state.range(2);
+	Arena arena;
+	std::vector<KeyRef> keys = randomKeys(arena, count, keySize);
+	int64_t bytes = 0;
+	for (auto _ : state) {
+		std::optional<Map> map;
+		map.emplace();
+		int64_t before = fastAllocatorLiveMemory();
+		populate(*map, keys, keysPerVersion, "value"_sr);
+		state.PauseTiming();
+		bytes += fastAllocatorLiveMemory() - before;
+		map.reset();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(count * static_cast<long>(state.iterations()));
+	state.counters["BytesPerKey"] = (double)bytes / (count * static_cast<double>(state.iterations()));
+}
+
+// Reads a key the way the storage server does, at a random version in the window
+template <class Map>
+static void bench_versioned_map_read(benchmark::State& state) {
+	int count = state.range(0);
+	int keySize = state.range(1);
+	int keysPerVersion = state.range(2);
+	Arena arena;
+	std::vector<KeyRef> keys = randomKeys(arena, count, keySize);
+	Map map;
+	populate(map, keys, keysPerVersion, "value"_sr);
+	for (auto _ : state) {
+		KeyRef key = keys[deterministicRandom()->randomInt(0, count)];
+		Version v = deterministicRandom()->randomInt64(map.getOldestVersion(), map.getLatestVersion() + 1);
+		auto i = map.at(v).lastLessOrEqual(key);
+		benchmark::DoNotOptimize(i);
+	}
+	state.SetItemsProcessed(static_cast<long>(state.iterations()));
+}
+
+// Forgets every version but the latest after each key has been overwritten once, freeing the replaced nodes
+template <class Map>
+static void bench_versioned_map_forget(benchmark::State& state) {
+	int count = state.range(0);
+	int keySize = state.range(1);
+	int keysPerVersion = state.range(2);
+	Arena arena;
+	std::vector<KeyRef> keys = randomKeys(arena, count, keySize);
+	for (auto _ : state) {
+		state.PauseTiming();
+		std::optional<Map> map;
+		map.emplace();
+		populate(*map, keys, keysPerVersion, "value"_sr);
+		populate(*map, keys, keysPerVersion, "newValue"_sr);
+		state.ResumeTiming();
+		map->forgetVersionsBefore(map->getLatestVersion());
+		state.PauseTiming();
+		map.reset();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(count * static_cast<long>(state.iterations()));
+}
+
+static const std::vector<std::vector<int64_t>> VERSIONED_MAP_ARGS = { { 1 << 10, 1 << 18 }, { 16, 128 }, { 10, 1000 } };
+
+BENCHMARK_TEMPLATE(bench_versioned_map_insert, PTreeData)->ArgsProduct(VERSIONED_MAP_ARGS);
+BENCHMARK_TEMPLATE(bench_versioned_map_insert, ArtData)->ArgsProduct(VERSIONED_MAP_ARGS);
+BENCHMARK_TEMPLATE(bench_versioned_map_read, PTreeData)->ArgsProduct(VERSIONED_MAP_ARGS);
+BENCHMARK_TEMPLATE(bench_versioned_map_read, ArtData)->ArgsProduct(VERSIONED_MAP_ARGS);
+BENCHMARK_TEMPLATE(bench_versioned_map_forget, PTreeData)->ArgsProduct(VERSIONED_MAP_ARGS);
+BENCHMARK_TEMPLATE(bench_versioned_map_forget, ArtData)->ArgsProduct(VERSIONED_MAP_ARGS);